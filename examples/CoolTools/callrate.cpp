@@ -17,6 +17,7 @@
 #include "pin++/Section.h"
 #include "pin++/Buffer.h"
 #include "pin++/Callback.h"
+#include "pin++/Thread_Pool.h"
 
 #include <fstream>
 #include <string>
@@ -93,6 +94,36 @@ private:
 
 
 
+/*******************************
+ * Sort task
+ *******************************/
+
+/**
+ * Task that sorts one chunk of the routine - count pairs.
+ */
+template <typename ITERATOR>
+class Sort_Task : public OASIS::Pin::Runnable
+{
+public:
+  Sort_Task (ITERATOR begin, ITERATOR end)
+    : begin_ (begin),
+      end_ (end)
+  {
+
+  }
+
+  void run (void)
+  {
+    std::sort (this->begin_, this->end_);
+  }
+
+private:
+  ITERATOR begin_;
+  ITERATOR end_;
+};
+
+
+
 /*******************************
  * Instrument
  *******************************/
@@ -123,7 +154,8 @@ public:
     // second iteration
     // pre-allocate one buffer for each image
     // the buffer size is equal to the number of routines in the image
-    item_type item ((size_t) total_rtn_in_img);
+    this->rtn_buffer_list_.emplace_back ((size_t) total_rtn_in_img);
+    item_type & item = this->rtn_buffer_list_.back ();
     item_type::iterator callback = item.begin ();
     
     for (auto sec : img)
@@ -137,9 +169,6 @@ public:
         ++callback;
       }
     }
-    
-    // the buffer list contains one buffer for each image
-    this->rtn_buffer_list_.push_back (item);
   }
 
   /**
@@ -151,7 +180,7 @@ public:
   {
     UINT64 total_rtn_count = 0;
 
-    for (auto buffer : this->rtn_buffer_list_)
+    for (auto & buffer : this->rtn_buffer_list_)
     {
       for (auto item : buffer)
       {
@@ -167,11 +196,14 @@ public:
    * The output format is: <routine name> : <routine call counts>, <total routine calls>, <callrate>
    *
    * Each routine - count pair is pushed into a vector; the vector is sorted,
-   * and the counts for the same routine are combined for output.
+   * and the counts for the same routine are combined for output. The vector
+   * is split into one chunk per worker in the pool, the chunks are sorted in
+   * parallel, and then merged.
    *
    * @param[in]    output_file    the file pointer for output
+   * @param[in]    pool           the pool that sorts the chunks
    */
-  void output_to_file_by_sorting (std::ofstream & fout)
+  void output_to_file_by_sorting (std::ofstream & fout, OASIS::Pin::Thread_Pool & pool)
   {
     UINT64 total_rtn_count = this->total_count ();
 
@@ -180,7 +212,7 @@ public:
     pair_vector pair_list;
 
     // iterate through the buffer and put the result into the vector
-    for (auto buffer : this->rtn_buffer_list_)
+    for (auto & buffer : this->rtn_buffer_list_)
     {
       for (auto item : buffer)
       {
@@ -192,7 +224,7 @@ public:
     }
     
     // sort the vector so that the counts for the same routine can be combined
-    std::sort (pair_list.begin (), pair_list.end ());
+    this->parallel_sort (pair_list, pool);
     size_t len = pair_list.size ();
 
     // combine the count for the same routine and output the result to fout
@@ -234,7 +266,7 @@ public:
     UINT64 curr_count = 0;
 
     // iterate through the buffer and put the result into the hashmap
-    for (auto buffer : this->rtn_buffer_list_)
+    for (auto & buffer : this->rtn_buffer_list_)
     {
       for (auto item : buffer)
       {
@@ -276,6 +308,51 @@ public:
   }
 
 private:
+  /**
+   * Sort a vector by sorting one chunk per worker, and merging the chunks.
+   */
+  template <typename VECTOR>
+  static void parallel_sort (VECTOR & v, OASIS::Pin::Thread_Pool & pool)
+  {
+    typedef Sort_Task <typename VECTOR::iterator> task_type;
+
+    // small vectors are not worth the tasks
+    size_t chunks = pool.size ();
+
+    if (chunks < 2 || v.size () < chunks * 1024)
+    {
+      std::sort (v.begin (), v.end ());
+      return;
+    }
+
+    size_t chunk_size = (v.size () + chunks - 1) / chunks;
+    std::vector <task_type> tasks;
+    std::vector <size_t> bounds;
+
+    for (size_t i = 0; i < v.size (); i += chunk_size)
+    {
+      size_t end = std::min (i + chunk_size, v.size ());
+
+      tasks.push_back (task_type (v.begin () + i, v.begin () + end));
+      bounds.push_back (end);
+    }
+
+    OASIS::Pin::Latch done;
+
+    for (size_t i = 0; i < tasks.size (); ++i)
+    {
+      // sort the chunk here if the pool is already shut down
+      if (!pool.submit (&tasks[i], &done))
+        tasks[i].run ();
+    }
+
+    pool.wait (done);
+
+    // merge each sorted chunk into the sorted prefix before it
+    for (size_t i = 1; i < bounds.size (); ++i)
+      std::inplace_merge (v.begin (), v.begin () + bounds[i - 1], v.begin () + bounds[i]);
+  }
+
   typedef OASIS::Pin::Buffer <Call_Rate> item_type;      // buffer type for a buffer of callback
   typedef std::list <item_type> list_type;               // list type of a list of buffers
   list_type rtn_buffer_list_;
@@ -297,15 +374,17 @@ public:
    * Constructor.
    */
   callrate (void)
+    : pool_ (threads_.Value ())
   {
     this->init_symbols ();
-    this->enable_fini_callback ();
+    this->enable_fini_unlocked_callback ();
   }
 
   /**
-   * Process after program execution.
+   * Process after program execution. The output is written before the
+   * internal threads of the pool are terminated by Pin.
    */
-  void handle_fini (INT32 code)
+  void handle_fini_unlocked (INT32 code)
   {
     // select between HASH and SORT for the implementation
     // sort: maybe slower for large program, but the result will be sorted
@@ -320,22 +399,27 @@ public:
     switch (choice)
     {
     case SORT:
-      this->image_.output_to_file_by_sorting (fout);
+      this->image_.output_to_file_by_sorting (fout, this->pool_);
       break;
     default:
       this->image_.output_to_file_by_hashmap (fout);
       break;
     }
+
+    this->pool_.shutdown ();
   }
 
 private:
   Image image_;                       // image level instrument
+  OASIS::Pin::Thread_Pool pool_;      // workers for sorting the output
   static KNOB <string> outfile_;      // output file handler
+  static KNOB <UINT32> threads_;      // number of workers in the pool
 };
 
 
 
 KNOB <string> callrate::outfile_ (KNOB_MODE_WRITEONCE, "pintool", "o", "callrate.out", "specify output file name");
+KNOB <UINT32> callrate::threads_ (KNOB_MODE_WRITEONCE, "pintool", "threads", "4", "number of threads for sorting the output");
 
 
 
@@ -8,7 +8,13 @@ const_char_ptr_cmd::~const_char_ptr_cmd (void)
 {
 }
 
-void const_char_ptr_cmd::execute (ADDRINT addr, std::ofstream & fout)
+const char * const_char_ptr_cmd::format (void)
 {
-  fout << "  Return value: " << (const char *) addr << std::endl;
+  return "  Return value: %s\n";
+}
+
+void const_char_ptr_cmd::execute (ADDRINT addr, OASIS::Pin::Async_Log & log, UINT32 format)
+{
+  // the string belongs to the application, so it is copied
+  log.log_text (format, (const char *) addr);
 }
\ No newline at end of file
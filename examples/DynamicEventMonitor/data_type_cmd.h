@@ -6,8 +6,8 @@
 #ifndef _DATA_TYPE_CMD_H_
 #define _DATA_TYPE_CMD_H_
 
-#include <fstream>
 #include "pin++/Pintool.h"
+#include "pin++/Async_Log.h"
 
 class data_type_cmd
 {
@@ -17,7 +17,12 @@ public:
 
   virtual ~ data_type_cmd(void);
 
-  virtual void execute (ADDRINT addr, std::ofstream & fout) = 0;
+  // Format of the return value, for OASIS::Pin::Async_Log::register_format.
+  virtual const char * format (void) = 0;
+
+  // Log the return value with a format registered with the log. The value
+  // is read now, and formatted later by the writer of the log.
+  virtual void execute (ADDRINT addr, OASIS::Pin::Async_Log & log, UINT32 format) = 0;
 };
 
 #endif
\ No newline at end of file
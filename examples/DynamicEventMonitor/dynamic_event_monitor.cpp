@@ -15,13 +15,17 @@
     //#include <unistd.h>
 //#endif
 
+#include "pin++/Image_Cache.h"
 #include "pin++/Image_Instrument.h"
+#include "pin++/Signature.h"
+#include "pin++/Signature_Matcher.h"
 #include "pin++/Pintool.h"
 #include "pin++/Callback.h"
 #include "pin++/Routine.h"
 #include "pin++/Symbol.h"
 #include "pin++/Buffer.h"
 #include "pin++/Copy.h"
+#include "pin++/Async_Log.h"
 
 #include <iostream>
 #include <sstream>
@@ -34,21 +38,116 @@
 #include "data_type_cmd.h"
 #include "data_type_cmd_factory.h"
 
-#include <fstream>
-
 /*******************************
 * Type definitions
 *******************************/
 
-// map between name of the target method and the event type passed into it
-typedef std::unordered_map <std::string, std::string> method_event_map_type;
+// map between name of the target method and the event type passed into it.
+// The event types are the keys of the event list, which are never changed
+// or removed, so the analysis routine can log them by address.
+typedef std::unordered_map <std::string, const std::string *> method_event_map_type;
+
+// list of the event types
+typedef std::unordered_map <std::string, bool> event_list_type;
 
 // map between event type and its helper methods
 typedef std::unordered_map <std::string, ADDRINT> helper_addr_map_type;
 typedef std::unordered_multimap <std::string, helper_addr_map_type> event_helper_map_type;
 
+// command for a return type, with the id of its format in the log and in the event trace
+struct return_type_cmd
+{
+  return_type_cmd (void)
+    : cmd_ (0),
+    log_format_ (OASIS::Pin::Async_Log::INVALID_FORMAT),
+    eventtrace_format_ (OASIS::Pin::Async_Log::INVALID_FORMAT)
+  {
+  }
+
+  data_type_cmd * cmd_;
+  UINT32 log_format_;
+  UINT32 eventtrace_format_;
+};
+
 // map between helper and return type.
-typedef std::unordered_map <std::string, data_type_cmd *> helper_returntype_map_type;
+typedef std::unordered_map <std::string, return_type_cmd> helper_returntype_map_type;
+
+/**
+* Ids of the formats of the messages written by the analysis routine. The
+* formats are registered once, and the analysis routine only logs the ids
+* with the arguments of the messages.
+*/
+struct event_formats
+{
+  /**
+  * Register the formats with the log and the event trace.
+  */
+  void init (OASIS::Pin::Async_Log & log, OASIS::Pin::Async_Log & eventtrace)
+  {
+    null_object_ = log.register_format ("..Error: the object passed in is null.\n");
+    not_registered_ = log.register_format ("..Error: push method '%s' not registered.\n");
+    intercepted_ = log.register_format ("..Intercepted a push method call '%s' with event type '%s'\n");
+    method_ = log.register_format ("  Method: %s\n");
+
+    event_ = eventtrace.register_format ("Date Time : %t Severity : 16854  Thread id : %u"
+                                         " Component : %s Event : %s Element : %s\n");
+  }
+
+  // messages of the log
+  UINT32 null_object_;
+  UINT32 not_registered_;
+  UINT32 intercepted_;
+  UINT32 method_;
+
+  // event of the event trace
+  UINT32 event_;
+};
+
+/**
+* Stream for the messages of the log that are written at instrumentation
+* time. Each line is queued on the log as one message, so it stays in order
+* with the messages of the analysis routine.
+*/
+class log_stream : public std::ostream
+{
+public:
+  log_stream (OASIS::Pin::Async_Log & log)
+    : std::ostream (0),
+    buffer_ (log)
+  {
+    this->rdbuf (&buffer_);
+  }
+
+private:
+  class line_buffer : public std::stringbuf
+  {
+  public:
+    line_buffer (OASIS::Pin::Async_Log & log)
+      : log_ (log),
+      format_ (log.register_format ("%s"))
+    {
+    }
+
+  protected:
+    // called by std::endl and flush
+    virtual int sync (void)
+    {
+      if (!this->str ().empty ())
+      {
+        log_.log_text (format_, this->str ().c_str ());
+        this->str ("");
+      }
+
+      return 0;
+    }
+
+  private:
+    OASIS::Pin::Async_Log & log_;
+    UINT32 format_;
+  };
+
+  line_buffer buffer_;
+};
 
 /*******************************
 * Analysis routine
@@ -61,10 +160,11 @@ class Event_Monitor : public OASIS::Pin::Callback <Event_Monitor (OASIS::Pin::AR
 {
 public:
   Event_Monitor ()
-    : fout_ (0),
+    : log_ (0),
+    eventtrace_ (0),
+    formats_ (0),
     method_event_map_ (0),
-    helper_return_type_map_ (0),
-    eventtrace_ (0)
+    helper_return_type_map_ (0)
   {
   }
   /**
@@ -75,7 +175,7 @@ public:
     if (object_addr == 0)
     {
       if (logs_required_)
-        *fout_ << "..Error: the object passed in is null." << std::endl;
+        log_->log (formats_->null_object_);
 
       return;
     }
@@ -84,15 +184,16 @@ public:
     if (push_event_iter == method_event_map_->end ())
     {
       if (logs_required_)
-        *fout_ << "..Error: push method '" << target_name_ << "' not registered." << std::endl;
+        log_->log (formats_->not_registered_, string_arg (target_name_));
 
       return;
     }
 
-    std::string event_type = push_event_iter->second;
+    // the strings are logged by address, so they must never change
+    const std::string & event_type = *push_event_iter->second;
 
     if (logs_required_)
-      *fout_ << "..Intercepted a push method call '" << target_name_ << "' with event type '" << event_type << "'" << std::endl;
+      log_->log (formats_->intercepted_, string_arg (target_name_), string_arg (event_type));
 
     helper_methods_execution (event_type, object_addr);
   }
@@ -104,7 +205,7 @@ public:
   * @param[in]      class_name       class name of the target object
   * @param[in]      object_addr      address of the target object
   */
-  void helper_methods_execution (std::string event_type, ADDRINT object_addr) //, OASIS::Pin::Context & ctx)
+  void helper_methods_execution (const std::string & event_type, ADDRINT object_addr) //, OASIS::Pin::Context & ctx)
   {
     // Find all the helper addr map for the event
     std::pair <std::unordered_multimap <std::string, helper_addr_map_type>::iterator,
@@ -116,18 +217,18 @@ public:
     std::unordered_multimap <std::string, helper_addr_map_type> ::iterator event_helper_it;
     for (event_helper_it = it.first; event_helper_it != it.second; ++ event_helper_it)
     {
-      helper_addr_map_type helper_addr_map = event_helper_it->second;
+      const helper_addr_map_type & helper_addr_map = event_helper_it->second;
 
-      for (auto method : helper_addr_map)
+      for (auto & method : helper_addr_map)
       {
         ADDRINT helper_addr = method.second;
         ADDRINT result_addr = 0;
 
-        // Create a command for the return type.
-        data_type_cmd * cmd = (*helper_return_type_map_)[method.first];
+        // Find the command for the return type.
+        helper_returntype_map_type::const_iterator cmd = helper_return_type_map_->find (method.first);
 
         if (logs_required_)
-          *fout_ << "  Method: " << method.first << std::endl;
+          log_->log (formats_->method_, string_arg (method.first));
 
         asm volatile(
           "mov %1, %%ecx\n"
@@ -144,22 +245,22 @@ public:
          * Host Name
          * Thread id
          * Message
+         *
+         * The event is formatted later by the writer of the event trace.
          **/
-        char machine_name [150];
-        *eventtrace_ << "Date Time : " << current_date_time () 
-                      << " Severity : 16854 " 
-                      //<< get_machine_name (machine_name);
-                      << " Thread id : " << PIN_GetTid ()
-                      << " Component : " << get_component_name () 
-                      << " Event : " << event_type
-                      << " Element : " << method.first << std::endl; 
-
-        if (cmd != 0)
+        eventtrace_->log (formats_->event_,
+                          time (0),
+                          PIN_GetTid (),
+                          string_arg (component_name_),
+                          string_arg (event_type),
+                          string_arg (method.first));
+
+        if (cmd != helper_return_type_map_->end () && cmd->second.cmd_ != 0)
         {
-          cmd->execute (result_addr, *eventtrace_);
+          cmd->second.cmd_->execute (result_addr, *eventtrace_, cmd->second.eventtrace_format_);
 
           if (logs_required_)
-            cmd->execute (result_addr, *fout_);
+            cmd->second.cmd_->execute (result_addr, *log_, cmd->second.log_format_);
         }          
       }
     }
@@ -172,17 +273,14 @@ public:
   }
 
   /**
-  * Get the current date time in string format
+  * Argument of the log for a string of the tool. The string is written
+  * later by the writer of the log, so it must never change or be freed:
+  * the target and component names are set once, the event types are keys
+  * of the event list, and the helper names are keys of the helper maps.
   */
-  const std::string current_date_time ()
+  static UINT64 string_arg (const std::string & str)
   {
-    time_t now = time (0);
-    struct tm tstruct;
-    char buf[50];
-    tstruct = *localtime(&now);
-    strftime (buf, sizeof(buf), "%Y-%m-%d.%X", &tstruct);
-
-    return buf;
+    return reinterpret_cast <ADDRINT> (str.c_str ());
   }
 
   /**
@@ -219,6 +317,7 @@ public:
   void set_target_name (std::string name)
   {
     target_name_.assign (name);
+    component_name_ = get_component_name ();
   }
 
   /**
@@ -255,21 +354,29 @@ public:
   }
 
    /**
-  * Setter for ofstream pointer of log file
+  * Setter for the log
   */
-  void set_logfile (std::ofstream & fout)
+  void set_log (OASIS::Pin::Async_Log & log)
   {
-    fout_ = &fout;
+    log_ = &log;
   }
 
   /**
-  * Setter for ofstream pointer of event trace
+  * Setter for the event trace
   */
-  void set_eventtrace (std::ofstream & eventtrace)
+  void set_eventtrace (OASIS::Pin::Async_Log & eventtrace)
   {
     eventtrace_ = &eventtrace;
   }
 
+  /**
+  * Setter for the formats of the messages
+  */
+  void set_formats (const event_formats & formats)
+  {
+    formats_ = &formats;
+  }
+
   /**
   * Setter for method event map
   */
@@ -305,11 +412,17 @@ public:
 private:
   std::string target_name_;
 
-  // File name to write output
-  std::ofstream * fout_;
+  // Name of the component of the target method
+  std::string component_name_;
 
-  // File to write event trace
-  std::ofstream * eventtrace_;
+  // Log
+  OASIS::Pin::Async_Log * log_;
+
+  // Event trace
+  OASIS::Pin::Async_Log * eventtrace_;
+
+  // Formats of the messages
+  const event_formats * formats_;
 
   // Map between events and methods
   method_event_map_type * method_event_map_;
@@ -338,8 +451,10 @@ class Image_Inst : public OASIS::Pin::Image_Instrument <Image_Inst>
 public:
 
   // Constructor
-  Image_Inst (ofstream & fout, 
-              std::ofstream & eventtrace,
+  Image_Inst (std::ostream & fout,
+              OASIS::Pin::Async_Log & log,
+              OASIS::Pin::Async_Log & eventtrace,
+              const event_formats & formats,
               method_event_map_type & method_event_map,
               std::vector<string> & target_method_list,
               std::vector<string> & include_list,
@@ -347,9 +462,12 @@ public:
               std::vector<string> & helper_list,
               std::string & obv,
               event_helper_map_type & event_helper_map,
-              bool & logs_required)
+              bool & logs_required,
+              OASIS::Pin::Image_Cache & cache)
     :fout_ (fout),
+    log_ (log),
     eventtrace_ (eventtrace),
+    formats_ (formats),
     method_event_map_ (method_event_map),
     target_method_list_ (target_method_list),
     include_list_ (include_list),
@@ -358,7 +476,8 @@ public:
     obv_ (obv),
     helper_image_loaded_ (false),
     event_helper_map_ (event_helper_map),
-    logs_required_ (logs_required)
+    logs_required_ (logs_required),
+    cache_ (cache)
   {
     
   }
@@ -366,110 +485,209 @@ public:
 private:
   enum RTN_TYPE {SIGNATURE, METHOD_CALL, INVALID};
 
+  // kinds of the decisions stored in the image cache
+  enum CACHE_TAG {CACHE_SIGNATURE, CACHE_METHOD_CALL, CACHE_HELPER};
+
 public:
   /**
-  * Instrument routine.
+  * Instrument routine. The routines found in an image are loaded from the
+  * image cache if possible; otherwise, the image is walked, and the routines
+  * are stored in the cache for the next run.
   *
   * @param[auto]      img      the image to be instrumented
   */
   void handle_instrument (const OASIS::Pin::Image & img)
   {
-    int push_method_count = 0;
+    bool is_include = false;
+    for (auto include : include_list_)
+    {
+      if (img.name ().find (include) != std::string::npos)
+        is_include = true;
+    }
 
-    size_t separator = std::string::npos;
+    bool is_helper = false;
+    for (auto helper : helper_list_)
+    {
+      if (img.name ().find (helper) != std::string::npos)
+        is_helper = true;
+    }
 
-    // The first iteration looks for target method signatures, method calls and their associated event types
-    // In the include list.
-    for (auto include : include_list_)
+    if (!is_include && !is_helper)
+      return;
+
+    OASIS::Pin::Image_Cache::entries_type entries;
+
+    if (cache_.lookup (img.name (), entries))
     {
-      separator = img.name ().find (include);
-      if (separator != std::string::npos)
+      if (logs_required_)
+        fout_ << "Loading " << entries.size () << " cached routines of " << img.name () << std::endl;
+
+      load_cached_image (img, entries);
+    }
+    else
+    {
+      if (is_include)
       {
         if (logs_required_)
           fout_ << "Finding push method in " << img.name () <<std::endl;
 
-        for (auto sec : img) 
+        find_push_methods (img, entries);
+      }
+
+      if (is_helper)
+      {
+        if (logs_required_)
+          fout_ << "Finding helper method in " << img.name () <<std::endl;
+
+        // Load the methods and address from helper image, so that we can process when we discover events laters.
+        load_helper_image_methods (img, entries);
+      }
+
+      cache_.store (img.name (), entries);
+    }
+
+    if (is_helper)
+      register_helper_image ();
+  }
+
+  /**
+  * Look for target method signatures, method calls and their associated event types
+  * in an image from the include list.
+  *
+  * @param[in]      img          the image to be instrumented
+  * @param[out]     entries      the routines found, for the image cache
+  */
+  void find_push_methods (const OASIS::Pin::Image & img, OASIS::Pin::Image_Cache::entries_type & entries)
+  {
+    for (auto sec : img) 
+    {
+      for (auto rtn : sec)
+      {
+        if (!rtn.valid ())
+          continue;
+
+        const std::string & rtn_signature = rtn.undecorate (UNDECORATION_COMPLETE);        
+        RTN_TYPE rtn_type = is_valid_push_method (rtn_signature);
+
+        if (rtn_type == INVALID)
+          continue;
+
+        const std::string & rtn_name = rtn.undecorate (UNDECORATION_NAME_ONLY);
+
+        OASIS::Pin::Image_Cache::Entry entry;
+        entry.offset_ = rtn.address () - img.load_offset ();
+        
+        // the routine is merely a target method signature; map it with its event type
+        if (rtn_type == SIGNATURE)
         {
-          for (auto rtn : sec)
+          std::string event_type = get_push_event_type (rtn_signature);
+          register_push_signature (rtn_name, event_type);
+
+          entry.tag_ = CACHE_SIGNATURE;
+          entry.data_ = rtn_name + '\0' + event_type;
+          entries.push_back (entry);
+
+          if (logs_required_)
           {
-            if (!rtn.valid ())
-              continue;
+            fout_ << "Signature found: " << std::endl;
+            fout_ << "Image: " << img.name () << std::endl;
+            fout_ << "Sign: " << rtn_signature << std::endl;
+            fout_ << "Name: " << rtn_name << std::endl;
+            fout_ << "Associated event type: " << event_type << std::endl;
+            fout_ << std::endl;
+          }
+        }
+        // the routine is an actual method call; insert the analysis routine
+        else if (rtn_type == METHOD_CALL)
+        {
+          instrument_method_call (rtn, rtn_name);
 
-            std::string rtn_signature = OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_COMPLETE);        
-            std::string rtn_name = OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_NAME_ONLY);
+          entry.tag_ = CACHE_METHOD_CALL;
+          entry.data_ = rtn_name;
+          entries.push_back (entry);
 
-            RTN_TYPE rtn_type = is_valid_push_method (rtn_signature);
-            
-            // the routine is merely a target method signature; map it with its event type
-            if (rtn_type == SIGNATURE)
-            {
-              ++ push_method_count;
-              std::string event_type = get_push_event_type (rtn_signature);
-              method_event_map_[rtn_name] = event_type;
-              event_list[event_type] = true;
-
-              if (helper_image_loaded_)
-                check_and_register_valid_helper_method ();
-
-              if (logs_required_)
-              {
-                fout_ << "Signature found: " << std::endl;
-                fout_ << "Image: " << img.name () << std::endl;
-                fout_ << "Sign: " << rtn_signature << std::endl;
-                fout_ << "Name: " << rtn_name << std::endl;
-                fout_ << "Associated event type: " << event_type << std::endl;
-                fout_ << std::endl;
-              }
-            }
-            // the routine is an actual method call; insert the analysis routine
-            else if (rtn_type == METHOD_CALL)
-            {
-              OASIS::Pin::Routine_Guard guard (rtn);
-              // buffers must be used; otherwise the analysis routine cannot be preserved
-              item_type helper_buffer (1);
-              item_type::iterator helper = helper_buffer.begin ();
-              helper->set_target_name (rtn_name);
-              helper->set_logs_required (logs_required_);
-              helper->set_logfile (fout_);
-              helper->set_eventtrace (eventtrace_);
-              helper->set_method_event_map (method_event_map_);
-              helper->set_event_helper_map (event_helper_map_);
-              helper->set_helper_returntype_map (helper_returntype_map_);
-              helper->insert (IPOINT_BEFORE, rtn, 0);
-              analysis_rtn_buffer_list_.push_back (helper_buffer);
-
-              if (logs_required_)
-              {
-                fout_ << "Method call found: " << std::endl;
-                fout_ << "Image: " << img.name () << std::endl;
-                fout_ << "Sign: " << rtn_signature << std::endl;
-                fout_ << "Name: " << rtn_name << std::endl;
-                fout_ << std::endl;
-              }
-            }
+          if (logs_required_)
+          {
+            fout_ << "Method call found: " << std::endl;
+            fout_ << "Image: " << img.name () << std::endl;
+            fout_ << "Sign: " << rtn_signature << std::endl;
+            fout_ << "Name: " << rtn_name << std::endl;
+            fout_ << std::endl;
           }
         }
       }
     }
+  }
 
-    // Load methods from the helper class.
-    size_t sep = std::string::npos;
-    for (auto helper : helper_list_)
+  /**
+  * Apply the routines found in an image by a previous run, in the order
+  * they were found.
+  *
+  * @param[in]      img          the image to be instrumented
+  * @param[in]      entries      the routines from the image cache
+  */
+  void load_cached_image (const OASIS::Pin::Image & img, const OASIS::Pin::Image_Cache::entries_type & entries)
+  {
+    for (auto entry : entries)
     {
-      sep = img.name ().find (helper);
-      if (sep != std::string::npos)
-      {
-        if (logs_required_)
-          fout_ << "Finding helper method in " << img.name () <<std::endl;
+      ADDRINT rtn_addr = entry.offset_ + img.load_offset ();
 
-        // Load the methods and address from helper image, so that we can process when we discover events laters.
-        load_helper_image_methods (img);
+      if (entry.tag_ == CACHE_SIGNATURE)
+      {
+        size_t separator = entry.data_.find ('\0');
+        register_push_signature (entry.data_.substr (0, separator), entry.data_.substr (separator + 1));
+      }
+      else if (entry.tag_ == CACHE_METHOD_CALL)
+      {
+        OASIS::Pin::Routine rtn = OASIS::Pin::Routine::find (rtn_addr);
 
-        helper_image_loaded_ = true;
+        if (rtn.valid ())
+          instrument_method_call (rtn, entry.data_);
+        else if (logs_required_)
+          fout_ << "Cached method call " << entry.data_ << " not found in " << img.name () << std::endl;
+      }
+      else if (entry.tag_ == CACHE_HELPER)
+      {
+        helper_methods_map[entry.data_] = rtn_addr;
       }
     }
   }
 
+  /**
+  * Map a target method signature with its event type.
+  */
+  void register_push_signature (const std::string & rtn_name, const std::string & event_type)
+  {
+    // the map refers to the key in the event list, so a queued event type
+    // is not changed if the method is registered again
+    event_list_type::iterator event = event_list.insert (std::make_pair (event_type, true)).first;
+    method_event_map_[rtn_name] = &event->first;
+
+    if (helper_image_loaded_)
+      check_and_register_valid_helper_method ();
+  }
+
+  /**
+  * Insert the analysis routine before a target method call.
+  */
+  void instrument_method_call (OASIS::Pin::Routine & rtn, const std::string & rtn_name)
+  {
+    OASIS::Pin::Routine_Guard guard (rtn);
+    // buffers must be used; otherwise the analysis routine cannot be preserved
+    analysis_rtn_buffer_list_.emplace_back (1);
+    item_type & helper_buffer = analysis_rtn_buffer_list_.back ();
+    item_type::iterator helper = helper_buffer.begin ();
+    helper->set_target_name (rtn_name);
+    helper->set_logs_required (logs_required_);
+    helper->set_log (log_);
+    helper->set_eventtrace (eventtrace_);
+    helper->set_formats (formats_);
+    helper->set_method_event_map (method_event_map_);
+    helper->set_event_helper_map (event_helper_map_);
+    helper->set_helper_returntype_map (helper_returntype_map_);
+    helper->insert (IPOINT_BEFORE, rtn, 0);
+  }
+
   /**
   * Determine whether the passed in routine is a valid target method, and further
   * if it is an actual method call, or merely a signature.
@@ -479,20 +697,24 @@ public:
   * @retval         SIGNATURE          a signature, not a real method call
   * @retval         METHOD_CALL        real method call
   */
-  RTN_TYPE is_valid_push_method (std::string rtn_signature)
+  RTN_TYPE is_valid_push_method (const std::string & rtn_signature)
   {
-    size_t separator = std::string::npos;
-    for (auto method : target_method_list_)
+    // the target methods are matched in one pass over the signature
+    if (!method_matcher_.is_compiled ())
     {
-      separator = rtn_signature.find ("::" + method);
-      if (separator != std::string::npos)
-        break;
+      for (auto method : target_method_list_)
+        method_matcher_.add ("::" + method);
+
+      method_matcher_.compile ();
     }
 
-    if (separator == std::string::npos)
+    OASIS::Pin::String_Slice signature (rtn_signature);
+    size_t method_id = 0, separator = 0;
+
+    if (!method_matcher_.find (signature, method_id, separator))
       return INVALID;
 
-    if (rtn_signature.find ("(", separator) != std::string::npos)
+    if (signature.find ('(', separator) != OASIS::Pin::String_Slice::npos)
       return SIGNATURE;
     else
       return METHOD_CALL;
@@ -505,11 +727,14 @@ public:
   * @param[in]      rtn_name           concise routine name
   * @return         returns the type of the object passed into the routine method
   */
-  std::string get_push_event_type (std::string rtn_signature)
+  std::string get_push_event_type (const std::string & rtn_signature)
   {
-    size_t start = rtn_signature.find ("(class ") + 7;
-    size_t end = rtn_signature.find (" ", start);
-    return rtn_signature.substr (start, end - start);
+    OASIS::Pin::String_Slice event_type = OASIS::Pin::Signature (rtn_signature).param (0);
+
+    if (event_type.starts_with ("class "))
+      event_type = event_type.substr (6);
+
+    return event_type.substr (0, event_type.find (' ')).str ();
   }
 
   /**
@@ -608,7 +833,14 @@ public:
 	    fout_ << "Return signature of helper method is " << rtn_signature << std::endl;
 	    fout_ << "Return type of method " << method_name << " is " << method_return_type << std::endl;
             data_type_cmd * cmd  = create_data_type_cmd (method_return_type);
-            helper_returntype_map_[method_name] = cmd;
+            return_type_cmd & return_type = helper_returntype_map_[method_name];
+            return_type.cmd_ = cmd;
+
+            if (cmd != 0)
+            {
+              return_type.log_format_ = log_.register_format (cmd->format ());
+              return_type.eventtrace_format_ = eventtrace_.register_format (cmd->format ());
+            }
           }         
          }
        }
@@ -646,7 +878,7 @@ public:
   */
   void output_helper_list (void)
   {
-    for (auto helper_buffer : analysis_rtn_buffer_list_)
+    for (auto & helper_buffer : analysis_rtn_buffer_list_)
     {
       for (auto helper : helper_buffer)
       {
@@ -662,7 +894,7 @@ public:
   /*
   * Load all the methods in the helper image methods and store them with their address
   */
-  void load_helper_image_methods (const OASIS::Pin::Image & img)
+  void load_helper_image_methods (const OASIS::Pin::Image & img, OASIS::Pin::Image_Cache::entries_type & entries)
   {
     // the second iteration looks for helper methods of the event
     for (auto sec : img)
@@ -672,10 +904,24 @@ public:
         if (!rtn.valid ())
           continue;
 
-        std::string rtn_signature = OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_COMPLETE);
+        const std::string & rtn_signature = rtn.undecorate (UNDECORATION_COMPLETE);
         helper_methods_map[rtn_signature] = rtn.address ();  // Store the method name and its return address.
+
+        OASIS::Pin::Image_Cache::Entry entry;
+        entry.tag_ = CACHE_HELPER;
+        entry.offset_ = rtn.address () - img.load_offset ();
+        entry.data_ = rtn_signature;
+        entries.push_back (entry);
       }
     }
+  }
+
+  /*
+  * Register the methods of a loaded helper image with the events found so far
+  */
+  void register_helper_image (void)
+  {
+    helper_image_loaded_ = true;
 
     // If event list is not empty, i.e. it was loaded before the helper image was loaded,
     // then register helper methods immediately.
@@ -687,11 +933,17 @@ public:
   }
 
 public:
-  // File for writing the logs
-  std::ofstream & fout_;
+  // Stream for writing the logs
+  std::ostream & fout_;
+
+  // Log, for the analysis routines
+  OASIS::Pin::Async_Log & log_;
+
+  // Event trace
+  OASIS::Pin::Async_Log & eventtrace_;
 
-  // File to write event trace
-  std::ofstream & eventtrace_;
+  // Formats of the messages of the analysis routines
+  const event_formats & formats_;
 
 private:
   typedef OASIS::Pin::Buffer <Event_Monitor> item_type;              // a buffer for a routine
@@ -699,7 +951,7 @@ private:
   list_type analysis_rtn_buffer_list_;                               // the list that carries all the buffers for routines
 
   // map for registered event types
-  std::unordered_map <std::string, bool> event_list;
+  event_list_type event_list;
 
   // map that loads and stores all the methods in the helper image, to be registered later with events
   typedef std::unordered_map <std::string, ADDRINT> helper_method_map_type;
@@ -711,6 +963,9 @@ private:
   // list of the target method call to be instrumented
   std::vector<string> & target_method_list_;
 
+  // matcher for "::" followed by each target method
+  OASIS::Pin::Signature_Matcher method_matcher_;
+
   // list of the dlls to be included in instrumentation
   std::vector<string> & include_list_;
 
@@ -734,6 +989,9 @@ private:
 
   // Logs required
   bool & logs_required_;
+
+  // Routines found in each image by previous runs
+  OASIS::Pin::Image_Cache & cache_;
 };
 
 /*******************************
@@ -750,8 +1008,14 @@ public:
   * Constructor.
   */
   dynamic_event_monitor (void)
-    : instrument_ (fout_, 
+    : log_ (logs_.Value () ? ::fopen (logfile_.Value ().c_str (), "a") : 0),
+    fout_ (log_),
+    eventtrace_file_ (::fopen (eventtrace_.Value ().c_str (), "a")),
+    cache_ (cache_dir_.Value (), cache_config ()),
+    instrument_ (fout_,
+    log_,
     eventtrace_file_,
+    formats_,
     method_event_map_,
     target_method_list_,
     include_list_,
@@ -759,7 +1023,8 @@ public:
     helper_list_,
     obv,
     event_helper_map_,
-    logs_required_)
+    logs_required_,
+    cache_)
   { 
     std::stringstream methods_string (target_methods_);              // parse the target method argument
     std::string method;
@@ -782,19 +1047,48 @@ public:
       helper_list_.push_back(helper);
 
     logs_required_ = logs_.Value ();
-    
+
+    // The messages are formatted and written by the writer threads.
+    formats_.init (log_, eventtrace_file_);
+
     if (logs_required_)
-      fout_.open (logfile_.Value ().c_str (), ios_base::app);
+      log_.open ();
 
-    eventtrace_file_.open (eventtrace_.Value ().c_str (), ios_base::app);
+    eventtrace_file_.open ();
 
     // Object by value prefix
     obv = obv_.Value ().c_str ();   
 
+    // The image cache can be disabled, or rebuilt after a change it cannot detect.
+    if (!cache_enabled_.Value ())
+      cache_.disable ();
+    else if (cache_refresh_.Value ())
+      cache_.refresh ();
+
     this->init_symbols ();
 
-    if (logs_required_)
-      this->enable_fini_callback ();
+    this->enable_fini_unlocked_callback ();
+    this->enable_fini_callback ();
+    this->enable_detach_callback ();
+  }
+
+  /**
+  * Stop the writers of the logs before Pin terminates the internal threads.
+  * The messages that are logged later are written by the logging thread.
+  */
+  void handle_fini_unlocked (INT32 code)
+  {
+    log_.close ();
+    eventtrace_file_.close ();
+  }
+
+  /**
+  * Write the queued messages when the tool detaches.
+  */
+  void handle_detach (void)
+  {
+    log_.close ();
+    eventtrace_file_.close ();
   }
 
   /**
@@ -818,7 +1112,7 @@ public:
 
       fout_ << "..Mapping between push method and event type:" << std::endl;
       for (auto pair : method_event_map_)
-        fout_ << "  " << pair.first << " <-> " << pair.second << std::endl;      
+        fout_ << "  " << pair.first << " <-> " << *pair.second << std::endl;      
 
       fout_ << std::endl;
 
@@ -831,17 +1125,24 @@ public:
       }
 
       fout_ << std::endl;
-      fout_.close ();
     }
 
-    eventtrace_file_.close ();
+    // Write the messages that are still queued.
+    log_.flush ();
+    eventtrace_file_.flush ();
   }
 private:
-  // file to write logs 
-  std::ofstream fout_;
+  // log, which owns the log file
+  OASIS::Pin::Async_Log log_;
+
+  // stream for the messages of the log written at instrumentation time
+  log_stream fout_;
+
+  // event trace, which owns the event trace file
+  OASIS::Pin::Async_Log eventtrace_file_;
 
-  // File to write event trace
-  std::ofstream eventtrace_file_;
+  // formats of the messages of the analysis routines
+  event_formats formats_;
 
   // map between name of the target method and the event type passed into it
   method_event_map_type method_event_map_; 
@@ -867,6 +1168,33 @@ private:
   // Logs required
   bool logs_required_;
 
+  /**
+  * Key of the image cache. It holds every option that decides which images
+  * are searched, and which routines are found in them, so a run with other
+  * options does not load the routines of the last run.
+  */
+  static std::string cache_config (void)
+  {
+    std::ostringstream config;
+    config << "dynamic_event_monitor"
+           << ";v=" << CACHE_VERSION
+           << ";m=" << target_methods_.Value ()
+           << ";i=" << include_.Value ()
+           << ";ih=" << helper_.Value ()
+           << ";e=" << exclude_.Value ()
+           << ";obv=" << obv_.Value ();
+
+    return config.str ();
+  }
+
+  // Version of the cached routines. Bump it when the matching of the
+  // routines (is_valid_push_method, get_push_event_type), or the layout
+  // of the entries, changes.
+  static const unsigned int CACHE_VERSION = 1;
+
+  // Routines found in each image by previous runs
+  OASIS::Pin::Image_Cache cache_;
+
   // Instrumentation
   Image_Inst instrument_;
 
@@ -879,6 +1207,9 @@ private:
   static KNOB <string> helper_;
   static KNOB <string> obv_;
   static KNOB <bool> logs_;
+  static KNOB <bool> cache_enabled_;
+  static KNOB <bool> cache_refresh_;
+  static KNOB <string> cache_dir_;
 };
 
 /*******************************
@@ -914,6 +1245,16 @@ KNOB <string> dynamic_event_monitor::obv_ (KNOB_MODE_WRITEONCE, "pintool", "obv"
 
 KNOB <bool> dynamic_event_monitor::logs_ (KNOB_MODE_WRITEONCE, "pintool", "l", "1", 
                                                "logs required?");
+
+KNOB <bool> dynamic_event_monitor::cache_enabled_ (KNOB_MODE_WRITEONCE, "pintool", "cache", "1",
+                                                   "cache the routines found in each image across runs?");
+
+KNOB <bool> dynamic_event_monitor::cache_refresh_ (KNOB_MODE_WRITEONCE, "pintool", "cache_refresh", "0",
+                                                   "ignore the cached routines, and rebuild the cache?");
+
+KNOB <string> dynamic_event_monitor::cache_dir_ (KNOB_MODE_WRITEONCE, "pintool", "cache_dir", "dem_cache",
+                                                 "directory of the image cache");
+
 /*******************************
 * Pintool declaration
 *******************************/
@@ -8,7 +8,12 @@ float_cmd::~float_cmd (void)
 {
 }
 
-void float_cmd::execute (ADDRINT addr, std::ofstream & fout)
+const char * float_cmd::format (void)
 {
-  fout << "  Return value: "<< LEVEL_BASE::StringFlt (* (float *) addr, 2, 4) << std::endl;
+  return "  Return value: %4.2f\n";
+}
+
+void float_cmd::execute (ADDRINT addr, OASIS::Pin::Async_Log & log, UINT32 format)
+{
+  log.log (format, OASIS::Pin::Async_Log::real (* (float *) addr));
 }
\ No newline at end of file
@@ -14,7 +14,9 @@ public:
 
   ~float_cmd (void);
 
-  void execute (ADDRINT addr, std::ofstream & fout);
+  const char * format (void);
+
+  void execute (ADDRINT addr, OASIS::Pin::Async_Log & log, UINT32 format);
 };
 
 #endif
\ No newline at end of file
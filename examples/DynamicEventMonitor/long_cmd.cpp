@@ -8,7 +8,12 @@ long_cmd::~long_cmd (void)
 {
 }
 
-void long_cmd::execute (ADDRINT addr, std::ofstream & fout)
+const char * long_cmd::format (void)
 {
-  fout << "  Return value: " << (long) addr << std::endl;
+  return "  Return value: %d\n";
+}
+
+void long_cmd::execute (ADDRINT addr, OASIS::Pin::Async_Log & log, UINT32 format)
+{
+  log.log (format, static_cast <INT64> ((long) addr));
 }
\ No newline at end of file
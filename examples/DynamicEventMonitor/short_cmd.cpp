@@ -8,7 +8,12 @@ short_cmd::~short_cmd (void)
 {
 }
 
-void short_cmd::execute (ADDRINT addr, std::ofstream & fout)
+const char * short_cmd::format (void)
 {
-  fout << "  Return value: " << (short) addr << std::endl;
+  return "  Return value: %d\n";
+}
+
+void short_cmd::execute (ADDRINT addr, OASIS::Pin::Async_Log & log, UINT32 format)
+{
+  log.log (format, static_cast <INT64> ((short) addr));
 }
\ No newline at end of file
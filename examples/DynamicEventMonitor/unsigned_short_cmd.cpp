@@ -8,7 +8,12 @@ unsigned_short_cmd::~unsigned_short_cmd (void)
 {
 }
 
-void unsigned_short_cmd::execute (ADDRINT addr, std::ofstream & fout)
+const char * unsigned_short_cmd::format (void)
 {
-  fout << "  Return value: " << (unsigned short) addr << std::endl;
+  return "  Return value: %u\n";
+}
+
+void unsigned_short_cmd::execute (ADDRINT addr, OASIS::Pin::Async_Log & log, UINT32 format)
+{
+  log.log (format, (unsigned short) addr);
 }
\ No newline at end of file
@@ -165,7 +165,7 @@ CallStack::ProcessReturn(ADDRINT current_sp, bool prevIpDoesPush)
 }
 
 VOID 
-CallStack::DumpStack(ostream *o)
+CallStack::DumpStack(OASIS::Pin::Text_Buffer & o)
 {
   vector<Activation>::reverse_iterator i;
   int level = _activations.size() - 1;
@@ -175,11 +175,11 @@ CallStack::DumpStack(ostream *o)
   for(i = _activations.rbegin(); i != _activations.rend(); i++) {
     string cur = _Target2RtnName(i->target());
     if( cur != last ) {
-      if( !first ) {*o << endl;}
-      *o << level << ": " << cur;
+      if( !first ) {o << '\n';}
+      o << level << ": " << cur;
     } else {
       if( !repeated ) {
-	*o << "(repeated)";
+	o << "(repeated)";
       }
       repeated = true;
     }
@@ -187,7 +187,7 @@ CallStack::DumpStack(ostream *o)
     last = cur;
     level--;
   }
-  *o << endl;
+  o << '\n';
 
   //cout << _activations.size() << ":" << _Target2RtnName(target) 
   //<< "@0x" << hex << target << dec
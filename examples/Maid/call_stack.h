@@ -32,6 +32,7 @@ END_LEGAL */
 #define _CALLSTACK_H_
 
 #include "pin.H"
+#include "pin++/Text_Buffer.h"
 
 class Activation {
 private:
@@ -84,7 +85,7 @@ public:
   VOID ProcessCall(ADDRINT current_sp, ADDRINT target);
   VOID ProcessMainEntry(ADDRINT current_sp, ADDRINT target);
   VOID ProcessReturn(ADDRINT current_sp, bool prevIpDoesPush);
-  VOID DumpStack(ostream *o);
+  VOID DumpStack(OASIS::Pin::Text_Buffer & o);
 };
 
 #endif
@@ -23,12 +23,15 @@
 #include "call_stack.h"
 #include "argv_readparam.h"
 
+#include "pin++/Address_Index.h"
 #include "pin++/Callback.h"
 #include "pin++/Image_Instrument.h"
 #include "pin++/Trace_Instrument.h"
+#include "pin++/Trace_Arena.h"
 #include "pin++/Symbol.h"
 #include "pin++/Pintool.h"
 #include "pin++/Guard.h"
+#include "pin++/Text_Sink.h"
 
 ///////////////////////// Prototypes //////////////////////////////////////////
 
@@ -37,7 +40,12 @@ string Target2LibName(ADDRINT target);
 
 ///////////////////////// Global Variables ////////////////////////////////////
 
-ostream *Output;
+/// Output for the reports. Each thread writes whole reports to its own
+/// buffer, and the reports are merged in time order at exit.
+OASIS::Pin::Text_Sink * Output = 0;
+
+/// Image and routine ranges for resolving addresses without the client lock.
+OASIS::Pin::Address_Index * addressIndex = 0;
 
 CallStack callStack (Target2RtnName, Target2LibName);
 
@@ -61,17 +69,15 @@ bool IpDoesPush (ADDRINT ip)
 
 std::string Target2RtnName (ADDRINT target)
 {
-  std::string name = OASIS::Pin::Routine::find_name (target);
-  return !name.empty () ? name : "[Unknown routine]";
+  const OASIS::Pin::Address_Index::Routine_Range * rtn = addressIndex->find_routine (target);
+  return 0 != rtn && !rtn->name_.empty () ? rtn->name_ : "[Unknown routine]";
 }
 
 std::string Target2LibName (ADDRINT target)
 {
-  // TODO Create a guard object for the Client.
-  OASIS::Pin::Client_Guard guard;
-  OASIS::Pin::Routine rtn = OASIS::Pin::Routine::find (target);
-
-  return rtn.valid () ? rtn.section ().image ().name () : "[Unknown image]";
+  // The index does not take the client lock, unlike Routine::find ().
+  const OASIS::Pin::Address_Index::Image_Range * img = addressIndex->find_image (target);
+  return 0 != img ? img->name_ : "[Unknown image]";
 }
 
 ///////////////////////// Analysis Functions //////////////////////////////////
@@ -230,7 +236,7 @@ public:
 
   }
 
-  void handle_analyze (ADDRINT ea, ADDRINT pc)
+  void handle_analyze (ADDRINT ea, ADDRINT pc, THREADID thr_id)
   {
     string filename;
     int lineno;
@@ -243,19 +249,21 @@ public:
         PIN_GetSourceLocation (pc, 0, &lineno, &filename);
       } while (false);
 
-      *Output << (this->is_store_ ? "store" : "load")
+      OASIS::Pin::Text_Record record (*Output, thr_id);
+      OASIS::Pin::Text_Buffer & out = record.buffer ();
 
-      << " pc=" << (void*)pc
-      << " ea=" << ea << endl;
+      out << (this->is_store_ ? "store" : "load")
+          << " pc=" << (void*)pc
+          << " ea=" << ea << '\n';
 
       if (filename != "")
-        *Output << filename << ":" << lineno;
+        out << filename << ":" << lineno;
       else
-        *Output << "UNKNOWN:0";
+        out << "UNKNOWN:0";
 
-      *Output << endl;
-      callStack.DumpStack(Output);
-      *Output << endl;
+      out << '\n';
+      callStack.DumpStack(out);
+      out << '\n';
     }
   }
 
@@ -264,7 +272,7 @@ private:
 };
 
 class do_mem :
-  public OASIS::Pin::Callback <do_mem (OASIS::Pin::ARG_MEMORYWRITE_EA, OASIS::Pin::ARG_INST_PTR)>,
+  public OASIS::Pin::Callback <do_mem (OASIS::Pin::ARG_MEMORYWRITE_EA, OASIS::Pin::ARG_INST_PTR, OASIS::Pin::ARG_THREAD_ID)>,
   public do_mem_base
 {
 public:
@@ -325,10 +333,8 @@ public:
         {
           if (is_memory_write || is_memory_read)
           {
-            std::shared_ptr <do_mem> callback (new do_mem (is_memory_write));
+            do_mem * callback = this->arena_.allocate (trace, 1, do_mem (is_memory_write));
             callback->insert (IPOINT_BEFORE, ins);
-
-            this->do_mems_.push_back (callback);
           }
           else
             ; //ins.insert_call (IPOINT_BEFORE, new do_mem2 (is_memory_write));
@@ -362,10 +368,8 @@ public:
           if (tail.is_direct_branch_or_call ())
           {
             ADDRINT target = tail.direct_branch_or_call_target_address ();
-            std::shared_ptr <process_directcall> callback (new process_directcall (target));
-
+            process_directcall * callback = this->arena_.allocate (trace, 1, process_directcall (target));
             callback->insert_predicated (IPOINT_BEFORE, tail, REG_STACK_PTR);
-            this->direct_calls_.push_back (callback);
           }
           else if (!IsPLT (trace))
             this->process_indirect_call_.insert (IPOINT_BEFORE, tail, REG_STACK_PTR);
@@ -391,9 +395,8 @@ private:
 
   process_return process_return_;
 
-  // TODO Update to a std::shared_ptr object.
-  std::vector < std::shared_ptr <process_directcall> > direct_calls_;
-  std::vector < std::shared_ptr <do_mem> > do_mems_;
+  /// Callback objects for the traces in the code cache.
+  OASIS::Pin::Trace_Arena arena_;
 };
 
 /**
@@ -465,23 +468,16 @@ private:
 
 ///////////////////////// main ////////////////////////////////////////////////
 
-class maid : OASIS::Pin::Tool <maid>
+class maid : public OASIS::Pin::Tool <maid>
 {
 public:
   maid (void)
-  : delete_outfile_ (false),
-    out_ (0)
+  : output_ (outfile_.Value (), OASIS::Pin::Text_Sink::MERGED_FILE)
   {
-    // Determine where the output is to written.
-    if (!outfile_.Value ().empty ())
-    {
-      this->delete_outfile_ = true;
-      this->out_ = new std::ofstream (outfile_.Value ().c_str ());
-    }
-    else
-    {
-      this->out_ = &std::cout;
-    }
+    addressIndex = &this->address_index_;
+    Output = &this->output_;
+
+    this->enable_fini_callback ();
 
     // Read the address file, if one is specified.
     if (!addrfile_.Value ().empty ())
@@ -507,22 +503,28 @@ public:
     }
   }
 
+  void handle_fini (INT32)
+  {
+    this->output_.close ();
+  }
+
 private:
+  /// Output for the reports.
+  OASIS::Pin::Text_Sink output_;
+
   /// @{ Instruments
+  OASIS::Pin::Address_Index address_index_;
   image_load img_load_;
   trace trace_;
   /// @}
 
-  bool delete_outfile_;
-  std::ostream * out_;
-
   /// @{ KNOBS
   static KNOB <string> addrfile_;
   static KNOB <string> outfile_;
   /// @}
 };
 
-KNOB <string> maid::outfile_ (KNOB_MODE_WRITEONCE, "pintool", "outfile", "", "specify output file name");
+KNOB <string> maid::outfile_ (KNOB_MODE_WRITEONCE, "pintool", "outfile", "maid.out", "specify output file name");
 KNOB <string> maid::addrfile_ (KNOB_MODE_WRITEONCE, "pintool", "addrfile", "", "specify output file name");
 
 DECLARE_PINTOOL (maid);
@@ -491,7 +491,7 @@ namespace Pin {
                     if (!rtn.valid ())
                         continue;
 
-                    std::string rtn_signature = OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_COMPLETE);
+                    const std::string & rtn_signature = rtn.undecorate (UNDECORATION_COMPLETE);
                     helper_methods_map[rtn_signature] = rtn.address ();  // Store the method name and its return address.
                 }
             }
@@ -509,8 +509,8 @@ namespace Pin {
         }
 
         virtual void analyze_rtn(const OASIS::Pin::Routine & rtn) {
-            std::string rtn_signature = OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_COMPLETE);
-            std::string rtn_name = OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_NAME_ONLY);
+            const std::string & rtn_signature = rtn.undecorate (UNDECORATION_COMPLETE);
+            const std::string & rtn_name = rtn.undecorate (UNDECORATION_NAME_ONLY);
 
             RTN_TYPE rtn_type = is_valid_push_method (rtn_signature);
             
@@ -532,7 +532,8 @@ namespace Pin {
             {
                 OASIS::Pin::Routine_Guard guard (rtn);
                 // buffers must be used; otherwise the analysis routine cannot be preserved
-                item_type helper_buffer (1);
+                analysis_rtn_buffer_list_.emplace_back (1);
+                item_type & helper_buffer = analysis_rtn_buffer_list_.back ();
                 item_type::iterator helper = helper_buffer.begin ();
                 helper->set_target_name (rtn_name);
                 helper->set_method_event_map (method_event_map_);
@@ -540,7 +541,6 @@ namespace Pin {
                 helper->set_helper_returntype_map (helper_returntype_map_);
                 helper->insert (IPOINT_BEFORE, rtn, 0);
                 output_list_.push_back (helper->info_);
-                analysis_rtn_buffer_list_.push_back (helper_buffer);
 
                 helper_method_info * helpmeth_info = new helper_method_info(this->img_name_, rtn_signature, rtn_name);
                 output_list_.push_back(helpmeth_info);
@@ -111,7 +111,12 @@ namespace Pin {
       :datawriter_write_("::write("),
       datareader_takenextsample_("::take_next_sample("),
       create_topic_("::create_topic(")
-    {  }
+    {
+      this->write_id_ = this->matcher_.add (this->datawriter_write_);
+      this->take_id_ = this->matcher_.add (this->datareader_takenextsample_);
+      this->topic_id_ = this->matcher_.add (this->create_topic_);
+      this->matcher_.compile ();
+    }
 
     virtual std::string name(void) {
       return "DDS Middleware";
@@ -129,18 +134,19 @@ namespace Pin {
       using OASIS::Pin::Section;
       using OASIS::Pin::Image;
 
-      std::string signature(OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_COMPLETE));
-      std::string calling_object("N/A");
-      std::string method;
-      std::string in_types;
+      const std::string & signature = rtn.undecorate (UNDECORATION_COMPLETE);
 
       //does the signature match one of the substrings we're looking for?
-      if (signature.find(datawriter_write_) != std::string::npos) {
-        std::list<std::string> sign_info(parse_signature(signature));
-        calling_object = sign_info.front(); sign_info.pop_front();
-        method = sign_info.front(); sign_info.pop_front();
-        in_types = sign_info.front(); sign_info.pop_front();
+      Match_Flags matched;
+      if (0 == this->matcher_.for_each (signature, matched))
+        return;
+
+      OASIS::Pin::Signature sign (signature);
+      std::string calling_object(sign.object ().str ());
+      std::string method(sign.method ().str ());
+      std::string in_types(sign.params ().str ());
 
+      if (matched.flags_[this->write_id_]) {
         dds_readwrite_info * dds_info = new dds_readwrite_info(method, in_types, calling_object);
         this->output_list_.push_back((Writer *) dds_info);
 
@@ -148,12 +154,7 @@ namespace Pin {
         dds_info->insert (IPOINT_BEFORE, rtn);
       }
 
-      if (signature.find(datareader_takenextsample_) != std::string::npos) {
-        std::list<std::string> sign_info(parse_signature(signature));
-        calling_object = sign_info.front(); sign_info.pop_front();
-        method = sign_info.front(); sign_info.pop_front();
-        in_types = sign_info.front(); sign_info.pop_front();
-
+      if (matched.flags_[this->take_id_]) {
         dds_readwrite_info * dds_info = new dds_readwrite_info(method, in_types, calling_object);
         this->output_list_.push_back((Writer *) dds_info);
 
@@ -161,12 +162,7 @@ namespace Pin {
         dds_info->insert (IPOINT_BEFORE, rtn);
       }
 
-      if (signature.find(create_topic_) != std::string::npos) {
-				std::list<std::string> sign_info(parse_signature(signature));
-        calling_object = sign_info.front(); sign_info.pop_front();
-        method = sign_info.front(); sign_info.pop_front();
-        in_types = sign_info.front(); sign_info.pop_front();
-
+      if (matched.flags_[this->topic_id_]) {
         dds_topic_info * topic_info = new dds_topic_info(method, in_types, calling_object);
         this->output_list_.push_back((Writer *) topic_info);
 
@@ -186,6 +182,13 @@ namespace Pin {
     std::string datawriter_write_;
     std::string datareader_takenextsample_;
     std::string create_topic_;
+
+    //matcher_ - finds all of the substrings in one pass over a signature
+    //write_id_, take_id_, topic_id_ - ids of the substrings in the matcher
+    OASIS::Pin::Signature_Matcher matcher_;
+    size_t write_id_;
+    size_t take_id_;
+    size_t topic_id_;
   };
 }
 }
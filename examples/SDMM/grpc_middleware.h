@@ -142,12 +142,17 @@ namespace Pin {
   class gRPC_Middleware : public Middleware {
   public:
     gRPC_Middleware(std::vector<std::string> & method_list, std::string & obv)
-      :stub_regex_("(.*)(Stub::)(.*)(ClientContext)(.*)"),
+      :stub_substr_("Stub::"),
       clientctx_substr_("ClientContext::"),
       channel_create_substr_("grpc_channel_create(char const*"),
 			value_substr_("set_value(double)"),
 			timestamp_substr_("set_timestamp(long long)")
-    {  }
+    {
+      this->stub_id_ = this->matcher_.add (this->stub_substr_);
+      this->clientctx_id_ = this->matcher_.add (this->clientctx_substr_);
+      this->channel_create_id_ = this->matcher_.add (this->channel_create_substr_);
+      this->matcher_.compile ();
+    }
 
     virtual std::string name(void) {
       return "gRPC Middleware";
@@ -165,19 +170,26 @@ namespace Pin {
       using OASIS::Pin::Section;
       using OASIS::Pin::Image;
 
-      std::string signature(OASIS::Pin::Symbol::undecorate (rtn.name (), UNDECORATION_COMPLETE));
-      std::string calling_object("N/A");
-      std::string method;
-      std::string in_types;
+      const std::string & signature = rtn.undecorate (UNDECORATION_COMPLETE);
+      OASIS::Pin::String_Slice text (signature);
+
+      //does the signature match one of the substrings we're looking for?
+      Match_Flags matched;
+      if (0 == this->matcher_.for_each (text, matched))
+        return;
 
-      //check if the method is a RPC method on the Client Stub
-      if (std::regex_match(signature, stub_regex_)) {
-        std::list<std::string> sign_info(parse_signature(signature));
-        calling_object = sign_info.front(); sign_info.pop_front();
-        method = sign_info.front(); sign_info.pop_front();
-        in_types = sign_info.front(); sign_info.pop_front();
+      OASIS::Pin::Signature sign (text);
 
-        grpc_general * m_info = new grpc_general (method, in_types, calling_object);
+      //check if the method is a RPC method on the Client Stub, i.e., a
+      //ClientContext appears after the "Stub::"
+      bool is_stub_method = false;
+      if (matched.flags_[this->stub_id_]) {
+        size_t stub = text.find (this->stub_substr_);
+        is_stub_method = OASIS::Pin::String_Slice::npos != text.find ("ClientContext", stub + this->stub_substr_.size ());
+      }
+
+      if (is_stub_method) {
+        grpc_general * m_info = new grpc_general (sign.method ().str (), sign.params ().str (), sign.object ().str ());
         
         this->output_list_.push_back ((Writer *) m_info);
         OASIS::Pin::Routine_Guard guard (rtn);
@@ -185,20 +197,15 @@ namespace Pin {
       }
 
       //check if the method belongs to the Client Context
-      if (signature.find(clientctx_substr_) != std::string::npos) {
-        std::list<std::string> sign_info(parse_signature(signature));
-        calling_object = sign_info.front(); sign_info.pop_front();
-        method = sign_info.front(); sign_info.pop_front();
-        in_types = sign_info.front(); sign_info.pop_front();
-
-        grpc_general * m_info = new grpc_general (method, in_types, calling_object);
+      if (matched.flags_[this->clientctx_id_]) {
+        grpc_general * m_info = new grpc_general (sign.method ().str (), sign.params ().str (), sign.object ().str ());
         
         this->output_list_.push_back ((Writer *) m_info);
         OASIS::Pin::Routine_Guard guard (rtn);
         m_info->insert (IPOINT_BEFORE, rtn);
       }
 
-      if (signature.find(channel_create_substr_) != std::string::npos) {
+      if (matched.flags_[this->channel_create_id_]) {
         address_info * a_info = new address_info();
 
         this->output_list_.push_back((Writer *) a_info);
@@ -238,15 +245,20 @@ namespace Pin {
     }
   private:
     //output_list_ - the output list
-    //stub_regex_ - regular expression for identifying Stub methods
+    //stub_substr_ - substring for identifying Stub methods; a ClientContext must follow it
     //clientctx_substr_ - substring for identifying ClientContext methods
     //channel_create_substr_ - substring for identifying the channel creation factory method
+    //matcher_ - finds all of the substrings in one pass over a signature
     list_type output_list_;
-    std::regex stub_regex_;
+    std::string stub_substr_;
     std::string clientctx_substr_;
     std::string channel_create_substr_;
 		std::string value_substr_;
 		std::string timestamp_substr_;
+    OASIS::Pin::Signature_Matcher matcher_;
+    size_t stub_id_;
+    size_t clientctx_id_;
+    size_t channel_create_id_;
   };
 }
 }
@@ -1,5 +1,7 @@
 #include "pin++/Image.h"
 #include "pin++/Routine.h"
+#include "pin++/Signature.h"
+#include "pin++/Signature_Matcher.h"
 #include "writer.h"
 #include <list>
 #include <string>
@@ -45,52 +47,24 @@ public:
   static time_accumulator accum_meth_info;
   static time_accumulator accum_data_coll;
 
-  //parse_signature - parses a Pin method signature and return
-  //a list of strings with the calling object, the invoked method, and
-  //the list of input types.
-  std::list<std::string> parse_signature(std::string & sign) {
-    std::list<std::string> parsed_list;
-    std::string object("");
-    std::string method("");
-    std::string in_types("");
-    size_t i = 0;
+  //Match_Flags - visitor for Signature_Matcher::for_each that records
+  //which of the matcher's substrings occur in a signature.
+  struct Match_Flags {
+    static const size_t MAX_PATTERNS = 8;
 
-    //parse up to "(" for the object + method name
-    for (; sign[i] != '('; ++i) {
-      object += sign[i];
+    Match_Flags(void) {
+      for (size_t i = 0; i < MAX_PATTERNS; ++i)
+        flags_[i] = false;
     }
 
-    //skip the '('
-    ++i;
-
-    //extract input types
-    for (; sign[i] != ')'; ++i) {
-      in_types += sign[i];
-    }
-
-    //remove method name from object
-    std::string temp("");
-    for (i=object.length(); object[i] != ':'; --i) {
-      temp += object[i];
-      object[i] = ' ';
-    }
-
-    //remove last "::" from object
-    object[i] = ' ';
-    object[i-1] = ' ';
-
-    //reverse method name to correct order
-    for (i=temp.length(); i > 0; --i) {
-      method += temp[i];
+    bool operator () (size_t id, size_t) {
+      if (id < MAX_PATTERNS)
+        flags_[id] = true;
+      return true;
     }
 
-    //add into list
-    parsed_list.push_back(object);
-    parsed_list.push_back(method);
-    parsed_list.push_back(in_types);
-
-    return parsed_list;
-  }
+    bool flags_[MAX_PATTERNS];
+  };
     
 }
 }
@@ -1,157 +1,65 @@
 
-#include "pin++/Lock.h"
-#include "pin++/Guard.h"
 #include "pin++/Trace_Buffer.h"
+#include "pin++/Buffer_Record.h"
+#include "pin++/Trace_Sink.h"
 #include "pin++/Trace_Instrument.h"
 #include "pin++/Pintool.h"
 #include "pin++/Operand.h"
 
-#if !defined (TARGET_WINDOWS)
-#include "pin++/TLS.h"
-#endif
-
-#include <fstream>
 #include <sstream>
 
 /*
  * Record of memory references.  Rather than having two separate
- * buffers for reads and writes, we just use one struct that includes a
- * flag for type.
- */
-struct MEMREF
-{
-  THREADID tid;
-  ADDRINT pc;
-  ADDRINT ea;
-  UINT32 size;
-  UINT32 read;
-};
-
-#if !defined (TARGET_WINDOWS)
-/*
- * MLOG - thread specific data that is not handled by the buffering API.
+ * buffers for reads and writes, we just use one record that includes a
+ * flag for type. The fields are arg1 (pc), arg2 (ea), arg3 (size), and
+ * arg4 (read).
  */
-class MLOG
-{
-public:
-  MLOG (THREADID tid)
-  {
-    std::ostringstream filename;
-    filename << "buffer." << PIN_GetPid () << "." << tid;
-
-    this->file_.open (filename.str ().c_str ());
-
-    if (!this->file_.is_open ())
-    {
-      cerr << "Error: could not open output file." << endl;
-      exit (1);
-    }
-
-    this->file_ << std::hex;
-  }
-
-  ~MLOG (void)
-  {
-    if (this->file_.is_open ())
-      this->file_.close ();
-  }
-
-  VOID dump_buffer_to_file (struct MEMREF * reference, UINT64 elements, THREADID tid)
-  {
-    for (UINT64 i = 0; i < elements; ++ i, ++ reference)
-    {
-      if (reference->ea != 0)
-        this->file_ << reference->pc << "   " << reference->ea << std::endl;
-    }
-  }
-
-private:
-  std::ofstream file_;
-};
-#endif
+typedef OASIS::Pin::Buffer_Record <OASIS::Pin::ARG_INST_PTR,
+                                   OASIS::Pin::ARG_MEMORYOP_EA,
+                                   OASIS::Pin::ARG_UINT32,
+                                   OASIS::Pin::ARG_BOOL> MEMREF;
 
 /**
- * @class Buffer_Fill
+ * @class Buffer_Full
  *
  * Class responsible for handling callbacks when the trace buffer is full.
+ * The full buffers are copied into a binary trace file for each thread by
+ * the drain thread of the trace buffer, so the application threads do not
+ * wait on the files. The files are converted to text offline by trace2text.
+ * By default, the records are delta/varint encoded (and compressed if the
+ * library has zlib) since consecutive references are close together.
  */
 class Buffer_Full : public OASIS::Pin::Trace_Buffer <Buffer_Full, MEMREF>
 {
 public:
-#if defined (TARGET_WINDOWS)
-  Buffer_Full (const OASIS::Pin::Lock & lock, std::ostream & out, UINT32 pages)
-    : OASIS::Pin::Trace_Buffer <Buffer_Full, MEMREF> (pages),
-      lock_ (lock),
-      out_ (out),
-      write_to_output_file_ (false)
-#else
-  Buffer_Full (const OASIS::Pin::TLS <MLOG> & tls_mlog, UINT32 pages)
-    : OASIS::Pin::Trace_Buffer <Buffer_Full, MEMREF> (pages)
-#endif
+  Buffer_Full (const std::string & prefix, UINT32 pages, UINT32 flags)
+    : OASIS::Pin::Trace_Buffer <Buffer_Full, MEMREF> (pages, true),
+      sink_ (prefix, flags)
   {
 
   }
 
-
-  element_type * handle_trace_buffer (BUFFER_ID id, THREADID tid, const OASIS::Pin::Context & ctx, element_type * buf, UINT64 elements)
+  void handle_drain (THREADID tid, element_type * buf, UINT64 elements)
   {
-#if defined (TARGET_WINDOWS)
-    // Windows implementation for writing buffer to the file. It must take
-    // a lock to ensure that no other operations occur on the file while the
-    // current thread is writing to the file. This is very slow, but the only
-    // workaround according to Pin.
-    if (!this->write_to_output_file_)
-      return buf;
-
-    OASIS::Pin::Guard <OASIS::Pin::Lock> guard (this->lock_);
-
-    for (UINT64 i = 0; i < elements; ++ i, ++ buf)
-    {
-      if (0 != buf->ea)
-        this->out_ << tid << "   "  << buf->pc << "   " << buf->ea << std::endl;
-    }
-#else
-    // Non-Windows implementation for writing trace buffer to a file. This
-    // version is more effecient than the Window implementation above according
-    // to the Pin documentation.
-    this->tls_mlog_.get (tid)->dump_buffer_to_file (buf, elements, tid);
-#endif
-
-    return buf;
+    this->sink_.write (tid, buf, elements);
   }
 
-#if defined (TARGET_WINDOWS)
-  void write_to_output_file (bool flag)
+  void close (void)
   {
-    this->write_to_output_file_ = flag;
+    this->sink_.close ();
   }
-#endif
 
 private:
-#if defined (TARGET_WINDOWS)
-  OASIS::Pin::Lock lock_;
-  std::ostream & out_;
-  bool write_to_output_file_;
-#else
-  OASIS::Pin::TLS <MLOG> tls_mlog_;
-#endif
+  OASIS::Pin::Trace_Sink <MEMREF> sink_;
 };
 
 class Trace : public OASIS::Pin::Trace_Instrument <Trace>
 {
 public:
-#if defined (TARGET_WINDOWS)
-  Trace (void)
-    : fout_ ("buffer.out"),
-      buffer_full_ (lock_, fout_, 1024)
-#else
-  Trace (const OASIS::Pin::TLS <MLOG> & tls_mlog)
-    : buffer_full_ (tls_mlog, 1024)
-#endif
+  Trace (const std::string & prefix, UINT32 flags)
+    : buffer_full_ (prefix, 1024, flags)
   {
-#if defined (TARGET_WINDOWS)
-    this->buffer_full_.write_to_output_file (true);
-#endif
+
   }
 
   void handle_instrument (const OASIS::Pin::Trace & trace)
@@ -173,87 +81,67 @@ public:
           // Note that if the operand is both read and written we log it once
           // for each.
           if (operand.is_read ())
-            INS_InsertFillBuffer (ins,
-                                  IPOINT_BEFORE, this->buffer_full_.buffer_id (),
-                                  IARG_INST_PTR, offsetof (struct MEMREF, pc),
-                                  IARG_MEMORYOP_EA, mem_op, offsetof (struct MEMREF, ea),
-                                  IARG_UINT32, ref_size, offsetof (struct MEMREF, size),
-                                  IARG_BOOL, TRUE, offsetof (struct MEMREF, read),
-                                  IARG_END);
+            this->buffer_full_.insert_fill (IPOINT_BEFORE, ins, mem_op, ref_size, TRUE);
 
           if (operand.is_written ())
-            INS_InsertFillBuffer (ins,
-                                  IPOINT_BEFORE, this->buffer_full_.buffer_id (),
-                                  IARG_INST_PTR, offsetof(struct MEMREF, pc),
-                                  IARG_MEMORYOP_EA, mem_op, offsetof(struct MEMREF, ea),
-                                  IARG_UINT32, ref_size, offsetof(struct MEMREF, size),
-                                  IARG_BOOL, FALSE, offsetof(struct MEMREF, read),
-                                  IARG_END);
+            this->buffer_full_.insert_fill (IPOINT_BEFORE, ins, mem_op, ref_size, FALSE);
         }
       }
     }
   }
 
-#if defined (TARGET_WINDOWS)
+  void handle_fini_unlocked (void)
+  {
+    // Wait for the drain thread to write the remaining buffers. The
+    // application threads can still fill buffers, and Pin flushes their
+    // last buffer when they exit. From now on, these buffers are written
+    // on the application thread.
+    this->buffer_full_.stop_draining ();
+  }
+
   void handle_fini (void)
   {
-    OASIS::Pin::Guard <OASIS::Pin::Lock> guard (this->lock_);
-    this->fout_.close ();
+    // The application threads have exited, so no more buffers are written.
+    this->buffer_full_.close ();
   }
-#endif
 
 private:
-#if defined (TARGET_WINDOWS)
-  OASIS::Pin::Lock lock_;
-  std::ofstream fout_;
-#endif
-
   Buffer_Full buffer_full_;
 };
 
+static KNOB <BOOL> knob_encode (KNOB_MODE_WRITEONCE, "pintool", "encode", "1",
+                                "delta/varint encode the trace files");
+
+static std::string trace_prefix (void)
+{
+  std::ostringstream prefix;
+  prefix << "buffer." << PIN_GetPid ();
+
+  return prefix.str ();
+}
+
 class buffer : public OASIS::Pin::Tool <buffer>
 {
 public:
   buffer (void)
-#if !defined (TARGET_WINDOWS)
-    : trace_ (tls_mlog_)
-#endif
+    : trace_ (trace_prefix (),
+              knob_encode.Value () ? OASIS::Pin::TRACE_FILE_ENCODED | OASIS::Pin::TRACE_FILE_ZLIB : 0)
   {
-#if defined (TARGET_WINDOWS)
+    this->enable_fini_unlocked_callback ();
     this->enable_fini_callback ();
-#else
-    this->enable_thread_start_callback ();
-    this->enable_thread_fini_callback ();
-#endif
   }
 
-  void handle_thread_start (THREADID thr_id, OASIS::Pin::Context & ctx, INT32 flags)
+  void handle_fini_unlocked (INT32 code)
   {
-#if !defined (TARGET_WINDOWS)
-    this->tls_mlog_.set (thr_id, new MLOG (thr_id));
-#endif
+    this->trace_.handle_fini_unlocked ();
   }
 
-  void handle_thread_fini (THREADID thr_id, const OASIS::Pin::Context & ctx, INT32 flags)
-  {
-#if !defined (TARGET_WINDOWS)
-    delete this->tls_mlog_.get (thr_id);
-    this->tls_mlog_.set (thr_id, 0);
-#endif
-  }
-
-#if defined (TARGET_WINDOWS)
   void handle_fini (INT32 code)
   {
     this->trace_.handle_fini ();
   }
-#endif
 
 private:
-#if !defined (TARGET_WINDOWS)
-  OASIS::Pin::TLS <MLOG> tls_mlog_;
-#endif
-
   Trace trace_;
 };
 
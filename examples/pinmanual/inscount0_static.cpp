@@ -0,0 +1,77 @@
+// $Id$
+
+#include "pin++/Static_Callback.h"
+#include "pin++/Instruction_Instrument.h"
+#include "pin++/Pintool.h"
+
+#include <fstream>
+
+//
+// Version of inscount0 that uses a static callback. The analysis routine
+// does not receive the callback object, so Pin can inline the increment
+// instead of calling the analysis routine for every instruction.
+//
+class docount : public OASIS::Pin::Static_Callback < docount (void) >
+{
+public:
+  static void handle_analyze (void)
+  {
+    ++ count_;
+  }
+
+  static UINT64 count (void)
+  {
+    return count_;
+  }
+
+private:
+  static UINT64 count_;
+};
+
+UINT64 docount::count_ = 0;
+
+class Instruction : public OASIS::Pin::Instruction_Instrument <Instruction>
+{
+public:
+  void handle_instrument (const OASIS::Pin::Ins & ins)
+  {
+    this->callback_.insert (IPOINT_BEFORE, ins);
+  }
+
+  UINT64 count (void) const
+  {
+    return docount::count ();
+  }
+
+private:
+  docount callback_;
+};
+
+class inscount : public OASIS::Pin::Tool <inscount>
+{
+public:
+  inscount (void)
+  {
+    this->enable_fini_callback ();
+  }
+
+  void handle_fini (INT32 code)
+  {
+    std::ofstream fout (outfile_.Value ().c_str ());
+    fout.setf (ios::showbase);
+    fout <<  "Count " << this->instruction_.count () << std::endl;
+
+    fout.close ();
+  }
+
+private:
+  Instruction instruction_;
+
+  /// @{ KNOBS
+  static KNOB <string> outfile_;
+  /// @}
+};
+
+KNOB <string> inscount::outfile_ (KNOB_MODE_WRITEONCE, "pintool", "o", "inscount.out", "specify output file name");
+
+DECLARE_PINTOOL (inscount);
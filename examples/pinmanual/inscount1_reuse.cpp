@@ -14,7 +14,8 @@ public:
   void handle_instrument (const OASIS::Pin::Trace & trace)
   {
     // Allocate a callback for each BBL.
-    item_type item (trace.num_bbl ());
+    this->traces_.emplace_back (trace.num_bbl ());
+    item_type & item = this->traces_.back ();
     item_type::iterator callback = item.begin ();
 
 #if defined (TARGET_WINDOWS) && (_MSC_VER == 1600)
@@ -28,8 +29,6 @@ public:
 
       ++ callback;
     }
-
-    this->traces_.push_back (item);
   }
 
   UINT64 count (void) const
@@ -39,7 +38,7 @@ public:
 #if defined (TARGET_WINDOWS) && (_MSC_VER == 1600)
     for each (auto & trace in this->traces_)
 #else
-    for (auto trace : this->traces_)
+    for (auto & trace : this->traces_)
 #endif
 #if defined (TARGET_WINDOWS) && (_MSC_VER == 1600)
       for each (auto & item in trace)
@@ -0,0 +1,66 @@
+// $Id$
+
+#include "pin++/Batch_Counter.h"
+#include "pin++/Pintool.h"
+#include "pin++/Trace_Instrument.h"
+
+#include <fstream>
+
+//
+// Version of inscount2 that counts in a tool register. A single counter
+// is inserted into every BBL with the BBL's instruction count as the
+// increment. Each thread counts in its own copy of the register, so the
+// threads do not share any memory while counting.
+//
+class Trace : public OASIS::Pin::Trace_Instrument <Trace>
+{
+public:
+  void handle_instrument (const OASIS::Pin::Trace & trace)
+  {
+#if defined (TARGET_WINDOWS) && (_MSC_VER == 1600)
+    for each (OASIS::Pin::Bbl & bbl in trace)
+#else
+    for (const OASIS::Pin::Bbl & bbl : trace)
+#endif
+    {
+      this->counter_.increment (bbl.ins_count ());
+      this->counter_.insert (IPOINT_ANYWHERE, bbl);
+    }
+  }
+
+  UINT64 count (void) const
+  {
+    return this->counter_.count ();
+  }
+
+private:
+  OASIS::Pin::Batch_Counter <UINT64, UINT64, OASIS::Pin::Register_Storage> counter_;
+};
+
+class inscount : public OASIS::Pin::Tool <inscount>
+{
+public:
+  inscount (void)
+  {
+    this->enable_fini_callback ();
+  }
+
+  void handle_fini (INT32)
+  {
+    std::ofstream fout (outfile_.Value ().c_str ());
+    fout <<  "Count " << this->trace_.count () << std::endl;
+
+    fout.close ();
+  }
+
+private:
+  Trace trace_;
+
+  /// @{ KNOBS
+  static KNOB <string> outfile_;
+  /// @}
+};
+
+KNOB <string> inscount::outfile_ (KNOB_MODE_WRITEONCE, "pintool", "o", "inscount.out", "specify output file name");
+
+DECLARE_PINTOOL (inscount);
@@ -0,0 +1,112 @@
+// $Id$
+
+#include "pin++/Callback.h"
+#include "pin++/Guard.h"
+#include "pin++/Lock.h"
+#include "pin++/Sharded_Counter.h"
+#include "pin++/Trace_Arena.h"
+#include "pin++/Trace_Instrument.h"
+#include "pin++/Pintool.h"
+
+#include <fstream>
+
+//
+// Version of inscount_tls that stores the count of each thread in a
+// Sharded_Counter. Each thread has its own cache line in the counter, so
+// there is no need for a padded thread data type, or a TLS lookup in the
+// analysis routine.
+//
+typedef OASIS::Pin::Sharded_Counter < > counter_type;
+
+class docount : public OASIS::Pin::Callback < docount (OASIS::Pin::ARG_THREAD_ID) >
+{
+public:
+  docount (void)
+  : counter_ (0),
+    ins_count_ (0)
+  {
+
+  }
+
+  void init (counter_type * counter, UINT64 count)
+  {
+    this->counter_ = counter;
+    this->ins_count_ = count;
+  }
+
+  void handle_analyze (THREADID thr_id)
+  {
+    this->counter_->add (thr_id, this->ins_count_);
+  }
+
+private:
+  counter_type * counter_;
+  UINT64 ins_count_;
+};
+
+class Trace : public OASIS::Pin::Trace_Instrument <Trace>
+{
+public:
+  void handle_instrument (const OASIS::Pin::Trace & trace)
+  {
+    // Visit every block in the trace, and attach a counter. The counters
+    // are released when the trace is removed from the code cache.
+    docount * callback = this->arena_.allocate <docount> (trace, trace.num_bbl ());
+
+    for (OASIS::Pin::Bbl & bbl : trace)
+    {
+      callback->init (&this->counter_, bbl.ins_count ());
+      callback->insert (IPOINT_BEFORE, bbl);
+
+      ++ callback;
+    }
+  }
+
+  const counter_type & counter (void) const
+  {
+    return this->counter_;
+  }
+
+private:
+  counter_type counter_;
+  OASIS::Pin::Trace_Arena arena_;
+};
+
+class inscount_sharded : public OASIS::Pin::Tool <inscount_sharded>
+{
+public:
+  inscount_sharded (void)
+    : num_threads_ (0)
+  {
+    this->init_symbols ();
+    this->enable_fini_callback ();
+    this->enable_thread_start_callback ();
+  }
+
+  void handle_fini (INT32)
+  {
+    const counter_type & counter = this->trace_.counter ();
+
+    std::ofstream fout ("inscount_sharded.out");
+    fout << "Total number of threads = " << this->num_threads_ << endl;
+
+    for (INT32 t = 0; t < this->num_threads_; t ++)
+      fout << "Count[" << decstr (t) << "]= " << counter[t] << std::endl;
+
+    fout << "Total = " << counter.total () << std::endl;
+    fout.close ();
+  }
+
+  void handle_thread_start (THREADID thr_id, OASIS::Pin::Context & ctxt, INT32 flags)
+  {
+    OASIS::Pin::Guard <OASIS::Pin::Lock> guard (this->lock_);
+    ++ this->num_threads_;
+  }
+
+private:
+  Trace trace_;
+  OASIS::Pin::Lock lock_;
+  INT32 num_threads_;
+};
+
+DECLARE_PINTOOL (inscount_sharded);
@@ -1,16 +1,15 @@
 // $Id: inscount_tls.cpp 2286 2013-09-19 18:40:30Z hillj $
 
-#include "pin++/Buffer.h"
 #include "pin++/Callback.h"
 #include "pin++/Guard.h"
 #include "pin++/Lock.h"
+#include "pin++/Trace_Arena.h"
 #include "pin++/Trace_Instrument.h"
 #include "pin++/Pintool.h"
-#include "pin++/TLS.h"
+#include "pin++/Thread_Array.h"
 
 #include <fstream>
 #include <iostream>
-#include <list>
 #include <vector>
 
 // Force each thread's data to be in its own data cache line so that
@@ -40,7 +39,7 @@ public:
 
   }
 
-  void init (OASIS::Pin::TLS <thread_data_t> * tls, UINT64 count)
+  void init (OASIS::Pin::Thread_Array <thread_data_t> * tls, UINT64 count)
   {
     this->tls_ = tls;
     this->ins_count_ = count;
@@ -56,7 +55,7 @@ public:
   }
 
 private:
-  OASIS::Pin::TLS <thread_data_t> * tls_;
+  OASIS::Pin::Thread_Array <thread_data_t> * tls_;
   UINT64 ins_count_;
 };
 
@@ -71,9 +70,9 @@ public:
 
   void handle_instrument (const OASIS::Pin::Trace & trace)
   {
-    // Visit every block in the trace, and attach a counter.
-    item_type item (trace.num_bbl ());
-    item_type::iterator callback = item.begin ();
+    // Visit every block in the trace, and attach a counter. The counters
+    // are released when the trace is removed from the code cache.
+    docount * callback = this->arena_.allocate <docount> (trace, trace.num_bbl ());
 
     for (OASIS::Pin::Bbl & bbl : trace)
     {
@@ -82,8 +81,6 @@ public:
 
       ++ callback;
     }
-
-    this->traces_.push_back (item);
   }
 
   void handle_thread_start (THREADID thr_id, OASIS::Pin::Context & ctxt, INT32 flags)
@@ -111,19 +108,16 @@ public:
     return this->num_threads_;
   }
 
-  inline const OASIS::Pin::TLS <thread_data_t> & tls (void) const
+  inline const OASIS::Pin::Thread_Array <thread_data_t> & tls (void) const
   {
     return this->tls_;
   }
 
 private:
-  typedef OASIS::Pin::Buffer <docount> item_type;
-  typedef std::list <item_type> list_type;
-
-  OASIS::Pin::TLS <thread_data_t> tls_;
+  OASIS::Pin::Thread_Array <thread_data_t> tls_;
   OASIS::Pin::Lock lock_;
   int num_threads_;
-  list_type traces_;
+  OASIS::Pin::Trace_Arena arena_;
 };
 
 class inscount_tls : public OASIS::Pin::Tool <inscount_tls>
@@ -141,7 +135,7 @@ public:
     std::ofstream fout ("inscount_tls.out");
     fout << "Total number of threads = " << this->trace_.num_threads () << endl;
 
-    const OASIS::Pin::TLS <thread_data_t> & tls = this->trace_.tls ();
+    const OASIS::Pin::Thread_Array <thread_data_t> & tls = this->trace_.tls ();
 
     for (INT32 t = 0; t < this->trace_.num_threads (); t ++)
       fout << "Count[" << decstr (t) << "]= " << tls.get (t)->count_ << std::endl;
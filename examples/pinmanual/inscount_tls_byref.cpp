@@ -66,7 +66,8 @@ public:
   void handle_instrument (const OASIS::Pin::Trace & trace)
   {
     // Visit every block in the trace, and attach a counter.
-    item_type item (trace.num_bbl ());
+    this->traces_.emplace_back (trace.num_bbl ());
+    item_type & item = this->traces_.back ();
     item_type::iterator callback = item.begin ();
 
     for (OASIS::Pin::Bbl & bbl : trace)
@@ -76,8 +77,6 @@ public:
 
       ++ callback;
     }
-
-    this->traces_.push_back (item);
   }
 
   void handle_thread_start (THREADID thr_id, OASIS::Pin::Context & ctxt, INT32 flags)
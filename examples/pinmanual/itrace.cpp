@@ -3,32 +3,33 @@
 #include "pin++/Instruction_Instrument.h"
 #include "pin++/Callback.h"
 #include "pin++/Pintool.h"
+#include "pin++/Text_Sink.h"
 
-#include <stdio.h>
-#include <cstdlib>
-
-class printip : public OASIS::Pin::Callback <printip (OASIS::Pin::ARG_INST_PTR) >
+class printip : public OASIS::Pin::Callback <printip (OASIS::Pin::ARG_INST_PTR,
+                                                      OASIS::Pin::ARG_THREAD_ID) >
 {
 public:
-  printip (FILE * file)
-    : file_ (file)
+  printip (OASIS::Pin::Text_Sink & sink)
+    : sink_ (sink)
   {
   }
 
-  void handle_analyze (ADDRINT addr)
+  void handle_analyze (ADDRINT addr, THREADID thr_id)
   {
-    ::fprintf (this->file_, "0x%p\n", addr);
+    // Each thread formats into its own buffer, which is written in bulk.
+    OASIS::Pin::Text_Record record (this->sink_, thr_id);
+    record.buffer () << OASIS::Pin::Hex (addr) << '\n';
   }
 
 private:
-  FILE * file_;
+  OASIS::Pin::Text_Sink & sink_;
 };
 
 class Instrument : public OASIS::Pin::Instruction_Instrument <Instrument>
 {
 public:
-  Instrument (FILE * file)
-    : printip_ (file)
+  Instrument (OASIS::Pin::Text_Sink & sink)
+    : printip_ (sink)
   {
 
   }
@@ -46,22 +47,24 @@ class itrace : public OASIS::Pin::Tool <itrace>
 {
 public:
   itrace (void)
-    : file_ (fopen ("itrace.out", "w")),
-      inst_ (file_)
+    : sink_ ("itrace.out", per_thread_.Value () ? OASIS::Pin::Text_Sink::PER_THREAD_FILES : OASIS::Pin::Text_Sink::MERGED_FILE),
+      inst_ (sink_)
   {
     this->enable_fini_callback ();
   }
 
-
   void handle_fini (INT32)
   {
-    fprintf (this->file_, "#eof\n");
-    fclose (this->file_);
+    this->sink_.close ("#eof\n");
   }
 
 private:
-  FILE * file_;
+  OASIS::Pin::Text_Sink sink_;
   Instrument inst_;
+
+  static KNOB <bool> per_thread_;
 };
 
+KNOB <bool> itrace::per_thread_ (KNOB_MODE_WRITEONCE, "pintool", "per_thread", "0", "write a file per thread instead of one merged file");
+
 DECLARE_PINTOOL (itrace);
@@ -1,11 +1,10 @@
 // $Id: pinatrace.cpp 2290 2013-09-20 05:02:26Z hillj $
 
-#include <stdio.h>
-
 #include "pin++/Instruction_Instrument.h"
 #include "pin++/Callback.h"
 #include "pin++/Pintool.h"
 #include "pin++/Operand.h"
+#include "pin++/Text_Sink.h"
 
 #if defined (TARGET_MAC)
   #define MALLOC "_malloc"
@@ -20,22 +19,24 @@
  */
 class Record_Memory_Read :
 public OASIS::Pin::Callback <Record_Memory_Read (OASIS::Pin::ARG_INST_PTR,
-                                                 OASIS::Pin::ARG_MEMORYOP_EA) >
+                                                 OASIS::Pin::ARG_MEMORYOP_EA,
+                                                 OASIS::Pin::ARG_THREAD_ID) >
 {
 public:
-  Record_Memory_Read (FILE * file)
-    : file_ (file)
+  Record_Memory_Read (OASIS::Pin::Text_Sink & sink)
+    : sink_ (sink)
   {
 
   }
 
-  inline void handle_analyze (ADDRINT ip, ADDRINT addr)
+  inline void handle_analyze (ADDRINT ip, ADDRINT addr, THREADID thr_id)
   {
-    fprintf (this->file_, "%p: R %p\n", ip, addr);
+    OASIS::Pin::Text_Record record (this->sink_, thr_id);
+    record.buffer () << OASIS::Pin::Hex (ip) << ": R " << OASIS::Pin::Hex (addr) << '\n';
   }
 
 private:
-  FILE * file_;
+  OASIS::Pin::Text_Sink & sink_;
 };
 
 /**
@@ -43,30 +44,32 @@ private:
  */
 class Record_Memory_Write :
   public OASIS::Pin::Callback <Record_Memory_Write (OASIS::Pin::ARG_INST_PTR,
-                                                    OASIS::Pin::ARG_MEMORYOP_EA) >
+                                                    OASIS::Pin::ARG_MEMORYOP_EA,
+                                                    OASIS::Pin::ARG_THREAD_ID) >
 {
 public:
-  Record_Memory_Write (FILE * file)
-    : file_ (file)
+  Record_Memory_Write (OASIS::Pin::Text_Sink & sink)
+    : sink_ (sink)
   {
 
   }
 
-  void handle_analyze (ADDRINT ip, ADDRINT addr)
+  void handle_analyze (ADDRINT ip, ADDRINT addr, THREADID thr_id)
   {
-    fprintf (this->file_,"%p: W %p\n", ip, addr);
+    OASIS::Pin::Text_Record record (this->sink_, thr_id);
+    record.buffer () << OASIS::Pin::Hex (ip) << ": W " << OASIS::Pin::Hex (addr) << '\n';
   }
 
 private:
-  FILE * file_;
+  OASIS::Pin::Text_Sink & sink_;
 };
 
 class Instrument : public OASIS::Pin::Instruction_Instrument <Instrument>
 {
 public:
-  Instrument (FILE * file)
-    : mem_read_ (file),
-      mem_write_ (file)
+  Instrument (OASIS::Pin::Text_Sink & sink)
+    : mem_read_ (sink),
+      mem_write_ (sink)
   {
 
   }
@@ -97,7 +100,6 @@ public:
   }
 
 private:
-  FILE * file_;
   Record_Memory_Read mem_read_;
   Record_Memory_Write mem_write_;
 };
@@ -106,21 +108,24 @@ class pinatrace : public OASIS::Pin::Tool <pinatrace>
 {
 public:
   pinatrace (void)
-    : file_ (fopen ("pinatrace.out", "w")),
-      inst_ (file_)
+    : sink_ ("pinatrace.out", per_thread_.Value () ? OASIS::Pin::Text_Sink::PER_THREAD_FILES : OASIS::Pin::Text_Sink::MERGED_FILE),
+      inst_ (sink_)
   {
     this->enable_fini_callback ();
   }
 
   void handle_fini (INT32)
   {
-    fprintf (this->file_, "#eof\n");
-    fclose (this->file_);
+    this->sink_.close ("#eof\n");
   }
 
 private:
-  FILE * file_;
+  OASIS::Pin::Text_Sink sink_;
   Instrument inst_;
+
+  static KNOB <bool> per_thread_;
 };
 
+KNOB <bool> pinatrace::per_thread_ (KNOB_MODE_WRITEONCE, "pintool", "per_thread", "0", "write a file per thread instead of one merged file");
+
 DECLARE_PINTOOL (pinatrace);
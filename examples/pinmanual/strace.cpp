@@ -12,6 +12,26 @@
 #include "pin++/Callback.h"
 #include "pin++/Pintool.h"
 #include "pin++/Context.h"
+#include "pin++/Event_Queue.h"
+#include "pin++/Text_Buffer.h"
+#include "pin++/Thread.h"
+
+/**
+ * @struct Syscall_Event
+ *
+ * Event for the entry or exit of a system call. The analysis routines only
+ * push events, and the writer thread formats them.
+ */
+struct Syscall_Event
+{
+  ADDRINT ip_;
+  ADDRINT num_;
+  ADDRINT args_[6];
+  ADDRINT ret_;
+  bool is_exit_;
+};
+
+typedef OASIS::Pin::Event_Queue <Syscall_Event> Syscall_Queue;
 
 /**
  * @class Syscall_Before
@@ -27,8 +47,8 @@ class Syscall_Before :
                                                OASIS::Pin::ARG_SYSARG_VALUE) >
 {
 public:
-  Syscall_Before (FILE * file)
-    : file_ (file)
+  Syscall_Before (Syscall_Queue & queue)
+    : queue_ (queue)
   {
 
   }
@@ -50,19 +70,23 @@ public:
       arg5 = mmapArgs[5];
     }
 #endif
-    fprintf (this->file_ ,"0x%lx: %ld(0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx)",
-        (unsigned long)ip,
-        (long)num,
-        (unsigned long)arg0,
-        (unsigned long)arg1,
-        (unsigned long)arg2,
-        (unsigned long)arg3,
-        (unsigned long)arg4,
-        (unsigned long)arg5);
+    Syscall_Event event;
+    event.ip_ = ip;
+    event.num_ = num;
+    event.args_[0] = arg0;
+    event.args_[1] = arg1;
+    event.args_[2] = arg2;
+    event.args_[3] = arg3;
+    event.args_[4] = arg4;
+    event.args_[5] = arg5;
+    event.ret_ = 0;
+    event.is_exit_ = false;
+
+    this->queue_.push (event);
   }
 
 private:
-  FILE * file_;
+  Syscall_Queue & queue_;
 };
 
 
@@ -73,28 +97,113 @@ class Syscall_After :
   public OASIS::Pin::Callback <Syscall_After (OASIS::Pin::ARG_SYSRET_VALUE)>
 {
 public:
-  Syscall_After (FILE * file)
-    : file_ (file)
+  Syscall_After (Syscall_Queue & queue)
+    : queue_ (queue)
   {
 
   }
 
   inline void handle_analyze (ADDRINT ret)
   {
-    fprintf (this->file_, " returns: 0x%lx\n", (unsigned long)ret);
-    fflush (this->file_);
+    Syscall_Event event;
+    event.ret_ = ret;
+    event.is_exit_ = true;
+
+    this->queue_.push (event);
   }
 
 private:
-  FILE * file_;
+  Syscall_Queue & queue_;
+};
+
+/**
+ * @class Syscall_Writer
+ *
+ * Internal thread that drains the queue in batches, and formats the events
+ * into a large buffer that is written to the output file in bulk.
+ */
+class Syscall_Writer : public OASIS::Pin::Thread
+{
+public:
+  Syscall_Writer (Syscall_Queue & queue, FILE * file)
+    : queue_ (queue),
+      out_ (file, false),
+      stopped_ (false)
+  {
+
+  }
+
+  virtual void run (void)
+  {
+    static const size_t BATCH_SIZE = 64;
+    Syscall_Event events[BATCH_SIZE];
+
+    for (;;)
+    {
+      size_t count = this->queue_.pop (events, BATCH_SIZE);
+
+      for (size_t i = 0; i < count; ++ i)
+        this->write (events[i]);
+
+      if (0 != count)
+        continue;
+
+      // Check the flag before the queue so the last events are not lost.
+      if (this->stopped_ && this->queue_.is_empty ())
+        break;
+
+      this->out_.flush ();
+      this->queue_.wait (100);
+    }
+
+    this->out_ << "#eof\n";
+    this->out_.flush ();
+  }
+
+  void stop (void)
+  {
+    // The application threads can still make system calls. Once the queue
+    // is closed, their events are dropped instead of waiting forever for
+    // the writer to free a slot.
+    this->stopped_ = true;
+    this->queue_.close ();
+    this->wait ();
+  }
+
+private:
+  void write (const Syscall_Event & event)
+  {
+    using OASIS::Pin::Hex;
+
+    if (event.is_exit_)
+    {
+      this->out_ << " returns: " << Hex (event.ret_) << '\n';
+      return;
+    }
+
+    this->out_ << Hex (event.ip_) << ": " << static_cast <long> (event.num_)
+               << "(" << Hex (event.args_[0])
+               << ", " << Hex (event.args_[1])
+               << ", " << Hex (event.args_[2])
+               << ", " << Hex (event.args_[3])
+               << ", " << Hex (event.args_[4])
+               << ", " << Hex (event.args_[5]) << ")";
+  }
+
+  Syscall_Queue & queue_;
+
+  /// Output buffer, which owns the output file.
+  OASIS::Pin::Text_Buffer out_;
+
+  volatile bool stopped_;
 };
 
 class Instrument : public OASIS::Pin::Instruction_Instrument <Instrument>
 {
 public:
-  Instrument (FILE * file)
-    : syscall_before_ (file),
-      syscall_after_ (file)
+  Instrument (Syscall_Queue & queue)
+    : syscall_before_ (queue),
+      syscall_after_ (queue)
   {
 
   }
@@ -128,10 +237,12 @@ class strace : public OASIS::Pin::Tool <strace>
 {
 public:
   strace (void)
-    : file_ (fopen ("strace.out", "w")),
-      inst_ (file_)
+    : writer_ (queue_, fopen ("strace.out", "w")),
+      inst_ (queue_)
   {
-    this->enable_fini_callback ();
+    this->writer_.start ();
+
+    this->enable_fini_unlocked_callback ();
     this->enable_syscall_entry_callback ();
     this->enable_syscall_exit_callback ();
   }
@@ -153,14 +264,15 @@ public:
     this->inst_.syscall_after ().handle_analyze (ctx.get_syscall_return (std));
   }
 
-  void handle_fini (INT32)
+  void handle_fini_unlocked (INT32)
   {
-    fprintf (this->file_, "#eof\n");
-    fclose (this->file_);
+    // Write the remaining events, and the end of the file.
+    this->writer_.stop ();
   }
 
 private:
-  FILE * file_;
+  Syscall_Queue queue_;
+  Syscall_Writer writer_;
   Instrument inst_;
 };
 
@@ -0,0 +1,371 @@
+// $Id$
+
+#include "Json.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+namespace OASIS
+{
+namespace Pin
+{
+namespace Benchmark
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Json_Writer
+
+Json_Writer::Json_Writer (std::ostream & out)
+: out_ (out),
+  after_key_ (false)
+{
+  this->out_.precision (std::numeric_limits <double>::digits10);
+}
+
+void Json_Writer::next (void)
+{
+  if (this->after_key_)
+  {
+    this->after_key_ = false;
+    return;
+  }
+
+  if (this->counts_.empty ())
+    return;
+
+  if (0 != this->counts_.back () ++)
+    this->out_ << ',';
+
+  this->out_ << '\n' << std::string (this->counts_.size () * 2, ' ');
+}
+
+void Json_Writer::begin_object (void)
+{
+  this->next ();
+  this->out_ << '{';
+  this->counts_.push_back (0);
+}
+
+void Json_Writer::end_object (void)
+{
+  const bool empty = 0 == this->counts_.back ();
+  this->counts_.pop_back ();
+
+  if (!empty)
+    this->out_ << '\n' << std::string (this->counts_.size () * 2, ' ');
+
+  this->out_ << '}';
+
+  if (this->counts_.empty ())
+    this->out_ << '\n';
+}
+
+void Json_Writer::begin_array (void)
+{
+  this->next ();
+  this->out_ << '[';
+  this->counts_.push_back (0);
+}
+
+void Json_Writer::end_array (void)
+{
+  const bool empty = 0 == this->counts_.back ();
+  this->counts_.pop_back ();
+
+  if (!empty)
+    this->out_ << '\n' << std::string (this->counts_.size () * 2, ' ');
+
+  this->out_ << ']';
+}
+
+void Json_Writer::key (const std::string & name)
+{
+  this->next ();
+  this->write_string (name);
+  this->out_ << ": ";
+
+  this->after_key_ = true;
+}
+
+void Json_Writer::value (const std::string & str)
+{
+  this->next ();
+  this->write_string (str);
+}
+
+void Json_Writer::value (const char * str)
+{
+  this->value (std::string (str));
+}
+
+void Json_Writer::value (double number)
+{
+  this->next ();
+
+  // JSON does not have infinity or NaN.
+  if (std::isfinite (number))
+    this->out_ << number;
+  else
+    this->out_ << "null";
+}
+
+void Json_Writer::value (size_t number)
+{
+  this->next ();
+  this->out_ << number;
+}
+
+void Json_Writer::value (int number)
+{
+  this->next ();
+  this->out_ << number;
+}
+
+void Json_Writer::value (bool boolean)
+{
+  this->next ();
+  this->out_ << (boolean ? "true" : "false");
+}
+
+void Json_Writer::write_string (const std::string & str)
+{
+  this->out_ << '"';
+
+  for (size_t i = 0; i < str.size (); ++ i)
+  {
+    const char ch = str[i];
+
+    switch (ch)
+    {
+    case '"':
+      this->out_ << "\\\"";
+      break;
+
+    case '\\':
+      this->out_ << "\\\\";
+      break;
+
+    case '\n':
+      this->out_ << "\\n";
+      break;
+
+    case '\t':
+      this->out_ << "\\t";
+      break;
+
+    default:
+      if (static_cast <unsigned char> (ch) < 0x20)
+      {
+        char escape[8];
+        std::sprintf (escape, "\\u%04x", static_cast <unsigned int> (ch));
+        this->out_ << escape;
+      }
+      else
+      {
+        this->out_ << ch;
+      }
+    }
+  }
+
+  this->out_ << '"';
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Json_Value
+
+/// Value returned by the accessors for missing members.
+static const Json_Value EMPTY_JSON_VALUE;
+
+/// Empty string returned for values that are not strings.
+static const std::string EMPTY_JSON_STRING;
+
+Json_Value::Json_Value (void)
+: type_ (JSON_NULL),
+  boolean_ (false),
+  number_ (0.0)
+{
+
+}
+
+Json_Value::Type Json_Value::type (void) const
+{
+  return this->type_;
+}
+
+double Json_Value::number (void) const
+{
+  return JSON_NUMBER == this->type_ ? this->number_ : 0.0;
+}
+
+const std::string & Json_Value::string (void) const
+{
+  return JSON_STRING == this->type_ ? this->string_ : EMPTY_JSON_STRING;
+}
+
+size_t Json_Value::size (void) const
+{
+  return this->array_.size ();
+}
+
+const Json_Value & Json_Value::operator [] (size_t index) const
+{
+  return index < this->array_.size () ? this->array_[index] : EMPTY_JSON_VALUE;
+}
+
+const Json_Value & Json_Value::operator [] (const std::string & name) const
+{
+  std::map <std::string, Json_Value>::const_iterator iter = this->object_.find (name);
+  return iter != this->object_.end () ? iter->second : EMPTY_JSON_VALUE;
+}
+
+bool Json_Value::parse (std::istream & in)
+{
+  if (!this->parse_value (in))
+    return false;
+
+  // Only white space can follow the document.
+  in >> std::ws;
+  return in.eof ();
+}
+
+bool Json_Value::parse_string (std::istream & in, std::string & str)
+{
+  char ch;
+
+  while (in.get (ch))
+  {
+    if ('"' == ch)
+      return true;
+
+    if ('\\' != ch)
+    {
+      str += ch;
+      continue;
+    }
+
+    if (!in.get (ch))
+      return false;
+
+    switch (ch)
+    {
+    case 'n': str += '\n'; break;
+    case 't': str += '\t'; break;
+    case 'r': str += '\r'; break;
+    case 'b': str += '\b'; break;
+    case 'f': str += '\f'; break;
+
+    case 'u':
+      {
+        char digits[5] = { 0 };
+
+        if (!in.read (digits, 4))
+          return false;
+
+        // Only the ASCII range is written by Json_Writer.
+        str += static_cast <char> (std::strtoul (digits, 0, 16) & 0x7F);
+      }
+      break;
+
+    default:
+      str += ch;
+    }
+  }
+
+  return false;
+}
+
+bool Json_Value::parse_value (std::istream & in)
+{
+  char ch;
+
+  if (!(in >> ch))
+    return false;
+
+  switch (ch)
+  {
+  case '{':
+    this->type_ = JSON_OBJECT;
+
+    in >> std::ws;
+
+    if ('}' == in.peek ())
+      return !!in.get (ch);
+
+    do
+    {
+      std::string name;
+
+      if (!(in >> ch) || '"' != ch || !Json_Value::parse_string (in, name))
+        return false;
+
+      if (!(in >> ch) || ':' != ch)
+        return false;
+
+      if (!this->object_[name].parse_value (in))
+        return false;
+
+      if (!(in >> ch))
+        return false;
+    } while (',' == ch);
+
+    return '}' == ch;
+
+  case '[':
+    this->type_ = JSON_ARRAY;
+
+    in >> std::ws;
+
+    if (']' == in.peek ())
+      return !!in.get (ch);
+
+    do
+    {
+      this->array_.push_back (Json_Value ());
+
+      if (!this->array_.back ().parse_value (in))
+        return false;
+
+      if (!(in >> ch))
+        return false;
+    } while (',' == ch);
+
+    return ']' == ch;
+
+  case '"':
+    this->type_ = JSON_STRING;
+    return Json_Value::parse_string (in, this->string_);
+
+  case 't':
+  case 'f':
+  case 'n':
+    {
+      std::string word (1, ch);
+
+      while (std::isalpha (in.peek ()))
+        word += static_cast <char> (in.get ());
+
+      if ("true" == word || "false" == word)
+      {
+        this->type_ = JSON_BOOL;
+        this->boolean_ = "true" == word;
+        return true;
+      }
+
+      this->type_ = JSON_NULL;
+      return "null" == word;
+    }
+
+  default:
+    in.putback (ch);
+    this->type_ = JSON_NUMBER;
+
+    return !!(in >> this->number_);
+  }
+}
+
+} // namespace Benchmark
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,135 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Json.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_BENCHMARK_JSON_H_
+#define _OASIS_PIN_BENCHMARK_JSON_H_
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+namespace Benchmark
+{
+
+/**
+ * @class Json_Writer
+ *
+ * Writes an indented JSON document to a stream. The caller is responsible
+ * for the structure of the document: inside an object, each value must be
+ * preceded by key ().
+ */
+class Json_Writer
+{
+public:
+  /// Initializing constructor.
+  explicit Json_Writer (std::ostream & out);
+
+  /// @{ Structure
+  void begin_object (void);
+  void end_object (void);
+  void begin_array (void);
+  void end_array (void);
+  void key (const std::string & name);
+  /// @}
+
+  /// @{ Values
+  void value (const std::string & str);
+  void value (const char * str);
+  void value (double number);
+  void value (size_t number);
+  void value (int number);
+  void value (bool boolean);
+  /// @}
+
+private:
+  /// Write the separator and indentation before a value or key.
+  void next (void);
+
+  /// Write a string with escapes.
+  void write_string (const std::string & str);
+
+  std::ostream & out_;
+
+  /// Number of values written at each nesting level.
+  std::vector <size_t> counts_;
+
+  /// The next value follows a key.
+  bool after_key_;
+};
+
+/**
+ * @class Json_Value
+ *
+ * A parsed JSON value. Objects keep their members in a map, which is
+ * enough for reading a stored baseline.
+ */
+class Json_Value
+{
+public:
+  /// The kinds of values.
+  enum Type
+  {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+  };
+
+  /// Default constructor. The value is null.
+  Json_Value (void);
+
+  /// Parse a document. Returns false if the document is not valid.
+  bool parse (std::istream & in);
+
+  Type type (void) const;
+
+  /// @{ Accessors. A value of the wrong type returns an empty value.
+  double number (void) const;
+  const std::string & string (void) const;
+  size_t size (void) const;
+  const Json_Value & operator [] (size_t index) const;
+  const Json_Value & operator [] (const std::string & name) const;
+  /// @}
+
+private:
+  /// Parse the value at the current position of @a in.
+  bool parse_value (std::istream & in);
+
+  /// Parse a string, after its opening quote.
+  static bool parse_string (std::istream & in, std::string & str);
+
+  Type type_;
+
+  bool boolean_;
+
+  double number_;
+
+  std::string string_;
+
+  std::vector <Json_Value> array_;
+
+  std::map <std::string, Json_Value> object_;
+};
+
+} // namespace Benchmark
+} // namespace OASIS
+} // namespace Pin
+
+#endif  // _OASIS_PIN_BENCHMARK_JSON_H_
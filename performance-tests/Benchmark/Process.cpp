@@ -0,0 +1,107 @@
+// $Id$
+
+#include "Process.h"
+
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace OASIS
+{
+namespace Pin
+{
+namespace Benchmark
+{
+
+/// Convert a timeval to seconds.
+static double to_seconds (const struct timeval & tv)
+{
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/// Current monotonic time, in seconds.
+static double now (void)
+{
+  struct timespec ts;
+  ::clock_gettime (CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+std::vector <std::string> split_command (const std::string & command)
+{
+  std::vector <std::string> argv;
+  std::istringstream istr (command);
+  std::string arg;
+
+  while (istr >> arg)
+    argv.push_back (arg);
+
+  return argv;
+}
+
+bool run_process (const std::vector <std::string> & argv, bool verbose, Process_Times & times)
+{
+  if (argv.empty ())
+    return false;
+
+  // Build the argument vector before forking so the child only calls
+  // async-signal-safe functions.
+  std::vector <char *> args;
+
+  for (size_t i = 0; i < argv.size (); ++ i)
+    args.push_back (const_cast <char *> (argv[i].c_str ()));
+
+  args.push_back (0);
+
+  const double start = now ();
+  pid_t pid = ::fork ();
+
+  if (-1 == pid)
+    return false;
+
+  if (0 == pid)
+  {
+    int null_fd = ::open ("/dev/null", O_RDWR);
+
+    if (-1 != null_fd)
+    {
+      ::dup2 (null_fd, STDIN_FILENO);
+
+      if (!verbose)
+      {
+        ::dup2 (null_fd, STDOUT_FILENO);
+        ::dup2 (null_fd, STDERR_FILENO);
+      }
+
+      if (null_fd > STDERR_FILENO)
+        ::close (null_fd);
+    }
+
+    ::execvp (args[0], &args[0]);
+    ::_exit (127);
+  }
+
+  int status = 0;
+  struct rusage usage;
+
+  if (-1 == ::wait4 (pid, &status, 0, &usage))
+    return false;
+
+  times.wall_ = now () - start;
+  times.user_ = to_seconds (usage.ru_utime);
+  times.system_ = to_seconds (usage.ru_stime);
+  times.status_ = WIFEXITED (status) ? WEXITSTATUS (status) : -1;
+
+  // The child could not execute the program.
+  return 127 != times.status_;
+}
+
+} // namespace Benchmark
+} // namespace OASIS
+} // namespace Pin
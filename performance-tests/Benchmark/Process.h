@@ -0,0 +1,73 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Process.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_BENCHMARK_PROCESS_H_
+#define _OASIS_PIN_BENCHMARK_PROCESS_H_
+
+#include <string>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+namespace Benchmark
+{
+
+/**
+ * @struct Process_Times
+ *
+ * Resource usage of one process (and the processes it waited for).
+ */
+struct Process_Times
+{
+  /// Wall time, in seconds.
+  double wall_;
+
+  /// User CPU time, in seconds.
+  double user_;
+
+  /// System CPU time, in seconds.
+  double system_;
+
+  /// Exit status; -1 if the process did not exit normally.
+  int status_;
+};
+
+/**
+ * Split a command line into its arguments. Arguments are separated by
+ * white space; there is no quoting, and the command is not passed to a
+ * shell, so the shell's startup is not part of the measurement.
+ *
+ * @param[in]       command         The command line
+ * @return          The arguments
+ */
+std::vector <std::string> split_command (const std::string & command);
+
+/**
+ * Run a process to completion and measure it. The standard input of the
+ * process is /dev/null, and its output is discarded unless @a verbose is
+ * true.
+ *
+ * @param[in]       argv            The program and its arguments
+ * @param[in]       verbose         Keep the output of the process
+ * @param[out]      times           The measurement
+ * @retval          true            The process ran
+ * @retval          false           The process could not be started
+ */
+bool run_process (const std::vector <std::string> & argv, bool verbose, Process_Times & times);
+
+} // namespace Benchmark
+} // namespace OASIS
+} // namespace Pin
+
+#endif  // _OASIS_PIN_BENCHMARK_PROCESS_H_
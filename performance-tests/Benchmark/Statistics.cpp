@@ -0,0 +1,87 @@
+// $Id$
+
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OASIS
+{
+namespace Pin
+{
+namespace Benchmark
+{
+
+const double CONFIDENCE_LEVEL = 0.95;
+
+/// Two-sided z value for CONFIDENCE_LEVEL.
+static const double CONFIDENCE_Z = 1.959964;
+
+Summary summarize (const std::vector <double> & samples)
+{
+  Summary summary;
+  summary.count_ = samples.size ();
+  summary.median_ = summary.mean_ = summary.stddev_ = 0.0;
+  summary.min_ = summary.max_ = summary.ci_low_ = summary.ci_high_ = 0.0;
+  summary.samples_ = samples;
+
+  if (samples.empty ())
+    return summary;
+
+  std::vector <double> sorted (samples);
+  std::sort (sorted.begin (), sorted.end ());
+
+  const size_t n = sorted.size ();
+
+  summary.min_ = sorted.front ();
+  summary.max_ = sorted.back ();
+  summary.median_ = 0 == n % 2 ? (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0 : sorted[n / 2];
+
+  double sum = 0.0;
+
+  for (size_t i = 0; i < n; ++ i)
+    sum += sorted[i];
+
+  summary.mean_ = sum / n;
+
+  if (n > 1)
+  {
+    double squares = 0.0;
+
+    for (size_t i = 0; i < n; ++ i)
+      squares += (sorted[i] - summary.mean_) * (sorted[i] - summary.mean_);
+
+    summary.stddev_ = std::sqrt (squares / (n - 1));
+  }
+
+  // The ranks of the interval are the normal approximation of the
+  // binomial quantiles. With fewer than 6 samples, the interval of
+  // the median cannot reach 95%, so it is the range of the samples.
+  const double half_width = CONFIDENCE_Z * std::sqrt (static_cast <double> (n)) / 2.0;
+  const double low_rank = std::floor (n / 2.0 - half_width);
+  const double high_rank = std::ceil (n / 2.0 + 1.0 + half_width);
+
+  summary.ci_low_ = low_rank < 1.0 ? sorted.front () : sorted[static_cast <size_t> (low_rank) - 1];
+  summary.ci_high_ = high_rank > n ? sorted.back () : sorted[static_cast <size_t> (high_rank) - 1];
+
+  return summary;
+}
+
+Summary summarize_ratio (const std::vector <double> & numerator,
+                         const std::vector <double> & denominator)
+{
+  std::vector <double> ratios;
+  const size_t n = std::min (numerator.size (), denominator.size ());
+
+  for (size_t i = 0; i < n; ++ i)
+  {
+    if (0.0 != denominator[i])
+      ratios.push_back (numerator[i] / denominator[i]);
+  }
+
+  return summarize (ratios);
+}
+
+} // namespace Benchmark
+} // namespace OASIS
+} // namespace Pin
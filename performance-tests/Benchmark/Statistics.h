@@ -0,0 +1,84 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Statistics.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_BENCHMARK_STATISTICS_H_
+#define _OASIS_PIN_BENCHMARK_STATISTICS_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+namespace Benchmark
+{
+
+/**
+ * @struct Summary
+ *
+ * Summary of the trials of one measurement. The confidence interval is
+ * the distribution-free interval of the median, which is computed from
+ * the order statistics of the samples, so it does not assume the run
+ * times are normally distributed (they are usually skewed to the right).
+ */
+struct Summary
+{
+  /// Number of samples.
+  size_t count_;
+
+  double median_;
+
+  double mean_;
+
+  /// Sample standard deviation.
+  double stddev_;
+
+  double min_;
+
+  double max_;
+
+  /// @{ Confidence interval of the median
+  double ci_low_;
+  double ci_high_;
+  /// @}
+
+  /// The samples, in the order they were taken.
+  std::vector <double> samples_;
+};
+
+/// Confidence level of the intervals.
+extern const double CONFIDENCE_LEVEL;
+
+/**
+ * Summarize a set of samples.
+ *
+ * @param[in]       samples         The samples
+ * @return          The summary; all 0 if there are no samples
+ */
+Summary summarize (const std::vector <double> & samples);
+
+/**
+ * Summarize the element-wise ratio of two sets of paired samples.
+ *
+ * @param[in]       numerator       The samples of the numerator
+ * @param[in]       denominator     The samples of the denominator
+ * @return          The summary of numerator[i] / denominator[i]
+ */
+Summary summarize_ratio (const std::vector <double> & numerator,
+                         const std::vector <double> & denominator);
+
+} // namespace Benchmark
+} // namespace OASIS
+} // namespace Pin
+
+#endif  // _OASIS_PIN_BENCHMARK_STATISTICS_H_
@@ -0,0 +1,733 @@
+// $Id$
+
+//
+// Benchmark driver for Pin++ pintools. Each tool (the native Pin tools
+// and their Pin++ versions, matched by name, plus any tools given with
+// --tool) is run on a fixed set of workloads. The driver discards a
+// number of warm-up runs, then interleaves the trials of the workload
+// without Pin, under Pin without a tool, and under each tool so drift
+// in the machine affects all of them alike. From the medians, the run
+// time of a tool is divided into:
+//
+//   pin_startup   - Pin's startup (Pin on an empty program)
+//   jit           - translating and running the workload from the code
+//                   cache (Pin without a tool, less native and startup)
+//   tool_startup  - the tool's initialization (the tool on an empty
+//                   program, less pin_startup)
+//   analysis      - instrumentation and analysis of the workload (the
+//                   tool, less Pin without a tool and tool_startup)
+//
+// The results are written as JSON. If a baseline (the JSON of a previous
+// run) is given, the overhead of each tool (tool / native) is compared
+// against it, and the driver exits with status 2 if the overhead grew by
+// more than the tolerance.
+//
+
+#include "Json.h"
+#include "Process.h"
+#include "Statistics.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+using namespace OASIS::Pin::Benchmark;
+
+/// Fewest trials for which the interval of the median excludes the
+/// extreme samples, so the baseline check can detect a regression.
+static const size_t MIN_BASELINE_TRIALS = 20;
+
+/**
+ * @struct Tool
+ *
+ * A pintool under test.
+ */
+struct Tool
+{
+  std::string name_;
+
+  std::string path_;
+
+  /// Arguments passed to the tool (e.g., its knobs).
+  std::vector <std::string> args_;
+};
+
+/**
+ * @struct Options
+ *
+ * Command-line options of the driver.
+ */
+struct Options
+{
+  Options (void)
+    : startup_binary_ ("/bin/true"),
+      warmup_ (2),
+      trials_ (20),
+      outfile_ ("benchmark.json"),
+      tolerance_ (5.0),
+      verbose_ (false) { }
+
+  std::string pin_;
+
+  std::string pindir_;
+
+  std::string pinppdir_;
+
+  std::vector <Tool> tools_;
+
+  std::vector <std::string> workloads_;
+
+  std::string startup_binary_;
+
+  size_t warmup_;
+
+  size_t trials_;
+
+  std::string outfile_;
+
+  std::string baseline_;
+
+  /// Allowed growth of the overhead, in percent.
+  double tolerance_;
+
+  bool verbose_;
+};
+
+/**
+ * @struct Measurement
+ *
+ * One configuration that is timed (e.g., a tool on a workload).
+ */
+struct Measurement
+{
+  std::vector <std::string> argv_;
+
+  std::vector <double> wall_;
+
+  std::vector <double> cpu_;
+
+  /// At least one run exited with a non-zero status.
+  bool failed_;
+};
+
+/**
+ * @struct Tool_Result
+ *
+ * The results of a tool on a workload.
+ */
+struct Tool_Result
+{
+  const Tool * tool_;
+
+  const Measurement * startup_;
+
+  Measurement run_;
+};
+
+/**
+ * @struct Workload_Result
+ *
+ * The results of a workload.
+ */
+struct Workload_Result
+{
+  std::string command_;
+
+  Measurement native_;
+
+  Measurement pin_;
+
+  std::vector <Tool_Result> tools_;
+};
+
+/**
+ * @struct Regression
+ *
+ * Change of the overhead of a tool relative to the baseline.
+ */
+struct Regression
+{
+  std::string tool_;
+
+  std::string workload_;
+
+  double baseline_;
+
+  Summary current_;
+};
+
+static std::string env (const char * name)
+{
+  const char * value = ::getenv (name);
+  return 0 != value ? value : "";
+}
+
+static void usage (const char * program)
+{
+  std::cerr
+    << "usage: " << program << " [options]" << std::endl
+    << "  --pin PATH              Pin launcher. Defaults to $PIN_ROOT/pin" << std::endl
+    << "  --pindir DIR            Native pintool directory. Defaults to $PIN_ROOT/source/tools" << std::endl
+    << "  --pinppdir DIR          Pin++ pintool directory. Defaults to $PINPP_ROOT/lib" << std::endl
+    << "  --tool NAME=PATH [ARGS] Additional pintool to test, with its arguments (repeatable)" << std::endl
+    << "  --workload COMMAND      Workload to run (repeatable)" << std::endl
+    << "  --workload_file FILE    File with one workload per line" << std::endl
+    << "  --startup_binary PATH   Empty program for the startup phases. Defaults to /bin/true" << std::endl
+    << "  --warmup N              Discarded runs of each configuration. Defaults to 2" << std::endl
+    << "  --trials N              Timed runs of each configuration. Defaults to 20" << std::endl
+    << "  --outfile FILE          Results. Defaults to benchmark.json" << std::endl
+    << "  --baseline FILE         Results of a previous run to check for regressions" << std::endl
+    << "  --tolerance PERCENT     Allowed growth of the overhead. Defaults to 5" << std::endl
+    << "  --verbose               Show the output of the runs" << std::endl;
+}
+
+static bool parse_args (int argc, char * argv [], Options & opts)
+{
+  opts.pin_ = env ("PIN_ROOT").empty () ? "" : env ("PIN_ROOT") + "/pin";
+  opts.pindir_ = env ("PIN_ROOT").empty () ? "" : env ("PIN_ROOT") + "/source/tools";
+  opts.pinppdir_ = env ("PINPP_ROOT").empty () ? "" : env ("PINPP_ROOT") + "/lib";
+
+  for (int i = 1; i < argc; ++ i)
+  {
+    const std::string arg (argv[i]);
+
+    if ("--verbose" == arg)
+    {
+      opts.verbose_ = true;
+      continue;
+    }
+
+    if (i + 1 == argc)
+      return false;
+
+    const std::string value (argv[++ i]);
+
+    if ("--pin" == arg)
+      opts.pin_ = value;
+    else if ("--pindir" == arg)
+      opts.pindir_ = value;
+    else if ("--pinppdir" == arg)
+      opts.pinppdir_ = value;
+    else if ("--startup_binary" == arg)
+      opts.startup_binary_ = value;
+    else if ("--workload" == arg)
+      opts.workloads_.push_back (value);
+    else if ("--warmup" == arg)
+      opts.warmup_ = ::strtoul (value.c_str (), 0, 10);
+    else if ("--trials" == arg)
+      opts.trials_ = ::strtoul (value.c_str (), 0, 10);
+    else if ("--outfile" == arg)
+      opts.outfile_ = value;
+    else if ("--baseline" == arg)
+      opts.baseline_ = value;
+    else if ("--tolerance" == arg)
+      opts.tolerance_ = ::strtod (value.c_str (), 0);
+    else if ("--tool" == arg)
+    {
+      const size_t pos = value.find ('=');
+
+      if (std::string::npos == pos)
+        return false;
+
+      // The path is followed by the arguments of the tool, so the same
+      // tool can be tested with different knobs.
+      std::vector <std::string> command = split_command (value.substr (pos + 1));
+
+      if (command.empty ())
+        return false;
+
+      Tool tool;
+      tool.name_ = value.substr (0, pos);
+      tool.path_ = command[0];
+      tool.args_.assign (command.begin () + 1, command.end ());
+
+      opts.tools_.push_back (tool);
+    }
+    else if ("--workload_file" == arg)
+    {
+      std::ifstream file (value.c_str ());
+
+      if (!file.is_open ())
+      {
+        std::cerr << "ERROR: Workload file <" << value << "> does not exist" << std::endl;
+        return false;
+      }
+
+      std::string line;
+
+      while (std::getline (file, line))
+      {
+        if (!split_command (line).empty () && '#' != line[line.find_first_not_of (" \t")])
+          opts.workloads_.push_back (line);
+      }
+    }
+    else
+      return false;
+  }
+
+  return !opts.pin_.empty () && 0 != opts.trials_;
+}
+
+//
+// Find the pintools in a directory and its subdirectories, keyed by
+// file name.
+//
+static void find_pintools (const std::string & path, std::vector <Tool> & tools)
+{
+  DIR * dir = ::opendir (path.c_str ());
+
+  if (0 == dir)
+    return;
+
+  while (struct dirent * entry = ::readdir (dir))
+  {
+    const std::string name (entry->d_name);
+
+    if ("." == name || ".." == name)
+      continue;
+
+    const std::string file = path + "/" + name;
+    struct stat info;
+
+    if (0 != ::stat (file.c_str (), &info))
+      continue;
+
+    if (S_ISDIR (info.st_mode))
+    {
+      find_pintools (file, tools);
+    }
+    else if (name.size () > 3 && 0 == name.compare (name.size () - 3, 3, ".so"))
+    {
+      Tool tool;
+      tool.name_ = name.substr (0, name.size () - 3);
+      tool.path_ = file;
+
+      tools.push_back (tool);
+    }
+  }
+
+  ::closedir (dir);
+}
+
+//
+// Match the native pintools (e.g., inscount0.so) with their Pin++
+// versions (e.g., libinscount0.so).
+//
+static void match_pintools (const Options & opts, std::vector <Tool> & tools)
+{
+  std::vector <Tool> native, pinpp;
+
+  if (!opts.pindir_.empty ())
+    find_pintools (opts.pindir_, native);
+
+  if (!opts.pinppdir_.empty ())
+    find_pintools (opts.pinppdir_, pinpp);
+
+  for (size_t i = 0; i < native.size (); ++ i)
+  {
+    for (size_t j = 0; j < pinpp.size (); ++ j)
+    {
+      if ("lib" + native[i].name_ != pinpp[j].name_)
+        continue;
+
+      Tool tool = native[i];
+      tool.name_ = native[i].name_ + "/native";
+      tools.push_back (tool);
+
+      tool = pinpp[j];
+      tool.name_ = native[i].name_ + "/pin++";
+      tools.push_back (tool);
+
+      break;
+    }
+  }
+}
+
+//
+// Command line of a run under Pin, with an optional tool.
+//
+static std::vector <std::string>
+pin_command (const Options & opts, const Tool * tool, const std::vector <std::string> & program)
+{
+  std::vector <std::string> argv;
+  argv.push_back (opts.pin_);
+
+  if (0 != tool)
+  {
+    argv.push_back ("-t");
+    argv.push_back (tool->path_);
+    argv.insert (argv.end (), tool->args_.begin (), tool->args_.end ());
+  }
+
+  argv.push_back ("--");
+  argv.insert (argv.end (), program.begin (), program.end ());
+
+  return argv;
+}
+
+//
+// Run a set of measurements: the warm-up runs of each, then the trials
+// interleaved across the measurements.
+//
+static bool run (const Options & opts, const std::vector <Measurement *> & measurements)
+{
+  const size_t runs = opts.warmup_ + opts.trials_;
+
+  for (size_t i = 0; i < runs; ++ i)
+  {
+    const bool warmup = i < opts.warmup_;
+
+    for (size_t j = 0; j < measurements.size (); ++ j)
+    {
+      Measurement & measurement = *measurements[j];
+      Process_Times times;
+
+      if (!run_process (measurement.argv_, opts.verbose_, times))
+      {
+        std::cerr << "ERROR: Failed to run <" << measurement.argv_[0] << ">" << std::endl;
+        return false;
+      }
+
+      if (warmup)
+        continue;
+
+      if (0 != times.status_)
+        measurement.failed_ = true;
+
+      measurement.wall_.push_back (times.wall_);
+      measurement.cpu_.push_back (times.user_ + times.system_);
+    }
+
+    std::cout << "INFO: Completed " << (warmup ? "warm-up run " : "trial ")
+              << (warmup ? i + 1 : i + 1 - opts.warmup_) << std::endl;
+  }
+
+  return true;
+}
+
+static Measurement make_measurement (const std::vector <std::string> & argv)
+{
+  Measurement measurement;
+  measurement.argv_ = argv;
+  measurement.failed_ = false;
+
+  return measurement;
+}
+
+static std::string join (const std::vector <std::string> & argv)
+{
+  std::ostringstream ostr;
+
+  for (size_t i = 0; i < argv.size (); ++ i)
+    ostr << (0 != i ? " " : "") << argv[i];
+
+  return ostr.str ();
+}
+
+static void write_summary (Json_Writer & writer, const Summary & summary)
+{
+  writer.begin_object ();
+  writer.key ("median"); writer.value (summary.median_);
+  writer.key ("ci_low"); writer.value (summary.ci_low_);
+  writer.key ("ci_high"); writer.value (summary.ci_high_);
+  writer.key ("mean"); writer.value (summary.mean_);
+  writer.key ("stddev"); writer.value (summary.stddev_);
+  writer.key ("min"); writer.value (summary.min_);
+  writer.key ("max"); writer.value (summary.max_);
+  writer.key ("samples");
+  writer.begin_array ();
+
+  for (size_t i = 0; i < summary.samples_.size (); ++ i)
+    writer.value (summary.samples_[i]);
+
+  writer.end_array ();
+  writer.end_object ();
+}
+
+static void write_measurement (Json_Writer & writer, const Measurement & measurement)
+{
+  writer.begin_object ();
+  writer.key ("command"); writer.value (join (measurement.argv_));
+  writer.key ("failed"); writer.value (measurement.failed_);
+  writer.key ("wall"); write_summary (writer, summarize (measurement.wall_));
+  writer.key ("cpu"); write_summary (writer, summarize (measurement.cpu_));
+  writer.end_object ();
+}
+
+static double median (const Measurement & measurement)
+{
+  return summarize (measurement.wall_).median_;
+}
+
+//
+// Compare the overhead of each tool against the baseline.
+//
+static bool check_baseline (const Options & opts,
+                            const std::vector <Workload_Result> & results,
+                            std::vector <Regression> & regressions)
+{
+  // With fewer trials, the interval of the median spans (almost) all the
+  // samples, so its lower end is close to the fastest run, and a real
+  // regression rarely moves it above the tolerance.
+  if (opts.trials_ < MIN_BASELINE_TRIALS)
+    std::cerr << "WARNING: The baseline check needs at least " << MIN_BASELINE_TRIALS
+              << " trials to detect regressions reliably" << std::endl;
+
+  std::ifstream file (opts.baseline_.c_str ());
+  Json_Value baseline;
+
+  if (!file.is_open () || !baseline.parse (file))
+  {
+    std::cerr << "ERROR: Failed to read baseline <" << opts.baseline_ << ">" << std::endl;
+    return false;
+  }
+
+  const Json_Value & workloads = baseline["workloads"];
+
+  for (size_t i = 0; i < results.size (); ++ i)
+  {
+    const Workload_Result & result = results[i];
+
+    for (size_t w = 0; w < workloads.size (); ++ w)
+    {
+      if (workloads[w]["command"].string () != result.command_)
+        continue;
+
+      const Json_Value & tools = workloads[w]["tools"];
+
+      for (size_t t = 0; t < result.tools_.size (); ++ t)
+      {
+        const Tool_Result & tool = result.tools_[t];
+
+        for (size_t b = 0; b < tools.size (); ++ b)
+        {
+          if (tools[b]["name"].string () != tool.tool_->name_)
+            continue;
+
+          const double expected = tools[b]["overhead"]["median"].number ();
+          const Summary current = summarize_ratio (tool.run_.wall_, result.native_.wall_);
+
+          // The overhead regressed only if the whole interval is above
+          // the tolerance, so noise does not fail the check.
+          const double limit = expected * (1.0 + opts.tolerance_ / 100.0);
+
+          std::cout << "INFO: <" << tool.tool_->name_ << "> on <" << result.command_ << ">: overhead "
+                    << current.median_ << "x [" << current.ci_low_ << ", " << current.ci_high_
+                    << "], baseline " << expected << "x" << std::endl;
+
+          if (0.0 != expected && current.ci_low_ > limit)
+          {
+            Regression regression;
+            regression.tool_ = tool.tool_->name_;
+            regression.workload_ = result.command_;
+            regression.baseline_ = expected;
+            regression.current_ = current;
+
+            regressions.push_back (regression);
+          }
+
+          break;
+        }
+      }
+
+      break;
+    }
+  }
+
+  return true;
+}
+
+static void write_results (Json_Writer & writer,
+                           const Options & opts,
+                           const Measurement & pin_startup,
+                           const std::vector <Workload_Result> & results,
+                           const std::vector <Regression> & regressions)
+{
+  writer.begin_object ();
+  writer.key ("pin"); writer.value (opts.pin_);
+  writer.key ("warmup"); writer.value (opts.warmup_);
+  writer.key ("trials"); writer.value (opts.trials_);
+  writer.key ("confidence"); writer.value (CONFIDENCE_LEVEL);
+  writer.key ("pin_startup"); write_measurement (writer, pin_startup);
+
+  writer.key ("workloads");
+  writer.begin_array ();
+
+  for (size_t i = 0; i < results.size (); ++ i)
+  {
+    const Workload_Result & result = results[i];
+
+    writer.begin_object ();
+    writer.key ("command"); writer.value (result.command_);
+    writer.key ("native"); write_measurement (writer, result.native_);
+    writer.key ("pin"); write_measurement (writer, result.pin_);
+
+    writer.key ("tools");
+    writer.begin_array ();
+
+    for (size_t t = 0; t < result.tools_.size (); ++ t)
+    {
+      const Tool_Result & tool = result.tools_[t];
+
+      const double startup = median (pin_startup);
+      const double tool_startup = median (*tool.startup_) - startup;
+
+      writer.begin_object ();
+      writer.key ("name"); writer.value (tool.tool_->name_);
+      writer.key ("path"); writer.value (tool.tool_->path_);
+      writer.key ("startup"); write_measurement (writer, *tool.startup_);
+      writer.key ("run"); write_measurement (writer, tool.run_);
+
+      writer.key ("phases");
+      writer.begin_object ();
+      writer.key ("pin_startup"); writer.value (startup);
+      writer.key ("jit"); writer.value (median (result.pin_) - median (result.native_) - startup);
+      writer.key ("tool_startup"); writer.value (tool_startup);
+      writer.key ("analysis"); writer.value (median (tool.run_) - median (result.pin_) - tool_startup);
+      writer.end_object ();
+
+      writer.key ("overhead"); write_summary (writer, summarize_ratio (tool.run_.wall_, result.native_.wall_));
+      writer.end_object ();
+    }
+
+    writer.end_array ();
+    writer.end_object ();
+  }
+
+  writer.end_array ();
+
+  if (!opts.baseline_.empty ())
+  {
+    writer.key ("baseline"); writer.value (opts.baseline_);
+    writer.key ("tolerance"); writer.value (opts.tolerance_);
+    writer.key ("regressions");
+    writer.begin_array ();
+
+    for (size_t i = 0; i < regressions.size (); ++ i)
+    {
+      writer.begin_object ();
+      writer.key ("tool"); writer.value (regressions[i].tool_);
+      writer.key ("workload"); writer.value (regressions[i].workload_);
+      writer.key ("baseline"); writer.value (regressions[i].baseline_);
+      writer.key ("overhead"); write_summary (writer, regressions[i].current_);
+      writer.end_object ();
+    }
+
+    writer.end_array ();
+  }
+
+  writer.end_object ();
+}
+
+int main (int argc, char * argv [])
+{
+  Options opts;
+
+  if (!parse_args (argc, argv, opts))
+  {
+    usage (argv[0]);
+    return 1;
+  }
+
+  std::vector <Tool> tools;
+  match_pintools (opts, tools);
+  tools.insert (tools.end (), opts.tools_.begin (), opts.tools_.end ());
+
+  if (tools.empty ())
+  {
+    std::cerr << "ERROR: No pintools found, are they compiled?" << std::endl;
+    return 1;
+  }
+
+  if (opts.workloads_.empty ())
+  {
+    std::cerr << "ERROR: No workloads specified" << std::endl;
+    return 1;
+  }
+
+  // The startup of Pin, and of each tool, does not depend on the workload.
+  const std::vector <std::string> startup_binary = split_command (opts.startup_binary_);
+
+  Measurement pin_startup = make_measurement (pin_command (opts, 0, startup_binary));
+  std::vector <Measurement> tool_startup;
+
+  for (size_t i = 0; i < tools.size (); ++ i)
+    tool_startup.push_back (make_measurement (pin_command (opts, &tools[i], startup_binary)));
+
+  std::vector <Measurement *> measurements;
+  measurements.push_back (&pin_startup);
+
+  for (size_t i = 0; i < tool_startup.size (); ++ i)
+    measurements.push_back (&tool_startup[i]);
+
+  std::cout << "INFO: Measuring the startup of Pin and " << tools.size () << " pintool(s)" << std::endl;
+
+  if (!run (opts, measurements))
+    return 1;
+
+  std::vector <Workload_Result> results (opts.workloads_.size ());
+
+  for (size_t i = 0; i < opts.workloads_.size (); ++ i)
+  {
+    Workload_Result & result = results[i];
+    const std::vector <std::string> program = split_command (opts.workloads_[i]);
+
+    result.command_ = opts.workloads_[i];
+    result.native_ = make_measurement (program);
+    result.pin_ = make_measurement (pin_command (opts, 0, program));
+
+    for (size_t t = 0; t < tools.size (); ++ t)
+    {
+      Tool_Result tool;
+      tool.tool_ = &tools[t];
+      tool.startup_ = &tool_startup[t];
+      tool.run_ = make_measurement (pin_command (opts, &tools[t], program));
+
+      result.tools_.push_back (tool);
+    }
+
+    measurements.clear ();
+    measurements.push_back (&result.native_);
+    measurements.push_back (&result.pin_);
+
+    for (size_t t = 0; t < result.tools_.size (); ++ t)
+      measurements.push_back (&result.tools_[t].run_);
+
+    std::cout << "INFO: Measuring workload <" << result.command_ << ">" << std::endl;
+
+    if (!run (opts, measurements))
+      return 1;
+  }
+
+  std::vector <Regression> regressions;
+
+  if (!opts.baseline_.empty () && !check_baseline (opts, results, regressions))
+    return 1;
+
+  std::ofstream outfile (opts.outfile_.c_str ());
+
+  if (!outfile.is_open ())
+  {
+    std::cerr << "ERROR: Failed to open <" << opts.outfile_ << ">" << std::endl;
+    return 1;
+  }
+
+  Json_Writer writer (outfile);
+  write_results (writer, opts, pin_startup, results, regressions);
+
+  std::cout << "INFO: Results written to <" << opts.outfile_ << ">" << std::endl;
+
+  for (size_t i = 0; i < regressions.size (); ++ i)
+  {
+    std::cerr << "ERROR: Overhead of <" << regressions[i].tool_ << "> on <" << regressions[i].workload_
+              << "> regressed from " << regressions[i].baseline_ << "x to "
+              << regressions[i].current_.median_ << "x" << std::endl;
+  }
+
+  return regressions.empty () ? 0 : 2;
+}
@@ -0,0 +1,390 @@
+// $Id$
+
+//
+// Micro-benchmarks of the analysis-side templates of Pin++. The program
+// is built against the host shim of pin.H in this directory, not against
+// a Pin kit, so each primitive is measured natively in seconds:
+//
+//   - dispatch of Callback, Static_Callback, and Counter analysis
+//     routines through a function pointer, as Pin calls them
+//   - dispatch over a Buffer of callback objects, one per instruction
+//   - TLS lookups, and Sharded_Counter updates
+//   - Lock, Mutex, and RW_Mutex guards, without and with contention
+//   - formatting an itrace line with Text_Buffer, fprintf, and ofstream
+//
+// The shim implements the Pin services with pthreads and thread_local,
+// so the absolute numbers are those of the host, not of Pin. They are
+// meant for comparing implementations of the Pin++ templates.
+//
+
+#include "pin++/Buffer.h"
+#include "pin++/Callback.h"
+#include "pin++/Static_Callback.h"
+#include "pin++/Counter.h"
+#include "pin++/Guard.h"
+#include "pin++/Sharded_Counter.h"
+#include "pin++/Text_Buffer.h"
+#include "pin++/TLS.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace OASIS::Pin;
+
+/// Sink for results, so the compiler cannot remove the benchmarks.
+static volatile UINT64 sink = 0;
+
+//
+// Callbacks under test.
+//
+class count_void : public Callback <count_void (void)>
+{
+public:
+  count_void (void) : count_ (0) { }
+
+  void handle_analyze (void) { ++ this->count_; }
+
+  UINT64 count_;
+};
+
+class count_ip : public Callback <count_ip (ARG_INST_PTR)>
+{
+public:
+  count_ip (void) : total_ (0) { }
+
+  void handle_analyze (ADDRINT ip) { this->total_ += ip; }
+
+  UINT64 total_;
+};
+
+class count_mem : public Callback <count_mem (ARG_INST_PTR, ARG_MEMORYREAD_EA, ARG_MEMORYREAD_SIZE)>
+{
+public:
+  count_mem (void) : total_ (0) { }
+
+  void handle_analyze (ADDRINT ip, ADDRINT ea, UINT32 size) { this->total_ += ip ^ ea ^ size; }
+
+  UINT64 total_;
+};
+
+class static_count_ip : public Static_Callback <static_count_ip (ARG_INST_PTR)>
+{
+public:
+  static void handle_analyze (ADDRINT ip) { static_total_ += ip; }
+
+  static UINT64 static_total_;
+};
+
+UINT64 static_count_ip::static_total_ = 0;
+
+/**
+ * @struct Benchmark
+ *
+ * A named benchmark. The function runs @a iterations operations, and
+ * returns a value that is added to the sink.
+ */
+struct Benchmark
+{
+  const char * name_;
+
+  UINT64 (* run_) (UINT64 iterations, size_t threads);
+
+  /// Number of threads; 1 runs on the main thread.
+  size_t threads_;
+};
+
+//
+// Pin calls the analysis routines through a pointer it cannot see
+// through. The pointers are volatile for the same effect.
+//
+typedef void (PIN_FAST_ANALYSIS_CALL * analyze0_type) (void *);
+typedef void (PIN_FAST_ANALYSIS_CALL * analyze1_type) (void *, ADDRINT);
+typedef void (PIN_FAST_ANALYSIS_CALL * analyze3_type) (void *, ADDRINT, ADDRINT, UINT32);
+typedef void (PIN_FAST_ANALYSIS_CALL * static_analyze1_type) (ADDRINT);
+
+static UINT64 bench_callback_void (UINT64 iterations, size_t)
+{
+  count_void callback;
+  analyze0_type volatile analyze = &count_void::__analyze;
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+    analyze (&callback);
+
+  return callback.count_;
+}
+
+static UINT64 bench_callback_ip (UINT64 iterations, size_t)
+{
+  count_ip callback;
+  analyze1_type volatile analyze = &count_ip::__analyze;
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+    analyze (&callback, i);
+
+  return callback.total_;
+}
+
+static UINT64 bench_callback_mem (UINT64 iterations, size_t)
+{
+  count_mem callback;
+  analyze3_type volatile analyze = &count_mem::__analyze;
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+    analyze (&callback, i, i << 3, 8);
+
+  return callback.total_;
+}
+
+static UINT64 bench_static_callback_ip (UINT64 iterations, size_t)
+{
+  static_analyze1_type volatile analyze = &static_count_ip::__analyze;
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+    analyze (i);
+
+  return static_count_ip::static_total_;
+}
+
+static UINT64 bench_counter (UINT64 iterations, size_t)
+{
+  typedef Counter <> counter_type;
+
+  counter_type counter;
+  analyze0_type volatile analyze = &counter_type::__analyze;
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+    analyze (&counter);
+
+  return counter.count ();
+}
+
+static UINT64 bench_buffer_callback_ip (UINT64 iterations, size_t)
+{
+  // A tool keeps one callback object per instrumented instruction, and
+  // Pin runs the routine of each in turn.
+  static const size_t INSTRUCTIONS = 64;
+
+  Buffer <count_ip> callbacks (INSTRUCTIONS);
+  analyze1_type volatile analyze = &count_ip::__analyze;
+
+  UINT64 i = 0;
+
+  while (i < iterations)
+  {
+    for (Buffer <count_ip>::iterator iter = callbacks.begin (), end = callbacks.end ();
+         iter != end && i < iterations;
+         ++ iter, ++ i)
+    {
+      analyze (&*iter, i);
+    }
+  }
+
+  UINT64 total = 0;
+
+  for (Buffer <count_ip>::const_iterator iter = callbacks.begin (), end = callbacks.end (); iter != end; ++ iter)
+    total += iter->total_;
+
+  callbacks.release ();
+  return total;
+}
+
+//
+// Run a function on a number of threads at the same time.
+//
+template <typename F>
+static void run_threads (size_t threads, F function)
+{
+  std::vector <std::thread> pool;
+
+  for (size_t i = 0; i < threads; ++ i)
+    pool.push_back (std::thread (function));
+
+  for (size_t i = 0; i < pool.size (); ++ i)
+    pool[i].join ();
+}
+
+static UINT64 bench_sharded_counter (UINT64 iterations, size_t threads)
+{
+  typedef Counter <UINT64, Sharded_Storage <> > counter_type;
+  typedef void (PIN_FAST_ANALYSIS_CALL * analyze_type) (void *, THREADID);
+
+  counter_type counter;
+  analyze_type volatile analyze = &counter_type::__analyze;
+
+  run_threads (threads, [&] {
+    const THREADID thr_id = PIN_ThreadId ();
+
+    for (UINT64 i = 0; i < iterations; ++ i)
+      analyze (&counter, thr_id);
+  });
+
+  return counter.count ();
+}
+
+static UINT64 bench_tls_get (UINT64 iterations, size_t threads)
+{
+  TLS <UINT64> tls;
+  UINT64 total = 0;
+  Lock lock;
+
+  run_threads (threads, [&] {
+    UINT64 value = 0;
+    tls.set (&value);
+
+    for (UINT64 i = 0; i < iterations; ++ i)
+      ++ *tls.get ();
+
+    Guard <Lock> guard (lock);
+    total += value;
+  });
+
+  return total;
+}
+
+static UINT64 bench_tls_get_thr_id (UINT64 iterations, size_t threads)
+{
+  TLS <UINT64> tls;
+  UINT64 total = 0;
+  Lock lock;
+
+  run_threads (threads, [&] {
+    const THREADID thr_id = PIN_ThreadId ();
+    UINT64 value = 0;
+    tls.set (thr_id, &value);
+
+    for (UINT64 i = 0; i < iterations; ++ i)
+      ++ *tls.get (thr_id);
+
+    Guard <Lock> guard (lock);
+    total += value;
+  });
+
+  return total;
+}
+
+template <typename LOCK, template <typename> class GUARD>
+static UINT64 bench_guard (UINT64 iterations, size_t threads)
+{
+  LOCK lock;
+  UINT64 total = 0;
+
+  run_threads (threads, [&] {
+    for (UINT64 i = 0; i < iterations; ++ i)
+    {
+      GUARD <LOCK> guard (lock);
+      ++ total;
+    }
+  });
+
+  return total;
+}
+
+//
+// The itrace line, "0x<address>\n", written to /dev/null.
+//
+static UINT64 bench_text_buffer (UINT64 iterations, size_t)
+{
+  Text_Buffer out (::fopen ("/dev/null", "w"), false);
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+  {
+    out.begin_record ();
+    out << Hex (0x400000 + i) << '\n';
+    out.end_record ();
+  }
+
+  return out.size ();
+}
+
+static UINT64 bench_fprintf (UINT64 iterations, size_t)
+{
+  FILE * file = ::fopen ("/dev/null", "w");
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+    ::fprintf (file, "0x%lx\n", static_cast <unsigned long> (0x400000 + i));
+
+  ::fclose (file);
+  return iterations;
+}
+
+static UINT64 bench_ofstream (UINT64 iterations, size_t)
+{
+  std::ofstream file ("/dev/null");
+
+  for (UINT64 i = 0; i < iterations; ++ i)
+    file << "0x" << std::hex << (0x400000 + i) << std::endl;
+
+  return iterations;
+}
+
+/// The benchmarks, in the order they run.
+static const Benchmark BENCHMARKS [] =
+{
+  { "Callback <T (void)>",                      &bench_callback_void, 1 },
+  { "Callback <T (ARG_INST_PTR)>",              &bench_callback_ip, 1 },
+  { "Callback <T (3 args)>",                    &bench_callback_mem, 1 },
+  { "Buffer <Callback <T (ARG_INST_PTR)> >",    &bench_buffer_callback_ip, 1 },
+  { "Static_Callback <T (ARG_INST_PTR)>",       &bench_static_callback_ip, 1 },
+  { "Counter <>",                               &bench_counter, 1 },
+  { "Counter <Sharded_Storage>",                &bench_sharded_counter, 1 },
+  { "Counter <Sharded_Storage> (4 threads)",    &bench_sharded_counter, 4 },
+  { "TLS::get ()",                              &bench_tls_get, 1 },
+  { "TLS::get (thr_id)",                        &bench_tls_get_thr_id, 1 },
+  { "TLS::get (thr_id) (4 threads)",            &bench_tls_get_thr_id, 4 },
+  { "Guard <Lock>",                             &bench_guard <Lock, Guard>, 1 },
+  { "Guard <Lock> (4 threads)",                 &bench_guard <Lock, Guard>, 4 },
+  { "Guard <Mutex>",                            &bench_guard <Mutex, Guard>, 1 },
+  { "Guard <Mutex> (4 threads)",                &bench_guard <Mutex, Guard>, 4 },
+  { "Read_Guard <RW_Mutex>",                    &bench_guard <RW_Mutex, Read_Guard>, 1 },
+  { "Read_Guard <RW_Mutex> (4 threads)",        &bench_guard <RW_Mutex, Read_Guard>, 4 },
+  { "Write_Guard <RW_Mutex>",                   &bench_guard <RW_Mutex, Write_Guard>, 1 },
+  { "Text_Buffer (itrace line)",                &bench_text_buffer, 1 },
+  { "fprintf (itrace line)",                    &bench_fprintf, 1 },
+  { "ofstream << std::endl (itrace line)",      &bench_ofstream, 1 },
+};
+
+int main (int argc, char * argv [])
+{
+  // usage: microbench [iterations] [repetitions] [filter]
+  const UINT64 iterations = argc > 1 ? ::strtoull (argv[1], 0, 10) : 10000000;
+  const size_t repetitions = argc > 2 ? ::strtoul (argv[2], 0, 10) : 5;
+  const char * filter = argc > 3 ? argv[3] : 0;
+
+  std::cout << std::left << std::setw (42) << "benchmark"
+            << std::right << std::setw (12) << "ns/op" << std::endl;
+
+  for (size_t i = 0; i < sizeof (BENCHMARKS) / sizeof (BENCHMARKS[0]); ++ i)
+  {
+    const Benchmark & benchmark = BENCHMARKS[i];
+
+    if (0 != filter && 0 == ::strstr (benchmark.name_, filter))
+      continue;
+
+    // The best of the repetitions is the least disturbed by the system.
+    double best = 0.0;
+
+    for (size_t r = 0; r < repetitions; ++ r)
+    {
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      sink += benchmark.run_ (iterations, benchmark.threads_);
+      const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+
+      const double ns = std::chrono::duration <double, std::nano> (end - start).count () / iterations;
+
+      if (0 == r || ns < best)
+        best = ns;
+    }
+
+    std::cout << std::left << std::setw (42) << benchmark.name_
+              << std::right << std::fixed << std::setprecision (2) << std::setw (12) << best << std::endl;
+  }
+
+  return 0;
+}
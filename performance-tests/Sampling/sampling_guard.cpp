@@ -0,0 +1,110 @@
+// $Id$
+
+#include "pin++/Instruction_Instrument.h"
+#include "pin++/Callback.h"
+#include "pin++/Constant_Sampling.h"
+#include "pin++/Per_Thread_Sampling.h"
+#include "pin++/Padded.h"
+#include "pin++/Pintool.h"
+
+#include <fstream>
+
+//
+// Pintool used to benchmark the sampling guards. Every instruction is
+// guarded by either the shared Constant_Sampling guard, or the per-thread
+// Per_Thread_Sampling guard (-guard shared|per_thread). The sampled
+// callback counts the samples taken by each thread.
+//
+class sample : public OASIS::Pin::Callback < sample (OASIS::Pin::ARG_THREAD_ID) >
+{
+public:
+  sample (void)
+    : samples_ (PIN_MAX_THREADS) { }
+
+  void handle_analyze (THREADID thr_id)
+  {
+    ++ this->samples_[thr_id];
+  }
+
+  UINT64 samples (void) const
+  {
+    UINT64 total = 0;
+
+    for (size_t i = 0; i < this->samples_.size (); ++ i)
+      total += this->samples_[i];
+
+    return total;
+  }
+
+private:
+  OASIS::Pin::Padded_Array <UINT64> samples_;
+};
+
+template <typename GUARD>
+class Instruction : public OASIS::Pin::Instruction_Instrument < Instruction <GUARD> >
+{
+public:
+  Instruction (size_t iters)
+    : guard_ (iters) { }
+
+  void handle_instrument (const OASIS::Pin::Ins & ins)
+  {
+    this->sample_[this->guard_].insert (IPOINT_BEFORE, ins);
+  }
+
+  UINT64 samples (void) const
+  {
+    return this->sample_.samples ();
+  }
+
+private:
+  GUARD guard_;
+  sample sample_;
+};
+
+class sampling_guard : public OASIS::Pin::Tool <sampling_guard>
+{
+public:
+  sampling_guard (void)
+    : shared_ (0),
+      per_thread_ (0)
+  {
+    if (guard_.Value () == "shared")
+      this->shared_ = new Instruction <OASIS::Pin::Constant_Sampling> (iters_.Value ());
+    else
+      this->per_thread_ = new Instruction <OASIS::Pin::Per_Thread_Sampling> (iters_.Value ());
+
+    this->enable_fini_callback ();
+  }
+
+  ~sampling_guard (void)
+  {
+    delete this->shared_;
+    delete this->per_thread_;
+  }
+
+  void handle_fini (INT32)
+  {
+    std::ofstream fout (outfile_.Value ().c_str ());
+    fout << "Guard " << guard_.Value () << std::endl
+         << "Samples " << (0 != this->shared_ ? this->shared_->samples () : this->per_thread_->samples ()) << std::endl;
+
+    fout.close ();
+  }
+
+private:
+  Instruction <OASIS::Pin::Constant_Sampling> * shared_;
+  Instruction <OASIS::Pin::Per_Thread_Sampling> * per_thread_;
+
+  /// @{ KNOBS
+  static KNOB <string> outfile_;
+  static KNOB <string> guard_;
+  static KNOB <UINT32> iters_;
+  /// @}
+};
+
+KNOB <string> sampling_guard::outfile_ (KNOB_MODE_WRITEONCE, "pintool", "o", "sampling_guard.out", "specify output file name");
+KNOB <string> sampling_guard::guard_ (KNOB_MODE_WRITEONCE, "pintool", "guard", "per_thread", "sampling guard (shared|per_thread)");
+KNOB <UINT32> sampling_guard::iters_ (KNOB_MODE_WRITEONCE, "pintool", "iters", "1000", "iterations between samples");
+
+DECLARE_PINTOOL (sampling_guard);
@@ -0,0 +1,46 @@
+// $Id$
+
+//
+// Multithreaded workload for the sampling benchmark. Each thread executes
+// the same compute-bound loop so the number of instrumented instructions
+// grows linearly with the number of threads.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static volatile unsigned long sink = 0;
+
+static void worker (unsigned long iterations)
+{
+  unsigned long value = 0;
+
+  for (unsigned long i = 0; i < iterations; ++ i)
+    value += (i ^ (value << 1)) & 0xFF;
+
+  sink += value;
+}
+
+int main (int argc, char * argv [])
+{
+  if (argc != 3)
+  {
+    std::cerr << "usage: " << argv[0] << " <threads> <iterations>" << std::endl;
+    return 1;
+  }
+
+  size_t threads = ::strtoul (argv[1], 0, 10);
+  unsigned long iterations = ::strtoul (argv[2], 0, 10);
+
+  std::vector <std::thread> pool;
+
+  for (size_t i = 0; i < threads; ++ i)
+    pool.push_back (std::thread (worker, iterations));
+
+  for (std::thread & t : pool)
+    t.join ();
+
+  return 0;
+}
@@ -0,0 +1,63 @@
+// $Id$
+
+//
+// Many-thread contention workload. The threads repeatedly update a
+// shared counter under a mutex, and a shared atomic counter, with a
+// little private work in between. The application scales poorly on its
+// own, which exposes tools whose analysis routines add more sharing
+// (e.g., a shared counter, lock, or buffer) on top of it.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static std::mutex lock;
+
+static unsigned long shared_total = 0;
+
+static std::atomic <unsigned long> shared_count (0);
+
+static void worker (size_t id, unsigned long iterations)
+{
+  unsigned long value = id;
+
+  for (unsigned long i = 0; i < iterations; ++ i)
+  {
+    value = value * 6364136223846793005UL + 1442695040888963407UL;
+
+    if (0 == (i & 7))
+    {
+      std::lock_guard <std::mutex> guard (lock);
+      shared_total += value >> 60;
+    }
+
+    shared_count.fetch_add (1, std::memory_order_relaxed);
+  }
+}
+
+int main (int argc, char * argv [])
+{
+  if (argc > 3)
+  {
+    std::cerr << "usage: " << argv[0] << " [threads] [iterations]" << std::endl;
+    return 1;
+  }
+
+  const size_t threads = argc > 1 ? ::strtoul (argv[1], 0, 10) : 16;
+  const unsigned long iterations = argc > 2 ? ::strtoul (argv[2], 0, 10) : 1000000;
+
+  std::vector <std::thread> pool;
+
+  for (size_t i = 0; i < threads; ++ i)
+    pool.push_back (std::thread (worker, i, iterations));
+
+  for (std::thread & t : pool)
+    t.join ();
+
+  std::cout << shared_total << ' ' << shared_count.load () << std::endl;
+  return 0;
+}
@@ -0,0 +1,94 @@
+// $Id$
+
+//
+// JIT-stress workload. The program contains 2048 small, distinct
+// functions, so Pin spends much of its time translating and instrumenting
+// new traces instead of running them from the code cache. Use it to
+// measure the instrumentation-time cost of a tool (e.g., its
+// handle_instrument () and symbol lookups). By default, each function
+// runs once, so almost all the time under Pin is spent translating it.
+// More rounds shift the time to running the functions from the code
+// cache.
+//
+
+#include <cstdlib>
+#include <iostream>
+
+#if defined (_MSC_VER)
+  #define WORKLOAD_NOINLINE __declspec (noinline)
+#else
+  #define WORKLOAD_NOINLINE __attribute__ ((noinline))
+#endif
+
+/// Number of distinct functions in the program.
+static const int MAX_FUNCTIONS = 2048;
+
+typedef unsigned long (* function_type) (unsigned long);
+
+/**
+ * A small function with two basic blocks. The constants depend on I so
+ * the compiler and linker cannot fold the functions together.
+ */
+template <int I>
+WORKLOAD_NOINLINE
+unsigned long small_function (unsigned long x)
+{
+  if (x & 1)
+    x ^= I;
+
+  return x * (2 * I + 1) + I;
+}
+
+/**
+ * @struct Function_Table
+ *
+ * Fills a table with the functions in [BEGIN, BEGIN + COUNT). The range
+ * is split in halves so the depth of the instantiations is logarithmic.
+ */
+template <int BEGIN, int COUNT>
+struct Function_Table
+{
+  static void fill (function_type * table)
+  {
+    Function_Table <BEGIN, COUNT / 2>::fill (table);
+    Function_Table <BEGIN + COUNT / 2, COUNT - COUNT / 2>::fill (table);
+  }
+};
+
+template <int BEGIN>
+struct Function_Table <BEGIN, 1>
+{
+  static void fill (function_type * table)
+  {
+    table[BEGIN] = &small_function <BEGIN>;
+  }
+};
+
+int main (int argc, char * argv [])
+{
+  if (argc > 3)
+  {
+    std::cerr << "usage: " << argv[0] << " [functions (max " << MAX_FUNCTIONS << ")] [rounds]" << std::endl;
+    return 1;
+  }
+
+  size_t functions = argc > 1 ? ::strtoul (argv[1], 0, 10) : MAX_FUNCTIONS;
+  const size_t rounds = argc > 2 ? ::strtoul (argv[2], 0, 10) : 1;
+
+  if (functions > static_cast <size_t> (MAX_FUNCTIONS))
+    functions = MAX_FUNCTIONS;
+
+  static function_type table[MAX_FUNCTIONS];
+  Function_Table <0, MAX_FUNCTIONS>::fill (table);
+
+  unsigned long checksum = 0;
+
+  for (size_t round = 0; round < rounds; ++ round)
+  {
+    for (size_t i = 0; i < functions; ++ i)
+      checksum = table[i] (checksum + round);
+  }
+
+  std::cout << checksum << std::endl;
+  return 0;
+}
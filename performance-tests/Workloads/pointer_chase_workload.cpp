@@ -0,0 +1,82 @@
+// $Id$
+
+//
+// Pointer-chasing workload. The nodes form a single random cycle, so
+// each load depends on the previous one and misses the cache once the
+// nodes do not fit. Every node is on its own cache line. Use it to
+// measure tools that instrument memory reads when the application is
+// latency bound rather than bandwidth bound.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @struct Node
+ *
+ * Node in the cycle, padded to a cache line.
+ */
+struct Node
+{
+  Node * next_;
+
+  unsigned long value_;
+
+  char padding_[64 - sizeof (Node *) - sizeof (unsigned long)];
+};
+
+/// Deterministic xorshift generator, so every run chases the same cycle.
+static unsigned long next_random (unsigned long & state)
+{
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+
+  return state;
+}
+
+int main (int argc, char * argv [])
+{
+  if (argc > 3)
+  {
+    std::cerr << "usage: " << argv[0] << " [nodes] [steps]" << std::endl;
+    return 1;
+  }
+
+  const size_t nodes = argc > 1 ? ::strtoul (argv[1], 0, 10) : 1 << 20;
+  const size_t steps = argc > 2 ? ::strtoul (argv[2], 0, 10) : 5000000;
+
+  if (0 == nodes)
+    return 1;
+
+  // Sattolo's algorithm produces a permutation that is a single cycle.
+  std::vector <size_t> order (nodes);
+  unsigned long state = 88172645463325252UL;
+
+  for (size_t i = 0; i < nodes; ++ i)
+    order[i] = i;
+
+  for (size_t i = nodes - 1; i > 0; -- i)
+    std::swap (order[i], order[next_random (state) % i]);
+
+  std::vector <Node> pool (nodes);
+
+  for (size_t i = 0; i < nodes; ++ i)
+  {
+    pool[i].next_ = &pool[order[i]];
+    pool[i].value_ = i;
+  }
+
+  const Node * node = &pool[0];
+  unsigned long checksum = 0;
+
+  for (size_t i = 0; i < steps; ++ i)
+  {
+    checksum += node->value_;
+    node = node->next_;
+  }
+
+  std::cout << checksum << std::endl;
+  return 0;
+}
@@ -0,0 +1,51 @@
+// $Id$
+
+//
+// Call-heavy workload. The naive recursive Fibonacci function executes
+// about 2 * fib (n) calls and returns of a tiny routine, so the cost of
+// instrumenting routine entry and exit, and calls and returns, dominates.
+// The recursive calls go through a volatile pointer; otherwise, the
+// compiler turns one of them into a loop.
+//
+
+#include <cstdlib>
+#include <iostream>
+
+#if defined (_MSC_VER)
+  #define WORKLOAD_NOINLINE __declspec (noinline)
+#else
+  #define WORKLOAD_NOINLINE __attribute__ ((noinline))
+#endif
+
+typedef unsigned long (* fibonacci_type) (unsigned long);
+
+WORKLOAD_NOINLINE
+static unsigned long fibonacci (unsigned long n);
+
+/// The function called by the recursion.
+static fibonacci_type volatile recurse = &fibonacci;
+
+unsigned long fibonacci (unsigned long n)
+{
+  return n < 2 ? n : recurse (n - 1) + recurse (n - 2);
+}
+
+int main (int argc, char * argv [])
+{
+  if (argc > 3)
+  {
+    std::cerr << "usage: " << argv[0] << " [n] [repetitions]" << std::endl;
+    return 1;
+  }
+
+  const unsigned long n = argc > 1 ? ::strtoul (argv[1], 0, 10) : 32;
+  const size_t repetitions = argc > 2 ? ::strtoul (argv[2], 0, 10) : 10;
+
+  unsigned long checksum = 0;
+
+  for (size_t i = 0; i < repetitions; ++ i)
+    checksum += fibonacci (n);
+
+  std::cout << checksum << std::endl;
+  return 0;
+}
@@ -0,0 +1,46 @@
+// $Id$
+
+//
+// Memory-streaming workload. Each pass executes the STREAM triad
+// (a = b + s * c) over three arrays that are much larger than the
+// caches, so nearly every instruction is a sequential load or store.
+// Use it to measure tools that instrument memory accesses.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+int main (int argc, char * argv [])
+{
+  if (argc > 3)
+  {
+    std::cerr << "usage: " << argv[0] << " [megabytes per array] [passes]" << std::endl;
+    return 1;
+  }
+
+  const size_t megabytes = argc > 1 ? ::strtoul (argv[1], 0, 10) : 64;
+  const size_t passes = argc > 2 ? ::strtoul (argv[2], 0, 10) : 10;
+  const size_t count = megabytes * 1024 * 1024 / sizeof (double);
+
+  std::vector <double> a (count, 0.0), b (count, 1.0), c (count, 2.0);
+
+  for (size_t pass = 0; pass < passes; ++ pass)
+  {
+    const double scalar = 1.0 + pass;
+
+    for (size_t i = 0; i < count; ++ i)
+      a[i] = b[i] + scalar * c[i];
+
+    // Feed the result into the next pass.
+    a.swap (b);
+  }
+
+  double checksum = 0.0;
+
+  for (size_t i = 0; i < count; i += 4096)
+    checksum += b[i];
+
+  std::cout << checksum << std::endl;
+  return 0;
+}
@@ -0,0 +1,67 @@
+// $Id$
+
+//
+// Syscall-heavy workload. Each iteration writes a small block to a
+// temporary file, seeks back, and reads it again, so the application
+// spends most of its time entering and leaving the kernel. Use it to
+// measure tools that instrument system calls (e.g., strace).
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+int main (int argc, char * argv [])
+{
+  if (argc > 3)
+  {
+    std::cerr << "usage: " << argv[0] << " [iterations] [block size]" << std::endl;
+    return 1;
+  }
+
+  const size_t iterations = argc > 1 ? ::strtoul (argv[1], 0, 10) : 200000;
+  const size_t block_size = argc > 2 ? ::strtoul (argv[2], 0, 10) : 64;
+
+  char path[] = "/tmp/syscall_workload.XXXXXX";
+  int fd = ::mkstemp (path);
+
+  if (-1 == fd)
+  {
+    std::cerr << "ERROR: failed to create a temporary file" << std::endl;
+    return 1;
+  }
+
+  // The file is removed when it is closed.
+  ::unlink (path);
+
+  char * block = new char [block_size + 1];
+  ::memset (block, 'x', block_size);
+
+  unsigned long checksum = 0;
+
+  for (size_t i = 0; i < iterations; ++ i)
+  {
+    block[0] = static_cast <char> (i);
+
+    if (::write (fd, block, block_size) != static_cast <ssize_t> (block_size) ||
+        ::lseek (fd, 0, SEEK_SET) != 0 ||
+        ::read (fd, block, block_size) != static_cast <ssize_t> (block_size) ||
+        ::lseek (fd, 0, SEEK_SET) != 0)
+    {
+      std::cerr << "ERROR: I/O failed" << std::endl;
+      return 1;
+    }
+
+    checksum += static_cast <unsigned char> (block[0]);
+  }
+
+  delete [] block;
+  ::close (fd);
+
+  std::cout << checksum << std::endl;
+  return 0;
+}
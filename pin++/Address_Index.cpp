@@ -0,0 +1,132 @@
+// $Id$
+
+#include "Address_Index.h"
+
+#include <algorithm>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+const Address_Index::Routine_Range *
+Address_Index::Image_Range::find (ADDRINT addr) const
+{
+  // Find the last routine that starts at or before the address.
+  size_t lo = 0, hi = this->routines_.size ();
+
+  while (lo < hi)
+  {
+    size_t mid = lo + (hi - lo) / 2;
+
+    if (this->routines_[mid].low_ <= addr)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (0 == lo)
+    return 0;
+
+  const Routine_Range & rtn = this->routines_[lo - 1];
+  return addr < rtn.high_ || addr == rtn.low_ ? &rtn : 0;
+}
+
+Address_Index::Address_Index (void)
+: current_ (new snapshot_type ())
+{
+  this->enable_unload_callback ();
+}
+
+Address_Index::~Address_Index (void)
+{
+  delete this->current_;
+
+  for (size_t i = 0; i < this->retired_.size (); ++ i)
+    delete this->retired_[i];
+
+  for (size_t i = 0; i < this->images_.size (); ++ i)
+    delete this->images_[i];
+}
+
+const Address_Index::Image_Range * Address_Index::find_image (ADDRINT addr) const
+{
+  const snapshot_type & images = *ATOMIC::OPS::Load (&this->current_, ATOMIC::BARRIER_LD_NEXT);
+
+  // Find the last image that starts at or before the address.
+  size_t lo = 0, hi = images.size ();
+
+  while (lo < hi)
+  {
+    size_t mid = lo + (hi - lo) / 2;
+
+    if (images[mid]->low_ <= addr)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (0 == lo || addr > images[lo - 1]->high_)
+    return 0;
+
+  return images[lo - 1];
+}
+
+void Address_Index::handle_instrument (const Image & img)
+{
+  // Pin serializes the image callbacks, so only the readers race with
+  // this method.
+  Image_Range * image = new Image_Range ();
+  image->low_ = img.low_address ();
+  image->high_ = img.high_address ();
+  image->id_ = img.id ();
+  image->name_ = img.name ();
+
+  for (Section::iterator_type sec = img.begin (), sec_end = img.end (); sec != sec_end; ++ sec)
+  {
+    for (Routine::iterator_type rtn = sec->begin (), rtn_end = sec->end (); rtn != rtn_end; ++ rtn)
+    {
+      Routine_Range range;
+      range.low_ = rtn->address ();
+      range.high_ = range.low_ + rtn->size ();
+      range.id_ = rtn->id ();
+      range.name_ = rtn->name ();
+
+      image->routines_.push_back (range);
+    }
+  }
+
+  std::stable_sort (image->routines_.begin (), image->routines_.end (), &Address_Index::lower_routine);
+  this->images_.push_back (image);
+
+  snapshot_type * snapshot = new snapshot_type (*this->current_);
+  snapshot->insert (std::upper_bound (snapshot->begin (), snapshot->end (), image, &Address_Index::lower_image), image);
+
+  this->publish (snapshot);
+}
+
+void Address_Index::handle_unload (const Image & img)
+{
+  const UINT32 id = img.id ();
+  snapshot_type * snapshot = new snapshot_type ();
+  snapshot->reserve (this->current_->size ());
+
+  for (snapshot_type::const_iterator iter = this->current_->begin (); iter != this->current_->end (); ++ iter)
+  {
+    if ((*iter)->id_ != id)
+      snapshot->push_back (*iter);
+  }
+
+  this->publish (snapshot);
+}
+
+void Address_Index::publish (snapshot_type * snapshot)
+{
+  // This is the only writer, so the old snapshot can be read directly.
+  snapshot_type * old = this->current_;
+  this->retired_.push_back (old);
+  ATOMIC::OPS::Store (&this->current_, snapshot, ATOMIC::BARRIER_ST_PREV);
+}
+
+} // namespace OASIS
+} // namespace Pin
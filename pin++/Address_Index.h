@@ -0,0 +1,171 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Address_Index.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_ADDRESS_INDEX_H_
+#define _OASIS_PIN_ADDRESS_INDEX_H_
+
+#include "pin.H"
+#include "atomic.hpp"
+
+#include "Pin_export.h"
+#include "Image_Instrument.h"
+
+#include <string>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Address_Index
+ *
+ * Index of the address ranges of the loaded images, and the routines in
+ * each image. It resolves an address to its image and routine from
+ * analysis code without PIN_LockClient (), unlike Image::find_by_address (),
+ * Routine::find (), and Routine::find_name (), which serialize all the
+ * application threads on the client lock.
+ *
+ * The index is built when an image is loaded, and updated when an image is
+ * unloaded. Each update publishes a new, immutable snapshot of the images
+ * with an atomic pointer swap. A lookup loads the current snapshot, and
+ * does a binary search over the images, and then over the routines of the
+ * image. The routine table of an image is built once when the image is
+ * loaded, and shared by all later snapshots.
+ *
+ * The ranges returned by a lookup are valid until the index is destroyed.
+ * A reader may still hold an old snapshot after an update, so replaced
+ * snapshots and the ranges of unloaded images are retired, and deleted
+ * with the index. A snapshot is one pointer per image, so this costs
+ * little since images are rarely loaded and unloaded.
+ *
+ * The index must be created before the images are loaded, i.e., in the
+ * constructor of the tool. Symbols must be initialized for routines to be
+ * found.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Address_Index :
+  public Image_Instrument <Address_Index>
+{
+public:
+  /**
+   * @struct Routine_Range
+   *
+   * Address range of a routine.
+   */
+  struct Routine_Range
+  {
+    /// Address of the routine.
+    ADDRINT low_;
+
+    /// Address after the last byte of the routine.
+    ADDRINT high_;
+
+    /// Id of the routine.
+    INT32 id_;
+
+    /// Name of the routine.
+    std::string name_;
+  };
+
+  /**
+   * @struct Image_Range
+   *
+   * Address range of an image, and its routines sorted by address.
+   */
+  struct Image_Range
+  {
+    /// Lowest address of the image.
+    ADDRINT low_;
+
+    /// Highest address of the image.
+    ADDRINT high_;
+
+    /// Id of the image.
+    UINT32 id_;
+
+    /// Name of the image.
+    std::string name_;
+
+    /// Routines of the image.
+    std::vector <Routine_Range> routines_;
+
+    /// Find the routine that contains an address, or 0.
+    const Routine_Range * find (ADDRINT addr) const;
+  };
+
+  /// Default constructor.
+  Address_Index (void);
+
+  /// Destructor.
+  ~Address_Index (void);
+
+  /**
+   * Find the image that contains an address.
+   *
+   * @param[in]       addr            The address
+   * @return          The image, or 0 if no loaded image contains the address
+   */
+  const Image_Range * find_image (ADDRINT addr) const;
+
+  /**
+   * Find the routine that contains an address.
+   *
+   * @param[in]       addr            The address
+   * @return          The routine, or 0 if no known routine contains the address
+   */
+  const Routine_Range * find_routine (ADDRINT addr) const;
+
+  /// Number of loaded images.
+  size_t image_count (void) const;
+
+  /// Add an image to the index.
+  void handle_instrument (const Image & img);
+
+  /// Remove an image from the index.
+  void handle_unload (const Image & img);
+
+private:
+  /// Type definition of a snapshot of the images, sorted by address.
+  typedef std::vector <const Image_Range *> snapshot_type;
+
+  /// Order routines by address.
+  static bool lower_routine (const Routine_Range & lhs, const Routine_Range & rhs);
+
+  /// Order images by address.
+  static bool lower_image (const Image_Range * lhs, const Image_Range * rhs);
+
+  /// Make a snapshot the current snapshot, and retire the old one.
+  void publish (snapshot_type * snapshot);
+
+  /// The current snapshot.
+  snapshot_type * volatile current_;
+
+  /// Replaced snapshots.
+  std::vector <snapshot_type *> retired_;
+
+  /// Ranges of all the images, loaded or unloaded.
+  std::vector <Image_Range *> images_;
+
+  // prevent the following operations
+  Address_Index (const Address_Index &);
+  const Address_Index & operator = (const Address_Index &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Address_Index.inl"
+
+#endif  // _OASIS_PIN_ADDRESS_INDEX_H_
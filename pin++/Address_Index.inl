@@ -0,0 +1,36 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+const Address_Index::Routine_Range *
+Address_Index::find_routine (ADDRINT addr) const
+{
+  const Image_Range * image = this->find_image (addr);
+  return 0 != image ? image->find (addr) : 0;
+}
+
+inline
+size_t Address_Index::image_count (void) const
+{
+  return ATOMIC::OPS::Load (&this->current_, ATOMIC::BARRIER_LD_NEXT)->size ();
+}
+
+inline
+bool Address_Index::lower_routine (const Routine_Range & lhs, const Routine_Range & rhs)
+{
+  return lhs.low_ < rhs.low_;
+}
+
+inline
+bool Address_Index::lower_image (const Image_Range * lhs, const Image_Range * rhs)
+{
+  return lhs->low_ < rhs->low_;
+}
+
+} // namespace OASIS
+} // namespace Pin
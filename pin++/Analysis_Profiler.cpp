@@ -0,0 +1,194 @@
+// $Id$
+
+#include "Analysis_Profiler.h"
+#include "Guard.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Default number of invocations between timed invocations.
+static const UINT32 ANALYSIS_PROFILER_SAMPLE_RATE = 1024;
+
+/**
+ * @struct Analysis_Profile_Entry
+ *
+ * A line of the report.
+ */
+struct Analysis_Profile_Entry
+{
+  const Analysis_Profile * profile_;
+
+  Analysis_Profile::Slot total_;
+
+  /// Estimated cycles of all the invocations.
+  double cycles_;
+
+  bool operator < (const Analysis_Profile_Entry & rhs) const
+  {
+    // The most expensive entries are first.
+    if (this->cycles_ != rhs.cycles_)
+      return this->cycles_ > rhs.cycles_;
+
+    return this->total_.calls_ > rhs.total_.calls_;
+  }
+};
+
+/// Readable name of a type from its typeid name.
+static std::string analysis_profile_name (const char * name)
+{
+#if defined (TARGET_WINDOWS)
+  return name;
+#else
+  // The typeid name is the mangled name of the type, without the prefix.
+  std::string undecorated = PIN_UndecorateSymbolName (std::string ("_Z") + name, UNDECORATION_COMPLETE);
+  return undecorated.empty () ? name : undecorated;
+#endif
+}
+
+Analysis_Profile::Analysis_Profile (const char * name)
+: name_ (name),
+  sample_mask_ (0),
+  sampling_ (false),
+  slots_ (PIN_MAX_THREADS)
+{
+  Analysis_Profiler::instance ().add (this);
+}
+
+void Analysis_Profile::sample_rate (UINT32 rate)
+{
+  UINT64 mask = 0;
+
+  while (mask + 1 < rate)
+    mask = (mask << 1) | 1;
+
+  this->sample_mask_ = mask;
+  this->sampling_ = 0 != rate;
+}
+
+Analysis_Profile::Slot Analysis_Profile::total (void) const
+{
+  Slot total;
+  total.calls_ = total.samples_ = total.cycles_ = 0;
+
+  for (size_t i = 0; i < this->slots_.size (); ++ i)
+  {
+    const Slot & slot = this->slots_[i];
+
+    total.calls_ += slot.calls_;
+    total.samples_ += slot.samples_;
+    total.cycles_ += slot.cycles_;
+  }
+
+  return total;
+}
+
+size_t Analysis_Profile::thread_count (void) const
+{
+  size_t count = 0;
+
+  for (size_t i = 0; i < this->slots_.size (); ++ i)
+  {
+    if (0 != this->slots_[i].calls_)
+      ++ count;
+  }
+
+  return count;
+}
+
+Analysis_Profiler & Analysis_Profiler::instance (void)
+{
+  static Analysis_Profiler profiler;
+  return profiler;
+}
+
+Analysis_Profiler::Analysis_Profiler (void)
+: sample_rate_ (ANALYSIS_PROFILER_SAMPLE_RATE),
+  output_ ("analysis_profile.out")
+{
+  PIN_AddFiniFunction (&Analysis_Profiler::__fini, this);
+}
+
+void Analysis_Profiler::sample_rate (UINT32 rate)
+{
+  Guard <Mutex> guard (this->lock_);
+  this->sample_rate_ = rate;
+
+  for (size_t i = 0; i < this->profiles_.size (); ++ i)
+    this->profiles_[i]->sample_rate (rate);
+}
+
+void Analysis_Profiler::add (Analysis_Profile * profile)
+{
+  Guard <Mutex> guard (this->lock_);
+
+  profile->sample_rate (this->sample_rate_);
+  this->profiles_.push_back (profile);
+}
+
+void Analysis_Profiler::report (std::ostream & out) const
+{
+  std::vector <Analysis_Profile_Entry> entries;
+  double total_cycles = 0.0;
+
+  {
+    Guard <Mutex> guard (this->lock_);
+
+    for (size_t i = 0; i < this->profiles_.size (); ++ i)
+    {
+      Analysis_Profile_Entry entry;
+      entry.profile_ = this->profiles_[i];
+      entry.total_ = entry.profile_->total ();
+      entry.cycles_ = 0 != entry.total_.samples_ ?
+        static_cast <double> (entry.total_.cycles_) / entry.total_.samples_ * entry.total_.calls_ : 0.0;
+
+      total_cycles += entry.cycles_;
+      entries.push_back (entry);
+    }
+  }
+
+  std::sort (entries.begin (), entries.end ());
+
+  out << "Pin++ analysis profile" << std::endl
+      << std::right
+      << std::setw (16) << "calls"
+      << std::setw (10) << "threads"
+      << std::setw (12) << "samples"
+      << std::setw (14) << "avg (cyc)"
+      << std::setw (16) << "est. (Mcyc)"
+      << std::setw (9) << "%"
+      << "  callback" << std::endl;
+
+  for (size_t i = 0; i < entries.size (); ++ i)
+  {
+    const Analysis_Profile_Entry & entry = entries[i];
+
+    out << std::right << std::fixed << std::setprecision (2)
+        << std::setw (16) << entry.total_.calls_
+        << std::setw (10) << entry.profile_->thread_count ()
+        << std::setw (12) << entry.total_.samples_
+        << std::setw (14) << (0 != entry.total_.samples_ ? static_cast <double> (entry.total_.cycles_) / entry.total_.samples_ : 0.0)
+        << std::setw (16) << entry.cycles_ / 1e6
+        << std::setw (9) << (0.0 != total_cycles ? entry.cycles_ * 100.0 / total_cycles : 0.0)
+        << "  " << analysis_profile_name (entry.profile_->name ()) << std::endl;
+  }
+
+  out << "Total estimated analysis time: " << total_cycles / 1e6 << " Mcycles" << std::endl;
+}
+
+VOID Analysis_Profiler::__fini (INT32, VOID * obj)
+{
+  Analysis_Profiler * profiler = reinterpret_cast <Analysis_Profiler *> (obj);
+  std::ofstream out (profiler->output_.c_str ());
+
+  if (out.is_open ())
+    profiler->report (out);
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,202 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Analysis_Profiler.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_ANALYSIS_PROFILER_H_
+#define _OASIS_PIN_ANALYSIS_PROFILER_H_
+
+#include "pin.H"
+#include "Mutex.h"
+#include "Padded.h"
+#include "Pin_export.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined (_MSC_VER)
+  #include <intrin.h>
+#else
+  #include <x86intrin.h>
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Analysis_Profile
+ *
+ * Profile of one callback type. Each thread counts the invocations of the
+ * callback's analysis routine in its own cache line aligned slot, and times
+ * every Nth invocation (the sample rate) with the time stamp counter. The
+ * profile is created by Profiled <CALLBACK>, and is never destroyed so it
+ * can be reported at fini.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Analysis_Profile
+{
+public:
+  /**
+   * @struct Slot
+   *
+   * The counters of one thread.
+   */
+  struct Slot
+  {
+    /// Number of invocations.
+    UINT64 calls_;
+
+    /// Number of timed invocations.
+    UINT64 samples_;
+
+    /// Total cycles of the timed invocations.
+    UINT64 cycles_;
+  };
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       name          Name of the callback type
+   */
+  explicit Analysis_Profile (const char * name);
+
+  /// Name of the callback type, as given by typeid.
+  const char * name (void) const;
+
+  /// Time every @a rate invocations; 0 disables timing.
+  void sample_rate (UINT32 rate);
+
+  /// Start an invocation. Returns the start time if it is sampled, else 0.
+  UINT64 enter (THREADID thr_id);
+
+  /// End a sampled invocation that started at @a start.
+  void leave (THREADID thr_id, UINT64 start);
+
+  /// Sum of the slots of all the threads.
+  Slot total (void) const;
+
+  /// Number of threads that invoked the callback.
+  size_t thread_count (void) const;
+
+private:
+  /// Name of the callback type.
+  const char * name_;
+
+  /// Invocations are sampled when (calls & mask) is 0.
+  UINT64 sample_mask_;
+
+  /// Timing is enabled.
+  bool sampling_;
+
+  /// The counters of each thread.
+  Padded_Array <Slot> slots_;
+
+  // prevent the following operations
+  Analysis_Profile (const Analysis_Profile &);
+  const Analysis_Profile & operator = (const Analysis_Profile &);
+};
+
+/**
+ * @class Analysis_Profiler
+ *
+ * Registry of the profiled callback types of the tool. At fini, the
+ * profiler writes a report of the types sorted by their estimated total
+ * cycles (calls times the average sampled cost), or by their calls if
+ * timing is disabled, so the analysis routines that dominate the overhead
+ * of the tool are at the top.
+ *
+ * The profiler is only used if OASIS_PIN_PROFILE_ANALYSIS is defined when
+ * building the tool. See Profiled <CALLBACK>.
+ */
+class OASIS_PIN_Export Analysis_Profiler
+{
+public:
+  /// The profiler of the tool. The report is written at fini.
+  static Analysis_Profiler & instance (void);
+
+  /// Current value of the time stamp counter.
+  static UINT64 cycles (void);
+
+  /// Set the file for the report. The default is analysis_profile.out.
+  void output (const std::string & filename);
+
+  /**
+   * Time every @a rate invocations of each callback; 0 disables timing.
+   * The rate is rounded up to a power of 2. The default is 1024.
+   */
+  void sample_rate (UINT32 rate);
+
+  /// Add a profile to the report.
+  void add (Analysis_Profile * profile);
+
+  /// Write the report.
+  void report (std::ostream & out) const;
+
+private:
+  /// Default constructor.
+  Analysis_Profiler (void);
+
+  /// Pin fini callback.
+  static VOID __fini (INT32 code, VOID * obj);
+
+  /// The registered profiles.
+  std::vector <Analysis_Profile *> profiles_;
+
+  /// Sample rate of the profiles.
+  UINT32 sample_rate_;
+
+  /// File for the report.
+  std::string output_;
+
+  /// Lock for the registered profiles.
+  mutable Mutex lock_;
+
+  // prevent the following operations
+  Analysis_Profiler (const Analysis_Profiler &);
+  const Analysis_Profiler & operator = (const Analysis_Profiler &);
+};
+
+/**
+ * @class Analysis_Profile_Scope
+ *
+ * Counts, and if sampled times, one invocation of an analysis routine.
+ */
+class Analysis_Profile_Scope
+{
+public:
+  /**
+   * Start the invocation.
+   *
+   * @param[in]       profile         Profile of the analysis routine
+   * @param[in]       thr_id          Thread invoking the routine
+   */
+  Analysis_Profile_Scope (Analysis_Profile & profile, THREADID thr_id);
+
+  /// End the invocation.
+  ~Analysis_Profile_Scope (void);
+
+private:
+  Analysis_Profile & profile_;
+
+  THREADID thr_id_;
+
+  UINT64 start_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Analysis_Profiler.inl"
+
+#endif  // _OASIS_PIN_ANALYSIS_PROFILER_H_
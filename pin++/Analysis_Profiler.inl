@@ -0,0 +1,64 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+const char * Analysis_Profile::name (void) const
+{
+  return this->name_;
+}
+
+inline
+UINT64 Analysis_Profile::enter (THREADID thr_id)
+{
+  Slot & slot = this->slots_[thr_id];
+
+  if (0 != (++ slot.calls_ & this->sample_mask_) || !this->sampling_)
+    return 0;
+
+  return Analysis_Profiler::cycles ();
+}
+
+inline
+void Analysis_Profile::leave (THREADID thr_id, UINT64 start)
+{
+  Slot & slot = this->slots_[thr_id];
+
+  ++ slot.samples_;
+  slot.cycles_ += Analysis_Profiler::cycles () - start;
+}
+
+inline
+UINT64 Analysis_Profiler::cycles (void)
+{
+  return __rdtsc ();
+}
+
+inline
+void Analysis_Profiler::output (const std::string & filename)
+{
+  this->output_ = filename;
+}
+
+inline
+Analysis_Profile_Scope::Analysis_Profile_Scope (Analysis_Profile & profile, THREADID thr_id)
+: profile_ (profile),
+  thr_id_ (thr_id),
+  start_ (profile.enter (thr_id_))
+{
+
+}
+
+inline
+Analysis_Profile_Scope::~Analysis_Profile_Scope (void)
+{
+  if (0 != this->start_)
+    this->profile_.leave (this->thr_id_, this->start_);
+}
+
+} // namespace OASIS
+} // namespace Pin
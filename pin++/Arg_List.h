@@ -96,6 +96,11 @@ DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_FUNCARG_CALLSITE_REFERENCE, int, ADDRI
 DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_SYSARG_VALUE, int, ADDRINT);
 DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_SYSARG_REFERENCE, int, ADDRINT *);
 
+DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_ADDRINT, ADDRINT, ADDRINT);
+DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_BOOL, BOOL, BOOL);
+DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_UINT32, UINT32, UINT32);
+DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_UINT64, UINT64, UINT64);
+
 //DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_SYSARG_CALLSITE_VALUE, int, ADDRINT);
 //DEFINE_TYPE_NODE_WITH_EXTRA_ARGUMENT (ARG_SYSARG_CALLSITE_REFERENCE, int, ADDRINT *);
 
@@ -108,6 +108,12 @@ DEFINE_ARG_TYPE (ARG_REG_OUTPUT_FRAME_REFERENCE  , ::IARG_REG_OUTPUT_FRAME_REFER
 
 DEFINE_ARG_TYPE (ARG_IARGLIST, ::IARG_IARGLIST , IARGLIST);
 
+// Constant values
+DEFINE_ARG_TYPE (ARG_ADDRINT, ::IARG_ADDRINT, ADDRINT);
+DEFINE_ARG_TYPE (ARG_BOOL, ::IARG_BOOL, BOOL);
+DEFINE_ARG_TYPE (ARG_UINT32, ::IARG_UINT32, UINT32);
+DEFINE_ARG_TYPE (ARG_UINT64, ::IARG_UINT64, UINT64);
+
 } // namespace Pin
 } // namespace OASIS
 
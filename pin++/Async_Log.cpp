@@ -0,0 +1,476 @@
+// $Id$
+
+#include "Async_Log.h"
+#include "Guard.h"
+#include "Semaphore.h"
+
+#include "atomic.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Largest width, and precision, of a %f or %g conversion, plus one.
+static const int MAX_FLOAT_FIELD = 32;
+
+/**
+ * @struct Async_Log::Format
+ *
+ * A format split into segments of literal text, each followed by one
+ * conversion.
+ */
+struct Async_Log::Format
+{
+  struct Segment
+  {
+    /// Text in front of the conversion.
+    std::string text_;
+
+    /// The conversion, or 0 for the text at the end of the format.
+    char conversion_;
+
+    /// Minimum width of a %f or %g conversion, or -1.
+    int width_;
+
+    /// Precision of a %f or %g conversion, or -1.
+    int precision_;
+  };
+
+  std::vector <Segment> segments_;
+};
+
+/**
+ * @struct Async_Log::Flush_Request
+ *
+ * A flush request on the stack of the thread that calls flush (). The
+ * thread waits on the semaphore, but it only returns once the writer sets
+ * the done flag, which is the writer's last access to the request.
+ */
+struct Async_Log::Flush_Request
+{
+  Flush_Request (void)
+    : done_ (0)
+  {
+
+  }
+
+  /// Set when the request is written.
+  Semaphore written_;
+
+  /// The writer no longer uses the request.
+  volatile UINT32 done_;
+};
+
+Async_Log::Async_Log (FILE * file, size_t capacity)
+: queue_ (capacity),
+  out_ (file, false),
+  format_count_ (1),
+  writer_ (0),
+  stopped_ (false),
+  failed_ (false)
+{
+  for (size_t i = 0; i < MAX_FORMATS; ++ i)
+    this->formats_[i] = 0;
+}
+
+Async_Log::~Async_Log (void)
+{
+  this->close ();
+
+  for (size_t i = 0; i < MAX_FORMATS; ++ i)
+    delete this->formats_[i];
+}
+
+void Async_Log::Writer::run (void)
+{
+  this->log_.svc ();
+}
+
+bool Async_Log::open (void)
+{
+  Guard <Mutex> guard (this->lock_);
+
+  if (0 != this->writer_)
+    return false;
+
+  this->stopped_ = false;
+
+  // The writer is set before it starts, so an application thread with a
+  // full queue does not write the records at the same time.
+  Writer * writer = new Writer (*this);
+  this->writer_ = writer;
+
+  if (writer->start () != Thread::ERROR)
+    return true;
+
+  this->writer_ = 0;
+  delete writer;
+
+  return false;
+}
+
+bool Async_Log::close (void)
+{
+  // The lock is held while waiting for the writer, so concurrent calls
+  // to close () do not delete the writer twice. The writer thread never
+  // takes the lock, and application threads only take it once the writer
+  // is gone.
+  Guard <Mutex> guard (this->lock_);
+
+  Writer * writer = this->writer_;
+
+  if (0 != writer)
+  {
+    this->stopped_ = true;
+    this->queue_.notify ();
+    writer->wait ();
+
+    this->writer_ = 0;
+    delete writer;
+  }
+
+  // Write the records that were queued after the writer exited.
+  this->drain ();
+
+  return !this->failed_;
+}
+
+UINT32 Async_Log::register_format (const char * format)
+{
+  Format * parsed = new Format;
+  Format::Segment segment;
+  size_t args = 0;
+
+  for (const char * iter = format; '\0' != *iter; ++ iter)
+  {
+    if ('%' != *iter)
+    {
+      segment.text_ += *iter;
+      continue;
+    }
+
+    ++ iter;
+
+    if ('%' == *iter)
+    {
+      segment.text_ += '%';
+      continue;
+    }
+
+    // The floating point conversions take a width and a precision.
+    segment.width_ = -1;
+    segment.precision_ = -1;
+
+    if ('0' <= *iter && *iter <= '9')
+    {
+      segment.width_ = 0;
+
+      for (; '0' <= *iter && *iter <= '9' && segment.width_ < MAX_FLOAT_FIELD; ++ iter)
+        segment.width_ = segment.width_ * 10 + (*iter - '0');
+    }
+
+    if ('.' == *iter)
+    {
+      segment.precision_ = 0;
+
+      for (++ iter; '0' <= *iter && *iter <= '9' && segment.precision_ < MAX_FLOAT_FIELD; ++ iter)
+        segment.precision_ = segment.precision_ * 10 + (*iter - '0');
+    }
+
+    const bool has_options = -1 != segment.width_ || -1 != segment.precision_;
+
+    if ('\0' == *iter || 0 == ::strchr ("diuxpcfgts", *iter) || Log_Record::MAX_ARGS == args ||
+        (has_options && 'f' != *iter && 'g' != *iter) ||
+        segment.width_ >= MAX_FLOAT_FIELD || segment.precision_ >= MAX_FLOAT_FIELD)
+    {
+      delete parsed;
+      return INVALID_FORMAT;
+    }
+
+    segment.conversion_ = *iter;
+    parsed->segments_.push_back (segment);
+
+    segment.text_.clear ();
+    ++ args;
+  }
+
+  if (!segment.text_.empty ())
+  {
+    segment.conversion_ = 0;
+    parsed->segments_.push_back (segment);
+  }
+
+  Guard <Mutex> guard (this->lock_);
+
+  if (MAX_FORMATS == this->format_count_)
+  {
+    delete parsed;
+    return INVALID_FORMAT;
+  }
+
+  // The writer reads the format by id, so the format is stored before
+  // the id is known to the analysis routines.
+  this->formats_[this->format_count_] = parsed;
+  return static_cast <UINT32> (this->format_count_ ++);
+}
+
+void Async_Log::log_text (UINT32 format, const char * text)
+{
+  Log_Record record;
+  record.format_ = format;
+
+  const size_t length = 0 != text ? ::strlen (text) : 0;
+
+  if (length <= MAX_INLINE_TEXT)
+  {
+    record.flags_ = INLINE_TEXT;
+
+    char * inline_text = reinterpret_cast <char *> (record.args_);
+
+    if (0 != length)
+      ::memcpy (inline_text, text, length);
+
+    inline_text[length] = '\0';
+  }
+  else
+  {
+    // The writer deletes the copy once it is written.
+    char * heap_text = new char [length + 1];
+    ::memcpy (heap_text, text, length + 1);
+
+    record.flags_ = HEAP_TEXT;
+    record.args_[0] = reinterpret_cast <ADDRINT> (heap_text);
+  }
+
+  this->enqueue (record);
+}
+
+bool Async_Log::flush (void)
+{
+  if (0 != this->writer_)
+  {
+    // The records are written in order, so the previous records are
+    // written once the writer signals the flush request.
+    Flush_Request request;
+
+    Log_Record record;
+    record.format_ = INVALID_FORMAT;
+    record.flags_ = FLUSH;
+    record.args_[0] = reinterpret_cast <ADDRINT> (&request);
+
+    this->enqueue (record);
+
+    // The writer can be closed before it reaches the request. The request
+    // is then written by this thread.
+    for (;;)
+    {
+      request.written_.wait (100);
+
+      if (0 != ATOMIC::OPS::Load (&request.done_, ATOMIC::BARRIER_LD_NEXT))
+        break;
+
+      Guard <Mutex> guard (this->lock_);
+
+      if (0 == this->writer_)
+        this->drain ();
+    }
+  }
+  else
+  {
+    Guard <Mutex> guard (this->lock_);
+    this->drain ();
+  }
+
+  return !this->failed_;
+}
+
+void Async_Log::overflow (const Log_Record & record)
+{
+  for (;;)
+  {
+    if (0 != this->writer_)
+    {
+      Thread::yield ();
+    }
+    else
+    {
+      Guard <Mutex> guard (this->lock_);
+
+      // Check again, since the writer may have started.
+      if (0 == this->writer_)
+        this->drain ();
+    }
+
+    if (this->queue_.try_push (record))
+      return;
+  }
+}
+
+void Async_Log::svc (void)
+{
+  static const size_t BATCH_SIZE = 64;
+  Log_Record records[BATCH_SIZE];
+
+  for (;;)
+  {
+    const size_t count = this->queue_.pop (records, BATCH_SIZE);
+
+    for (size_t i = 0; i < count; ++ i)
+      this->write (records[i]);
+
+    if (0 != count)
+      continue;
+
+    // Check the flag before the queue so the last records are not lost.
+    if (this->stopped_ && this->queue_.is_empty ())
+      break;
+
+    this->write_file ();
+    this->queue_.wait (100);
+  }
+
+  this->write_file ();
+}
+
+void Async_Log::drain (void)
+{
+  Log_Record record;
+
+  while (this->queue_.try_pop (record))
+    this->write (record);
+
+  this->write_file ();
+}
+
+void Async_Log::write_file (void)
+{
+  if (!this->out_.flush ())
+    this->failed_ = true;
+}
+
+void Async_Log::write (const Log_Record & record)
+{
+  if (0 != (record.flags_ & FLUSH))
+  {
+    this->write_file ();
+
+    // The request is on the stack of the thread that called flush (), so
+    // it must not be used after the done flag is set.
+    Flush_Request * request =
+      reinterpret_cast <Flush_Request *> (static_cast <ADDRINT> (record.args_[0]));
+
+    request->written_.set ();
+    ATOMIC::OPS::Store (&request->done_, static_cast <UINT32> (1), ATOMIC::BARRIER_ST_PREV);
+    return;
+  }
+
+  const char * text = 0;
+
+  if (0 != (record.flags_ & INLINE_TEXT))
+    text = reinterpret_cast <const char *> (record.args_);
+  else if (0 != (record.flags_ & HEAP_TEXT))
+    text = reinterpret_cast <const char *> (static_cast <ADDRINT> (record.args_[0]));
+
+  const Format * format = record.format_ < MAX_FORMATS ? this->formats_[record.format_] : 0;
+
+  if (0 != format)
+  {
+    const std::vector <Format::Segment> & segments = format->segments_;
+    const UINT64 * arg = record.args_;
+
+    for (size_t i = 0; i < segments.size (); ++ i)
+    {
+      const Format::Segment & segment = segments[i];
+      this->out_.write (segment.text_);
+
+      // The conversions of a text record are replaced by its text.
+      if (0 != text)
+      {
+        if (0 != segment.conversion_)
+          this->out_.write (text);
+
+        continue;
+      }
+
+      switch (segment.conversion_)
+      {
+      case 'd':
+      case 'i':
+        this->out_.write_dec (static_cast <INT64> (*arg ++));
+        break;
+
+      case 'u':
+        this->out_.write_dec (*arg ++);
+        break;
+
+      case 'x':
+        this->out_.write_hex (*arg ++, false);
+        break;
+
+      case 'p':
+        this->out_.write_hex (*arg ++, true);
+        break;
+
+      case 'c':
+        this->out_.write (static_cast <char> (*arg ++));
+        break;
+
+      case 'f':
+      case 'g':
+        {
+          double value;
+          ::memcpy (&value, arg ++, sizeof (value));
+
+          const int width = -1 != segment.width_ ? segment.width_ : 0;
+          const int precision = -1 != segment.precision_ ? segment.precision_ : 6;
+
+          // Large enough for any double in fixed notation.
+          char str[384];
+          const int length = 'f' == segment.conversion_ ?
+            ::snprintf (str, sizeof (str), "%*.*f", width, precision, value) :
+            ::snprintf (str, sizeof (str), "%*.*g", width, precision, value);
+
+          if (length > 0)
+            this->out_.write (str, static_cast <size_t> (length) < sizeof (str) ? length : sizeof (str) - 1);
+        }
+        break;
+
+      case 't':
+        {
+          const time_t now = static_cast <time_t> (*arg ++);
+          struct tm local;
+
+#if defined (_MSC_VER)
+          ::localtime_s (&local, &now);
+#else
+          ::localtime_r (&now, &local);
+#endif
+
+          char str[64];
+          const size_t length = ::strftime (str, sizeof (str), "%Y-%m-%d.%X", &local);
+          this->out_.write (str, length);
+        }
+        break;
+
+      case 's':
+        {
+          const char * str = reinterpret_cast <const char *> (static_cast <ADDRINT> (*arg ++));
+          this->out_.write (0 != str ? str : "(null)");
+        }
+        break;
+      }
+    }
+  }
+
+  if (0 != (record.flags_ & HEAP_TEXT))
+    delete [] text;
+}
+
+} // namespace OASIS
+} // namespace Pin
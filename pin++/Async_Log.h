@@ -0,0 +1,283 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Async_Log.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_ASYNC_LOG_H_
+#define _OASIS_PIN_ASYNC_LOG_H_
+
+#include "pin.H"
+#include "Pin_export.h"
+
+#include "Event_Queue.h"
+#include "Mutex.h"
+#include "Text_Buffer.h"
+#include "Thread.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Log_Record
+ *
+ * A message of an Async_Log as it is queued: the id of its format, and
+ * its arguments as raw words. With the sequence number of its slot in the
+ * Event_Queue, a record fills one cache line.
+ */
+struct Log_Record
+{
+  /// Number of arguments in a record.
+  static const size_t MAX_ARGS = 6;
+
+  /// Id of the format, from Async_Log::register_format ().
+  UINT32 format_;
+
+  /// What the arguments hold (see Async_Log).
+  UINT32 flags_;
+
+  /// The arguments, or the text of a text record.
+  UINT64 args_[MAX_ARGS];
+};
+
+/**
+ * @class Async_Log
+ *
+ * Log with deferred formatting. The format strings are registered once,
+ * e.g., at instrumentation time, and the analysis routines only log the
+ * id of a format with its raw arguments. The record is pushed onto an
+ * Event_Queue, and a Pin internal thread formats the records into a
+ * Text_Buffer and writes them to the file. An application thread pays for
+ * copying a few words per message instead of for the formatting and the
+ * I/O.
+ *
+ * @code
+ * UINT32 id = log.register_format ("%p: read %u bytes at %p\n");
+ *
+ * log.open ();                      // in the constructor of the tool
+ * log.log (id, ip, size, addr);     // in an analysis routine
+ * log.close ();                     // in handle_fini_unlocked ()
+ * @endcode
+ *
+ * The formats use a subset of printf. Each conversion takes one argument:
+ *
+ * - %d, %i: signed decimal
+ * - %u: unsigned decimal
+ * - %x: hexadecimal
+ * - %p: hexadecimal with a 0x prefix
+ * - %c: character
+ * - %f: floating point in fixed notation, passed as real (value)
+ * - %g: floating point, passed as real (value)
+ * - %t: local date and time, passed as time (0)
+ * - %s: string that stays valid until it is written, e.g., a string
+ *       owned by the tool, or the text of log_text ()
+ * - %%: a percent sign
+ *
+ * %f and %g take a width and a precision as in printf, e.g., %4.2f.
+ *
+ * The records are written in the order they are queued, so the messages
+ * of each thread stay in program order. If the queue is full, the
+ * application thread yields until the writer catches up. If the writer
+ * is not running, e.g., open () was not called, the application thread
+ * writes the queued records itself.
+ *
+ * flush () returns once all the messages that were logged before it are
+ * written to the file. close () stops the writer, and writes the messages
+ * that are still queued. It must be called before Pin terminates the
+ * internal threads, i.e., in the handle_fini_unlocked () or
+ * handle_detach () method of the tool. The log still accepts messages
+ * after close (), e.g., from handle_fini (). They are written by the
+ * thread that fills the queue, or that calls flush ().
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Async_Log
+{
+public:
+  /// Maximum number of formats.
+  static const size_t MAX_FORMATS = 1024;
+
+  /// Format id returned when a format cannot be registered.
+  static const UINT32 INVALID_FORMAT = 0;
+
+  /// Longest text that log_text () copies into the record itself.
+  static const size_t MAX_INLINE_TEXT = sizeof (UINT64) * Log_Record::MAX_ARGS - 1;
+
+  /**
+   * Initializing constructor. The log takes ownership of the file, and
+   * closes it when it is destroyed. If the file is 0, the messages are
+   * dropped.
+   *
+   * @param[in]       file            The file to write to
+   * @param[in]       capacity        Number of records in the queue
+   */
+  explicit Async_Log (FILE * file, size_t capacity = 4096);
+
+  /// Destructor. The log is closed.
+  ~Async_Log (void);
+
+  /**
+   * Start the writer thread.
+   *
+   * @retval          true            The writer started
+   * @retval          false           Failed to start the writer
+   */
+  bool open (void);
+
+  /**
+   * Stop the writer thread, and write the messages in the queue. The
+   * messages that are logged after close () are written without the
+   * writer thread.
+   *
+   * @retval          true            All the messages were written
+   * @retval          false           Failed to write some of the messages
+   */
+  bool close (void);
+
+  /**
+   * Register a format. The format is parsed once, here, and not each time
+   * a message is written.
+   *
+   * @param[in]       format          The format
+   * @return          Id of the format, or INVALID_FORMAT if the format has
+   *                  an unknown conversion, more than Log_Record::MAX_ARGS
+   *                  conversions, or there are too many formats
+   */
+  UINT32 register_format (const char * format);
+
+  /**
+   * Log a message. The arguments that the format does not use are
+   * ignored.
+   *
+   * @param[in]       format          Id of the format
+   */
+  void log (UINT32 format,
+            UINT64 arg0 = 0,
+            UINT64 arg1 = 0,
+            UINT64 arg2 = 0,
+            UINT64 arg3 = 0,
+            UINT64 arg4 = 0,
+            UINT64 arg5 = 0);
+
+  /**
+   * Log a message with a copy of a string, e.g., a string of the
+   * application that can change before the message is written. The format
+   * must have exactly one conversion, %s. A text of up to MAX_INLINE_TEXT
+   * characters is copied into the record. A longer text is copied to the
+   * heap, so the method is also suited to long messages that are
+   * formatted at instrumentation time.
+   *
+   * @param[in]       format          Id of the format
+   * @param[in]       text            The text
+   */
+  void log_text (UINT32 format, const char * text);
+
+  /**
+   * Wait until the messages logged before the call are written.
+   *
+   * @retval          true            All the messages were written
+   * @retval          false           Failed to write some of the messages
+   */
+  bool flush (void);
+
+  /// Convert a value for the %f and %g conversions.
+  static UINT64 real (double value);
+
+private:
+  /// What the arguments of a record hold.
+  enum Flags
+  {
+    /// The text of log_text () is in the arguments.
+    INLINE_TEXT = 1,
+
+    /// The first argument is the text of log_text () on the heap.
+    HEAP_TEXT = 2,
+
+    /// The record is a flush request, with a Flush_Request in the first argument.
+    FLUSH = 4
+  };
+
+  /// A parsed format.
+  struct Format;
+
+  /// A flush request, which the thread that calls flush () waits on.
+  struct Flush_Request;
+
+  /**
+   * @class Writer
+   *
+   * Thread that writes the records of the log.
+   */
+  class Writer : public Thread
+  {
+  public:
+    explicit Writer (Async_Log & log);
+
+    virtual void run (void);
+
+  private:
+    Async_Log & log_;
+  };
+
+  /// Queue a record.
+  void enqueue (const Log_Record & record);
+
+  /// Slow path of enqueue (): the queue is full.
+  void overflow (const Log_Record & record);
+
+  /// Service routine of the writer thread.
+  void svc (void);
+
+  /// Write the queued records on the calling thread. The lock must be held.
+  void drain (void);
+
+  /// Format a record into the buffer.
+  void write (const Log_Record & record);
+
+  /// Write the buffer to the file.
+  void write_file (void);
+
+  /// The queued records.
+  Event_Queue <Log_Record> queue_;
+
+  /// Buffer for the formatted records, which owns the file.
+  Text_Buffer out_;
+
+  /// The registered formats, by id.
+  Format * formats_[MAX_FORMATS];
+
+  /// Number of ids in use, including INVALID_FORMAT.
+  size_t format_count_;
+
+  /// The writer thread, or 0 if the writer is not running.
+  Writer * volatile writer_;
+
+  /// Tell the writer to exit once the queue is empty.
+  volatile bool stopped_;
+
+  /// Failed to write some of the messages.
+  volatile bool failed_;
+
+  /// Lock for the formats, the writer, and for writing without the
+  /// writer thread. The writer thread never takes the lock.
+  Mutex lock_;
+
+  // prevent the following operations
+  Async_Log (const Async_Log &);
+  const Async_Log & operator = (const Async_Log &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Async_Log.inl"
+
+#endif  // _OASIS_PIN_ASYNC_LOG_H_
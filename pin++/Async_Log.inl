@@ -0,0 +1,55 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Async_Log::Writer::Writer (Async_Log & log)
+: log_ (log)
+{
+
+}
+
+inline
+void Async_Log::log (UINT32 format,
+                     UINT64 arg0,
+                     UINT64 arg1,
+                     UINT64 arg2,
+                     UINT64 arg3,
+                     UINT64 arg4,
+                     UINT64 arg5)
+{
+  Log_Record record;
+  record.format_ = format;
+  record.flags_ = 0;
+  record.args_[0] = arg0;
+  record.args_[1] = arg1;
+  record.args_[2] = arg2;
+  record.args_[3] = arg3;
+  record.args_[4] = arg4;
+  record.args_[5] = arg5;
+
+  this->enqueue (record);
+}
+
+inline
+void Async_Log::enqueue (const Log_Record & record)
+{
+  if (!this->queue_.try_push (record))
+    this->overflow (record);
+}
+
+inline
+UINT64 Async_Log::real (double value)
+{
+  UINT64 bits;
+  ::memcpy (&bits, &value, sizeof (bits));
+
+  return bits;
+}
+
+} // namespace OASIS
+} // namespace Pin
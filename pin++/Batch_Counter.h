@@ -12,14 +12,22 @@
 #define _OASIS_PINPP_CALLBACK_BATCH_COUNTER_H_
 
 #include "pin++/Callback.h"
+#include "pin++/Register_Counter.h"
+#include "pin++/Sharded_Counter.h"
 
 namespace OASIS
 {
 namespace Pin
 {
 
-template <typename T = UINT64, typename INCREMENT = T>
-class Batch_Counter : public OASIS::Pin::Callback < Batch_Counter <T, INCREMENT> (void) >
+/**
+ * @class Batch_Counter
+ *
+ * Counter callback object that adds an increment to the count. The STORAGE
+ * parameter selects where the count is kept (see Counter).
+ */
+template <typename T = UINT64, typename INCREMENT = T, typename STORAGE = Memory_Storage>
+class Batch_Counter : public OASIS::Pin::Callback < Batch_Counter <T, INCREMENT, STORAGE> (void) >
 {
 public:
   /// Type definition for the counter type.
@@ -52,6 +60,89 @@ private:
   INCREMENT increment_;
 };
 
+/**
+ * @class Batch_Counter <T, INCREMENT, Register_Storage>
+ *
+ * Batch counter that adds the increment to a tool register. The increment
+ * is captured when the counter is inserted, so a single counter can be
+ * inserted with a different increment at each instrumentation point
+ * (e.g., the instruction count of each BBL).
+ */
+template <typename T, typename INCREMENT>
+class Batch_Counter <T, INCREMENT, Register_Storage> : public Register_Counter <T>
+{
+public:
+  /// Type definition of the increment type.
+  typedef INCREMENT increment_type;
+
+  /// Default constructor
+  Batch_Counter (void);
+  Batch_Counter (const INCREMENT & inc);
+
+  /// Set the increment value for the batch counter.
+  void increment (const INCREMENT & inc);
+
+  /// Get the current increment value.
+  const INCREMENT & increment (void) const;
+
+  /// Instrument the object with the current increment.
+  template <typename S>
+  void insert (IPOINT location, const S & obj);
+
+  /// Instrument the object with the current increment as a predicated call.
+  template <typename S>
+  void insert_predicated (IPOINT location, const S & obj);
+
+private:
+  /// Increment value
+  INCREMENT increment_;
+};
+
+/**
+ * @class Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >
+ *
+ * Batch counter that adds the increment to the slot of the current thread
+ * in a Sharded_Counter. Like the sharded Counter, each batch counter holds
+ * MAX_THREADS + 2 cache lines.
+ */
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
+class Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> > :
+  public OASIS::Pin::Callback < Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> > (ARG_THREAD_ID) >
+{
+public:
+  /// Type definition for the counter type.
+  typedef T type;
+
+  /// Type definition of the increment type.
+  typedef INCREMENT increment_type;
+
+  /// Default constructor
+  Batch_Counter (void);
+  Batch_Counter (const INCREMENT & inc);
+
+  /// Set the increment value for the batch counter.
+  void increment (const INCREMENT & inc);
+
+  /// Get the current increment value.
+  const INCREMENT & increment (void) const;
+
+  /// Handle the analysis callback from Pin.
+  void handle_analyze (THREADID thr_id);
+
+  /// The the current count.
+  T count (void) const;
+
+  /// Get the underlying sharded counter.
+  const Sharded_Counter <T, MAX_THREADS> & shards (void) const;
+
+private:
+  /// Current count of each thread.
+  Sharded_Counter <T, MAX_THREADS> count_;
+
+  /// Increment value
+  INCREMENT increment_;
+};
+
 }
 }
 
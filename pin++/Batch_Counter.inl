@@ -5,47 +5,144 @@ namespace OASIS
 namespace Pin
 {
 
-template <typename T, typename INCREMENT>
+template <typename T, typename INCREMENT, typename STORAGE>
 inline
-Batch_Counter <T, INCREMENT>::Batch_Counter (void)
+Batch_Counter <T, INCREMENT, STORAGE>::Batch_Counter (void)
 : count_ (0)
 {
 
 }
 
-template <typename T, typename INCREMENT>
+template <typename T, typename INCREMENT, typename STORAGE>
 inline
-Batch_Counter <T, INCREMENT>::Batch_Counter (const INCREMENT & incr)
+Batch_Counter <T, INCREMENT, STORAGE>::Batch_Counter (const INCREMENT & incr)
 : count_ (0),
   increment_ (incr)
 {
 
 }
 
+template <typename T, typename INCREMENT, typename STORAGE>
+inline
+void Batch_Counter <T, INCREMENT, STORAGE>::increment (const INCREMENT & incr)
+{
+  this->increment_ = incr;
+}
+
+template <typename T, typename INCREMENT, typename STORAGE>
+inline
+const INCREMENT & Batch_Counter <T, INCREMENT, STORAGE>::increment (void) const
+{
+  return this->increment_;
+}
+
+template <typename T, typename INCREMENT, typename STORAGE>
+inline
+void Batch_Counter <T, INCREMENT, STORAGE>::handle_analyze (void)
+{
+  this->count_ += this->increment_;
+}
+
+template <typename T, typename INCREMENT, typename STORAGE>
+inline
+const T & Batch_Counter <T, INCREMENT, STORAGE>::count (void) const
+{
+  return this->count_;
+}
+
+template <typename T, typename INCREMENT>
+inline
+Batch_Counter <T, INCREMENT, Register_Storage>::Batch_Counter (void)
+: increment_ (1)
+{
+
+}
+
+template <typename T, typename INCREMENT>
+inline
+Batch_Counter <T, INCREMENT, Register_Storage>::Batch_Counter (const INCREMENT & incr)
+: increment_ (incr)
+{
+
+}
+
 template <typename T, typename INCREMENT>
 inline
-void Batch_Counter <T, INCREMENT>::increment (const INCREMENT & incr)
+void Batch_Counter <T, INCREMENT, Register_Storage>::increment (const INCREMENT & incr)
 {
   this->increment_ = incr;
 }
 
 template <typename T, typename INCREMENT>
 inline
-const INCREMENT & Batch_Counter <T, INCREMENT>::increment (void) const
+const INCREMENT & Batch_Counter <T, INCREMENT, Register_Storage>::increment (void) const
 {
   return this->increment_;
 }
 
 template <typename T, typename INCREMENT>
+template <typename S>
 inline
-void Batch_Counter <T, INCREMENT>::handle_analyze (void)
+void Batch_Counter <T, INCREMENT, Register_Storage>::insert (IPOINT location, const S & obj)
 {
-  this->count_ += this->increment_;
+  this->insert_increment (S::__insert_call, obj, location, this->increment_);
 }
 
 template <typename T, typename INCREMENT>
+template <typename S>
+inline
+void Batch_Counter <T, INCREMENT, Register_Storage>::insert_predicated (IPOINT location, const S & obj)
+{
+  this->insert_increment (S::__insert_predicated_call, obj, location, this->increment_);
+}
+
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
+inline
+Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >::Batch_Counter (void)
+{
+
+}
+
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
+inline
+Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >::Batch_Counter (const INCREMENT & incr)
+: increment_ (incr)
+{
+
+}
+
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
+inline
+void Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >::increment (const INCREMENT & incr)
+{
+  this->increment_ = incr;
+}
+
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
+inline
+const INCREMENT & Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >::increment (void) const
+{
+  return this->increment_;
+}
+
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
+inline
+void Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >::handle_analyze (THREADID thr_id)
+{
+  this->count_.add (thr_id, this->increment_);
+}
+
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
+inline
+T Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >::count (void) const
+{
+  return this->count_.total ();
+}
+
+template <typename T, typename INCREMENT, size_t MAX_THREADS>
 inline
-const T & Batch_Counter <T, INCREMENT>::count (void) const
+const Sharded_Counter <T, MAX_THREADS> &
+Batch_Counter <T, INCREMENT, Sharded_Storage <MAX_THREADS> >::shards (void) const
 {
   return this->count_;
 }
@@ -25,7 +25,14 @@ namespace Pin
  *
  * Utility buffer designed to be used in STL containers. Unlike std::vector,
  * the buffer is not released in the destructor. Instead, you must manually
- * release the buffer using the release() method.
+ * release the buffer using the release() method. The items are referenced
+ * by the analysis routines, so the buffer cannot be copied. Construct it
+ * in place instead, e.g., with emplace_back () on a std::list.
+ *
+ * Buffers that hold the callback objects of a trace should use the
+ * Trace_Arena instead, which releases the objects with the trace.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
  */
 template <typename T>
 class Buffer
@@ -40,14 +47,9 @@ public:
   /// Default constructor.
   Buffer (size_t count);
 
-  /// Copy constructor.
-  Buffer (const Buffer & buf);
-
   /// Destructor.
   ~Buffer (void);
 
-  const Buffer & operator = (const Buffer & buf);
-
   /// Release the buffer.
   void release (void);
 
@@ -65,6 +67,10 @@ private:
 
   /// Number of items in the buffer.
   size_t count_;
+
+  // prevent the following operations
+  Buffer (const Buffer &);
+  const Buffer & operator = (const Buffer &);
 };
 
 } // namespace OASIS
@@ -15,15 +15,6 @@ Buffer <T>::Buffer (size_t count)
 
 }
 
-template <typename T>
-inline
-Buffer <T>::Buffer (const Buffer & buf)
-: items_ (buf.items_),
-  count_ (buf.count_)
-{
-
-}
-
 template <typename T>
 inline
 Buffer <T>::~Buffer (void)
@@ -31,16 +22,6 @@ Buffer <T>::~Buffer (void)
 
 }
 
-template <typename T>
-inline
-const Buffer <T> & Buffer <T>::operator = (const Buffer & buf)
-{
-  this->items_ = buf.items_;
-  this->count_ = buf.items_;
-
-  return *this;
-}
-
 template <typename T>
 inline
 typename Buffer <T>::iterator Buffer <T>::begin (void)
@@ -0,0 +1,1142 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Buffer_Record.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_BUFFER_RECORD_H_
+#define _OASIS_PIN_BUFFER_RECORD_H_
+
+#include "Arg_List.h"
+
+#include <cstddef>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Buffer_Record
+ *
+ * Record in a trace buffer whose layout is defined by the same ARG_*
+ * types used by Callback. The record has one field for each argument,
+ * named arg1 ... argN, whose type is the native Pin type of the argument.
+ * The record is used as the ELEMENT_TYPE of a Trace_Buffer, and the fill
+ * is inserted with Trace_Buffer::insert_fill (). The offset of each field
+ * is computed from the record so there is no need to write offsetof lists
+ * by hand, and the consumer's handle_trace_buffer () is type checked
+ * against the record.
+ *
+ * Arguments that take an extra value (e.g., ARG_MEMORYOP_EA, ARG_UINT32)
+ * receive the value as an extra argument to insert_fill (), in the same
+ * way as Callback::insert ().
+ */
+template <typename A1,
+          typename A2 = End,
+          typename A3 = End,
+          typename A4 = End,
+          typename A5 = End,
+          typename A6 = End>
+struct Buffer_Record;
+
+/**
+ * @struct Buffer_Record <A1>
+ *
+ * Record with 1 field.
+ */
+template <typename A1>
+struct Buffer_Record <A1, End, End, End, End, End>
+{
+  /// Type definition of the argument list.
+  typedef Type_Node <A1> arglist_type;
+
+  /// Number of fields in the record.
+  static const int field_count = 1;
+
+  /// @{ Field Type Definitions
+  typedef typename A1::pin_type type1;
+  /// @}
+
+  /// @{ Fields
+  type1 arg1;
+  /// @}
+
+  /// Offset of a field in the record.
+  static UINT32 offset (int field)
+  {
+    switch (field)
+    {
+    case 0: return offsetof (Buffer_Record, arg1);
+    default: return 0;
+    }
+  }
+
+  /// Size of a field in the record.
+  static UINT32 size (int field)
+  {
+    switch (field)
+    {
+    case 0: return sizeof (type1);
+    default: return 0;
+    }
+  }
+
+  /// Argument type of a field in the record.
+  static IARG_TYPE arg_type (int field)
+  {
+    switch (field)
+    {
+    case 0: return A1::arg_type;
+    default: return IARG_INVALID;
+    }
+  }
+};
+
+/**
+ * @struct Buffer_Record <A1, A2>
+ *
+ * Record with 2 fields.
+ */
+template <typename A1, typename A2>
+struct Buffer_Record <A1, A2, End, End, End, End>
+{
+  /// Type definition of the argument list.
+  typedef Type_Node <A1, Type_Node <A2> > arglist_type;
+
+  /// Number of fields in the record.
+  static const int field_count = 2;
+
+  /// @{ Field Type Definitions
+  typedef typename A1::pin_type type1;
+  typedef typename A2::pin_type type2;
+  /// @}
+
+  /// @{ Fields
+  type1 arg1;
+  type2 arg2;
+  /// @}
+
+  /// Offset of a field in the record.
+  static UINT32 offset (int field)
+  {
+    switch (field)
+    {
+    case 0: return offsetof (Buffer_Record, arg1);
+    case 1: return offsetof (Buffer_Record, arg2);
+    default: return 0;
+    }
+  }
+
+  /// Size of a field in the record.
+  static UINT32 size (int field)
+  {
+    switch (field)
+    {
+    case 0: return sizeof (type1);
+    case 1: return sizeof (type2);
+    default: return 0;
+    }
+  }
+
+  /// Argument type of a field in the record.
+  static IARG_TYPE arg_type (int field)
+  {
+    switch (field)
+    {
+    case 0: return A1::arg_type;
+    case 1: return A2::arg_type;
+    default: return IARG_INVALID;
+    }
+  }
+};
+
+/**
+ * @struct Buffer_Record <A1, A2, A3>
+ *
+ * Record with 3 fields.
+ */
+template <typename A1, typename A2, typename A3>
+struct Buffer_Record <A1, A2, A3, End, End, End>
+{
+  /// Type definition of the argument list.
+  typedef Type_Node <A1, Type_Node <A2, Type_Node <A3> > > arglist_type;
+
+  /// Number of fields in the record.
+  static const int field_count = 3;
+
+  /// @{ Field Type Definitions
+  typedef typename A1::pin_type type1;
+  typedef typename A2::pin_type type2;
+  typedef typename A3::pin_type type3;
+  /// @}
+
+  /// @{ Fields
+  type1 arg1;
+  type2 arg2;
+  type3 arg3;
+  /// @}
+
+  /// Offset of a field in the record.
+  static UINT32 offset (int field)
+  {
+    switch (field)
+    {
+    case 0: return offsetof (Buffer_Record, arg1);
+    case 1: return offsetof (Buffer_Record, arg2);
+    case 2: return offsetof (Buffer_Record, arg3);
+    default: return 0;
+    }
+  }
+
+  /// Size of a field in the record.
+  static UINT32 size (int field)
+  {
+    switch (field)
+    {
+    case 0: return sizeof (type1);
+    case 1: return sizeof (type2);
+    case 2: return sizeof (type3);
+    default: return 0;
+    }
+  }
+
+  /// Argument type of a field in the record.
+  static IARG_TYPE arg_type (int field)
+  {
+    switch (field)
+    {
+    case 0: return A1::arg_type;
+    case 1: return A2::arg_type;
+    case 2: return A3::arg_type;
+    default: return IARG_INVALID;
+    }
+  }
+};
+
+/**
+ * @struct Buffer_Record <A1, A2, A3, A4>
+ *
+ * Record with 4 fields.
+ */
+template <typename A1, typename A2, typename A3, typename A4>
+struct Buffer_Record <A1, A2, A3, A4, End, End>
+{
+  /// Type definition of the argument list.
+  typedef Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4> > > > arglist_type;
+
+  /// Number of fields in the record.
+  static const int field_count = 4;
+
+  /// @{ Field Type Definitions
+  typedef typename A1::pin_type type1;
+  typedef typename A2::pin_type type2;
+  typedef typename A3::pin_type type3;
+  typedef typename A4::pin_type type4;
+  /// @}
+
+  /// @{ Fields
+  type1 arg1;
+  type2 arg2;
+  type3 arg3;
+  type4 arg4;
+  /// @}
+
+  /// Offset of a field in the record.
+  static UINT32 offset (int field)
+  {
+    switch (field)
+    {
+    case 0: return offsetof (Buffer_Record, arg1);
+    case 1: return offsetof (Buffer_Record, arg2);
+    case 2: return offsetof (Buffer_Record, arg3);
+    case 3: return offsetof (Buffer_Record, arg4);
+    default: return 0;
+    }
+  }
+
+  /// Size of a field in the record.
+  static UINT32 size (int field)
+  {
+    switch (field)
+    {
+    case 0: return sizeof (type1);
+    case 1: return sizeof (type2);
+    case 2: return sizeof (type3);
+    case 3: return sizeof (type4);
+    default: return 0;
+    }
+  }
+
+  /// Argument type of a field in the record.
+  static IARG_TYPE arg_type (int field)
+  {
+    switch (field)
+    {
+    case 0: return A1::arg_type;
+    case 1: return A2::arg_type;
+    case 2: return A3::arg_type;
+    case 3: return A4::arg_type;
+    default: return IARG_INVALID;
+    }
+  }
+};
+
+/**
+ * @struct Buffer_Record <A1, A2, A3, A4, A5>
+ *
+ * Record with 5 fields.
+ */
+template <typename A1, typename A2, typename A3, typename A4, typename A5>
+struct Buffer_Record <A1, A2, A3, A4, A5, End>
+{
+  /// Type definition of the argument list.
+  typedef Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4, Type_Node <A5> > > > > arglist_type;
+
+  /// Number of fields in the record.
+  static const int field_count = 5;
+
+  /// @{ Field Type Definitions
+  typedef typename A1::pin_type type1;
+  typedef typename A2::pin_type type2;
+  typedef typename A3::pin_type type3;
+  typedef typename A4::pin_type type4;
+  typedef typename A5::pin_type type5;
+  /// @}
+
+  /// @{ Fields
+  type1 arg1;
+  type2 arg2;
+  type3 arg3;
+  type4 arg4;
+  type5 arg5;
+  /// @}
+
+  /// Offset of a field in the record.
+  static UINT32 offset (int field)
+  {
+    switch (field)
+    {
+    case 0: return offsetof (Buffer_Record, arg1);
+    case 1: return offsetof (Buffer_Record, arg2);
+    case 2: return offsetof (Buffer_Record, arg3);
+    case 3: return offsetof (Buffer_Record, arg4);
+    case 4: return offsetof (Buffer_Record, arg5);
+    default: return 0;
+    }
+  }
+
+  /// Size of a field in the record.
+  static UINT32 size (int field)
+  {
+    switch (field)
+    {
+    case 0: return sizeof (type1);
+    case 1: return sizeof (type2);
+    case 2: return sizeof (type3);
+    case 3: return sizeof (type4);
+    case 4: return sizeof (type5);
+    default: return 0;
+    }
+  }
+
+  /// Argument type of a field in the record.
+  static IARG_TYPE arg_type (int field)
+  {
+    switch (field)
+    {
+    case 0: return A1::arg_type;
+    case 1: return A2::arg_type;
+    case 2: return A3::arg_type;
+    case 3: return A4::arg_type;
+    case 4: return A5::arg_type;
+    default: return IARG_INVALID;
+    }
+  }
+};
+
+/**
+ * @struct Buffer_Record
+ *
+ * Record with 6 fields.
+ */
+template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct Buffer_Record
+{
+  /// Type definition of the argument list.
+  typedef Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4, Type_Node <A5, Type_Node <A6> > > > > > arglist_type;
+
+  /// Number of fields in the record.
+  static const int field_count = 6;
+
+  /// @{ Field Type Definitions
+  typedef typename A1::pin_type type1;
+  typedef typename A2::pin_type type2;
+  typedef typename A3::pin_type type3;
+  typedef typename A4::pin_type type4;
+  typedef typename A5::pin_type type5;
+  typedef typename A6::pin_type type6;
+  /// @}
+
+  /// @{ Fields
+  type1 arg1;
+  type2 arg2;
+  type3 arg3;
+  type4 arg4;
+  type5 arg5;
+  type6 arg6;
+  /// @}
+
+  /// Offset of a field in the record.
+  static UINT32 offset (int field)
+  {
+    switch (field)
+    {
+    case 0: return offsetof (Buffer_Record, arg1);
+    case 1: return offsetof (Buffer_Record, arg2);
+    case 2: return offsetof (Buffer_Record, arg3);
+    case 3: return offsetof (Buffer_Record, arg4);
+    case 4: return offsetof (Buffer_Record, arg5);
+    case 5: return offsetof (Buffer_Record, arg6);
+    default: return 0;
+    }
+  }
+
+  /// Size of a field in the record.
+  static UINT32 size (int field)
+  {
+    switch (field)
+    {
+    case 0: return sizeof (type1);
+    case 1: return sizeof (type2);
+    case 2: return sizeof (type3);
+    case 3: return sizeof (type4);
+    case 4: return sizeof (type5);
+    case 5: return sizeof (type6);
+    default: return 0;
+    }
+  }
+
+  /// Argument type of a field in the record.
+  static IARG_TYPE arg_type (int field)
+  {
+    switch (field)
+    {
+    case 0: return A1::arg_type;
+    case 1: return A2::arg_type;
+    case 2: return A3::arg_type;
+    case 3: return A4::arg_type;
+    case 4: return A5::arg_type;
+    case 5: return A6::arg_type;
+    default: return IARG_INVALID;
+    }
+  }
+};
+
+/**
+ * @struct Xarg_Pack
+ *
+ * Holds the extra arguments passed to insert_fill () so the fill can be
+ * generated without an overload for each number of extra arguments.
+ */
+template <typename X1 = End,
+          typename X2 = End,
+          typename X3 = End,
+          typename X4 = End,
+          typename X5 = End,
+          typename X6 = End>
+struct Xarg_Pack
+{
+  /// @{ Extra Argument Type Definitions
+  typedef X1 type1;
+  typedef X2 type2;
+  typedef X3 type3;
+  typedef X4 type4;
+  typedef X5 type5;
+  typedef X6 type6;
+  /// @}
+
+  Xarg_Pack (const X1 & x1 = X1 (),
+             const X2 & x2 = X2 (),
+             const X3 & x3 = X3 (),
+             const X4 & x4 = X4 (),
+             const X5 & x5 = X5 (),
+             const X6 & x6 = X6 ())
+    : x1_ (x1), x2_ (x2), x3_ (x3), x4_ (x4), x5_ (x5), x6_ (x6) { }
+
+  /// @{ Extra Arguments
+  X1 x1_;
+  X2 x2_;
+  X3 x3_;
+  X4 x4_;
+  X5 x5_;
+  X6 x6_;
+  /// @}
+};
+
+/**
+ * @struct Xarg_Pack_Get
+ *
+ * Get the Nth (0-based) extra argument from an Xarg_Pack.
+ */
+template <typename PACK, int N>
+struct Xarg_Pack_Get;
+
+template <typename PACK>
+struct Xarg_Pack_Get <PACK, 0>
+{
+  typedef typename PACK::type1 result_type;
+
+  static result_type execute (const PACK & pack)
+  {
+    return pack.x1_;
+  }
+};
+
+template <typename PACK>
+struct Xarg_Pack_Get <PACK, 1>
+{
+  typedef typename PACK::type2 result_type;
+
+  static result_type execute (const PACK & pack)
+  {
+    return pack.x2_;
+  }
+};
+
+template <typename PACK>
+struct Xarg_Pack_Get <PACK, 2>
+{
+  typedef typename PACK::type3 result_type;
+
+  static result_type execute (const PACK & pack)
+  {
+    return pack.x3_;
+  }
+};
+
+template <typename PACK>
+struct Xarg_Pack_Get <PACK, 3>
+{
+  typedef typename PACK::type4 result_type;
+
+  static result_type execute (const PACK & pack)
+  {
+    return pack.x4_;
+  }
+};
+
+template <typename PACK>
+struct Xarg_Pack_Get <PACK, 4>
+{
+  typedef typename PACK::type5 result_type;
+
+  static result_type execute (const PACK & pack)
+  {
+    return pack.x5_;
+  }
+};
+
+template <typename PACK>
+struct Xarg_Pack_Get <PACK, 5>
+{
+  typedef typename PACK::type6 result_type;
+
+  static result_type execute (const PACK & pack)
+  {
+    return pack.x6_;
+  }
+};
+
+/// @{ Kinds of values in the argument list of INS_InsertFillBuffer
+enum Fill_Kind
+{
+  FILL_KIND_NONE,
+  FILL_KIND_IARG,
+  FILL_KIND_XARG,
+  FILL_KIND_OFFSET
+};
+/// @}
+
+/**
+ * @struct Fill_Position
+ *
+ * Compile-time mapping from a position in the argument list passed to
+ * INS_InsertFillBuffer to the record's argument list. The fill argument
+ * list has the form IARG_X, [extra value,] offset, ... for each field.
+ * At position \a P, \a kind is the kind of value, \a iarg is the IARG_TYPE
+ * of a FILL_KIND_IARG value, \a field is the field index of a
+ * FILL_KIND_OFFSET value, and \a xarg is the extra argument index of a
+ * FILL_KIND_XARG value.
+ */
+template <typename LIST,
+          int P,
+          int FIELD = 0,
+          int XARG = 0,
+          bool IS_VALUE = Is_Value_Node <LIST>::RET>
+struct Fill_Position;
+
+/**
+ * @struct Fill_Position <LIST, P, FIELD, XARG, false>
+ *
+ * Position on a Type_Node. The node is followed by the field offset,
+ * unless it has an extra value.
+ */
+template <typename LIST, int P, int FIELD, int XARG>
+struct Fill_Position <LIST, P, FIELD, XARG, false>
+{
+  static const bool has_xarg = Is_Value_Node <typename LIST::Tail>::RET;
+  static const int size = has_xarg ? 1 : 2;
+
+  typedef Fill_Position <typename LIST::Tail, P - size, has_xarg ? FIELD : FIELD + 1, XARG> next_type;
+
+  static const Fill_Kind kind = P == 0 ? FILL_KIND_IARG : (P < size ? FILL_KIND_OFFSET : next_type::kind);
+  static const IARG_TYPE iarg = P == 0 ? LIST::value : next_type::iarg;
+  static const int field = P < size ? FIELD : next_type::field;
+  static const int xarg = next_type::xarg;
+
+  /// Length of the fill argument list from this node.
+  static const int length = size + next_type::length;
+};
+
+/**
+ * @struct Fill_Position <LIST, P, FIELD, XARG, true>
+ *
+ * Position on a Value_Node. The extra value is followed by the field offset.
+ */
+template <typename LIST, int P, int FIELD, int XARG>
+struct Fill_Position <LIST, P, FIELD, XARG, true>
+{
+  typedef Fill_Position <typename LIST::Tail, P - 2, FIELD + 1, XARG + 1> next_type;
+
+  static const Fill_Kind kind = P == 0 ? FILL_KIND_XARG : (P == 1 ? FILL_KIND_OFFSET : next_type::kind);
+  static const IARG_TYPE iarg = next_type::iarg;
+  static const int field = P < 2 ? FIELD : next_type::field;
+  static const int xarg = P == 0 ? XARG : next_type::xarg;
+
+  /// Length of the fill argument list from this node.
+  static const int length = 2 + next_type::length;
+};
+
+/**
+ * @struct Fill_Position <End, P, FIELD, XARG, false>
+ *
+ * End of the argument list.
+ */
+template <int P, int FIELD, int XARG>
+struct Fill_Position <End, P, FIELD, XARG, false>
+{
+  static const Fill_Kind kind = FILL_KIND_NONE;
+  static const IARG_TYPE iarg = IARG_INVALID;
+  static const int field = -1;
+  static const int xarg = -1;
+  static const int length = 0;
+};
+
+/**
+ * @struct Fill_Token
+ *
+ * Get the value at position \a P in the fill argument list.
+ */
+template <typename RECORD,
+          typename PACK,
+          int P,
+          Fill_Kind KIND = Fill_Position <typename RECORD::arglist_type, P>::kind>
+struct Fill_Token;
+
+template <typename RECORD, typename PACK, int P>
+struct Fill_Token <RECORD, PACK, P, FILL_KIND_IARG>
+{
+  typedef IARG_TYPE result_type;
+
+  static result_type execute (const PACK &)
+  {
+    return Fill_Position <typename RECORD::arglist_type, P>::iarg;
+  }
+};
+
+template <typename RECORD, typename PACK, int P>
+struct Fill_Token <RECORD, PACK, P, FILL_KIND_XARG>
+{
+  typedef Xarg_Pack_Get <PACK, Fill_Position <typename RECORD::arglist_type, P>::xarg> get_type;
+  typedef typename get_type::result_type result_type;
+
+  static result_type execute (const PACK & pack)
+  {
+    return get_type::execute (pack);
+  }
+};
+
+template <typename RECORD, typename PACK, int P>
+struct Fill_Token <RECORD, PACK, P, FILL_KIND_OFFSET>
+{
+  typedef UINT32 result_type;
+
+  static result_type execute (const PACK &)
+  {
+    return RECORD::offset (Fill_Position <typename RECORD::arglist_type, P>::field);
+  }
+};
+
+/**
+ * @struct Fill_Buffer_T
+ *
+ * Functor executing an INS_InsertFillBuffer function for a Buffer_Record.
+ * The \a N template parameter is the length of the fill argument list.
+ */
+template <typename RECORD,
+          int N = Fill_Position <typename RECORD::arglist_type, 0>::length>
+struct Fill_Buffer_T;
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 2>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 3>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 4>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 5>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 6>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 7>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 8>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 9>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 10>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 11>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 12>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            Fill_Token <RECORD, PACK, 11>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 13>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            Fill_Token <RECORD, PACK, 11>::execute (pack),
+            Fill_Token <RECORD, PACK, 12>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 14>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            Fill_Token <RECORD, PACK, 11>::execute (pack),
+            Fill_Token <RECORD, PACK, 12>::execute (pack),
+            Fill_Token <RECORD, PACK, 13>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 15>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            Fill_Token <RECORD, PACK, 11>::execute (pack),
+            Fill_Token <RECORD, PACK, 12>::execute (pack),
+            Fill_Token <RECORD, PACK, 13>::execute (pack),
+            Fill_Token <RECORD, PACK, 14>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 16>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            Fill_Token <RECORD, PACK, 11>::execute (pack),
+            Fill_Token <RECORD, PACK, 12>::execute (pack),
+            Fill_Token <RECORD, PACK, 13>::execute (pack),
+            Fill_Token <RECORD, PACK, 14>::execute (pack),
+            Fill_Token <RECORD, PACK, 15>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 17>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            Fill_Token <RECORD, PACK, 11>::execute (pack),
+            Fill_Token <RECORD, PACK, 12>::execute (pack),
+            Fill_Token <RECORD, PACK, 13>::execute (pack),
+            Fill_Token <RECORD, PACK, 14>::execute (pack),
+            Fill_Token <RECORD, PACK, 15>::execute (pack),
+            Fill_Token <RECORD, PACK, 16>::execute (pack),
+            IARG_END);
+  }
+};
+
+template <typename RECORD>
+struct Fill_Buffer_T <RECORD, 18>
+{
+  /// Type definition of the function pointer to INS_InsertFillBuffer*.
+  typedef VOID (* funcptr_type) (INS, IPOINT, BUFFER_ID, ...);
+
+  template <typename PACK>
+  static void execute (funcptr_type insert, INS ins, IPOINT location, BUFFER_ID id, const PACK & pack)
+  {
+    insert (ins,
+            location,
+            id,
+            Fill_Token <RECORD, PACK, 0>::execute (pack),
+            Fill_Token <RECORD, PACK, 1>::execute (pack),
+            Fill_Token <RECORD, PACK, 2>::execute (pack),
+            Fill_Token <RECORD, PACK, 3>::execute (pack),
+            Fill_Token <RECORD, PACK, 4>::execute (pack),
+            Fill_Token <RECORD, PACK, 5>::execute (pack),
+            Fill_Token <RECORD, PACK, 6>::execute (pack),
+            Fill_Token <RECORD, PACK, 7>::execute (pack),
+            Fill_Token <RECORD, PACK, 8>::execute (pack),
+            Fill_Token <RECORD, PACK, 9>::execute (pack),
+            Fill_Token <RECORD, PACK, 10>::execute (pack),
+            Fill_Token <RECORD, PACK, 11>::execute (pack),
+            Fill_Token <RECORD, PACK, 12>::execute (pack),
+            Fill_Token <RECORD, PACK, 13>::execute (pack),
+            Fill_Token <RECORD, PACK, 14>::execute (pack),
+            Fill_Token <RECORD, PACK, 15>::execute (pack),
+            Fill_Token <RECORD, PACK, 16>::execute (pack),
+            Fill_Token <RECORD, PACK, 17>::execute (pack),
+            IARG_END);
+  }
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#endif  // _OASIS_PIN_BUFFER_RECORD_H_
@@ -205,6 +205,9 @@ public:
   /// The number of arguments expected by the insert method.
   static const int arglist_length = Length <arglist_type>::RET;
 
+  /// The analysis routine is passed the callback object.
+  static const bool is_static_callback = false;
+
   /// @{ InsertCall
 
   /**
@@ -764,6 +767,9 @@ public:
 
   /// The number of arguments expected by the insert method.
   static const int arglist_length = Length <arglist_type>::RET;
+
+  /// The analysis routine is passed the callback object.
+  static const bool is_static_callback = false;
 };
 
 /**
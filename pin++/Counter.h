@@ -12,6 +12,8 @@
 #define _OASIS_PINPP_CALLBACK_COUNTER_H_
 
 #include "pin++/Callback.h"
+#include "pin++/Register_Counter.h"
+#include "pin++/Sharded_Counter.h"
 
 namespace OASIS
 {
@@ -26,12 +28,17 @@ namespace Pin
  * allows the counter to be used with basic integers, or abstract data types
  * that use operator overloading to implement pre-increment operator.
  *
+ * The STORAGE parameter selects where the count is kept. The default,
+ * Memory_Storage, keeps the count in the counter object. Register_Storage
+ * keeps the count of each thread in a tool register (see Register_Counter).
+ * Sharded_Storage keeps the count in a Sharded_Counter.
+ *
  * T Requirements:
  *  - Initialization constructor with integer parameter
  *  - Pre-increment operator
  */
-template <typename T = UINT64>
-class Counter : public OASIS::Pin::Callback < Counter <T> (void) >
+template <typename T = UINT64, typename STORAGE = Memory_Storage>
+class Counter : public OASIS::Pin::Callback < Counter <T, STORAGE> (void) >
 {
 public:
   /// Type definition of the counter's type.
@@ -51,6 +58,64 @@ private:
   T count_;
 };
 
+/**
+ * @class Counter <T, Register_Storage>
+ *
+ * Counter that increments a tool register instead of calling an analysis
+ * routine that updates memory. The counter cannot be used with a guard.
+ */
+template <typename T>
+class Counter <T, Register_Storage> : public Register_Counter <T>
+{
+public:
+  /// Default constructor
+  Counter (void);
+
+  /// Instrument the object with the counter.
+  template <typename S>
+  void insert (IPOINT location, const S & obj);
+
+  /// Instrument the object with the predicated counter.
+  template <typename S>
+  void insert_predicated (IPOINT location, const S & obj);
+};
+
+/**
+ * @class Counter <T, Sharded_Storage <MAX_THREADS> >
+ *
+ * Counter that increments the slot of the current thread in a
+ * Sharded_Counter. Unlike the Register_Storage counter, this counter
+ * is a regular callback, and can be used with a guard.
+ *
+ * Each counter holds MAX_THREADS + 2 cache lines, which is about 4 KB
+ * with the default of OASIS_PIN_SHARDED_MAX_THREADS (64). Use it for a
+ * few hot counters, not for a counter per instruction or basic block.
+ */
+template <typename T, size_t MAX_THREADS>
+class Counter <T, Sharded_Storage <MAX_THREADS> > :
+  public OASIS::Pin::Callback < Counter <T, Sharded_Storage <MAX_THREADS> > (ARG_THREAD_ID) >
+{
+public:
+  /// Type definition of the counter's type.
+  typedef T type;
+
+  /// Default constructor
+  Counter (void);
+
+  /// Handle the analysis callback
+  void handle_analyze (THREADID thr_id);
+
+  /// Get the current count.
+  T count (void) const;
+
+  /// Get the underlying sharded counter.
+  const Sharded_Counter <T, MAX_THREADS> & shards (void) const;
+
+private:
+  /// Current count of each thread.
+  Sharded_Counter <T, MAX_THREADS> count_;
+};
+
 }
 }
 
@@ -5,24 +5,76 @@ namespace OASIS
 namespace Pin
 {
 
-template <typename T>
+template <typename T, typename STORAGE>
 inline
-Counter <T>::Counter (void)
+Counter <T, STORAGE>::Counter (void)
 : count_ (0)
 {
 
 }
 
-template <typename T>
+template <typename T, typename STORAGE>
 inline
-void Counter <T>::handle_analyze (void)
+void Counter <T, STORAGE>::handle_analyze (void)
 {
   ++ this->count_;
 }
 
+template <typename T, typename STORAGE>
+inline
+const T & Counter <T, STORAGE>::count (void) const
+{
+  return this->count_;
+}
+
+template <typename T>
+inline
+Counter <T, Register_Storage>::Counter (void)
+{
+
+}
+
+template <typename T>
+template <typename S>
+inline
+void Counter <T, Register_Storage>::insert (IPOINT location, const S & obj)
+{
+  this->insert_increment (S::__insert_call, obj, location, 1);
+}
+
 template <typename T>
+template <typename S>
+inline
+void Counter <T, Register_Storage>::insert_predicated (IPOINT location, const S & obj)
+{
+  this->insert_increment (S::__insert_predicated_call, obj, location, 1);
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+Counter <T, Sharded_Storage <MAX_THREADS> >::Counter (void)
+{
+
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+void Counter <T, Sharded_Storage <MAX_THREADS> >::handle_analyze (THREADID thr_id)
+{
+  this->count_.increment (thr_id);
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+T Counter <T, Sharded_Storage <MAX_THREADS> >::count (void) const
+{
+  return this->count_.total ();
+}
+
+template <typename T, size_t MAX_THREADS>
 inline
-const T & Counter <T>::count (void) const
+const Sharded_Counter <T, MAX_THREADS> &
+Counter <T, Sharded_Storage <MAX_THREADS> >::shards (void) const
 {
   return this->count_;
 }
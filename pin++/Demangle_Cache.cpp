@@ -0,0 +1,168 @@
+// $Id$
+
+#include "Demangle_Cache.h"
+#include "Guard.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Initial number of buckets; always a power of 2.
+static const size_t DEMANGLE_CACHE_BUCKETS = 1024;
+
+Demangle_Cache & Demangle_Cache::instance (void)
+{
+  static Demangle_Cache cache;
+  return cache;
+}
+
+Demangle_Cache::Demangle_Cache (void)
+: buckets_ (DEMANGLE_CACHE_BUCKETS, 0),
+  size_ (0),
+  hits_ (0),
+  misses_ (0)
+{
+
+}
+
+Demangle_Cache::~Demangle_Cache (void)
+{
+  this->destroy ();
+}
+
+size_t Demangle_Cache::hash (const std::string & name, UNDECORATION style)
+{
+  size_t hash = 2166136261U ^ static_cast <size_t> (style);
+
+  for (size_t i = 0; i < name.size (); ++ i)
+  {
+    hash ^= static_cast <unsigned char> (name[i]);
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+const Demangle_Cache::Entry *
+Demangle_Cache::find (size_t hash, const std::string & name, UNDECORATION style) const
+{
+  const Entry * entry = this->buckets_[hash & (this->buckets_.size () - 1)];
+
+  for (; 0 != entry; entry = entry->next_)
+  {
+    if (entry->hash_ == hash && entry->style_ == style && entry->name_ == name)
+      return entry;
+  }
+
+  return 0;
+}
+
+const std::string & Demangle_Cache::undecorate (const std::string & name, UNDECORATION style)
+{
+  const size_t hash = Demangle_Cache::hash (name, style);
+
+  {
+    Read_Guard <RW_Mutex> guard (this->lock_);
+    const Entry * entry = this->find (hash, name, style);
+
+    if (0 != entry)
+    {
+      ATOMIC::OPS::Increment (&this->hits_, static_cast <UINT64> (1));
+      return entry->result_;
+    }
+  }
+
+  // Undecorate the name before taking the write lock so lookups of other
+  // names are not blocked by the demangler.
+  std::string result = PIN_UndecorateSymbolName (name, style);
+
+  Write_Guard <RW_Mutex> guard (this->lock_);
+
+  // Another thread may have added the name in the meantime.
+  const Entry * found = this->find (hash, name, style);
+
+  if (0 != found)
+  {
+    ATOMIC::OPS::Increment (&this->hits_, static_cast <UINT64> (1));
+    return found->result_;
+  }
+
+  ATOMIC::OPS::Increment (&this->misses_, static_cast <UINT64> (1));
+
+  if (this->size_ >= this->buckets_.size ())
+    this->grow ();
+
+  Entry * entry = new Entry ();
+  entry->hash_ = hash;
+  entry->style_ = style;
+  entry->name_ = name;
+  entry->result_.swap (result);
+
+  Entry * & bucket = this->buckets_[hash & (this->buckets_.size () - 1)];
+  entry->next_ = bucket;
+  bucket = entry;
+
+  ++ this->size_;
+
+  return entry->result_;
+}
+
+void Demangle_Cache::grow (void)
+{
+  std::vector <Entry *> buckets (this->buckets_.size () * 2, 0);
+  const size_t mask = buckets.size () - 1;
+
+  for (size_t i = 0; i < this->buckets_.size (); ++ i)
+  {
+    Entry * entry = this->buckets_[i];
+
+    while (0 != entry)
+    {
+      Entry * next = entry->next_;
+      Entry * & bucket = buckets[entry->hash_ & mask];
+
+      entry->next_ = bucket;
+      bucket = entry;
+
+      entry = next;
+    }
+  }
+
+  this->buckets_.swap (buckets);
+}
+
+size_t Demangle_Cache::size (void) const
+{
+  Read_Guard <RW_Mutex> guard (this->lock_);
+  return this->size_;
+}
+
+void Demangle_Cache::clear (void)
+{
+  Write_Guard <RW_Mutex> guard (this->lock_);
+  this->destroy ();
+
+  this->buckets_.assign (DEMANGLE_CACHE_BUCKETS, 0);
+  this->size_ = 0;
+}
+
+void Demangle_Cache::destroy (void)
+{
+  for (size_t i = 0; i < this->buckets_.size (); ++ i)
+  {
+    Entry * entry = this->buckets_[i];
+
+    while (0 != entry)
+    {
+      Entry * next = entry->next_;
+      delete entry;
+      entry = next;
+    }
+
+    this->buckets_[i] = 0;
+  }
+}
+
+} // namespace OASIS
+} // namespace Pin
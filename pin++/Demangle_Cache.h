@@ -0,0 +1,132 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Demangle_Cache.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_DEMANGLE_CACHE_H_
+#define _OASIS_PIN_DEMANGLE_CACHE_H_
+
+#include "pin.H"
+#include "RW_Mutex.h"
+#include "atomic.hpp"
+
+#include "Pin_export.h"
+
+#include <string>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Demangle_Cache
+ *
+ * Process-wide memo of PIN_UndecorateSymbolName, keyed by the mangled name
+ * and the undecoration style. Each name is undecorated once, and the result
+ * is interned: the returned reference stays valid, and keeps its address,
+ * until the cache is cleared or destroyed. Tools that undecorate every
+ * routine of every image (e.g., once per style) therefore pay for the
+ * demangler once per name, and can compare or store the handles instead
+ * of copies.
+ *
+ * Lookups take a read lock, so the cache can be used from analysis
+ * routines as well as from instrumentation callbacks.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Demangle_Cache
+{
+public:
+  /// The cache used by Symbol::undecorate ().
+  static Demangle_Cache & instance (void);
+
+  /// Default constructor.
+  Demangle_Cache (void);
+
+  /// Destructor.
+  ~Demangle_Cache (void);
+
+  /**
+   * Undecorate a name.
+   *
+   * @param[in]       name            The mangled name
+   * @param[in]       style           The undecoration style
+   * @return          The interned undecorated name
+   */
+  const std::string & undecorate (const std::string & name, UNDECORATION style);
+
+  /// Number of names in the cache.
+  size_t size (void) const;
+
+  /// Number of lookups answered from the cache.
+  UINT64 hit_count (void) const;
+
+  /// Number of lookups that called the demangler.
+  UINT64 miss_count (void) const;
+
+  /// Remove all the names. The references returned so far are invalid.
+  void clear (void);
+
+private:
+  /**
+   * @struct Entry
+   *
+   * Undecorated name in a bucket's chain. Entries are never moved, so
+   * their results can be returned by reference.
+   */
+  struct Entry
+  {
+    size_t hash_;
+    UNDECORATION style_;
+    std::string name_;
+    std::string result_;
+    Entry * next_;
+  };
+
+  /// Hash a name and style.
+  static size_t hash (const std::string & name, UNDECORATION style);
+
+  /// Find an entry in the current buckets.
+  const Entry * find (size_t hash, const std::string & name, UNDECORATION style) const;
+
+  /// Double the number of buckets.
+  void grow (void);
+
+  /// Delete all the entries.
+  void destroy (void);
+
+  /// Chains of entries, indexed by hash.
+  std::vector <Entry *> buckets_;
+
+  /// Number of entries.
+  size_t size_;
+
+  /// Number of lookups answered from the cache.
+  volatile UINT64 hits_;
+
+  /// Number of lookups that called the demangler.
+  volatile UINT64 misses_;
+
+  /// Lock for the buckets.
+  mutable RW_Mutex lock_;
+
+  // prevent the following operations
+  Demangle_Cache (const Demangle_Cache &);
+  const Demangle_Cache & operator = (const Demangle_Cache &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Demangle_Cache.inl"
+
+#endif  // _OASIS_PIN_DEMANGLE_CACHE_H_
@@ -0,0 +1,22 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+UINT64 Demangle_Cache::hit_count (void) const
+{
+  return ATOMIC::OPS::Load (&this->hits_);
+}
+
+inline
+UINT64 Demangle_Cache::miss_count (void) const
+{
+  return ATOMIC::OPS::Load (&this->misses_);
+}
+
+} // namespace OASIS
+} // namespace Pin
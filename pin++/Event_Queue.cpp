@@ -0,0 +1,79 @@
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+Event_Queue <T>::Event_Queue (size_t capacity)
+: cells_ (0),
+  mask_ (0)
+{
+  // Round the capacity up to a power of 2 so the position of a slot is
+  // a mask instead of a division.
+  UINT64 size = 2;
+
+  while (size < capacity)
+    size <<= 1;
+
+  this->mask_ = size - 1;
+  this->cells_ = new Cell[size];
+
+  for (UINT64 i = 0; i < size; ++ i)
+    this->cells_[i].sequence_ = i;
+}
+
+template <typename T>
+Event_Queue <T>::~Event_Queue (void)
+{
+  delete [] this->cells_;
+}
+
+template <typename T>
+bool Event_Queue <T>::push (const T & event)
+{
+  for (;;)
+  {
+    // Nobody frees a slot once the queue is closed, so do not wait on one.
+    if (this->is_closed ())
+    {
+      ATOMIC::OPS::Increment (&this->drops_.value, static_cast <UINT64> (1));
+      return false;
+    }
+
+    if (this->enqueue (event))
+      return true;
+
+    PIN_Yield ();
+  }
+}
+
+template <typename T>
+bool Event_Queue <T>::wait (UINT32 timeout)
+{
+  if (!this->is_empty ())
+    return true;
+
+  // Tell the producers to signal, then check again in case an event was
+  // pushed before they could see the flag.
+  ATOMIC::OPS::CompareAndSwap (&this->waiting_.value, static_cast <UINT32> (0), static_cast <UINT32> (1));
+
+  if (this->is_empty ())
+    this->ready_.wait (timeout);
+
+  this->ready_.release ();
+  ATOMIC::OPS::Store (&this->waiting_.value, static_cast <UINT32> (0));
+  return !this->is_empty ();
+}
+
+template <typename T>
+void Event_Queue <T>::signal (void)
+{
+  // Only the first producer to see the flag signals the semaphore.
+  if (1 == ATOMIC::OPS::CompareAndSwap (&this->waiting_.value, static_cast <UINT32> (1), static_cast <UINT32> (0)))
+    this->ready_.set ();
+}
+
+} // namespace OASIS
+} // namespace Pin
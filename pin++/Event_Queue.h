@@ -0,0 +1,195 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Event_Queue.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_EVENT_QUEUE_H_
+#define _OASIS_PIN_EVENT_QUEUE_H_
+
+#include "pin.H"
+#include "atomic.hpp"
+
+#include "Padded.h"
+#include "Semaphore.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Event_Queue
+ *
+ * Bounded, lock-free queue of fixed-size events with many producers and a
+ * single consumer. The producers are analysis routines on application
+ * threads. The consumer is usually a Pin internal thread (see Thread) that
+ * processes the events in batches, off the critical path of the
+ * application.
+ *
+ * Each slot in the ring has a sequence number that tells whether it is
+ * free or full for the current lap, so a push is one compare-and-swap on
+ * the tail and two stores, and a pop never touches the tail. A full queue
+ * is handled by the producer: try_push () drops the event and counts the
+ * drop, and push () yields until a slot is free.
+ *
+ * Once the consumer stops, it closes the queue. A closed queue drops and
+ * counts new events, so a producer does not yield forever waiting on a
+ * slot that will never be freed. The events already in the queue can
+ * still be popped.
+ *
+ * The tail, the head, and the flags are each padded to their own cache
+ * line (see Padded), so the producers and the consumer do not falsely
+ * share a line. The alignment holds if the queue itself is not allocated
+ * on the heap, e.g., it is a member of the tool.
+ *
+ * The consumer can sleep in wait () when the queue is empty. A producer
+ * only signals the consumer if it is asleep, so pushes stay cheap while
+ * the consumer is busy. A wakeup can be missed if it races with the
+ * consumer going to sleep, so the consumer always sleeps with a timeout.
+ *
+ * T must be copyable with assignment, and should be a small POD type. The
+ * copy constructor and assignment operator for this class are disabled.
+ */
+template <typename T>
+class Event_Queue
+{
+public:
+  /// Type definition of the event type.
+  typedef T event_type;
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       capacity        Number of slots, rounded up to a power of 2
+   */
+  explicit Event_Queue (size_t capacity = 4096);
+
+  /// Destructor.
+  ~Event_Queue (void);
+
+  /// Number of slots in the queue.
+  size_t capacity (void) const;
+
+  /**
+   * Push an event if there is a free slot. If the queue is full, the
+   * event is dropped and counted.
+   *
+   * @param[in]       event           The event
+   * @retval          true            The event is in the queue
+   * @retval          false           The queue is full or closed
+   */
+  bool try_push (const T & event);
+
+  /**
+   * Push an event, and yield until there is a free slot. If the queue is
+   * closed, the event is dropped and counted.
+   *
+   * @param[in]       event           The event
+   * @retval          true            The event is in the queue
+   * @retval          false           The queue is closed
+   */
+  bool push (const T & event);
+
+  /**
+   * Pop an event. This method must only be called by the consumer.
+   *
+   * @param[out]      event           The event
+   * @retval          true            An event was popped
+   * @retval          false           The queue is empty
+   */
+  bool try_pop (T & event);
+
+  /**
+   * Pop up to \a max events. This method must only be called by the
+   * consumer.
+   *
+   * @param[out]      events          Array of at least \a max events
+   * @param[in]       max             Maximum number of events
+   * @return          Number of events popped
+   */
+  size_t pop (T * events, size_t max);
+
+  /**
+   * Wait until the queue is not empty, or the timeout expires. This
+   * method must only be called by the consumer.
+   *
+   * @param[in]       timeout         Timeout in ms
+   * @retval          true            The queue is not empty
+   */
+  bool wait (UINT32 timeout);
+
+  /// Wake the consumer, e.g., to tell it to stop.
+  void notify (void);
+
+  /// Close the queue, and wake the consumer. New events are dropped.
+  void close (void);
+
+  /// Test if the queue is closed.
+  bool is_closed (void) const;
+
+  /// Test if the queue is empty. This is exact only for the consumer.
+  bool is_empty (void) const;
+
+  /// Number of events dropped by try_push (), or by push () once closed.
+  UINT64 drops (void) const;
+
+private:
+  /// Slot in the ring.
+  struct Cell
+  {
+    /// Position of the slot; pos + 1 if full, pos + capacity once consumed.
+    volatile UINT64 sequence_;
+
+    /// The event in the slot.
+    T event_;
+  };
+
+  /// Push an event if there is a free slot.
+  bool enqueue (const T & event);
+
+  /// Wake the consumer if it is waiting.
+  void signal (void);
+
+  /// The ring of slots.
+  Cell * cells_;
+
+  /// Number of slots minus one.
+  UINT64 mask_;
+
+  /// Position of the next push. Shared by the producers.
+  Padded <volatile UINT64> tail_;
+
+  /// Position of the next pop. Owned by the consumer.
+  Padded <UINT64> head_;
+
+  /// Number of dropped events.
+  Padded <volatile UINT64> drops_;
+
+  /// The consumer is waiting.
+  Padded <volatile UINT32> waiting_;
+
+  /// The queue is closed.
+  Padded <volatile UINT32> closed_;
+
+  /// Semaphore the consumer waits on.
+  Semaphore ready_;
+
+  // prevent the following operations
+  Event_Queue (const Event_Queue &);
+  const Event_Queue & operator = (const Event_Queue &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Event_Queue.inl"
+#include "Event_Queue.cpp"
+
+#endif  // _OASIS_PIN_EVENT_QUEUE_H_
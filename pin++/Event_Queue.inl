@@ -0,0 +1,139 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+inline
+size_t Event_Queue <T>::capacity (void) const
+{
+  return static_cast <size_t> (this->mask_ + 1);
+}
+
+template <typename T>
+inline
+bool Event_Queue <T>::try_push (const T & event)
+{
+  if (!this->is_closed () && this->enqueue (event))
+    return true;
+
+  ATOMIC::OPS::Increment (&this->drops_.value, static_cast <UINT64> (1));
+  return false;
+}
+
+template <typename T>
+inline
+bool Event_Queue <T>::enqueue (const T & event)
+{
+  UINT64 pos = ATOMIC::OPS::Load (&this->tail_.value);
+
+  for (;;)
+  {
+    Cell & cell = this->cells_[pos & this->mask_];
+    UINT64 seq = ATOMIC::OPS::Load (&cell.sequence_, ATOMIC::BARRIER_LD_NEXT);
+    INT64 diff = static_cast <INT64> (seq - pos);
+
+    if (0 == diff)
+    {
+      // The slot is free for this lap, so try to claim it.
+      UINT64 prev = ATOMIC::OPS::CompareAndSwap (&this->tail_.value, pos, pos + 1);
+
+      if (prev == pos)
+      {
+        cell.event_ = event;
+        ATOMIC::OPS::Store (&cell.sequence_, pos + 1, ATOMIC::BARRIER_ST_PREV);
+
+        if (0 != ATOMIC::OPS::Load (&this->waiting_.value))
+          this->signal ();
+
+        return true;
+      }
+
+      pos = prev;
+    }
+    else if (diff < 0)
+    {
+      // The consumer has not freed the slot from the last lap.
+      return false;
+    }
+    else
+    {
+      // Another producer claimed the slot.
+      pos = ATOMIC::OPS::Load (&this->tail_.value);
+    }
+  }
+}
+
+template <typename T>
+inline
+bool Event_Queue <T>::try_pop (T & event)
+{
+  const UINT64 pos = this->head_.value;
+  Cell & cell = this->cells_[pos & this->mask_];
+
+  if (ATOMIC::OPS::Load (&cell.sequence_, ATOMIC::BARRIER_LD_NEXT) != pos + 1)
+    return false;
+
+  event = cell.event_;
+
+  // Free the slot for the next lap.
+  ATOMIC::OPS::Store (&cell.sequence_, pos + this->mask_ + 1, ATOMIC::BARRIER_ST_PREV);
+  this->head_.value = pos + 1;
+
+  return true;
+}
+
+template <typename T>
+inline
+size_t Event_Queue <T>::pop (T * events, size_t max)
+{
+  size_t count = 0;
+
+  while (count < max && this->try_pop (events[count]))
+    ++ count;
+
+  return count;
+}
+
+template <typename T>
+inline
+bool Event_Queue <T>::is_empty (void) const
+{
+  const Cell & cell = this->cells_[this->head_.value & this->mask_];
+  return ATOMIC::OPS::Load (&cell.sequence_, ATOMIC::BARRIER_LD_NEXT) != this->head_.value + 1;
+}
+
+template <typename T>
+inline
+UINT64 Event_Queue <T>::drops (void) const
+{
+  return ATOMIC::OPS::Load (&this->drops_.value);
+}
+
+template <typename T>
+inline
+void Event_Queue <T>::notify (void)
+{
+  this->ready_.set ();
+}
+
+template <typename T>
+inline
+void Event_Queue <T>::close (void)
+{
+  ATOMIC::OPS::Store (&this->closed_.value, static_cast <UINT32> (1));
+  this->ready_.set ();
+}
+
+template <typename T>
+inline
+bool Event_Queue <T>::is_closed (void) const
+{
+  return 0 != ATOMIC::OPS::Load (&this->closed_.value);
+}
+
+} // namespace OASIS
+} // namespace Pin
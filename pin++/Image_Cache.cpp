@@ -0,0 +1,224 @@
+// $Id$
+
+#include "Image_Cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined (TARGET_WINDOWS)
+#include <direct.h>
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Magic number at the start of a cache file.
+static const char IMAGE_CACHE_MAGIC [8] = { 'P', 'I', 'N', 'P', 'P', 'I', 'C', '2' };
+
+/// Largest string read from a cache file.
+static const UINT32 IMAGE_CACHE_MAX_STRING = 1 << 24;
+
+static bool write_u32 (FILE * file, UINT32 value)
+{
+  return 1 == ::fwrite (&value, sizeof (UINT32), 1, file);
+}
+
+static bool write_u64 (FILE * file, UINT64 value)
+{
+  return 1 == ::fwrite (&value, sizeof (UINT64), 1, file);
+}
+
+static bool write_string (FILE * file, const std::string & value)
+{
+  return write_u32 (file, static_cast <UINT32> (value.size ())) &&
+         value.size () == ::fwrite (value.data (), 1, value.size (), file);
+}
+
+static bool read_u32 (FILE * file, UINT32 & value)
+{
+  return 1 == ::fread (&value, sizeof (UINT32), 1, file);
+}
+
+static bool read_u64 (FILE * file, UINT64 & value)
+{
+  return 1 == ::fread (&value, sizeof (UINT64), 1, file);
+}
+
+static bool read_string (FILE * file, std::string & value)
+{
+  UINT32 size = 0;
+
+  if (!read_u32 (file, size) || size > IMAGE_CACHE_MAX_STRING)
+    return false;
+
+  value.resize (size);
+  return 0 == size || size == ::fread (&value[0], 1, size, file);
+}
+
+Image_Cache::Image_Cache (const std::string & directory, const std::string & config)
+: directory_ (directory.empty () ? "." : directory),
+  config_ (config),
+  enabled_ (true),
+  refresh_ (false)
+{
+  // The directory may already exist, and a store fails later if it
+  // cannot be created.
+#if defined (TARGET_WINDOWS)
+  ::_mkdir (this->directory_.c_str ());
+#else
+  ::mkdir (this->directory_.c_str (), 0755);
+#endif
+}
+
+bool Image_Cache::identity (const std::string & path, UINT64 & size, INT64 & mtime)
+{
+  struct stat st;
+
+  if (0 != ::stat (path.c_str (), &st))
+    return false;
+
+  const INT64 NS_PER_SEC = 1000000000;
+  size = static_cast <UINT64> (st.st_size);
+
+#if defined (TARGET_WINDOWS)
+  mtime = static_cast <INT64> (st.st_mtime) * NS_PER_SEC;
+#elif defined (TARGET_MAC)
+  mtime = static_cast <INT64> (st.st_mtimespec.tv_sec) * NS_PER_SEC + st.st_mtimespec.tv_nsec;
+#else
+  mtime = static_cast <INT64> (st.st_mtim.tv_sec) * NS_PER_SEC + st.st_mtim.tv_nsec;
+#endif
+
+  return true;
+}
+
+std::string Image_Cache::filename (const std::string & path) const
+{
+  // Name the file by a hash of the path. The path is also stored in the
+  // file, so a collision is only a miss.
+  UINT64 hash = 14695981039346656037ULL;
+
+  for (size_t i = 0; i < path.size (); ++ i)
+  {
+    hash ^= static_cast <unsigned char> (path[i]);
+    hash *= 1099511628211ULL;
+  }
+
+  char name [32];
+  ::sprintf (name, "/%016llx.cache", static_cast <unsigned long long> (hash));
+
+  return this->directory_ + name;
+}
+
+bool Image_Cache::lookup (const std::string & path, entries_type & entries) const
+{
+  entries.clear ();
+
+  if (!this->enabled_ || this->refresh_)
+    return false;
+
+  UINT64 size = 0;
+  INT64 mtime = 0;
+
+  if (!Image_Cache::identity (path, size, mtime))
+    return false;
+
+  FILE * file = ::fopen (this->filename (path).c_str (), "rb");
+
+  if (0 == file)
+    return false;
+
+  char magic [sizeof (IMAGE_CACHE_MAGIC)];
+  UINT64 cached_size = 0, cached_mtime = 0;
+  UINT32 count = 0;
+  std::string cached_path, cached_config;
+
+  bool valid =
+    1 == ::fread (magic, sizeof (magic), 1, file) &&
+    0 == ::memcmp (magic, IMAGE_CACHE_MAGIC, sizeof (magic)) &&
+    read_string (file, cached_path) && cached_path == path &&
+    read_u64 (file, cached_size) && cached_size == size &&
+    read_u64 (file, cached_mtime) && static_cast <INT64> (cached_mtime) == mtime &&
+    read_string (file, cached_config) && cached_config == this->config_ &&
+    read_u32 (file, count);
+
+  for (UINT32 i = 0; valid && i < count; ++ i)
+  {
+    Entry entry;
+    UINT64 offset = 0;
+
+    valid = read_u32 (file, entry.tag_) && read_u64 (file, offset) && read_string (file, entry.data_);
+
+    entry.offset_ = static_cast <ADDRINT> (offset);
+    entries.push_back (entry);
+  }
+
+  // The file must end after the last entry.
+  valid = valid && EOF == ::fgetc (file);
+  ::fclose (file);
+
+  if (!valid)
+    entries.clear ();
+
+  return valid;
+}
+
+bool Image_Cache::store (const std::string & path, const entries_type & entries) const
+{
+  if (!this->enabled_)
+    return false;
+
+  UINT64 size = 0;
+  INT64 mtime = 0;
+
+  if (!Image_Cache::identity (path, size, mtime))
+    return false;
+
+  const std::string filename = this->filename (path);
+
+  char suffix [32];
+  ::sprintf (suffix, ".%u.tmp", static_cast <unsigned> (PIN_GetPid ()));
+
+  const std::string tempname = filename + suffix;
+  FILE * file = ::fopen (tempname.c_str (), "wb");
+
+  if (0 == file)
+    return false;
+
+  bool written =
+    1 == ::fwrite (IMAGE_CACHE_MAGIC, sizeof (IMAGE_CACHE_MAGIC), 1, file) &&
+    write_string (file, path) &&
+    write_u64 (file, size) &&
+    write_u64 (file, static_cast <UINT64> (mtime)) &&
+    write_string (file, this->config_) &&
+    write_u32 (file, static_cast <UINT32> (entries.size ()));
+
+  for (entries_type::const_iterator iter = entries.begin (); written && iter != entries.end (); ++ iter)
+  {
+    written = write_u32 (file, iter->tag_) &&
+              write_u64 (file, iter->offset_) &&
+              write_string (file, iter->data_);
+  }
+
+  written = 0 == ::fclose (file) && written;
+
+#if defined (TARGET_WINDOWS)
+  // rename () does not replace an existing file on Windows.
+  if (written)
+    ::remove (filename.c_str ());
+#endif
+
+  if (!written || 0 != ::rename (tempname.c_str (), filename.c_str ()))
+  {
+    ::remove (tempname.c_str ());
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,145 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Image_Cache.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_IMAGE_CACHE_H_
+#define _OASIS_PIN_IMAGE_CACHE_H_
+
+#include "pin.H"
+#include "Pin_export.h"
+
+#include <string>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Image_Cache
+ *
+ * Persistent cache of the instrumentation decisions a tool makes for an
+ * image. A tool that walks every section, routine, and symbol of an image
+ * to decide what to instrument (e.g., by undecorating and matching the
+ * names) stores the routines it selected, and the data it derived from
+ * them, the first time it sees the image. On later runs, the tool
+ * instruments the image straight from the cache, and skips the walk.
+ *
+ * The cache has one file per image in a directory. The file is keyed by
+ * the path, size, and modification time of the image, and a configuration
+ * string from the tool. The modification time has nanosecond resolution
+ * where the file system has it, so an image rebuilt within the same second
+ * is still detected. The configuration must hold everything that affects
+ * the decisions, e.g., the options of the tool, and a version the tool
+ * bumps when its matching code changes. If any of them changed, the lookup
+ * misses, and the next store replaces the file. Routines are stored as
+ * offsets from the link-time addresses of the image (i.e., the address
+ * minus Image::load_offset ()), so the cache is still valid if the image
+ * is loaded at a different address.
+ *
+ * A store writes a temporary file, and renames it over the old one, so
+ * concurrent runs of the tool never read a partial file.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Image_Cache
+{
+public:
+  /**
+   * @struct Entry
+   *
+   * One cached decision of the tool.
+   */
+  struct Entry
+  {
+    /// Tool-defined kind of the decision.
+    UINT32 tag_;
+
+    /// Offset of the routine from the link-time base of the image.
+    ADDRINT offset_;
+
+    /// Data the tool derived from the routine.
+    std::string data_;
+  };
+
+  /// Type definition of the entries of an image.
+  typedef std::vector <Entry> entries_type;
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       directory       Directory for the cache files
+   * @param[in]       config          Options of the tool that affect the decisions
+   */
+  Image_Cache (const std::string & directory, const std::string & config);
+
+  /// Destructor.
+  ~Image_Cache (void);
+
+  /// Test if the cache is enabled.
+  bool is_enabled (void) const;
+
+  /// Disable the cache. Lookups miss, and stores are ignored.
+  void disable (void);
+
+  /// Ignore the existing files. Lookups miss, and stores replace the files.
+  void refresh (void);
+
+  /**
+   * Load the entries of an image.
+   *
+   * @param[in]       path            Path of the image
+   * @param[out]      entries         The entries
+   * @retval          true            The cache is valid for the image
+   * @retval          false           Miss; the tool must walk the image
+   */
+  bool lookup (const std::string & path, entries_type & entries) const;
+
+  /**
+   * Store the entries of an image.
+   *
+   * @param[in]       path            Path of the image
+   * @param[in]       entries         The entries
+   * @retval          true            The entries are stored
+   */
+  bool store (const std::string & path, const entries_type & entries) const;
+
+  /// Path of the cache file of an image.
+  std::string filename (const std::string & path) const;
+
+private:
+  /// Get the size and modification time (in ns) of a file.
+  static bool identity (const std::string & path, UINT64 & size, INT64 & mtime);
+
+  /// Directory for the cache files.
+  std::string directory_;
+
+  /// Options of the tool.
+  std::string config_;
+
+  /// The cache is enabled.
+  bool enabled_;
+
+  /// The existing files are ignored.
+  bool refresh_;
+
+  // prevent the following operations
+  Image_Cache (const Image_Cache &);
+  const Image_Cache & operator = (const Image_Cache &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Image_Cache.inl"
+
+#endif  // _OASIS_PIN_IMAGE_CACHE_H_
@@ -0,0 +1,34 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Image_Cache::~Image_Cache (void)
+{
+
+}
+
+inline
+bool Image_Cache::is_enabled (void) const
+{
+  return this->enabled_;
+}
+
+inline
+void Image_Cache::disable (void)
+{
+  this->enabled_ = false;
+}
+
+inline
+void Image_Cache::refresh (void)
+{
+  this->refresh_ = true;
+}
+
+} // namespace OASIS
+} // namespace Pin
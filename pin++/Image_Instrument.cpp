@@ -11,8 +11,18 @@ namespace Pin
 template <typename T>
 VOID Image_Instrument <T>::__instrument (IMG img, VOID * v)
 {
+  OASIS_PIN_PROFILE_HOOK (HOOK_IMG, 0);
   reinterpret_cast <T *> (v)->handle_instrument (Image (img));
 }
 
+//
+// __unload
+//
+template <typename T>
+VOID Image_Instrument <T>::__unload (IMG img, VOID * v)
+{
+  reinterpret_cast <T *> (v)->handle_unload (Image (img));
+}
+
 } // namespace OASIS
 } // namespace Pin
@@ -24,7 +24,11 @@ namespace Pin
 /**
  * @class Image_Instrument
  *
- * Base class for instruction-level instrumentation Pin tools.
+ * Base class for image-level instrumentation Pin tools. The subclass
+ * implements handle_instrument (img), which is called when an image is
+ * loaded. If the subclass calls enable_unload_callback (), it must also
+ * implement handle_unload (img), which is called before an image is
+ * unloaded.
  */
 template <typename T>
 class Image_Instrument : public Instrument
@@ -36,8 +40,13 @@ public:
   /// Destructor.
   ~Image_Instrument (void);
 
+  /// Enable the callback for unloading an image.
+  void enable_unload_callback (void);
+
 private:
   static VOID __instrument (IMG image, VOID * v);
+
+  static VOID __unload (IMG image, VOID * v);
 };
 
 } // namespace Pin
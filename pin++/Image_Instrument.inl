@@ -18,6 +18,7 @@ Image_Instrument <T>::Image_Instrument (void)
 #endif
   
   IMG_AddInstrumentFunction (&Image_Instrument::__instrument, this);
+  OASIS_PIN_PROFILE_INIT ();
 }
 
 //
@@ -30,5 +31,15 @@ Image_Instrument <T>::~Image_Instrument (void)
 
 }
 
+//
+// enable_unload_callback
+//
+template <typename T>
+inline
+void Image_Instrument <T>::enable_unload_callback (void)
+{
+  IMG_AddUnloadFunction (&Image_Instrument::__unload, this);
+}
+
 } // namespace OASIS
 } // namespace Pin
@@ -2,6 +2,7 @@
 #define _OASIS_PIN_INSERT_T_H_
 
 #include "Arg_List.h"
+#include "Instrument_Profiler.h"
 
 namespace OASIS
 {
@@ -18,8 +19,16 @@ struct Insert_Call_T
   typedef VOID (* funcptr_type) (pin_type, IPOINT, AFUNPTR, ...);
 };
 
-template <typename S, typename CALLBACK>
-struct Insert_Base_T
+/**
+ * @struct Insert_Call_Base_T
+ *
+ * Base class of the insert functors that calls the insert function. The
+ * arguments are passed to Pin after IARG_FAST_ANALYSIS_CALL, and they end
+ * with IARG_END. Each call is counted by the instrumentation profiler, if
+ * enabled.
+ */
+template <typename S>
+struct Insert_Call_Base_T
 {
   /// Type definition of the function pointer.
   typedef typename Insert_Call_T <S>::funcptr_type funcptr_type;
@@ -28,15 +37,297 @@ struct Insert_Base_T
    * Initialization constructor
    *
    * @param[in]       insert        Pointer to insert function
-   * @param[in]       callback      Target callback object to insert
    */
-  Insert_Base_T (funcptr_type insert, CALLBACK & callback)
-    : insert_ (insert),
-      callback_ (callback) { }
+  Insert_Call_Base_T (funcptr_type insert)
+    : insert_ (insert)
+  {
+
+  }
 
 protected:
+  /// @{ Call the insert function with the arguments.
+  template <typename A0>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0);
+  }
+
+  template <typename A0, typename A1>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1);
+  }
+
+  template <typename A0, typename A1, typename A2>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13, A14 a14)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13, A14 a14, A15 a15)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13, A14 a14, A15 a15, A16 a16)
+  {
+    OASIS_PIN_PROFILE_INSERT ();
+    this->insert_ (scope, location, analyze, IARG_FAST_ANALYSIS_CALL, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  }
+  /// @}
+
   /// Pointer to the insert function
   funcptr_type insert_;
+};
+
+/**
+ * @struct Insert_Base_T
+ *
+ * Base class of the insert functors. The callback object is passed to the
+ * analysis routine as an IARG_PTR so the analysis routine can dispatch to
+ * the object's handler. The \a IS_STATIC template parameter selects the
+ * specialization for static callbacks, which do not pass the object.
+ */
+template <typename S, typename CALLBACK, bool IS_STATIC = CALLBACK::is_static_callback>
+struct Insert_Base_T : public Insert_Call_Base_T <S>
+{
+  /// Type definition of the base type that calls the insert function.
+  typedef Insert_Call_Base_T <S> insert_call_type;
+
+  /// Type definition of the function pointer.
+  typedef typename insert_call_type::funcptr_type funcptr_type;
+
+  /**
+   * Initialization constructor
+   *
+   * @param[in]       insert        Pointer to insert function
+   * @param[in]       callback      Target callback object to insert
+   */
+  Insert_Base_T (funcptr_type insert, CALLBACK & callback)
+    : insert_call_type (insert),
+      callback_ (callback)
+  {
+
+  }
+
+protected:
+  /// @{ Insert the call with the callback object in front of the arguments.
+  template <typename A0>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0);
+  }
+
+  template <typename A0, typename A1>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1);
+  }
+
+  template <typename A0, typename A1, typename A2>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7, a8);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
+  }
+
+  template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14>
+  void insert (const S & scope, IPOINT location, AFUNPTR analyze, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13, A14 a14)
+  {
+    this->insert_call_type::insert (scope, location, analyze, IARG_PTR, &this->callback_, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+  }
+  /// @}
+
+  /// Target callback object
+  CALLBACK & callback_;
+};
+
+/**
+ * @struct Insert_Base_T <S, CALLBACK, true>
+ *
+ * Base class of the insert functors for static callbacks. The analysis
+ * routine of a static callback does not take the callback object, so the
+ * arguments are given to Pin as they are.
+ */
+template <typename S, typename CALLBACK>
+struct Insert_Base_T <S, CALLBACK, true> : public Insert_Call_Base_T <S>
+{
+  /// Type definition of the base type that calls the insert function.
+  typedef Insert_Call_Base_T <S> insert_call_type;
+
+  /// Type definition of the function pointer.
+  typedef typename insert_call_type::funcptr_type funcptr_type;
+
+  /**
+   * Initialization constructor
+   *
+   * @param[in]       insert        Pointer to insert function
+   * @param[in]       callback      Target callback object to insert
+   */
+  Insert_Base_T (funcptr_type insert, CALLBACK & callback)
+    : insert_call_type (insert),
+      callback_ (callback)
+  {
+
+  }
+
+protected:
+  using insert_call_type::insert;
 
   /// Target callback object
   CALLBACK & callback_;
@@ -83,13 +374,10 @@ struct Insert_T <S, CALLBACK, 0> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (const S & scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, 
-                   location, 
-                   (AFUNPTR)analyze, 
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, 
-                   &this->callback_,
-                   IARG_END);
+    this->insert (scope, 
+                  location, 
+                  (AFUNPTR)analyze,
+                  IARG_END);
   }
 };
 
@@ -113,14 +401,11 @@ struct Insert_T <S, CALLBACK, 1> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (const S & scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, 
-                   location, 
-                   (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, 
-                   &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   IARG_END);
+    this->insert (scope, 
+                  location, 
+                  (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  IARG_END);
   }
 };
 
@@ -145,23 +430,19 @@ struct Insert_T <S, CALLBACK, 2> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1),
+                  IARG_END);
   }
 };
 
@@ -186,25 +467,21 @@ struct Insert_T <S, CALLBACK, 3> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   Arg_List <CALLBACK>::template get_arg <2> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  Arg_List <CALLBACK>::template get_arg <2> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1),
+                  IARG_END);
   }
 };
 
@@ -229,22 +506,18 @@ struct Insert_T <S, CALLBACK, 4> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   Arg_List <CALLBACK>::template get_arg <2> (),
-                   Arg_List <CALLBACK>::template get_arg <3> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  Arg_List <CALLBACK>::template get_arg <2> (),
+                  Arg_List <CALLBACK>::template get_arg <3> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-       IARG_FAST_ANALYSIS_CALL,
-       IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
        Arg_List <CALLBACK>::template get_arg <0> (xarg1),
        Arg_List <CALLBACK>::template get_arg <1> (xarg1),
        Arg_List <CALLBACK>::template get_arg <2> (xarg1),
@@ -255,14 +528,12 @@ struct Insert_T <S, CALLBACK, 4> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
+                  IARG_END);
   }
 };
 
@@ -287,43 +558,37 @@ struct Insert_T <S, CALLBACK, 5> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   Arg_List <CALLBACK>::template get_arg <2> (),
-                   Arg_List <CALLBACK>::template get_arg <3> (),
-                   Arg_List <CALLBACK>::template get_arg <4> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  Arg_List <CALLBACK>::template get_arg <2> (),
+                  Arg_List <CALLBACK>::template get_arg <3> (),
+                  Arg_List <CALLBACK>::template get_arg <4> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
+                  IARG_END);
   }
 };
 
@@ -348,61 +613,53 @@ struct Insert_T <S, CALLBACK, 6> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   Arg_List <CALLBACK>::template get_arg <2> (),
-                   Arg_List <CALLBACK>::template get_arg <3> (),
-                   Arg_List <CALLBACK>::template get_arg <4> (),
-                   Arg_List <CALLBACK>::template get_arg <5> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  Arg_List <CALLBACK>::template get_arg <2> (),
+                  Arg_List <CALLBACK>::template get_arg <3> (),
+                  Arg_List <CALLBACK>::template get_arg <4> (),
+                  Arg_List <CALLBACK>::template get_arg <5> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
+                  IARG_END);
   }
 };
 
@@ -427,65 +684,57 @@ struct Insert_T <S, CALLBACK, 7> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   Arg_List <CALLBACK>::template get_arg <2> (),
-                   Arg_List <CALLBACK>::template get_arg <3> (),
-                   Arg_List <CALLBACK>::template get_arg <4> (),
-                   Arg_List <CALLBACK>::template get_arg <5> (),
-                   Arg_List <CALLBACK>::template get_arg <6> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  Arg_List <CALLBACK>::template get_arg <2> (),
+                  Arg_List <CALLBACK>::template get_arg <3> (),
+                  Arg_List <CALLBACK>::template get_arg <4> (),
+                  Arg_List <CALLBACK>::template get_arg <5> (),
+                  Arg_List <CALLBACK>::template get_arg <6> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3),
+                  IARG_END);
   }
 };
 
@@ -510,86 +759,76 @@ struct Insert_T <S, CALLBACK, 8> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   Arg_List <CALLBACK>::template get_arg <2> (),
-                   Arg_List <CALLBACK>::template get_arg <3> (),
-                   Arg_List <CALLBACK>::template get_arg <4> (),
-                   Arg_List <CALLBACK>::template get_arg <5> (),
-                   Arg_List <CALLBACK>::template get_arg <6> (),
-                   Arg_List <CALLBACK>::template get_arg <7> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  Arg_List <CALLBACK>::template get_arg <2> (),
+                  Arg_List <CALLBACK>::template get_arg <3> (),
+                  Arg_List <CALLBACK>::template get_arg <4> (),
+                  Arg_List <CALLBACK>::template get_arg <5> (),
+                  Arg_List <CALLBACK>::template get_arg <6> (),
+                  Arg_List <CALLBACK>::template get_arg <7> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3, xarg4),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3, xarg4),
+                  IARG_END);
   }
 };
 
@@ -614,91 +853,81 @@ struct Insert_T <S, CALLBACK, 9> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (),
-                   Arg_List <CALLBACK>::template get_arg <1> (),
-                   Arg_List <CALLBACK>::template get_arg <2> (),
-                   Arg_List <CALLBACK>::template get_arg <3> (),
-                   Arg_List <CALLBACK>::template get_arg <4> (),
-                   Arg_List <CALLBACK>::template get_arg <5> (),
-                   Arg_List <CALLBACK>::template get_arg <6> (),
-                   Arg_List <CALLBACK>::template get_arg <7> (),
-                   Arg_List <CALLBACK>::template get_arg <8> (),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (),
+                  Arg_List <CALLBACK>::template get_arg <1> (),
+                  Arg_List <CALLBACK>::template get_arg <2> (),
+                  Arg_List <CALLBACK>::template get_arg <3> (),
+                  Arg_List <CALLBACK>::template get_arg <4> (),
+                  Arg_List <CALLBACK>::template get_arg <5> (),
+                  Arg_List <CALLBACK>::template get_arg <6> (),
+                  Arg_List <CALLBACK>::template get_arg <7> (),
+                  Arg_List <CALLBACK>::template get_arg <8> (),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1),
-                   Arg_List <CALLBACK>::template get_arg <8> (xarg1),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1),
+                  Arg_List <CALLBACK>::template get_arg <8> (xarg1),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2),
-                   Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2),
+                  Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3),
-                   Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2, xarg3),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3),
+                  Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2, xarg3),
+                  IARG_END);
   }
 
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                   IARG_FAST_ANALYSIS_CALL,
-                   IARG_PTR, &this->callback_,
-                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3, xarg4),
-                   Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2, xarg3, xarg4),
-                   IARG_END);
+    this->insert (scope, location, (AFUNPTR)analyze,
+                  Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <3> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <4> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <5> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <6> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <7> (xarg1, xarg2, xarg3, xarg4),
+                  Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2, xarg3, xarg4),
+                  IARG_END);
   }
 };
 
@@ -723,9 +952,7 @@ struct Insert_T <S, CALLBACK, 10> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (),
                   Arg_List <CALLBACK>::template get_arg <1> (),
                   Arg_List <CALLBACK>::template get_arg <2> (),
@@ -742,9 +969,7 @@ struct Insert_T <S, CALLBACK, 10> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                    IARG_FAST_ANALYSIS_CALL,
-                    IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                     Arg_List <CALLBACK>::template get_arg <0> (xarg1),
                     Arg_List <CALLBACK>::template get_arg <1> (xarg1),
                     Arg_List <CALLBACK>::template get_arg <2> (xarg1),
@@ -761,9 +986,7 @@ struct Insert_T <S, CALLBACK, 10> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
@@ -780,9 +1003,7 @@ struct Insert_T <S, CALLBACK, 10> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
@@ -799,9 +1020,7 @@ struct Insert_T <S, CALLBACK, 10> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
@@ -818,9 +1037,7 @@ struct Insert_T <S, CALLBACK, 10> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5),
@@ -856,9 +1073,7 @@ struct Insert_T <S, CALLBACK, 11> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (),
                   Arg_List <CALLBACK>::template get_arg <1> (),
                   Arg_List <CALLBACK>::template get_arg <2> (),
@@ -876,9 +1091,7 @@ struct Insert_T <S, CALLBACK, 11> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
@@ -896,9 +1109,7 @@ struct Insert_T <S, CALLBACK, 11> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
@@ -916,9 +1127,7 @@ struct Insert_T <S, CALLBACK, 11> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
@@ -936,9 +1145,7 @@ struct Insert_T <S, CALLBACK, 11> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
@@ -956,9 +1163,7 @@ struct Insert_T <S, CALLBACK, 11> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5),
@@ -995,9 +1200,7 @@ struct Insert_T <S, CALLBACK, 12> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (),
                   Arg_List <CALLBACK>::template get_arg <1> (),
                   Arg_List <CALLBACK>::template get_arg <2> (),
@@ -1016,9 +1219,7 @@ struct Insert_T <S, CALLBACK, 12> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
@@ -1037,9 +1238,7 @@ struct Insert_T <S, CALLBACK, 12> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
@@ -1058,9 +1257,7 @@ struct Insert_T <S, CALLBACK, 12> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
@@ -1079,9 +1276,7 @@ struct Insert_T <S, CALLBACK, 12> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
@@ -1100,9 +1295,7 @@ struct Insert_T <S, CALLBACK, 12> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5),
@@ -1121,9 +1314,7 @@ struct Insert_T <S, CALLBACK, 12> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5, const XARG6 & xarg6)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
@@ -1161,9 +1352,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (),
                   Arg_List <CALLBACK>::template get_arg <1> (),
                   Arg_List <CALLBACK>::template get_arg <2> (),
@@ -1183,9 +1372,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
@@ -1205,9 +1392,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
@@ -1227,9 +1412,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
@@ -1249,9 +1432,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
@@ -1271,9 +1452,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5),
@@ -1293,9 +1472,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5, const XARG6 & xarg6)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
@@ -1307,6 +1484,7 @@ struct Insert_T <S, CALLBACK, 13> : public Insert_Base_T <S, CALLBACK>
                   Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <9> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <10> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
+                  Arg_List <CALLBACK>::template get_arg <11> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <12> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   IARG_END);
   }
@@ -1333,9 +1511,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A>
   void operator () (S scope, IPOINT location, A analyze)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (),
                   Arg_List <CALLBACK>::template get_arg <1> (),
                   Arg_List <CALLBACK>::template get_arg <2> (),
@@ -1356,9 +1532,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1),
@@ -1379,9 +1553,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2),
@@ -1402,9 +1574,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3),
@@ -1425,9 +1595,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4),
@@ -1448,9 +1616,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5),
@@ -1471,9 +1637,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5, const XARG6 & xarg6)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
@@ -1485,6 +1649,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
                   Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <9> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <10> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
+                  Arg_List <CALLBACK>::template get_arg <11> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <12> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   Arg_List <CALLBACK>::template get_arg <13> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6),
                   IARG_END);
@@ -1493,9 +1658,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
   template <typename A, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6, typename XARG7>
   void operator () (S scope, IPOINT location, A analyze, const XARG1 & xarg1, const XARG2 & xarg2, const XARG3 & xarg3, const XARG4 & xarg4, const XARG5 & xarg5, const XARG6 & xarg6, const XARG7 & xarg7)
   {
-    this->insert_ (scope, location, (AFUNPTR)analyze,
-                  IARG_FAST_ANALYSIS_CALL,
-                  IARG_PTR, &this->callback_,
+    this->insert (scope, location, (AFUNPTR)analyze,
                   Arg_List <CALLBACK>::template get_arg <0> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
                   Arg_List <CALLBACK>::template get_arg <1> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
                   Arg_List <CALLBACK>::template get_arg <2> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
@@ -1507,6 +1670,7 @@ struct Insert_T <S, CALLBACK, 14> : public Insert_Base_T <S, CALLBACK>
                   Arg_List <CALLBACK>::template get_arg <8> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
                   Arg_List <CALLBACK>::template get_arg <9> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
                   Arg_List <CALLBACK>::template get_arg <10> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
+                  Arg_List <CALLBACK>::template get_arg <11> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
                   Arg_List <CALLBACK>::template get_arg <12> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
                   Arg_List <CALLBACK>::template get_arg <13> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6, xarg7),
                   IARG_END);
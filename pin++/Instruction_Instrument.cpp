@@ -11,6 +11,7 @@ namespace Pin
 template <typename T>
 VOID Instruction_Instrument <T>::__instrument (INS ins, VOID * v)
 {
+  OASIS_PIN_PROFILE_HOOK (HOOK_INS, 1);
   reinterpret_cast <T *> (v)->handle_instrument (Ins (ins));
 }
 
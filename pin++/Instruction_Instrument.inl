@@ -14,6 +14,7 @@ inline
 Instruction_Instrument <T>::Instruction_Instrument (void)
 {
   INS_AddInstrumentFunction (&Instruction_Instrument::__instrument, this);
+  OASIS_PIN_PROFILE_INIT ();
 }
 
 //
@@ -13,6 +13,8 @@
 #ifndef _OASIS_PIN_INSTRUMENT_H_
 #define _OASIS_PIN_INSTRUMENT_H_
 
+#include "Instrument_Profiler.h"
+
 namespace OASIS
 {
 namespace Pin
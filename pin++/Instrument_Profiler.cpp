@@ -0,0 +1,113 @@
+// $Id$
+
+#include "Instrument_Profiler.h"
+
+#include <fstream>
+#include <iomanip>
+
+#if defined (TARGET_WINDOWS)
+namespace WINDOWS
+{
+#include <windows.h>
+}
+#else
+#include <time.h>
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Names of the hooks in the report.
+static const char * INSTRUMENT_PROFILER_HOOKS [Instrument_Profiler::HOOK_COUNT] =
+{
+  "trace", "ins", "rtn", "img", "other"
+};
+
+Instrument_Profiler & Instrument_Profiler::instance (void)
+{
+  static Instrument_Profiler profiler;
+  return profiler;
+}
+
+Instrument_Profiler::Instrument_Profiler (void)
+: active_ (HOOK_NONE),
+  output_ ("instrument_profile.out")
+{
+  for (size_t i = 0; i < HOOK_COUNT; ++ i)
+  {
+    Stats & stats = this->stats_[i];
+    stats.calls_ = stats.total_time_ = stats.max_time_ = stats.instructions_ = stats.inserts_ = 0;
+  }
+
+  PIN_AddFiniFunction (&Instrument_Profiler::__fini, this);
+}
+
+UINT64 Instrument_Profiler::now (void)
+{
+#if defined (TARGET_WINDOWS)
+  static WINDOWS::LARGE_INTEGER frequency = { 0 };
+
+  if (0 == frequency.QuadPart)
+    WINDOWS::QueryPerformanceFrequency (&frequency);
+
+  WINDOWS::LARGE_INTEGER counter;
+  WINDOWS::QueryPerformanceCounter (&counter);
+
+  return static_cast <UINT64> (counter.QuadPart / frequency.QuadPart) * 1000000000ULL +
+         static_cast <UINT64> (counter.QuadPart % frequency.QuadPart) * 1000000000ULL / frequency.QuadPart;
+#else
+  struct timespec ts;
+  ::clock_gettime (CLOCK_MONOTONIC, &ts);
+
+  return static_cast <UINT64> (ts.tv_sec) * 1000000000ULL + static_cast <UINT64> (ts.tv_nsec);
+#endif
+}
+
+void Instrument_Profiler::report (std::ostream & out) const
+{
+  out << "Pin++ instrumentation profile" << std::endl
+      << std::left << std::setw (8) << "hook"
+      << std::right
+      << std::setw (12) << "calls"
+      << std::setw (14) << "total (ms)"
+      << std::setw (12) << "avg (us)"
+      << std::setw (12) << "max (us)"
+      << std::setw (16) << "instructions"
+      << std::setw (12) << "inserts" << std::endl;
+
+  UINT64 total_time = 0;
+
+  for (size_t i = 0; i < HOOK_COUNT; ++ i)
+  {
+    const Stats & stats = this->stats_[i];
+    total_time += stats.total_time_;
+
+    if (0 == stats.calls_ && 0 == stats.inserts_)
+      continue;
+
+    out << std::left << std::setw (8) << INSTRUMENT_PROFILER_HOOKS[i]
+        << std::right << std::fixed << std::setprecision (3)
+        << std::setw (12) << stats.calls_
+        << std::setw (14) << stats.total_time_ / 1e6
+        << std::setw (12) << (0 != stats.calls_ ? stats.total_time_ / 1e3 / stats.calls_ : 0.0)
+        << std::setw (12) << stats.max_time_ / 1e3
+        << std::setw (16) << stats.instructions_
+        << std::setw (12) << stats.inserts_ << std::endl;
+  }
+
+  out << "Total instrumentation time: " << total_time / 1e6 << " ms" << std::endl;
+}
+
+VOID Instrument_Profiler::__fini (INT32, VOID * obj)
+{
+  Instrument_Profiler * profiler = reinterpret_cast <Instrument_Profiler *> (obj);
+  std::ofstream out (profiler->output_.c_str ());
+
+  if (out.is_open ())
+    profiler->report (out);
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,171 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Instrument_Profiler.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_INSTRUMENT_PROFILER_H_
+#define _OASIS_PIN_INSTRUMENT_PROFILER_H_
+
+#include "pin.H"
+#include "Pin_export.h"
+
+#include <ostream>
+#include <string>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Instrument_Profiler
+ *
+ * Profile of the time a tool spends instrumenting code, as opposed to the
+ * time its analysis routines run. For each kind of instrumentation hook
+ * (trace, instruction, routine, and image), the profiler records the
+ * number of calls, the total and maximum wall time of the tool's
+ * handle_instrument (), the number of instructions it was given, and the
+ * number of analysis calls it inserted. The report is written when the
+ * application exits.
+ *
+ * The profiler is compiled in only if OASIS_PIN_PROFILE_INSTRUMENT is
+ * defined when building the tool; otherwise, the hooks are not timed,
+ * and this class is never used.
+ *
+ * Pin serializes the instrumentation callbacks, and analysis calls can
+ * only be inserted from them, so the profile is not locked.
+ */
+class OASIS_PIN_Export Instrument_Profiler
+{
+public:
+  /// The kinds of instrumentation hooks.
+  enum Hook
+  {
+    HOOK_TRACE,
+    HOOK_INS,
+    HOOK_RTN,
+    HOOK_IMG,
+    HOOK_NONE,
+    HOOK_COUNT
+  };
+
+  /**
+   * @struct Stats
+   *
+   * The profile of one kind of hook.
+   */
+  struct Stats
+  {
+    /// Number of calls.
+    UINT64 calls_;
+
+    /// Total wall time, in nanoseconds.
+    UINT64 total_time_;
+
+    /// Longest call, in nanoseconds.
+    UINT64 max_time_;
+
+    /// Number of instructions passed to the hook.
+    UINT64 instructions_;
+
+    /// Number of analysis calls inserted by the hook.
+    UINT64 inserts_;
+  };
+
+  /// The profiler of the tool. The report is written at fini.
+  static Instrument_Profiler & instance (void);
+
+  /// Current wall time, in nanoseconds.
+  static UINT64 now (void);
+
+  /// Set the file for the report. The default is instrument_profile.out.
+  void output (const std::string & filename);
+
+  /// Record the start of a hook. Returns the hook that was active.
+  Hook enter (Hook hook);
+
+  /// Record the end of a hook that started at @a start.
+  void leave (Hook hook, Hook previous, UINT64 start, UINT64 instructions);
+
+  /// Record an analysis call inserted by the active hook.
+  void count_insert (void);
+
+  /// The profile of a kind of hook.
+  const Stats & stats (Hook hook) const;
+
+  /// Write the report.
+  void report (std::ostream & out) const;
+
+private:
+  /// Default constructor.
+  Instrument_Profiler (void);
+
+  /// Pin fini callback.
+  static VOID __fini (INT32 code, VOID * obj);
+
+  /// Profile of each kind of hook.
+  Stats stats_[HOOK_COUNT];
+
+  /// The hook that is running.
+  Hook active_;
+
+  /// File for the report.
+  std::string output_;
+
+  // prevent the following operations
+  Instrument_Profiler (const Instrument_Profiler &);
+  const Instrument_Profiler & operator = (const Instrument_Profiler &);
+};
+
+/**
+ * @class Instrument_Profile_Scope
+ *
+ * Times one call of an instrumentation hook.
+ */
+class Instrument_Profile_Scope
+{
+public:
+  /// Start timing the hook.
+  Instrument_Profile_Scope (Instrument_Profiler::Hook hook, UINT64 instructions);
+
+  /// Stop timing the hook.
+  ~Instrument_Profile_Scope (void);
+
+private:
+  Instrument_Profiler::Hook hook_;
+
+  Instrument_Profiler::Hook previous_;
+
+  UINT64 instructions_;
+
+  UINT64 start_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Instrument_Profiler.inl"
+
+#if defined (OASIS_PIN_PROFILE_INSTRUMENT)
+  #define OASIS_PIN_PROFILE_HOOK(hook, instructions) \
+    ::OASIS::Pin::Instrument_Profile_Scope __oasis_pin_profile_scope (::OASIS::Pin::Instrument_Profiler::hook, instructions)
+
+  #define OASIS_PIN_PROFILE_INSERT() \
+    ::OASIS::Pin::Instrument_Profiler::instance ().count_insert ()
+
+  #define OASIS_PIN_PROFILE_INIT() \
+    ::OASIS::Pin::Instrument_Profiler::instance ()
+#else
+  #define OASIS_PIN_PROFILE_HOOK(hook, instructions)
+  #define OASIS_PIN_PROFILE_INSERT()
+  #define OASIS_PIN_PROFILE_INIT()
+#endif
+
+#endif  // _OASIS_PIN_INSTRUMENT_PROFILER_H_
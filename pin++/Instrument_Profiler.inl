@@ -0,0 +1,70 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+void Instrument_Profiler::output (const std::string & filename)
+{
+  this->output_ = filename;
+}
+
+inline
+Instrument_Profiler::Hook Instrument_Profiler::enter (Hook hook)
+{
+  Hook previous = this->active_;
+  this->active_ = hook;
+
+  return previous;
+}
+
+inline
+void Instrument_Profiler::leave (Hook hook, Hook previous, UINT64 start, UINT64 instructions)
+{
+  const UINT64 elapsed = Instrument_Profiler::now () - start;
+  Stats & stats = this->stats_[hook];
+
+  ++ stats.calls_;
+  stats.total_time_ += elapsed;
+  stats.instructions_ += instructions;
+
+  if (elapsed > stats.max_time_)
+    stats.max_time_ = elapsed;
+
+  this->active_ = previous;
+}
+
+inline
+void Instrument_Profiler::count_insert (void)
+{
+  ++ this->stats_[this->active_].inserts_;
+}
+
+inline
+const Instrument_Profiler::Stats & Instrument_Profiler::stats (Hook hook) const
+{
+  return this->stats_[hook];
+}
+
+inline
+Instrument_Profile_Scope::
+Instrument_Profile_Scope (Instrument_Profiler::Hook hook, UINT64 instructions)
+: hook_ (hook),
+  previous_ (Instrument_Profiler::instance ().enter (hook)),
+  instructions_ (instructions),
+  start_ (Instrument_Profiler::now ())
+{
+
+}
+
+inline
+Instrument_Profile_Scope::~Instrument_Profile_Scope (void)
+{
+  Instrument_Profiler::instance ().leave (this->hook_, this->previous_, this->start_, this->instructions_);
+}
+
+} // namespace OASIS
+} // namespace Pin
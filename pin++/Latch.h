@@ -0,0 +1,89 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Latch.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_LATCH_H_
+#define _OASIS_PIN_LATCH_H_
+
+#include "pin.H"
+#include "atomic.hpp"
+
+#include "Semaphore.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Latch
+ *
+ * Completion latch for a group of tasks. The count is raised for each task
+ * that is started, and lowered when the task completes. Threads waiting on
+ * the latch are released when the count reaches zero. Thread_Pool raises
+ * and lowers the count for tasks submitted with a latch.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class Latch
+{
+public:
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       count           Initial count
+   */
+  explicit Latch (UINT32 count = 0);
+
+  /// Raise the count.
+  void add (UINT32 count = 1);
+
+  /// Lower the count, and release the waiters if it reaches zero.
+  void count_down (void);
+
+  /// Test if the count is zero, and no count_down () is in progress.
+  bool is_done (void) const;
+
+  /// Current count.
+  UINT32 count (void) const;
+
+  /// Block until the count is zero.
+  void wait (void);
+
+  /**
+   * Block until the count is zero, or the timeout expires.
+   *
+   * @param[in]       timeout         Timeout in ms
+   * @retval          true            The count is zero
+   */
+  bool wait (UINT32 timeout);
+
+private:
+  /// The count.
+  volatile UINT32 count_;
+
+  /// Number of count_down () calls in progress.
+  volatile UINT32 leaving_;
+
+  /// Semaphore set when the count reaches zero.
+  Semaphore done_;
+
+  // prevent the following operations
+  Latch (const Latch &);
+  const Latch & operator = (const Latch &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Latch.inl"
+
+#endif  // _OASIS_PIN_LATCH_H_
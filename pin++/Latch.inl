@@ -0,0 +1,84 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Latch::Latch (UINT32 count)
+: count_ (count),
+  leaving_ (0)
+{
+
+}
+
+inline
+void Latch::add (UINT32 count)
+{
+  ATOMIC::OPS::Increment (&this->count_, count);
+}
+
+inline
+void Latch::count_down (void)
+{
+  // A waiter may destroy the latch as soon as it sees the latch is done,
+  // so the latch is not done until the last access below.
+  ATOMIC::OPS::Increment (&this->leaving_, static_cast <UINT32> (1));
+
+  if (1 == ATOMIC::OPS::Increment (&this->count_, static_cast <UINT32> (-1)))
+    this->done_.set ();
+
+  ATOMIC::OPS::Increment (&this->leaving_, static_cast <UINT32> (-1));
+}
+
+inline
+bool Latch::is_done (void) const
+{
+  return 0 == ATOMIC::OPS::Load (&this->count_, ATOMIC::BARRIER_LD_NEXT) &&
+         0 == ATOMIC::OPS::Load (&this->leaving_, ATOMIC::BARRIER_LD_NEXT);
+}
+
+inline
+UINT32 Latch::count (void) const
+{
+  return ATOMIC::OPS::Load (&this->count_, ATOMIC::BARRIER_LD_NEXT);
+}
+
+inline
+void Latch::wait (void)
+{
+  while (!this->wait (PIN_INFINITE_TIMEOUT))
+    continue;
+}
+
+inline
+bool Latch::wait (UINT32 timeout)
+{
+  if (this->is_done ())
+    return true;
+
+  // Clear the semaphore before checking the count again so a count_down ()
+  // between the check and the wait is not lost. If the count reached zero
+  // in the meantime, set it again for any other waiters.
+  this->done_.release ();
+
+  if (this->is_done ())
+  {
+    this->done_.set ();
+    return true;
+  }
+
+  this->done_.wait (timeout);
+
+  // The count is zero, but the last count_down () may not have returned
+  // yet. It is about to, so wait for it instead of reporting a timeout.
+  while (0 == this->count () && !this->is_done ())
+    PIN_Yield ();
+
+  return this->is_done ();
+}
+
+} // namespace OASIS
+} // namespace Pin
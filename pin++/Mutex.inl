@@ -29,15 +29,19 @@ void Mutex::acquire (void)
 inline
 bool Mutex::try_acquire (void)
 {
-  this->locked_ = PIN_MutexTryLock (&this->mutex_);
-  return this->locked_;
+  if (!PIN_MutexTryLock (&this->mutex_))
+    return false;
+
+  this->locked_ = true;
+  return true;
 }
 
 inline
 void Mutex::release (void)
 {
-  PIN_MutexUnlock (&this->mutex_);
+  // Clear the flag while the mutex is still held by this thread.
   this->locked_ = false;
+  PIN_MutexUnlock (&this->mutex_);
 }
 
 inline
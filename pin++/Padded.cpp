@@ -0,0 +1,48 @@
+// $Id$
+
+#include <new>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+Padded_Array <T>::Padded_Array (size_t size)
+: storage_ (0),
+  items_ (0),
+  size_ (size)
+{
+  this->allocate ();
+
+  for (size_t i = 0; i < this->size_; ++ i)
+    new (&this->items_[i]) Padded <T> ();
+}
+
+template <typename T>
+Padded_Array <T>::Padded_Array (size_t size, const T & value)
+: storage_ (0),
+  items_ (0),
+  size_ (size)
+{
+  this->allocate ();
+
+  for (size_t i = 0; i < this->size_; ++ i)
+    new (&this->items_[i]) Padded <T> (value);
+}
+
+template <typename T>
+void Padded_Array <T>::allocate (void)
+{
+  // The allocator does not guarantee cache line alignment. We therefore
+  // allocate an extra cache line, and align the first element manually.
+  this->storage_ = new char [sizeof (Padded <T>) * this->size_ + OASIS_PIN_CACHE_LINE_SIZE];
+
+  ADDRINT addr = reinterpret_cast <ADDRINT> (this->storage_);
+  addr = (addr + OASIS_PIN_CACHE_LINE_SIZE - 1) & ~static_cast <ADDRINT> (OASIS_PIN_CACHE_LINE_SIZE - 1);
+
+  this->items_ = reinterpret_cast <Padded <T> *> (addr);
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,154 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Padded.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_PADDED_H_
+#define _OASIS_PIN_PADDED_H_
+
+#include "pin.H"
+
+/// Size of a cache line on the target architecture.
+#if !defined (OASIS_PIN_CACHE_LINE_SIZE)
+  #define OASIS_PIN_CACHE_LINE_SIZE 64
+#endif
+
+/// Align a type to the cache line size.
+#if defined (_MSC_VER)
+  #define OASIS_PIN_CACHE_ALIGNED __declspec (align (OASIS_PIN_CACHE_LINE_SIZE))
+#else
+  #define OASIS_PIN_CACHE_ALIGNED __attribute__ ((aligned (OASIS_PIN_CACHE_LINE_SIZE)))
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Padded
+ *
+ * Wrapper that pads a value to a multiple of the cache line size, and
+ * aligns it to a cache line. Two padded values therefore never share a
+ * cache line, which prevents false sharing when each value is updated by a
+ * different thread. The value is the first member so it starts on the
+ * cache line boundary.
+ *
+ * The alignment holds for static and automatic objects, and for members
+ * of such objects. The heap only guarantees it with an aligned allocation,
+ * e.g., Padded_Array aligns its elements itself.
+ */
+template <typename T,
+          size_t N = (OASIS_PIN_CACHE_LINE_SIZE - sizeof (T) % OASIS_PIN_CACHE_LINE_SIZE) % OASIS_PIN_CACHE_LINE_SIZE>
+struct OASIS_PIN_CACHE_ALIGNED Padded
+{
+  /// Default constructor.
+  Padded (void)
+    : value () { }
+
+  /// Initializing constructor.
+  explicit Padded (const T & v)
+    : value (v) { }
+
+  /// The padded value.
+  T value;
+
+  /// Padding to the end of the cache line.
+  char padding_[N];
+};
+
+/**
+ * @struct Padded <T, 0>
+ *
+ * Specialization for values that are already a multiple of the cache line.
+ */
+template <typename T>
+struct OASIS_PIN_CACHE_ALIGNED Padded <T, 0>
+{
+  /// Default constructor.
+  Padded (void)
+    : value () { }
+
+  /// Initializing constructor.
+  explicit Padded (const T & v)
+    : value (v) { }
+
+  /// The padded value.
+  T value;
+};
+
+/**
+ * @class Padded_Array
+ *
+ * Fixed-size array of padded values that is aligned to a cache line. The
+ * primary use of this class is per-thread state indexed by THREADID. Each
+ * thread updates its own element without contending for the cache line of
+ * another thread.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+template <typename T>
+class Padded_Array
+{
+public:
+  /// Type definition of the value type.
+  typedef T value_type;
+
+  /**
+   * Initializing constructor. Each element is value-initialized.
+   *
+   * @param[in]       size          Number of elements in the array
+   */
+  explicit Padded_Array (size_t size);
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       size          Number of elements in the array
+   * @param[in]       value         Initial value of each element
+   */
+  Padded_Array (size_t size, const T & value);
+
+  /// Destructor.
+  ~Padded_Array (void);
+
+  /// @{ Accessor Methods
+  T & operator [] (size_t index);
+  const T & operator [] (size_t index) const;
+  /// @}
+
+  /// Number of elements in the array.
+  size_t size (void) const;
+
+private:
+  /// Allocate the storage for the array.
+  void allocate (void);
+
+  /// Raw storage for the elements.
+  char * storage_;
+
+  /// Cache line aligned elements in the storage.
+  Padded <T> * items_;
+
+  /// Number of elements in the array.
+  size_t size_;
+
+  // prevent the following operations
+  Padded_Array (const Padded_Array &);
+  const Padded_Array & operator = (const Padded_Array &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Padded.inl"
+#include "Padded.cpp"
+
+#endif  // _OASIS_PIN_PADDED_H_
@@ -0,0 +1,41 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+inline
+Padded_Array <T>::~Padded_Array (void)
+{
+  for (size_t i = 0; i < this->size_; ++ i)
+    this->items_[i].~Padded ();
+
+  delete [] this->storage_;
+}
+
+template <typename T>
+inline
+T & Padded_Array <T>::operator [] (size_t index)
+{
+  return this->items_[index].value;
+}
+
+template <typename T>
+inline
+const T & Padded_Array <T>::operator [] (size_t index) const
+{
+  return this->items_[index].value;
+}
+
+template <typename T>
+inline
+size_t Padded_Array <T>::size (void) const
+{
+  return this->size_;
+}
+
+} // namespace OASIS
+} // namespace Pin
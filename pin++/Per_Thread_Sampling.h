@@ -0,0 +1,86 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Per_Thread_Sampling.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_PER_THREAD_SAMPLING_H_
+#define _OASIS_PIN_PER_THREAD_SAMPLING_H_
+
+#include "Callback.h"
+#include "Padded.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Per_Thread_Sampling
+ *
+ * Implementation of a Conditional_Callback that performs constant sampling
+ * for each application thread. It has the same semantics as the
+ * Constant_Sampling guard, i.e., the associated callback is fired every N
+ * iterations. Unlike Constant_Sampling, each thread has its own countdown
+ * in a cache line padded slot indexed by THREADID. The threads therefore do
+ * not race on a shared counter, or contend for the same cache line.
+ *
+ * The do_next () method is intentionally small so Pin can inline it as
+ * the If-call of the guarded callback.
+ */
+class Per_Thread_Sampling :
+  public Conditional_Callback < Per_Thread_Sampling (ARG_THREAD_ID) >
+{
+public:
+  /**
+   * Initializing constructor. A value of 0 for \a iters is treated as 1,
+   * i.e., every iteration is sampled.
+   *
+   * @param[in]       iters       Number of iteration between samples.
+   */
+  Per_Thread_Sampling (size_t iters);
+
+  /// Destructor.
+  ~Per_Thread_Sampling (void);
+
+  /**
+   * Analysis routine executed as a guard for sampling.
+   *
+   * @param[in]       thr_id      Id of the current thread
+   * @return          true when the current iteration should be sampled
+   */
+  bool do_next (THREADID thr_id);
+
+  /// Get the number of iterations between firing the associated callback.
+  size_t iterations (void) const;
+
+  /**
+   * Set the number of iterations between firing the associated callback.
+   * The new value takes effect after each thread takes its next sample.
+   * A value of 0 is treated as 1.
+   */
+  void iterations (size_t iters);
+
+  /// Current iteration of the sampling callback for a thread.
+  size_t current_iteration (THREADID thr_id) const;
+
+private:
+  /// The number of iterations to execute before firing the associated callback.
+  size_t iters_;
+
+  /// The remaining iterations before the next sample for each thread.
+  Padded_Array <size_t> countdown_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Per_Thread_Sampling.inl"
+
+#endif  // _OASIS_PIN_PER_THREAD_SAMPLING_H_
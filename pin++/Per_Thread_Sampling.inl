@@ -0,0 +1,55 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Per_Thread_Sampling::Per_Thread_Sampling (size_t iters)
+: iters_ (iters != 0 ? iters : 1),
+  countdown_ (PIN_MAX_THREADS, this->iters_)
+{
+
+}
+
+inline
+Per_Thread_Sampling::~Per_Thread_Sampling (void)
+{
+
+}
+
+inline
+bool Per_Thread_Sampling::do_next (THREADID thr_id)
+{
+  size_t & countdown = this->countdown_[thr_id];
+
+  if (-- countdown != 0)
+    return false;
+
+  // Reset the countdown for the next sample.
+  countdown = this->iters_;
+  return true;
+}
+
+inline
+size_t Per_Thread_Sampling::iterations (void) const
+{
+  return this->iters_;
+}
+
+inline
+void Per_Thread_Sampling::iterations (size_t iters)
+{
+  this->iters_ = iters != 0 ? iters : 1;
+}
+
+inline
+size_t Per_Thread_Sampling::current_iteration (THREADID thr_id) const
+{
+  return this->iters_ - this->countdown_[thr_id];
+}
+
+} // namespace OASIS
+} // namespace Pin
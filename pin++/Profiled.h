@@ -0,0 +1,528 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Profiled.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_PROFILED_H_
+#define _OASIS_PIN_PROFILED_H_
+
+#include "Callback.h"
+
+#if defined (OASIS_PIN_PROFILE_ANALYSIS)
+
+#include "Analysis_Profiler.h"
+#include <typeinfo>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Param_Count
+ *
+ * Number of parameters of the analysis routine of a callback, which is the
+ * number of Type_Node elements in its argument list.
+ */
+template <typename List>
+struct Param_Count
+{
+  static const int RET = Param_Count <typename List::Tail>::RET + 1;
+};
+
+template <>
+struct Param_Count <End>
+{
+  static const int RET = 0;
+};
+
+template <typename ARG_VALUE_TYPE, typename PARAM_TYPE, typename NEXT>
+struct Param_Count < Value_Node <ARG_VALUE_TYPE, PARAM_TYPE, NEXT> >
+{
+  static const int RET = Param_Count <NEXT>::RET;
+};
+
+/**
+ * @struct Profiled_Analyze
+ *
+ * The analysis routines of Profiled <CALLBACK>. Each routine counts, and
+ * if sampled times, the invocation, and calls the routine of the callback
+ * it wraps. __analyze () wraps a Callback, and __do_next () wraps a
+ * Conditional_Callback; only the routine that is inserted is instantiated.
+ * The \a N template parameter is the number of parameters of the callback's
+ * routine. Pin passes the thread id ahead of the parameters (see
+ * Profiled::arglist_type), so the routines do not call PIN_ThreadId ().
+ */
+template <typename PROFILED, typename CALLBACK, int N>
+struct Profiled_Analyze;
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 0>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled));
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled));
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 1>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1);
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 2>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1, p2);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1, p2);
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 3>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1, p2, p3);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1, p2, p3);
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 4>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4);
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 5>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5);
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 6>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5, typename CALLBACK::pin_type6 p6)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5, p6);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5, typename CALLBACK::pin_type6 p6)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5, p6);
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 7>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5, typename CALLBACK::pin_type6 p6, typename CALLBACK::pin_type7 p7)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5, p6, p7);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5, typename CALLBACK::pin_type6 p6, typename CALLBACK::pin_type7 p7)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5, p6, p7);
+  }
+};
+
+template <typename PROFILED, typename CALLBACK>
+struct Profiled_Analyze <PROFILED, CALLBACK, 8>
+{
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5, typename CALLBACK::pin_type6 p6, typename CALLBACK::pin_type7 p7, typename CALLBACK::pin_type8 p8)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    CALLBACK::__analyze (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5, p6, p7, p8);
+  }
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void * cb, THREADID thr_id, typename CALLBACK::pin_type1 p1, typename CALLBACK::pin_type2 p2, typename CALLBACK::pin_type3 p3, typename CALLBACK::pin_type4 p4, typename CALLBACK::pin_type5 p5, typename CALLBACK::pin_type6 p6, typename CALLBACK::pin_type7 p7, typename CALLBACK::pin_type8 p8)
+  {
+    PROFILED * profiled = reinterpret_cast <PROFILED *> (cb);
+    Analysis_Profile_Scope scope (profiled->profile (), thr_id);
+
+    return CALLBACK::__do_next (static_cast <CALLBACK *> (profiled), p1, p2, p3, p4, p5, p6, p7, p8);
+  }
+};
+
+/**
+ * @class Profiled
+ *
+ * Decorator that profiles the analysis routine of a Callback, or of a
+ * Conditional_Callback, without changes to the callback. The decorator
+ * is used in place of the callback:
+ *
+ * @code
+ * Profiled <docount> callback;
+ * callback.insert (IPOINT_BEFORE, ins);
+ * @endcode
+ *
+ * Each invocation is counted in a per-thread slot of the profile of the
+ * \a CALLBACK type, and every Nth invocation is timed with the time stamp
+ * counter (see Analysis_Profiler::sample_rate ()). The objects of the same
+ * type share a profile. At fini, the Analysis_Profiler reports the types
+ * sorted by their estimated cost.
+ *
+ * The profile is only compiled in if OASIS_PIN_PROFILE_ANALYSIS is defined
+ * when building the tool. Otherwise, Profiled <CALLBACK> is an empty class
+ * derived from \a CALLBACK that inserts the callback's analysis routine,
+ * and the decorator has no cost.
+ *
+ * Static callbacks do not have an object to profile, and are not supported.
+ * The thread id adds one argument to the insert call, so the argument list
+ * of \a CALLBACK can have at most 13 nodes (Insert_T supports 14).
+ */
+template <typename CALLBACK>
+class Profiled :
+  public CALLBACK,
+  public Profiled_Analyze <Profiled <CALLBACK>, CALLBACK, Param_Count <typename CALLBACK::arglist_type>::RET>
+{
+public:
+  /// Type definition of the profiled callback.
+  typedef CALLBACK callback_type;
+
+  /// Type definition of the analysis routines.
+  typedef Profiled_Analyze <Profiled <CALLBACK>, CALLBACK, Param_Count <typename CALLBACK::arglist_type>::RET> analyze_type;
+
+  /// Type definition of the argument list. The thread id of the profile
+  /// slot is passed ahead of the arguments of the callback.
+  typedef Type_Node <ARG_THREAD_ID, typename CALLBACK::arglist_type> arglist_type;
+
+  /// The number of arguments expected by the insert method.
+  static const int arglist_length = Length <arglist_type>::RET;
+
+  /// The analysis routine is passed the decorator.
+  static const bool is_static_callback = false;
+
+  /// @{ Analysis Methods
+  using analyze_type::__analyze;
+  using analyze_type::__do_next;
+  /// @}
+
+  /// Default constructor.
+  Profiled (void)
+    : profile_ (Profiled::type_profile ()) { }
+
+  /// @{ Initializing constructors. The arguments are passed to the callback.
+  template <typename A1>
+  explicit Profiled (A1 & a1)
+    : CALLBACK (a1),
+      profile_ (Profiled::type_profile ()) { }
+
+  template <typename A1, typename A2>
+  Profiled (A1 & a1, A2 & a2)
+    : CALLBACK (a1, a2),
+      profile_ (Profiled::type_profile ()) { }
+
+  template <typename A1, typename A2, typename A3>
+  Profiled (A1 & a1, A2 & a2, A3 & a3)
+    : CALLBACK (a1, a2, a3),
+      profile_ (Profiled::type_profile ()) { }
+
+  template <typename A1, typename A2, typename A3, typename A4>
+  Profiled (A1 & a1, A2 & a2, A3 & a3, A4 & a4)
+    : CALLBACK (a1, a2, a3, a4),
+      profile_ (Profiled::type_profile ()) { }
+
+  template <typename A1>
+  explicit Profiled (const A1 & a1)
+    : CALLBACK (a1),
+      profile_ (Profiled::type_profile ()) { }
+  /// @}
+
+  /// The profile of the callback type.
+  Analysis_Profile & profile (void)
+  {
+    return this->profile_;
+  }
+
+  /// @{ InsertCall
+
+  /// Insert the profiled analysis routine. See Callback_Base::insert ().
+  template <typename S>
+  void insert (IPOINT location, const S & obj)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_call, *this);
+    insert (obj, location, &Profiled::__analyze);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1>
+  void insert (IPOINT location, const S & obj, XARG1 xarg1)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2>
+  void insert (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3>
+  void insert (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
+  void insert (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3, xarg4);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
+  void insert (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3, xarg4, xarg5);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
+  void insert (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5, XARG6 xarg6)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3, xarg4, xarg5, xarg6);
+  }
+  /// @}
+
+  /// @{ InsertPredicatedCall
+
+  /// Insert the profiled analysis routine. See Callback_Base::insert_predicated ().
+  template <typename S>
+  void insert_predicated (IPOINT location, const S & obj)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_predicated_call, *this);
+    insert (obj, location, &Profiled::__analyze);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1>
+  void insert_predicated (IPOINT location, const S & obj, XARG1 xarg1)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_predicated_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2>
+  void insert_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_predicated_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3>
+  void insert_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_predicated_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
+  void insert_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_predicated_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3, xarg4);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
+  void insert_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_predicated_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3, xarg4, xarg5);
+  }
+
+  /// @overload
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
+  void insert_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5, XARG6 xarg6)
+  {
+    Insert_T <S, Profiled, arglist_length> insert (S::__insert_predicated_call, *this);
+    insert (obj, location, &Profiled::__analyze, xarg1, xarg2, xarg3, xarg4, xarg5, xarg6);
+  }
+  /// @}
+
+  /// Create a guard for the decorator. See Callback_Base::operator [] ().
+  template <typename GUARD>
+  Callback_Guard <GUARD, Profiled> operator [] (GUARD & guard)
+  {
+    return Callback_Guard <GUARD, Profiled> (guard, *this);
+  }
+
+private:
+  /// The profile shared by the objects of the callback type.
+  static Analysis_Profile & type_profile (void)
+  {
+    static Analysis_Profile profile (typeid (CALLBACK).name ());
+    return profile;
+  }
+
+  /// The profile of the callback type.
+  Analysis_Profile & profile_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#else
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Profiled
+ *
+ * Profiling of analysis routines is disabled, so the decorator is the
+ * callback.
+ */
+template <typename CALLBACK>
+class Profiled : public CALLBACK
+{
+public:
+  /// Type definition of the profiled callback.
+  typedef CALLBACK callback_type;
+
+  /// Default constructor.
+  Profiled (void) { }
+
+  /// @{ Initializing constructors. The arguments are passed to the callback.
+  template <typename A1>
+  explicit Profiled (A1 & a1)
+    : CALLBACK (a1) { }
+
+  template <typename A1, typename A2>
+  Profiled (A1 & a1, A2 & a2)
+    : CALLBACK (a1, a2) { }
+
+  template <typename A1, typename A2, typename A3>
+  Profiled (A1 & a1, A2 & a2, A3 & a3)
+    : CALLBACK (a1, a2, a3) { }
+
+  template <typename A1, typename A2, typename A3, typename A4>
+  Profiled (A1 & a1, A2 & a2, A3 & a3, A4 & a4)
+    : CALLBACK (a1, a2, a3, a4) { }
+
+  template <typename A1>
+  explicit Profiled (const A1 & a1)
+    : CALLBACK (a1) { }
+  /// @}
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#endif  // defined OASIS_PIN_PROFILE_ANALYSIS
+
+#endif  // _OASIS_PIN_PROFILED_H_
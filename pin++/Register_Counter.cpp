@@ -0,0 +1,50 @@
+// $Id$
+
+#include <stdexcept>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+Register_Counter <T>::Register_Counter (void)
+: reg_ (PIN_ClaimToolRegister ()),
+  totals_ (PIN_MAX_THREADS, 0)
+{
+  if (!REG_valid (this->reg_))
+    throw std::runtime_error ("Failed to claim a tool register");
+
+  PIN_AddThreadStartFunction (&Register_Counter::__thread_start, this);
+  PIN_AddThreadFiniFunction (&Register_Counter::__thread_fini, this);
+}
+
+template <typename T>
+T Register_Counter <T>::count (void) const
+{
+  T total = 0;
+
+  for (size_t i = 0; i < this->totals_.size (); ++ i)
+    total += this->totals_[i];
+
+  return total;
+}
+
+template <typename T>
+VOID Register_Counter <T>::__thread_start (THREADID, CONTEXT * ctx, INT32, VOID * v)
+{
+  Register_Counter * counter = reinterpret_cast <Register_Counter *> (v);
+  PIN_SetContextReg (ctx, counter->reg_, 0);
+}
+
+template <typename T>
+VOID Register_Counter <T>::__thread_fini (THREADID thr_id, const CONTEXT * ctx, INT32, VOID * v)
+{
+  // Only the finishing thread writes its slot, so there is no need to
+  // synchronize the update.
+  Register_Counter * counter = reinterpret_cast <Register_Counter *> (v);
+  counter->totals_[thr_id] += PIN_GetContextReg (ctx, counter->reg_);
+}
+
+} // namespace OASIS
+} // namespace Pin
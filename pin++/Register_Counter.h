@@ -0,0 +1,140 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Register_Counter.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_REGISTER_COUNTER_H_
+#define _OASIS_PIN_REGISTER_COUNTER_H_
+
+#include "pin.H"
+#include "Insert_T.h"
+#include "Padded.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Memory_Storage
+ *
+ * Counter storage policy that keeps the count in a member of the counter
+ * object. This is the default storage policy for Counter and Batch_Counter.
+ */
+struct Memory_Storage
+{
+
+};
+
+/**
+ * @struct Register_Storage
+ *
+ * Counter storage policy that keeps the count for each thread in a tool
+ * register. See Register_Counter for details.
+ */
+struct Register_Storage
+{
+
+};
+
+/**
+ * @class Register_Counter
+ *
+ * Base class for counters that use the Register_Storage policy. The counter
+ * claims a tool register with PIN_ClaimToolRegister (), and each insert ()
+ * adds a constant to the register using IARG_REG_VALUE/IARG_RETURN_REGS.
+ * Each thread therefore counts in its own copy of the register without
+ * touching memory, and the analysis routine is simple enough for Pin to
+ * inline. The register is zeroed when a thread starts, and its value is
+ * spilled to a padded per-thread total when the thread ends.
+ *
+ * The count () methods only include threads that have finished. Pin calls
+ * the thread fini callbacks before the tool's fini callback, so the count
+ * is complete when it is read from handle_fini ().
+ *
+ * The register is ADDRINT sized. Each thread can therefore count up to
+ * 2^32 events on IA-32 before the register wraps.
+ *
+ * Pin has a small number of tool registers, and the thread callbacks
+ * cannot be removed. Each counter should live as long as the tool, and
+ * should be inserted many times instead of allocating a counter per
+ * instrumentation point.
+ */
+template <typename T>
+class Register_Counter
+{
+public:
+  /// Type definition of the counter's type.
+  typedef T type;
+
+  /**
+   * Default constructor. The constructor claims the tool register, and
+   * throws std::runtime_error if there are no tool registers left.
+   */
+  Register_Counter (void);
+
+  /// Destructor.
+  ~Register_Counter (void);
+
+  /// The tool register claimed by the counter.
+  REG reg (void) const;
+
+  /// Get the current count for all finished threads.
+  T count (void) const;
+
+  /**
+   * Get the count of a finished thread.
+   *
+   * @param[in]       thr_id        Target thread
+   */
+  T count (THREADID thr_id) const;
+
+protected:
+  /**
+   * Insert the increment of the tool register into \a obj.
+   *
+   * @param[in]       insert        Pointer to the insert function
+   * @param[in]       obj           Object to instrument
+   * @param[in]       location      Location to insert instrument
+   * @param[in]       incr          Value added to the register
+   */
+  template <typename S>
+  void insert_increment (typename Insert_Call_T <S>::funcptr_type insert,
+                         const S & obj,
+                         IPOINT location,
+                         ADDRINT incr);
+
+private:
+  /// Analysis routine that increments the tool register.
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __increment (ADDRINT value, ADDRINT incr);
+
+  /// @{ Thread Callbacks
+  static VOID __thread_start (THREADID thr_id, CONTEXT * ctx, INT32 flags, VOID * v);
+  static VOID __thread_fini (THREADID thr_id, const CONTEXT * ctx, INT32 flags, VOID * v);
+  /// @}
+
+  /// The tool register that holds the count of the current thread.
+  REG reg_;
+
+  /// The spilled count for each thread.
+  Padded_Array <T> totals_;
+
+  // prevent the following operations
+  Register_Counter (const Register_Counter &);
+  const Register_Counter & operator = (const Register_Counter &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Register_Counter.inl"
+#include "Register_Counter.cpp"
+
+#endif  // _OASIS_PIN_REGISTER_COUNTER_H_
@@ -0,0 +1,54 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+inline
+Register_Counter <T>::~Register_Counter (void)
+{
+
+}
+
+template <typename T>
+inline
+REG Register_Counter <T>::reg (void) const
+{
+  return this->reg_;
+}
+
+template <typename T>
+inline
+T Register_Counter <T>::count (THREADID thr_id) const
+{
+  return this->totals_[thr_id];
+}
+
+template <typename T>
+inline
+ADDRINT PIN_FAST_ANALYSIS_CALL Register_Counter <T>::__increment (ADDRINT value, ADDRINT incr)
+{
+  return value + incr;
+}
+
+template <typename T>
+template <typename S>
+inline
+void Register_Counter <T>::
+insert_increment (typename Insert_Call_T <S>::funcptr_type insert, const S & obj, IPOINT location, ADDRINT incr)
+{
+  insert (obj,
+          location,
+          (AFUNPTR)&Register_Counter::__increment,
+          IARG_FAST_ANALYSIS_CALL,
+          IARG_REG_VALUE, this->reg_,
+          IARG_ADDRINT, incr,
+          IARG_RETURN_REGS, this->reg_,
+          IARG_END);
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -80,6 +80,9 @@ public:
   /// Get the name of the routine.
   const std::string & name (void) const;
 
+  /// Get the undecorated name of the routine. The result is interned.
+  const std::string & undecorate (UNDECORATION style) const;
+
   /// Get the routine's id.
   INT32 id (void) const;
 
@@ -79,6 +79,12 @@ const std::string & Routine::name (void) const
   return RTN_Name (this->rtn_);
 }
 
+inline
+const std::string & Routine::undecorate (UNDECORATION style) const
+{
+  return Symbol::undecorate (this->name (), style);
+}
+
 inline
 INT32 Routine::id (void) const
 {
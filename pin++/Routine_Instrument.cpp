@@ -11,6 +11,8 @@ namespace Pin
 template <typename T>
 VOID Routine_Instrument <T>::__instrument (RTN rtn, VOID * v)
 {
+  // The routine is not open, so its instructions are not counted.
+  OASIS_PIN_PROFILE_HOOK (HOOK_RTN, 0);
   reinterpret_cast <T *> (v)->handle_instrument (Routine (rtn));
 }
 
@@ -14,6 +14,7 @@ inline
 Routine_Instrument <T>::Routine_Instrument (void)
 {
   RTN_AddInstrumentFunction (&Routine_Instrument::__instrument, this);
+  OASIS_PIN_PROFILE_INIT ();
 }
 
 //
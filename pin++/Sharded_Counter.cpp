@@ -0,0 +1,29 @@
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T, size_t MAX_THREADS>
+T Sharded_Counter <T, MAX_THREADS>::total (void) const
+{
+  T total = 0;
+
+  // Read each slot through a volatile reference. Otherwise, a monitor
+  // thread that calls this method in a loop could see a cached value.
+  for (size_t i = 0; i <= MAX_THREADS; ++ i)
+    total += const_cast <const volatile T &> (this->slots_[i]);
+
+  return total;
+}
+
+template <typename T, size_t MAX_THREADS>
+void Sharded_Counter <T, MAX_THREADS>::reset (void)
+{
+  for (size_t i = 0; i <= MAX_THREADS; ++ i)
+    this->slots_[i] = 0;
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,128 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Sharded_Counter.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_SHARDED_COUNTER_H_
+#define _OASIS_PIN_SHARDED_COUNTER_H_
+
+#include "pin.H"
+#include "atomic.hpp"
+#include "Padded.h"
+
+/// Default number of slots in a Sharded_Counter.
+#if !defined (OASIS_PIN_SHARDED_MAX_THREADS)
+  #define OASIS_PIN_SHARDED_MAX_THREADS 64
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Sharded_Storage
+ *
+ * Counter storage policy that keeps the count in a Sharded_Counter. The
+ * analysis routine receives the current THREADID, and updates the slot
+ * of the thread.
+ */
+template <size_t MAX_THREADS = OASIS_PIN_SHARDED_MAX_THREADS>
+struct Sharded_Storage
+{
+
+};
+
+/**
+ * @class Sharded_Counter
+ *
+ * Counter that is divided into one cache line aligned slot for each
+ * THREADID. A thread only updates its own slot, so updates are wait-free,
+ * do not contend for a cache line, and do not require a TLS key lookup.
+ *
+ * The total () method sums the slots without stopping the writers. It can
+ * be called from handle_fini (), or periodically from a monitor thread. In
+ * the latter case, the total includes each slot as of the time it was read.
+ * T must be an arithmetic type whose aligned loads are atomic on the target
+ * (e.g., UINT64 on Intel64, or UINT32 on IA-32) for the running total to be
+ * exact per slot.
+ *
+ * Each counter uses MAX_THREADS + 2 cache lines: one slot for each thread,
+ * an overflow slot, and the padding that aligns the slots. The default of
+ * OASIS_PIN_SHARDED_MAX_THREADS (64) slots is about 4 KB per counter with
+ * 64 byte cache lines. A slot for each of the PIN_MAX_THREADS threads Pin
+ * supports would be over 100 KB per counter, so the default is kept small.
+ * Threads with a THREADID of MAX_THREADS or more share the overflow slot,
+ * which is updated atomically, so their counts are exact but they contend
+ * for the slot. Tools with more threads can raise MAX_THREADS.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+template <typename T = UINT64, size_t MAX_THREADS = OASIS_PIN_SHARDED_MAX_THREADS>
+class Sharded_Counter
+{
+public:
+  /// Type definition of the counter's type.
+  typedef T type;
+
+  /// Maximum number of threads supported by the counter.
+  static const size_t max_threads = MAX_THREADS;
+
+  /// Default constructor.
+  Sharded_Counter (void);
+
+  /// Destructor.
+  ~Sharded_Counter (void);
+
+  /**
+   * Increment the slot of a thread.
+   *
+   * @param[in]       thr_id        Current thread
+   */
+  void increment (THREADID thr_id);
+
+  /**
+   * Add a value to the slot of a thread.
+   *
+   * @param[in]       thr_id        Current thread
+   * @param[in]       value         Value to add
+   */
+  void add (THREADID thr_id, const T & value);
+
+  /// @{ Slot Accessors. Threads past MAX_THREADS share the overflow slot.
+  T & operator [] (THREADID thr_id);
+  const T & operator [] (THREADID thr_id) const;
+  /// @}
+
+  /// Sum of all the slots.
+  T total (void) const;
+
+  /// Reset all the slots to 0. The writers must be stopped.
+  void reset (void);
+
+private:
+  /// Index of the slot of a thread.
+  static size_t slot (THREADID thr_id);
+
+  /// The slot for each thread, followed by the overflow slot.
+  Padded_Array <T> slots_;
+
+  // prevent the following operations
+  Sharded_Counter (const Sharded_Counter &);
+  const Sharded_Counter & operator = (const Sharded_Counter &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Sharded_Counter.inl"
+#include "Sharded_Counter.cpp"
+
+#endif  // _OASIS_PIN_SHARDED_COUNTER_H_
@@ -0,0 +1,64 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T, size_t MAX_THREADS>
+inline
+Sharded_Counter <T, MAX_THREADS>::Sharded_Counter (void)
+: slots_ (MAX_THREADS + 1, 0)
+{
+
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+Sharded_Counter <T, MAX_THREADS>::~Sharded_Counter (void)
+{
+
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+size_t Sharded_Counter <T, MAX_THREADS>::slot (THREADID thr_id)
+{
+  return thr_id < MAX_THREADS ? thr_id : MAX_THREADS;
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+void Sharded_Counter <T, MAX_THREADS>::increment (THREADID thr_id)
+{
+  this->add (thr_id, 1);
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+void Sharded_Counter <T, MAX_THREADS>::add (THREADID thr_id, const T & value)
+{
+  // The overflow slot is shared, so its updates must be atomic.
+  if (thr_id < MAX_THREADS)
+    this->slots_[thr_id] += value;
+  else
+    ATOMIC::OPS::Increment (&this->slots_[MAX_THREADS], value);
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+T & Sharded_Counter <T, MAX_THREADS>::operator [] (THREADID thr_id)
+{
+  return this->slots_[slot (thr_id)];
+}
+
+template <typename T, size_t MAX_THREADS>
+inline
+const T & Sharded_Counter <T, MAX_THREADS>::operator [] (THREADID thr_id) const
+{
+  return this->slots_[slot (thr_id)];
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,123 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Signature.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_SIGNATURE_H_
+#define _OASIS_PIN_SIGNATURE_H_
+
+#include "String_Slice.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Signature
+ *
+ * Parser for the undecorated name of a routine, such as the string
+ * returned by Symbol::undecorate (name, UNDECORATION_COMPLETE). The
+ * signature is split into slices of the original string:
+ *
+ *   public: virtual int __thiscall Foo::Bar::push (class Event *) const
+ *   |------------ prefix ---------| scope | method | params | qualifiers |
+ *
+ * The object is the prefix and the scope together, i.e., everything before
+ * the last "::" of the name. Names without a parameter list (e.g., from
+ * UNDECORATION_NAME_ONLY) are parsed too; they just have no parameters.
+ *
+ * Parsing does not allocate memory, and the slices are only valid as long
+ * as the parsed string. This class does not depend on Pin.
+ */
+class Signature
+{
+public:
+  /// Default constructor.
+  Signature (void);
+
+  /// Initializing constructor. The signature is parsed.
+  explicit Signature (const String_Slice & text);
+
+  /**
+   * Parse a signature.
+   *
+   * @param[in]       text          The undecorated name
+   * @retval          true          The name has a method
+   * @retval          false         The name is empty or malformed
+   */
+  bool parse (const String_Slice & text);
+
+  /// Test if the last parse succeeded.
+  bool is_valid (void) const;
+
+  /// Test if the signature has a parameter list.
+  bool has_params (void) const;
+
+  /// The parsed text.
+  const String_Slice & text (void) const;
+
+  /// Access specifier, storage, return type, and calling convention.
+  const String_Slice & prefix (void) const;
+
+  /// Qualified name of the class or namespace of the method.
+  const String_Slice & scope (void) const;
+
+  /// Everything before the last "::" of the name.
+  String_Slice object (void) const;
+
+  /// Name of the method.
+  const String_Slice & method (void) const;
+
+  /// Qualified name of the method.
+  String_Slice qualified_name (void) const;
+
+  /// Text between the parentheses of the parameter list.
+  const String_Slice & params (void) const;
+
+  /// Number of parameters.
+  size_t param_count (void) const;
+
+  /// Parameter at the index, or an empty slice.
+  String_Slice param (size_t index) const;
+
+  /// Text after the parameter list (e.g., const).
+  const String_Slice & qualifiers (void) const;
+
+private:
+  /// Clear the slices.
+  void reset (void);
+
+  /// Find the next top-level comma at or after @a pos in the parameters.
+  size_t next_param (size_t pos) const;
+
+  String_Slice text_;
+
+  String_Slice prefix_;
+
+  String_Slice scope_;
+
+  String_Slice method_;
+
+  String_Slice params_;
+
+  String_Slice qualifiers_;
+
+  bool valid_;
+
+  bool has_params_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Signature.inl"
+
+#endif  // _OASIS_PIN_SIGNATURE_H_
@@ -0,0 +1,255 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Signature::Signature (void)
+: valid_ (false),
+  has_params_ (false)
+{
+
+}
+
+inline
+Signature::Signature (const String_Slice & text)
+: valid_ (false),
+  has_params_ (false)
+{
+  this->parse (text);
+}
+
+inline
+void Signature::reset (void)
+{
+  this->prefix_ = this->scope_ = this->method_ = this->params_ = this->qualifiers_ = String_Slice ();
+  this->valid_ = this->has_params_ = false;
+}
+
+inline
+bool Signature::parse (const String_Slice & text)
+{
+  this->reset ();
+  this->text_ = text;
+
+  const char * str = text.data ();
+  size_t name_end = text.size ();
+
+  // The parameter list is the last parenthesized group. Searching from the
+  // end skips the parentheses in the names of local classes and lambdas.
+  size_t close = text.rfind (')');
+
+  if (String_Slice::npos != close)
+  {
+    size_t depth = 0, open = close + 1;
+
+    while (open > 0)
+    {
+      char ch = str[-- open];
+
+      if (ch == ')')
+        ++ depth;
+      else if (ch == '(' && 0 == -- depth)
+        break;
+    }
+
+    if (0 != depth)
+      return false;
+
+    this->has_params_ = true;
+    this->params_ = text.substr (open + 1, close - open - 1).trim ();
+    this->qualifiers_ = text.substr (close + 1).trim ();
+    name_end = open;
+  }
+
+  while (name_end > 0 && str[name_end - 1] == ' ')
+    -- name_end;
+
+  // An operator name has characters that look like template brackets, so
+  // the search for the scope starts in front of it.
+  size_t method_end = name_end;
+  size_t op = text.substr (0, name_end).rfind ("operator");
+
+  if (String_Slice::npos != op && (op == 0 || str[op - 1] == ':' || str[op - 1] == ' '))
+    name_end = op;
+
+  // Search backward for the "::" or space in front of the method, skipping
+  // the template arguments and parameters of the enclosing names.
+  size_t depth = 0, method_start = 0, scope_end = String_Slice::npos;
+
+  for (size_t i = name_end; i > 0; -- i)
+  {
+    char ch = str[i - 1];
+
+    if (ch == '>' || ch == ')')
+      ++ depth;
+    else if ((ch == '<' || ch == '(') && depth > 0)
+      -- depth;
+    else if (0 == depth && ch == ':' && i > 1 && str[i - 2] == ':')
+    {
+      method_start = i;
+      scope_end = i - 2;
+      break;
+    }
+    else if (0 == depth && ch == ' ')
+    {
+      method_start = i;
+      break;
+    }
+  }
+
+  this->method_ = text.substr (method_start, method_end - method_start);
+
+  size_t name_start = method_start;
+
+  if (String_Slice::npos != scope_end)
+  {
+    // The scope extends back to the first space outside of brackets.
+    size_t scope_start = 0;
+    depth = 0;
+
+    for (size_t i = scope_end; i > 0; -- i)
+    {
+      char ch = str[i - 1];
+
+      if (ch == '>' || ch == ')')
+        ++ depth;
+      else if ((ch == '<' || ch == '(') && depth > 0)
+        -- depth;
+      else if (0 == depth && ch == ' ')
+      {
+        scope_start = i;
+        break;
+      }
+    }
+
+    this->scope_ = text.substr (scope_start, scope_end - scope_start);
+    name_start = scope_start;
+  }
+
+  this->prefix_ = text.substr (0, name_start).trim ();
+  this->valid_ = !this->method_.empty ();
+
+  return this->valid_;
+}
+
+inline
+bool Signature::is_valid (void) const
+{
+  return this->valid_;
+}
+
+inline
+bool Signature::has_params (void) const
+{
+  return this->has_params_;
+}
+
+inline
+const String_Slice & Signature::text (void) const
+{
+  return this->text_;
+}
+
+inline
+const String_Slice & Signature::prefix (void) const
+{
+  return this->prefix_;
+}
+
+inline
+const String_Slice & Signature::scope (void) const
+{
+  return this->scope_;
+}
+
+inline
+String_Slice Signature::object (void) const
+{
+  if (this->scope_.empty ())
+    return this->prefix_;
+
+  return this->text_.substr (0, this->scope_.end () - this->text_.data ());
+}
+
+inline
+const String_Slice & Signature::method (void) const
+{
+  return this->method_;
+}
+
+inline
+String_Slice Signature::qualified_name (void) const
+{
+  const char * start = this->scope_.empty () ? this->method_.data () : this->scope_.data ();
+  return String_Slice (start, this->method_.end () - start);
+}
+
+inline
+const String_Slice & Signature::params (void) const
+{
+  return this->params_;
+}
+
+inline
+size_t Signature::next_param (size_t pos) const
+{
+  size_t depth = 0;
+
+  for (; pos < this->params_.size (); ++ pos)
+  {
+    char ch = this->params_[pos];
+
+    if (ch == '<' || ch == '(' || ch == '[')
+      ++ depth;
+    else if ((ch == '>' || ch == ')' || ch == ']') && depth > 0)
+      -- depth;
+    else if (ch == ',' && 0 == depth)
+      break;
+  }
+
+  return pos;
+}
+
+inline
+size_t Signature::param_count (void) const
+{
+  if (this->params_.empty () || this->params_ == "void")
+    return 0;
+
+  size_t count = 1;
+
+  for (size_t pos = this->next_param (0); pos < this->params_.size (); pos = this->next_param (pos + 1))
+    ++ count;
+
+  return count;
+}
+
+inline
+String_Slice Signature::param (size_t index) const
+{
+  if (index >= this->param_count ())
+    return String_Slice ();
+
+  size_t start = 0, end = this->next_param (0);
+
+  for (; index > 0; -- index)
+  {
+    start = end + 1;
+    end = this->next_param (start);
+  }
+
+  return this->params_.substr (start, end - start).trim ();
+}
+
+inline
+const String_Slice & Signature::qualifiers (void) const
+{
+  return this->qualifiers_;
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,120 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Signature_Matcher.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_SIGNATURE_MATCHER_H_
+#define _OASIS_PIN_SIGNATURE_MATCHER_H_
+
+#include "String_Slice.h"
+
+#include <string>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Signature_Matcher
+ *
+ * Finds a set of substrings (e.g., "::push_" or "::write(") in routine
+ * signatures in a single pass over the signature, instead of one find ()
+ * per substring. The patterns are compiled into an Aho-Corasick automaton
+ * with a full transition table, so matching costs one table lookup per
+ * character of the signature, and never allocates memory.
+ *
+ * Add the patterns, and then call compile () before matching. This class
+ * does not depend on Pin.
+ */
+class Signature_Matcher
+{
+public:
+  /// Value returned when nothing matches.
+  static const size_t npos = static_cast <size_t> (-1);
+
+  /// Default constructor.
+  Signature_Matcher (void);
+
+  /**
+   * Add a pattern. Adding a pattern that already exists returns the id
+   * of the existing pattern.
+   *
+   * @param[in]       pattern         The non-empty substring
+   * @return          Id of the pattern, in order of addition
+   */
+  size_t add (const String_Slice & pattern);
+
+  /// Build the automaton for the current patterns.
+  void compile (void);
+
+  /// Test if the automaton is built for the current patterns.
+  bool is_compiled (void) const;
+
+  /// Number of patterns.
+  size_t pattern_count (void) const;
+
+  /// The pattern with the id.
+  const std::string & pattern (size_t id) const;
+
+  /**
+   * Find the first occurrence of any pattern, i.e., the one that ends
+   * first in the text.
+   *
+   * @param[in]       text            Text to search
+   * @param[out]      id              Id of the pattern found
+   * @param[out]      pos             Start of the pattern in the text
+   * @retval          true            A pattern is found
+   */
+  bool find (const String_Slice & text, size_t & id, size_t & pos) const;
+
+  /// Test if any pattern occurs in the text.
+  bool contains (const String_Slice & text) const;
+
+  /**
+   * Visit every occurrence of every pattern, in the order they end in
+   * the text. The visitor is called as visitor (id, pos), and returns
+   * false to stop the search.
+   *
+   * @return          Number of occurrences visited
+   */
+  template <typename VISITOR>
+  size_t for_each (const String_Slice & text, VISITOR & visitor) const;
+
+private:
+  /// Number of transitions of each state.
+  static const size_t ALPHABET = 256;
+
+  /// Transition of a state on a character.
+  unsigned int next (unsigned int state, char ch) const;
+
+  /// The patterns.
+  std::vector <std::string> patterns_;
+
+  /// Transition table, ALPHABET entries per state.
+  std::vector <unsigned int> next_;
+
+  /// Id of the longest pattern ending at each state, or npos.
+  std::vector <size_t> output_;
+
+  /// Next state on the failure chain with an output, or 0.
+  std::vector <unsigned int> dict_;
+
+  /// The automaton matches the patterns.
+  bool compiled_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Signature_Matcher.inl"
+
+#endif  // _OASIS_PIN_SIGNATURE_MATCHER_H_
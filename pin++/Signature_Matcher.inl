@@ -0,0 +1,197 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Signature_Matcher::Signature_Matcher (void)
+: compiled_ (false)
+{
+
+}
+
+inline
+size_t Signature_Matcher::add (const String_Slice & pattern)
+{
+  if (pattern.empty ())
+    return npos;
+
+  for (size_t id = 0; id < this->patterns_.size (); ++ id)
+  {
+    if (pattern == this->patterns_[id])
+      return id;
+  }
+
+  this->patterns_.push_back (pattern.str ());
+  this->compiled_ = false;
+
+  return this->patterns_.size () - 1;
+}
+
+inline
+void Signature_Matcher::compile (void)
+{
+  static const unsigned int NONE = static_cast <unsigned int> (-1);
+  const size_t no_output = npos;
+
+  // Build the trie of the patterns.
+  this->next_.assign (ALPHABET, NONE);
+  this->output_.assign (1, no_output);
+  this->dict_.assign (1, 0);
+
+  for (size_t id = 0; id < this->patterns_.size (); ++ id)
+  {
+    const std::string & pattern = this->patterns_[id];
+    unsigned int state = 0;
+
+    for (size_t i = 0; i < pattern.size (); ++ i)
+    {
+      size_t index = state * ALPHABET + static_cast <unsigned char> (pattern[i]);
+
+      if (NONE == this->next_[index])
+      {
+        this->next_[index] = static_cast <unsigned int> (this->output_.size ());
+        this->next_.resize (this->next_.size () + ALPHABET, NONE);
+        this->output_.push_back (no_output);
+        this->dict_.push_back (0);
+      }
+
+      state = this->next_[index];
+    }
+
+    this->output_[state] = id;
+  }
+
+  // Fill in the missing transitions from the failure links, in breadth
+  // first order so the failure state of a state is always complete.
+  std::vector <unsigned int> fail (this->output_.size (), 0);
+  std::vector <unsigned int> queue;
+  queue.reserve (this->output_.size ());
+
+  for (size_t ch = 0; ch < ALPHABET; ++ ch)
+  {
+    if (NONE == this->next_[ch])
+      this->next_[ch] = 0;
+    else
+      queue.push_back (this->next_[ch]);
+  }
+
+  for (size_t head = 0; head < queue.size (); ++ head)
+  {
+    const unsigned int state = queue[head];
+
+    for (size_t ch = 0; ch < ALPHABET; ++ ch)
+    {
+      const unsigned int fallback = this->next_[fail[state] * ALPHABET + ch];
+      unsigned int & target = this->next_[state * ALPHABET + ch];
+
+      if (NONE == target)
+      {
+        target = fallback;
+        continue;
+      }
+
+      fail[target] = fallback;
+      this->dict_[target] = npos != this->output_[fallback] ? fallback : this->dict_[fallback];
+
+      queue.push_back (target);
+    }
+  }
+
+  this->compiled_ = true;
+}
+
+inline
+bool Signature_Matcher::is_compiled (void) const
+{
+  return this->compiled_;
+}
+
+inline
+size_t Signature_Matcher::pattern_count (void) const
+{
+  return this->patterns_.size ();
+}
+
+inline
+const std::string & Signature_Matcher::pattern (size_t id) const
+{
+  return this->patterns_[id];
+}
+
+inline
+unsigned int Signature_Matcher::next (unsigned int state, char ch) const
+{
+  return this->next_[state * ALPHABET + static_cast <unsigned char> (ch)];
+}
+
+inline
+bool Signature_Matcher::find (const String_Slice & text, size_t & id, size_t & pos) const
+{
+  if (!this->compiled_)
+    return false;
+
+  unsigned int state = 0;
+
+  for (size_t i = 0; i < text.size (); ++ i)
+  {
+    state = this->next (state, text[i]);
+
+    // The pattern of the state itself is the longest one ending here.
+    size_t found = this->output_[state];
+
+    if (npos == found && 0 != this->dict_[state])
+      found = this->output_[this->dict_[state]];
+
+    if (npos != found)
+    {
+      id = found;
+      pos = i + 1 - this->patterns_[found].size ();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+inline
+bool Signature_Matcher::contains (const String_Slice & text) const
+{
+  size_t id, pos;
+  return this->find (text, id, pos);
+}
+
+template <typename VISITOR>
+inline
+size_t Signature_Matcher::for_each (const String_Slice & text, VISITOR & visitor) const
+{
+  if (!this->compiled_)
+    return 0;
+
+  unsigned int state = 0;
+  size_t count = 0;
+
+  for (size_t i = 0; i < text.size (); ++ i)
+  {
+    state = this->next (state, text[i]);
+
+    unsigned int match = npos != this->output_[state] ? state : this->dict_[state];
+
+    for (; 0 != match; match = this->dict_[match])
+    {
+      const size_t id = this->output_[match];
+      ++ count;
+
+      if (!visitor (id, i + 1 - this->patterns_[id].size ()))
+        return count;
+    }
+  }
+
+  return count;
+}
+
+} // namespace OASIS
+} // namespace Pin
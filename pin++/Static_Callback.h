@@ -0,0 +1,626 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Static_Callback.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_STATIC_CALLBACK_H_
+#define _OASIS_PIN_STATIC_CALLBACK_H_
+
+#include "Callback.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Static_Callback
+
+/**
+ * @class Static_Callback
+ *
+ * Callback whose analysis routine is a static method on \a T. Unlike the
+ * regular \a Callback, the callback object is not passed to the analysis
+ * routine as an IARG_PTR. The analysis routine therefore only sees the
+ * arguments defined in the signature, and is a candidate for Pin's analysis
+ * routine inlining. The handle_analyze () method on \a T must be static, and
+ * it can only operate on static (or thread local) state.
+ *
+ * The callback is inserted the same way as a regular \a Callback object,
+ * including as the target of a \a Callback_Guard.
+ */
+template <typename T> class Static_Callback;
+
+/**
+ * @class Static_Callback <T (void)>
+ *
+ * Static callback with no arguments.
+ */
+template <typename T>
+class Static_Callback <T (void)> : public Callback_Base <T, End>
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (void)
+  {
+    T::handle_analyze ();
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1)>
+ *
+ * Static callback with 1 argument.
+ */
+template <typename T, typename A1>
+class Static_Callback <T (A1)> :
+  public Callback_Base <T, Type_Node <A1> >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1)
+  {
+    param_type1 pp1 (p1);
+
+    T::handle_analyze (pp1);
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1, A2)>
+ *
+ * Static callback with 2 arguments.
+ */
+template <typename T, typename A1, typename A2>
+class Static_Callback <T (A1, A2)> :
+  public Callback_Base <T, Type_Node <A1, Type_Node <A2> > >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1, pin_type2 p2)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+
+    T::handle_analyze (pp1, pp2);
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1, A2, A3)>
+ *
+ * Static callback with 3 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3>
+class Static_Callback <T (A1, A2, A3)> :
+  public Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3> > > >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1, pin_type2 p2, pin_type3 p3)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+
+    T::handle_analyze (pp1, pp2, pp3);
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1, A2, A3, A4)>
+ *
+ * Static callback with 4 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3, typename A4>
+class Static_Callback <T (A1, A2, A3, A4)> :
+  public Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4> > > > >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  static const IARG_TYPE arg_type4 = A4::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  typedef typename A4::pinpp_type param_type4;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  typedef typename A4::pin_type pin_type4;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1, pin_type2 p2, pin_type3 p3, pin_type4 p4)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+    param_type4 pp4 (p4);
+
+    T::handle_analyze (pp1, pp2, pp3, pp4);
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1, A2, A3, A4, A5)>
+ *
+ * Static callback with 5 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3, typename A4, typename A5>
+class Static_Callback <T (A1, A2, A3, A4, A5)> :
+  public Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4, Type_Node <A5> > > > > >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  static const IARG_TYPE arg_type4 = A4::arg_type;
+  static const IARG_TYPE arg_type5 = A5::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  typedef typename A4::pinpp_type param_type4;
+  typedef typename A5::pinpp_type param_type5;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  typedef typename A4::pin_type pin_type4;
+  typedef typename A5::pin_type pin_type5;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1, pin_type2 p2, pin_type3 p3, pin_type4 p4, pin_type5 p5)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+    param_type4 pp4 (p4);
+    param_type5 pp5 (p5);
+
+    T::handle_analyze (pp1, pp2, pp3, pp4, pp5);
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1, A2, A3, A4, A5, A6)>
+ *
+ * Static callback with 6 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+class Static_Callback <T (A1, A2, A3, A4, A5, A6)> :
+  public Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4, Type_Node <A5, Type_Node <A6> > > > > > >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  static const IARG_TYPE arg_type4 = A4::arg_type;
+  static const IARG_TYPE arg_type5 = A5::arg_type;
+  static const IARG_TYPE arg_type6 = A6::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  typedef typename A4::pinpp_type param_type4;
+  typedef typename A5::pinpp_type param_type5;
+  typedef typename A6::pinpp_type param_type6;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  typedef typename A4::pin_type pin_type4;
+  typedef typename A5::pin_type pin_type5;
+  typedef typename A6::pin_type pin_type6;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1, pin_type2 p2, pin_type3 p3, pin_type4 p4, pin_type5 p5, pin_type6 p6)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+    param_type4 pp4 (p4);
+    param_type5 pp5 (p5);
+    param_type6 pp6 (p6);
+
+    T::handle_analyze (pp1, pp2, pp3, pp4, pp5, pp6);
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1, A2, A3, A4, A5, A6, A7)>
+ *
+ * Static callback with 7 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+class Static_Callback <T (A1, A2, A3, A4, A5, A6, A7)> :
+  public Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4, Type_Node <A5, Type_Node <A6, Type_Node <A7> > > > > > > >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  static const IARG_TYPE arg_type4 = A4::arg_type;
+  static const IARG_TYPE arg_type5 = A5::arg_type;
+  static const IARG_TYPE arg_type6 = A6::arg_type;
+  static const IARG_TYPE arg_type7 = A7::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  typedef typename A4::pinpp_type param_type4;
+  typedef typename A5::pinpp_type param_type5;
+  typedef typename A6::pinpp_type param_type6;
+  typedef typename A7::pinpp_type param_type7;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  typedef typename A4::pin_type pin_type4;
+  typedef typename A5::pin_type pin_type5;
+  typedef typename A6::pin_type pin_type6;
+  typedef typename A7::pin_type pin_type7;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1, pin_type2 p2, pin_type3 p3, pin_type4 p4, pin_type5 p5, pin_type6 p6, pin_type7 p7)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+    param_type4 pp4 (p4);
+    param_type5 pp5 (p5);
+    param_type6 pp6 (p6);
+    param_type7 pp7 (p7);
+
+    T::handle_analyze (pp1, pp2, pp3, pp4, pp5, pp6, pp7);
+  }
+};
+
+/**
+ * @class Static_Callback <T (A1, A2, A3, A4, A5, A6, A7, A8)>
+ *
+ * Static callback with 8 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+class Static_Callback <T (A1, A2, A3, A4, A5, A6, A7, A8)> :
+  public Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4, Type_Node <A5, Type_Node <A6, Type_Node <A7, Type_Node <A8> > > > > > > > >
+{
+public:
+  /// The analysis routine is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  static const IARG_TYPE arg_type4 = A4::arg_type;
+  static const IARG_TYPE arg_type5 = A5::arg_type;
+  static const IARG_TYPE arg_type6 = A6::arg_type;
+  static const IARG_TYPE arg_type7 = A7::arg_type;
+  static const IARG_TYPE arg_type8 = A8::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  typedef typename A4::pinpp_type param_type4;
+  typedef typename A5::pinpp_type param_type5;
+  typedef typename A6::pinpp_type param_type6;
+  typedef typename A7::pinpp_type param_type7;
+  typedef typename A8::pinpp_type param_type8;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  typedef typename A4::pin_type pin_type4;
+  typedef typename A5::pin_type pin_type5;
+  typedef typename A6::pin_type pin_type6;
+  typedef typename A7::pin_type pin_type7;
+  typedef typename A8::pin_type pin_type8;
+  /// @}
+
+  static void PIN_FAST_ANALYSIS_CALL __analyze (pin_type1 p1, pin_type2 p2, pin_type3 p3, pin_type4 p4, pin_type5 p5, pin_type6 p6, pin_type7 p7, pin_type8 p8)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+    param_type4 pp4 (p4);
+    param_type5 pp5 (p5);
+    param_type6 pp6 (p6);
+    param_type7 pp7 (p7);
+    param_type8 pp8 (p8);
+
+    T::handle_analyze (pp1, pp2, pp3, pp4, pp5, pp6, pp7, pp8);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Static_Conditional_Callback
+
+/**
+ * @class Static_Conditional_Callback
+ *
+ * Conditional callback whose do_next () method is a static method on \a T.
+ * Similar to the \a Static_Callback, the conditional callback object is not
+ * passed to the If-call. This allows Pin to inline the If-call, which is
+ * the intended usage of INS_InsertIfCall.
+ */
+template <typename T> class Static_Conditional_Callback;
+
+/**
+ * @class Static_Conditional_Callback <T (void)>
+ *
+ * Static conditional callback with no arguments.
+ */
+template <typename T>
+class Static_Conditional_Callback <T (void)> :
+  public Conditional_Callback_Base <T, End>
+{
+public:
+  /// The If-call is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (void)
+  {
+    return static_cast <ADDRINT> (T::do_next ());
+  }
+};
+
+/**
+ * @class Static_Conditional_Callback <T (A1)>
+ *
+ * Static conditional callback with 1 argument.
+ */
+template <typename T, typename A1>
+class Static_Conditional_Callback <T (A1)> :
+  public Conditional_Callback_Base <T, Type_Node <A1> >
+{
+public:
+  /// The If-call is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  /// @}
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (pin_type1 p1)
+  {
+    param_type1 pp1 (p1);
+
+    return static_cast <ADDRINT> (T::do_next (pp1));
+  }
+};
+
+/**
+ * @class Static_Conditional_Callback <T (A1, A2)>
+ *
+ * Static conditional callback with 2 arguments.
+ */
+template <typename T, typename A1, typename A2>
+class Static_Conditional_Callback <T (A1, A2)> :
+  public Conditional_Callback_Base <T, Type_Node <A1, Type_Node <A2> > >
+{
+public:
+  /// The If-call is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  /// @}
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (pin_type1 p1, pin_type2 p2)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+
+    return static_cast <ADDRINT> (T::do_next (pp1, pp2));
+  }
+};
+
+/**
+ * @class Static_Conditional_Callback <T (A1, A2, A3)>
+ *
+ * Static conditional callback with 3 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3>
+class Static_Conditional_Callback <T (A1, A2, A3)> :
+  public Conditional_Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3> > > >
+{
+public:
+  /// The If-call is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  /// @}
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (pin_type1 p1, pin_type2 p2, pin_type3 p3)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+
+    return static_cast <ADDRINT> (T::do_next (pp1, pp2, pp3));
+  }
+};
+
+/**
+ * @class Static_Conditional_Callback <T (A1, A2, A3, A4)>
+ *
+ * Static conditional callback with 4 arguments.
+ */
+template <typename T, typename A1, typename A2, typename A3, typename A4>
+class Static_Conditional_Callback <T (A1, A2, A3, A4)> :
+  public Conditional_Callback_Base <T, Type_Node <A1, Type_Node <A2, Type_Node <A3, Type_Node <A4> > > > >
+{
+public:
+  /// The If-call is not passed the callback object.
+  static const bool is_static_callback = true;
+
+  /// @{ Argument Type Definitions
+  static const IARG_TYPE arg_type1 = A1::arg_type;
+  static const IARG_TYPE arg_type2 = A2::arg_type;
+  static const IARG_TYPE arg_type3 = A3::arg_type;
+  static const IARG_TYPE arg_type4 = A4::arg_type;
+  /// @}
+
+  /// @{ Parameter Type Definitions
+  typedef typename A1::pinpp_type param_type1;
+  typedef typename A2::pinpp_type param_type2;
+  typedef typename A3::pinpp_type param_type3;
+  typedef typename A4::pinpp_type param_type4;
+  /// @}
+
+  /// @{ Native Pin Type Definitions
+  typedef typename A1::pin_type pin_type1;
+  typedef typename A2::pin_type pin_type2;
+  typedef typename A3::pin_type pin_type3;
+  typedef typename A4::pin_type pin_type4;
+  /// @}
+
+  static ADDRINT PIN_FAST_ANALYSIS_CALL __do_next (pin_type1 p1, pin_type2 p2, pin_type3 p3, pin_type4 p4)
+  {
+    param_type1 pp1 (p1);
+    param_type2 pp2 (p2);
+    param_type3 pp3 (p3);
+    param_type4 pp4 (p4);
+
+    return static_cast <ADDRINT> (T::do_next (pp1, pp2, pp3, pp4));
+  }
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#endif  // _OASIS_PIN_STATIC_CALLBACK_H_
@@ -0,0 +1,111 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        String_Slice.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_STRING_SLICE_H_
+#define _OASIS_PIN_STRING_SLICE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class String_Slice
+ *
+ * Read-only view of a range of characters owned by someone else (e.g., the
+ * std::string returned by Symbol::undecorate ()). Taking a substring of a
+ * slice, or searching it, never allocates memory. The slice is only valid
+ * as long as the characters it views.
+ *
+ * This class does not depend on Pin.
+ */
+class String_Slice
+{
+public:
+  /// Position returned when a search fails.
+  static const size_t npos = static_cast <size_t> (-1);
+
+  /// Default constructor. The slice is empty.
+  String_Slice (void);
+
+  /// Initializing constructor for a null-terminated string.
+  String_Slice (const char * str);
+
+  /// Initializing constructor.
+  String_Slice (const char * str, size_t size);
+
+  /// Initializing constructor. The slice views the string's characters.
+  String_Slice (const std::string & str);
+
+  /// Pointer to the first character.
+  const char * data (void) const;
+
+  /// Number of characters.
+  size_t size (void) const;
+
+  /// Test if the slice is empty.
+  bool empty (void) const;
+
+  /// Iterators over the characters.
+  const char * begin (void) const;
+  const char * end (void) const;
+
+  /// Character at the position.
+  char operator [] (size_t pos) const;
+
+  /// Slice of at most @a count characters starting at @a pos.
+  String_Slice substr (size_t pos, size_t count = npos) const;
+
+  /// Find the first occurrence at or after @a pos.
+  size_t find (char ch, size_t pos = 0) const;
+  size_t find (const String_Slice & str, size_t pos = 0) const;
+
+  /// Find the last occurrence that starts at or before @a pos.
+  size_t rfind (char ch, size_t pos = npos) const;
+  size_t rfind (const String_Slice & str, size_t pos = npos) const;
+
+  /// Test the start and end of the slice.
+  bool starts_with (const String_Slice & str) const;
+  bool ends_with (const String_Slice & str) const;
+
+  /// Slice without the leading and trailing spaces.
+  String_Slice trim (void) const;
+
+  /// Copy the characters into a string.
+  std::string str (void) const;
+
+  /// Comparison operators.
+  bool operator == (const String_Slice & rhs) const;
+  bool operator != (const String_Slice & rhs) const;
+
+private:
+  /// The first character.
+  const char * data_;
+
+  /// Number of characters.
+  size_t size_;
+};
+
+/// Write the characters of a slice to a stream.
+std::ostream & operator << (std::ostream & out, const String_Slice & str);
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "String_Slice.inl"
+
+#endif  // _OASIS_PIN_STRING_SLICE_H_
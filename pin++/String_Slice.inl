@@ -0,0 +1,208 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+String_Slice::String_Slice (void)
+: data_ (""),
+  size_ (0)
+{
+
+}
+
+inline
+String_Slice::String_Slice (const char * str)
+: data_ (str),
+  size_ (::strlen (str))
+{
+
+}
+
+inline
+String_Slice::String_Slice (const char * str, size_t size)
+: data_ (str),
+  size_ (size)
+{
+
+}
+
+inline
+String_Slice::String_Slice (const std::string & str)
+: data_ (str.data ()),
+  size_ (str.size ())
+{
+
+}
+
+inline
+const char * String_Slice::data (void) const
+{
+  return this->data_;
+}
+
+inline
+size_t String_Slice::size (void) const
+{
+  return this->size_;
+}
+
+inline
+bool String_Slice::empty (void) const
+{
+  return 0 == this->size_;
+}
+
+inline
+const char * String_Slice::begin (void) const
+{
+  return this->data_;
+}
+
+inline
+const char * String_Slice::end (void) const
+{
+  return this->data_ + this->size_;
+}
+
+inline
+char String_Slice::operator [] (size_t pos) const
+{
+  return this->data_[pos];
+}
+
+inline
+String_Slice String_Slice::substr (size_t pos, size_t count) const
+{
+  if (pos > this->size_)
+    pos = this->size_;
+
+  if (count > this->size_ - pos)
+    count = this->size_ - pos;
+
+  return String_Slice (this->data_ + pos, count);
+}
+
+inline
+size_t String_Slice::find (char ch, size_t pos) const
+{
+  if (pos >= this->size_)
+    return npos;
+
+  const void * found = ::memchr (this->data_ + pos, ch, this->size_ - pos);
+  return 0 != found ? static_cast <const char *> (found) - this->data_ : npos;
+}
+
+inline
+size_t String_Slice::find (const String_Slice & str, size_t pos) const
+{
+  if (str.size_ == 0)
+    return pos <= this->size_ ? pos : npos;
+
+  if (pos >= this->size_ || str.size_ > this->size_ - pos)
+    return npos;
+
+  // Look for the first character, then compare the rest.
+  const size_t last = this->size_ - str.size_;
+
+  for (pos = this->find (str.data_[0], pos); npos != pos && pos <= last; pos = this->find (str.data_[0], pos + 1))
+  {
+    if (0 == ::memcmp (this->data_ + pos + 1, str.data_ + 1, str.size_ - 1))
+      return pos;
+  }
+
+  return npos;
+}
+
+inline
+size_t String_Slice::rfind (char ch, size_t pos) const
+{
+  if (this->size_ == 0)
+    return npos;
+
+  if (pos >= this->size_)
+    pos = this->size_ - 1;
+
+  for (size_t i = pos + 1; i > 0; -- i)
+  {
+    if (this->data_[i - 1] == ch)
+      return i - 1;
+  }
+
+  return npos;
+}
+
+inline
+size_t String_Slice::rfind (const String_Slice & str, size_t pos) const
+{
+  if (str.size_ > this->size_)
+    return npos;
+
+  if (pos > this->size_ - str.size_)
+    pos = this->size_ - str.size_;
+
+  for (size_t i = pos + 1; i > 0; -- i)
+  {
+    if (0 == ::memcmp (this->data_ + i - 1, str.data_, str.size_))
+      return i - 1;
+  }
+
+  return npos;
+}
+
+inline
+bool String_Slice::starts_with (const String_Slice & str) const
+{
+  return str.size_ <= this->size_ && 0 == ::memcmp (this->data_, str.data_, str.size_);
+}
+
+inline
+bool String_Slice::ends_with (const String_Slice & str) const
+{
+  return str.size_ <= this->size_ &&
+         0 == ::memcmp (this->data_ + this->size_ - str.size_, str.data_, str.size_);
+}
+
+inline
+String_Slice String_Slice::trim (void) const
+{
+  size_t first = 0, last = this->size_;
+
+  while (first < last && this->data_[first] == ' ')
+    ++ first;
+
+  while (last > first && this->data_[last - 1] == ' ')
+    -- last;
+
+  return String_Slice (this->data_ + first, last - first);
+}
+
+inline
+std::string String_Slice::str (void) const
+{
+  return std::string (this->data_, this->size_);
+}
+
+inline
+bool String_Slice::operator == (const String_Slice & rhs) const
+{
+  return this->size_ == rhs.size_ && 0 == ::memcmp (this->data_, rhs.data_, this->size_);
+}
+
+inline
+bool String_Slice::operator != (const String_Slice & rhs) const
+{
+  return !(*this == rhs);
+}
+
+inline
+std::ostream & operator << (std::ostream & out, const String_Slice & str)
+{
+  return out.write (str.data (), str.size ());
+}
+
+} // namespace OASIS
+} // namespace Pin
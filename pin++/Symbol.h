@@ -15,6 +15,7 @@
 
 #include "pin.H"
 #include "Iterator.h"
+#include "Demangle_Cache.h"
 
 #include "Pin_export.h"
 
@@ -54,8 +55,8 @@ public:
   bool operator != (const Symbol & rhs) const;
   /// @}
 
-  /// Undecorate a symbol.
-  static std::string undecorate (const std::string & name, UNDECORATION style);
+  /// Undecorate a symbol. The result is interned in Demangle_Cache::instance ().
+  static const std::string & undecorate (const std::string & name, UNDECORATION style);
 
   /// Name of the symbol.
   const string & name (void) const;
@@ -80,7 +81,7 @@ public:
   ADDRINT address (void) const;
 
   /// Undecorate the current symbol.
-  std::string undecorate (UNDECORATION style) const;
+  const std::string & undecorate (UNDECORATION style) const;
 
 private:
   SYM & sym_;
@@ -38,9 +38,9 @@ Symbol::operator SYM () const
 }
 
 inline
-std::string Symbol::undecorate (const std::string & name, UNDECORATION style)
+const std::string & Symbol::undecorate (const std::string & name, UNDECORATION style)
 {
-  return PIN_UndecorateSymbolName (name, style);
+  return Demangle_Cache::instance ().undecorate (name, style);
 }
 
 inline
@@ -100,7 +100,7 @@ ADDRINT Symbol::address (void) const
 }
 
 inline
-std::string Symbol::undecorate (UNDECORATION style) const
+const std::string & Symbol::undecorate (UNDECORATION style) const
 {
   return undecorate (this->name (), style);
 }
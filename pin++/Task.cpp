@@ -0,0 +1,169 @@
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename MSG>
+Task <MSG>::Task (size_t high_water_mark, size_t batch_size)
+: thread_count_ (0),
+  high_water_mark_ (0 != high_water_mark ? high_water_mark : 1),
+  batch_size_ (0 != batch_size ? batch_size : 1),
+  active_ (true)
+{
+  this->not_full_.set ();
+}
+
+template <typename MSG>
+Task <MSG>::~Task (void)
+{
+  this->close ();
+}
+
+template <typename MSG>
+size_t Task <MSG>::open (size_t threads)
+{
+  if (!this->is_active ())
+    return 0;
+
+  size_t first = this->workers_.size ();
+
+  for (size_t i = 0; i < threads; ++ i)
+    this->workers_.push_back (new Worker (*this));
+
+  for (size_t i = first; i < this->workers_.size (); ++ i)
+  {
+    if (this->workers_[i]->start () != Thread::ERROR)
+      ++ this->thread_count_;
+  }
+
+  return this->thread_count_;
+}
+
+template <typename MSG>
+void Task <MSG>::close (void)
+{
+  do
+  {
+    Guard <Mutex> guard (this->lock_);
+    this->active_ = false;
+
+    // Wake the workers so they drain the queue and return, and any thread
+    // blocked in putq () so it sees the task is closed.
+    this->not_empty_.set ();
+    this->not_full_.set ();
+  } while (false);
+
+  for (size_t i = 0; i < this->workers_.size (); ++ i)
+    this->workers_[i]->wait ();
+
+  for (size_t i = 0; i < this->workers_.size (); ++ i)
+    delete this->workers_[i];
+
+  this->workers_.clear ();
+  this->thread_count_ = 0;
+}
+
+template <typename MSG>
+bool Task <MSG>::putq (const MSG & msg)
+{
+  for (;;)
+  {
+    do
+    {
+      Guard <Mutex> guard (this->lock_);
+
+      if (!this->active_)
+        return false;
+
+      if (this->queue_.size () < this->high_water_mark_)
+      {
+        this->enqueue (msg);
+        return true;
+      }
+
+      // The semaphore is only cleared while the queue is full, and set by
+      // getq () under the lock once it is not, so the wakeup is not lost.
+      this->not_full_.release ();
+    } while (false);
+
+    this->not_full_.acquire ();
+  }
+}
+
+template <typename MSG>
+bool Task <MSG>::try_putq (const MSG & msg)
+{
+  Guard <Mutex> guard (this->lock_);
+
+  if (!this->active_ || this->queue_.size () >= this->high_water_mark_)
+    return false;
+
+  this->enqueue (msg);
+  return true;
+}
+
+template <typename MSG>
+size_t Task <MSG>::getq (MSG * msgs, size_t max)
+{
+  if (0 == max)
+    return 0;
+
+  for (;;)
+  {
+    do
+    {
+      Guard <Mutex> guard (this->lock_);
+
+      if (!this->queue_.empty ())
+      {
+        const bool full = this->queue_.size () >= this->high_water_mark_;
+        size_t count = 0;
+
+        for (; count < max && !this->queue_.empty (); ++ count)
+        {
+          msgs[count] = this->queue_.front ();
+          this->queue_.pop_front ();
+        }
+
+        if (full && this->queue_.size () < this->high_water_mark_)
+          this->not_full_.set ();
+
+        return count;
+      }
+
+      if (!this->active_)
+        return 0;
+
+      // The semaphore is only cleared while the queue is empty, and set by
+      // putq () under the lock once it is not, so the wakeup is not lost.
+      this->not_empty_.release ();
+    } while (false);
+
+    this->not_empty_.acquire ();
+  }
+}
+
+template <typename MSG>
+void Task <MSG>::high_water_mark (size_t hwm)
+{
+  Guard <Mutex> guard (this->lock_);
+  this->high_water_mark_ = 0 != hwm ? hwm : 1;
+
+  if (this->queue_.size () < this->high_water_mark_)
+    this->not_full_.set ();
+}
+
+template <typename MSG>
+void Task <MSG>::svc (void)
+{
+  std::vector <MSG> msgs (this->batch_size_);
+  size_t count;
+
+  while (0 != (count = this->getq (&msgs[0], msgs.size ())))
+    this->handle_messages (&msgs[0], count);
+}
+
+} // namespace OASIS
+} // namespace Pin
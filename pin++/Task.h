@@ -0,0 +1,233 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Task.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TASK_H_
+#define _OASIS_PIN_TASK_H_
+
+#include "pin.H"
+
+#include "Guard.h"
+#include "Mutex.h"
+#include "Semaphore.h"
+#include "Thread.h"
+
+#include <deque>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Task
+ *
+ * Active object with a message queue that is serviced by one or more Pin
+ * internal threads, similar to ACE_Task. Application threads put messages
+ * on the queue with putq (), and return to the application. The workers
+ * run svc (), which takes the messages off the queue with getq () and
+ * processes them. This moves expensive per-event processing (e.g.,
+ * formatting, lookups, and I/O) off the application threads.
+ *
+ * The default svc () takes up to batch_size () messages at a time, and
+ * passes them to handle_messages (). A subclass either overrides
+ * handle_messages (), or overrides svc () and calls getq () itself. svc ()
+ * must return once getq () returns 0, i.e., the task is closed and the
+ * queue is empty.
+ *
+ * @code
+ * class Writer : public OASIS::Pin::Task <Event>
+ * {
+ * protected:
+ *   virtual void handle_messages (Event * events, size_t count)
+ *   {
+ *     for (size_t i = 0; i < count; ++ i)
+ *       ...
+ *   }
+ * };
+ *
+ * writer.open (2);          // in the constructor of the tool
+ * writer.putq (event);      // in an analysis routine
+ * writer.close ();          // in handle_fini_unlocked ()
+ * @endcode
+ *
+ * The queue holds at most high_water_mark () messages. Once the queue is
+ * full, putq () blocks the application thread until a worker catches up,
+ * and try_putq () fails. This bounds the memory of the task if the workers
+ * are slower than the application.
+ *
+ * The queue is protected by a mutex, and the workers take messages off
+ * the queue in batches, so the lock is taken once per batch instead of
+ * once per message. The semaphores are only set when the queue goes from
+ * empty to not empty, or from full to not full.
+ *
+ * The workers must be stopped with close () before Pin terminates the
+ * internal threads, i.e., in the handle_fini_unlocked () or handle_detach ()
+ * method of the tool. close () lets the workers process the messages that
+ * are still in the queue before it returns. A subclass that overrides
+ * svc () or handle_messages () must also close the task in its destructor,
+ * since the workers call the subclass.
+ *
+ * MSG must be default constructible, and copyable with assignment, since
+ * getq () assigns the messages to an array, and the default svc () creates
+ * an array of batch_size () messages. The copy constructor and assignment
+ * operator for this class are disabled.
+ */
+template <typename MSG>
+class Task
+{
+public:
+  /// Type definition of the message type.
+  typedef MSG message_type;
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       high_water_mark     Maximum number of queued messages
+   * @param[in]       batch_size          Messages per call to handle_messages ()
+   */
+  explicit Task (size_t high_water_mark = 4096, size_t batch_size = 64);
+
+  /// Destructor.
+  virtual ~Task (void);
+
+  /**
+   * Start the workers.
+   *
+   * @param[in]       threads         Number of workers
+   * @return          Number of workers that started
+   */
+  size_t open (size_t threads = 1);
+
+  /// Close the queue, and wait for the workers to process the queued messages.
+  void close (void);
+
+  /// Test if the task accepts messages.
+  bool is_active (void);
+
+  /// Number of workers that are running.
+  size_t thread_count (void) const;
+
+  /**
+   * Put a message on the queue. If the queue is full, the calling thread
+   * blocks until there is room.
+   *
+   * @param[in]       msg             The message
+   * @retval          true            The message is on the queue
+   * @retval          false           The task is closed
+   */
+  bool putq (const MSG & msg);
+
+  /**
+   * Put a message on the queue if there is room.
+   *
+   * @param[in]       msg             The message
+   * @retval          true            The message is on the queue
+   * @retval          false           The queue is full, or the task is closed
+   */
+  bool try_putq (const MSG & msg);
+
+  /**
+   * Take up to \a max messages off the queue. The calling thread blocks
+   * until there is at least one message, or the task is closed.
+   *
+   * @param[out]      msgs            Array of at least \a max messages
+   * @param[in]       max             Maximum number of messages
+   * @return          Number of messages, or 0 if the task is closed and the
+   *                  queue is empty
+   */
+  size_t getq (MSG * msgs, size_t max);
+
+  /// Number of messages in the queue.
+  size_t message_count (void);
+
+  /// Get the high water mark of the queue.
+  size_t high_water_mark (void);
+
+  /// Set the high water mark of the queue.
+  void high_water_mark (size_t hwm);
+
+  /// Number of messages svc () passes to handle_messages () at a time.
+  size_t batch_size (void) const;
+
+  /// Service routine of the workers.
+  virtual void svc (void);
+
+protected:
+  /**
+   * Process a batch of messages taken off the queue by svc (). The
+   * default implementation ignores the messages.
+   *
+   * @param[in]       msgs            The messages
+   * @param[in]       count           Number of messages
+   */
+  virtual void handle_messages (MSG * msgs, size_t count);
+
+private:
+  /**
+   * @class Worker
+   *
+   * Worker thread that runs the service routine of the task.
+   */
+  class Worker : public Thread
+  {
+  public:
+    explicit Worker (Task & task);
+
+    virtual void run (void);
+
+  private:
+    Task & task_;
+  };
+
+  /// Put a message on the queue. The lock must be held, and the queue not full.
+  void enqueue (const MSG & msg);
+
+  /// The workers.
+  std::vector <Worker *> workers_;
+
+  /// Number of workers that started.
+  size_t thread_count_;
+
+  /// Lock for the queue.
+  Mutex lock_;
+
+  /// The queued messages.
+  std::deque <MSG> queue_;
+
+  /// Maximum number of queued messages.
+  size_t high_water_mark_;
+
+  /// Messages per batch in svc ().
+  size_t batch_size_;
+
+  /// The task accepts messages.
+  bool active_;
+
+  /// Semaphore set while the queue is not empty, or the task is closed.
+  Semaphore not_empty_;
+
+  /// Semaphore set while the queue is not full, or the task is closed.
+  Semaphore not_full_;
+
+  // prevent the following operations
+  Task (const Task &);
+  const Task & operator = (const Task &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Task.inl"
+#include "Task.cpp"
+
+#endif  // _OASIS_PIN_TASK_H_
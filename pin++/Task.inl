@@ -0,0 +1,80 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename MSG>
+inline
+size_t Task <MSG>::thread_count (void) const
+{
+  return this->thread_count_;
+}
+
+template <typename MSG>
+inline
+bool Task <MSG>::is_active (void)
+{
+  Guard <Mutex> guard (this->lock_);
+  return this->active_;
+}
+
+template <typename MSG>
+inline
+size_t Task <MSG>::message_count (void)
+{
+  Guard <Mutex> guard (this->lock_);
+  return this->queue_.size ();
+}
+
+template <typename MSG>
+inline
+size_t Task <MSG>::high_water_mark (void)
+{
+  Guard <Mutex> guard (this->lock_);
+  return this->high_water_mark_;
+}
+
+template <typename MSG>
+inline
+size_t Task <MSG>::batch_size (void) const
+{
+  return this->batch_size_;
+}
+
+template <typename MSG>
+inline
+void Task <MSG>::handle_messages (MSG *, size_t)
+{
+
+}
+
+template <typename MSG>
+inline
+void Task <MSG>::enqueue (const MSG & msg)
+{
+  this->queue_.push_back (msg);
+
+  if (1 == this->queue_.size ())
+    this->not_empty_.set ();
+}
+
+template <typename MSG>
+inline
+Task <MSG>::Worker::Worker (Task & task)
+: task_ (task)
+{
+
+}
+
+template <typename MSG>
+inline
+void Task <MSG>::Worker::run (void)
+{
+  this->task_.svc ();
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,84 @@
+// $Id$
+
+#include "Text_Buffer.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+Text_Buffer::Text_Buffer (FILE * file, bool framed, size_t capacity)
+: file_ (file),
+  framed_ (framed),
+  buffer_ (new char [capacity]),
+  length_ (0),
+  capacity_ (capacity),
+  record_ (NO_RECORD)
+{
+  // The text is already written in bulk, so the stdio buffer would only
+  // copy it a second time.
+  if (0 != this->file_)
+    ::setvbuf (this->file_, 0, _IONBF, 0);
+}
+
+Text_Buffer::~Text_Buffer (void)
+{
+  this->end_record ();
+  this->flush ();
+
+  if (0 != this->file_)
+    ::fclose (this->file_);
+
+  delete [] this->buffer_;
+}
+
+bool Text_Buffer::flush (void)
+{
+  // Only write the complete records. The open record is moved to the
+  // front of the buffer.
+  const size_t complete = NO_RECORD != this->record_ ? this->record_ : this->length_;
+
+  if (0 == complete)
+    return true;
+
+  // The records are dropped if they cannot be written. Otherwise, the
+  // buffer would grow without bound on a full disk.
+  const bool written =
+    0 != this->file_ && complete == ::fwrite (this->buffer_, 1, complete, this->file_);
+
+  this->length_ -= complete;
+
+  if (0 != this->length_)
+    ::memmove (this->buffer_, this->buffer_ + complete, this->length_);
+
+  if (NO_RECORD != this->record_)
+    this->record_ = 0;
+
+  return written;
+}
+
+void Text_Buffer::make_room (size_t length)
+{
+  this->flush ();
+
+  if (this->capacity_ - this->length_ >= length)
+    return;
+
+  // The open record, or the requested length, does not fit in the buffer.
+  // Grow the buffer instead of splitting the record.
+  size_t capacity = this->capacity_ * 2;
+
+  if (capacity < this->length_ + length)
+    capacity = this->length_ + length;
+
+  char * buffer = new char [capacity];
+  ::memcpy (buffer, this->buffer_, this->length_);
+
+  delete [] this->buffer_;
+
+  this->buffer_ = buffer;
+  this->capacity_ = capacity;
+}
+
+} // namespace OASIS
+} // namespace Pin
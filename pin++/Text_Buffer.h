@@ -0,0 +1,182 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Text_Buffer.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TEXT_BUFFER_H_
+#define _OASIS_PIN_TEXT_BUFFER_H_
+
+#include "pin.H"
+#include "Pin_export.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Hex
+ *
+ * Writes a value to a Text_Buffer in lowercase hexadecimal, e.g.,
+ *
+ * @code
+ * buffer << Hex (addr) << '\n';
+ * @endcode
+ */
+struct Hex
+{
+  explicit Hex (UINT64 value, bool prefix = true)
+    : value_ (value), prefix_ (prefix) { }
+
+  /// The value to write.
+  UINT64 value_;
+
+  /// Write the 0x prefix.
+  bool prefix_;
+};
+
+/**
+ * @class Text_Buffer
+ *
+ * Large private buffer for the text output of one thread. The values are
+ * formatted by hand into the buffer, so writing an event does not pay for
+ * iostream sentries, locales, or a lock on a shared FILE. The buffer is
+ * written to its file in bulk when it fills, when flush () is called, and
+ * when it is destroyed.
+ *
+ * The text is written in records. A record is the text of one event, and
+ * is never split between two writes to the file. If the buffer is framed,
+ * each record is also stored with its timestamp and length so the files
+ * of several threads can be merged in time order later (see Text_Sink).
+ * Text that is written outside of a record is only allowed if the buffer
+ * is not framed.
+ *
+ * A Text_Buffer is not thread-safe. It is meant to be written by the
+ * thread that owns it. The copy constructor and assignment operator for
+ * this class are disabled.
+ */
+class OASIS_PIN_Export Text_Buffer
+{
+public:
+  /// Default capacity of the buffer (1 MB).
+  static const size_t DEFAULT_CAPACITY = 1024 * 1024;
+
+  /// Size of the frame in front of each record of a framed buffer.
+  static const size_t FRAME_SIZE = sizeof (UINT64) + sizeof (UINT32);
+
+  /**
+   * Initializing constructor. The buffer takes ownership of the file,
+   * and closes it when it is destroyed.
+   *
+   * @param[in]       file            The file to write to
+   * @param[in]       framed          Store records with their frame
+   * @param[in]       capacity        Initial capacity of the buffer
+   */
+  Text_Buffer (FILE * file, bool framed, size_t capacity = DEFAULT_CAPACITY);
+
+  /// Destructor. The buffer is flushed and the file is closed.
+  ~Text_Buffer (void);
+
+  /// Test if the records are framed.
+  bool framed (void) const;
+
+  /**
+   * Begin a new record. An open record is ended first.
+   *
+   * @param[in]       timestamp       Time of the record, for merging
+   */
+  void begin_record (UINT64 timestamp = 0);
+
+  /// End the current record.
+  void end_record (void);
+
+  /// @{ Formatting Methods
+  Text_Buffer & write (const char * str, size_t length);
+  Text_Buffer & write (const char * str);
+  Text_Buffer & write (const std::string & str);
+  Text_Buffer & write (char ch);
+  Text_Buffer & write_dec (UINT64 value);
+  Text_Buffer & write_dec (INT64 value);
+  Text_Buffer & write_hex (UINT64 value, bool prefix = true);
+  /// @}
+
+  /**
+   * Write the complete records in the buffer to the file. An open record
+   * stays in the buffer.
+   *
+   * @retval          true            The records were written
+   * @retval          false           Failed to write the records, which
+   *                                  are dropped
+   */
+  bool flush (void);
+
+  /// Number of bytes in the buffer.
+  size_t size (void) const;
+
+  /// Current capacity of the buffer.
+  size_t capacity (void) const;
+
+private:
+  /// Make room for @a length more bytes.
+  void reserve (size_t length);
+
+  /// Slow path of reserve (): flush the buffer, and grow it if needed.
+  void make_room (size_t length);
+
+  /// Offset of record_ when there is no open record.
+  static const size_t NO_RECORD = static_cast <size_t> (-1);
+
+  /// The file for the text.
+  FILE * file_;
+
+  /// Store a frame in front of each record.
+  bool framed_;
+
+  /// The text.
+  char * buffer_;
+
+  /// Number of bytes in the buffer.
+  size_t length_;
+
+  /// Size of the buffer.
+  size_t capacity_;
+
+  /// Offset of the open record, or NO_RECORD.
+  size_t record_;
+
+  // prevent the following operations
+  Text_Buffer (const Text_Buffer &);
+  const Text_Buffer & operator = (const Text_Buffer &);
+};
+
+/// @{ Stream Operators
+Text_Buffer & operator << (Text_Buffer & buffer, char ch);
+Text_Buffer & operator << (Text_Buffer & buffer, const char * str);
+Text_Buffer & operator << (Text_Buffer & buffer, const std::string & str);
+Text_Buffer & operator << (Text_Buffer & buffer, int value);
+Text_Buffer & operator << (Text_Buffer & buffer, unsigned int value);
+Text_Buffer & operator << (Text_Buffer & buffer, long value);
+Text_Buffer & operator << (Text_Buffer & buffer, unsigned long value);
+Text_Buffer & operator << (Text_Buffer & buffer, long long value);
+Text_Buffer & operator << (Text_Buffer & buffer, unsigned long long value);
+Text_Buffer & operator << (Text_Buffer & buffer, const void * ptr);
+Text_Buffer & operator << (Text_Buffer & buffer, const Hex & hex);
+/// @}
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Text_Buffer.inl"
+
+#endif  // _OASIS_PIN_TEXT_BUFFER_H_
@@ -0,0 +1,219 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+bool Text_Buffer::framed (void) const
+{
+  return this->framed_;
+}
+
+inline
+size_t Text_Buffer::size (void) const
+{
+  return this->length_;
+}
+
+inline
+size_t Text_Buffer::capacity (void) const
+{
+  return this->capacity_;
+}
+
+inline
+void Text_Buffer::reserve (size_t length)
+{
+  if (this->capacity_ - this->length_ < length)
+    this->make_room (length);
+}
+
+inline
+void Text_Buffer::begin_record (UINT64 timestamp)
+{
+  this->end_record ();
+
+  if (this->framed_)
+  {
+    this->reserve (FRAME_SIZE);
+
+    // The length is filled in by end_record ().
+    ::memcpy (this->buffer_ + this->length_, &timestamp, sizeof (UINT64));
+    ::memset (this->buffer_ + this->length_ + sizeof (UINT64), 0, sizeof (UINT32));
+  }
+
+  this->record_ = this->length_;
+
+  if (this->framed_)
+    this->length_ += FRAME_SIZE;
+}
+
+inline
+void Text_Buffer::end_record (void)
+{
+  if (NO_RECORD == this->record_)
+    return;
+
+  if (this->framed_)
+  {
+    const UINT32 length = static_cast <UINT32> (this->length_ - this->record_ - FRAME_SIZE);
+    ::memcpy (this->buffer_ + this->record_ + sizeof (UINT64), &length, sizeof (UINT32));
+  }
+
+  this->record_ = NO_RECORD;
+}
+
+inline
+Text_Buffer & Text_Buffer::write (const char * str, size_t length)
+{
+  this->reserve (length);
+
+  ::memcpy (this->buffer_ + this->length_, str, length);
+  this->length_ += length;
+
+  return *this;
+}
+
+inline
+Text_Buffer & Text_Buffer::write (const char * str)
+{
+  return this->write (str, ::strlen (str));
+}
+
+inline
+Text_Buffer & Text_Buffer::write (const std::string & str)
+{
+  return this->write (str.data (), str.length ());
+}
+
+inline
+Text_Buffer & Text_Buffer::write (char ch)
+{
+  this->reserve (1);
+  this->buffer_[this->length_ ++] = ch;
+
+  return *this;
+}
+
+inline
+Text_Buffer & Text_Buffer::write_dec (UINT64 value)
+{
+  // The digits are formatted from the end of a scratch buffer.
+  char digits[20];
+  char * iter = digits + sizeof (digits);
+
+  do
+  {
+    *-- iter = static_cast <char> ('0' + value % 10);
+    value /= 10;
+  } while (0 != value);
+
+  return this->write (iter, digits + sizeof (digits) - iter);
+}
+
+inline
+Text_Buffer & Text_Buffer::write_dec (INT64 value)
+{
+  if (value >= 0)
+    return this->write_dec (static_cast <UINT64> (value));
+
+  this->write ('-');
+
+  // Negate in unsigned arithmetic so the minimum value does not overflow.
+  return this->write_dec (0 - static_cast <UINT64> (value));
+}
+
+inline
+Text_Buffer & Text_Buffer::write_hex (UINT64 value, bool prefix)
+{
+  static const char DIGITS[] = "0123456789abcdef";
+
+  char digits[18];
+  char * iter = digits + sizeof (digits);
+
+  do
+  {
+    *-- iter = DIGITS[value & 0xF];
+    value >>= 4;
+  } while (0 != value);
+
+  if (prefix)
+  {
+    *-- iter = 'x';
+    *-- iter = '0';
+  }
+
+  return this->write (iter, digits + sizeof (digits) - iter);
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, char ch)
+{
+  return buffer.write (ch);
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, const char * str)
+{
+  return buffer.write (str);
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, const std::string & str)
+{
+  return buffer.write (str);
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, int value)
+{
+  return buffer.write_dec (static_cast <INT64> (value));
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, unsigned int value)
+{
+  return buffer.write_dec (static_cast <UINT64> (value));
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, long value)
+{
+  return buffer.write_dec (static_cast <INT64> (value));
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, unsigned long value)
+{
+  return buffer.write_dec (static_cast <UINT64> (value));
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, long long value)
+{
+  return buffer.write_dec (static_cast <INT64> (value));
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, unsigned long long value)
+{
+  return buffer.write_dec (static_cast <UINT64> (value));
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, const void * ptr)
+{
+  return buffer.write_hex (reinterpret_cast <ADDRINT> (ptr));
+}
+
+inline
+Text_Buffer & operator << (Text_Buffer & buffer, const Hex & hex)
+{
+  return buffer.write_hex (hex.value_, hex.prefix_);
+}
+
+} // namespace OASIS
+} // namespace Pin
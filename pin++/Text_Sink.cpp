@@ -0,0 +1,211 @@
+// $Id$
+
+#include "Text_Sink.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Merge_Input
+ *
+ * A temporary file of a thread while it is merged, with the frame of its
+ * next record.
+ */
+struct Merge_Input
+{
+  FILE * file_;
+
+  THREADID thr_id_;
+
+  UINT64 timestamp_;
+
+  UINT32 length_;
+
+  /// The file could not be read, or ends in the middle of a frame.
+  bool failed_;
+
+  /// Read the frame of the next record. Returns false at the end.
+  bool next (void)
+  {
+    const size_t count = ::fread (&this->timestamp_, 1, sizeof (UINT64), this->file_);
+
+    if (0 == count && ::feof (this->file_) && !::ferror (this->file_))
+      return false;
+
+    if (sizeof (UINT64) != count ||
+        1 != ::fread (&this->length_, sizeof (UINT32), 1, this->file_))
+    {
+      this->failed_ = true;
+      return false;
+    }
+
+    return true;
+  }
+
+  /// Order for a min-heap of the inputs. Ties go to the lower thread.
+  bool operator < (const Merge_Input & rhs) const
+  {
+    if (this->timestamp_ != rhs.timestamp_)
+      return this->timestamp_ > rhs.timestamp_;
+
+    return this->thr_id_ > rhs.thr_id_;
+  }
+};
+
+Text_Sink::Text_Sink (const std::string & filename, Mode mode, size_t capacity)
+: filename_ (filename),
+  mode_ (mode),
+  capacity_ (capacity),
+  buffers_ (PIN_MAX_THREADS, 0)
+{
+
+}
+
+std::string Text_Sink::thread_filename (THREADID thr_id) const
+{
+  std::ostringstream filename;
+  filename << this->filename_ << "." << thr_id;
+
+  if (MERGED_FILE == this->mode_)
+    filename << ".tmp";
+
+  return filename.str ();
+}
+
+Text_Buffer & Text_Sink::open (THREADID thr_id)
+{
+  // A buffer without a file drops its text, so the tool keeps running if
+  // the file cannot be created.
+  FILE * file = ::fopen (this->thread_filename (thr_id).c_str (), "wb");
+
+  Text_Buffer * buffer = new Text_Buffer (file, MERGED_FILE == this->mode_, this->capacity_);
+  this->buffers_[thr_id] = buffer;
+
+  return *buffer;
+}
+
+bool Text_Sink::close (const char * trailer)
+{
+  bool retval = true;
+  std::vector <THREADID> threads;
+
+  for (size_t i = 0; i < this->buffers_.size (); ++ i)
+  {
+    Text_Buffer * buffer = this->buffers_[i];
+
+    if (0 == buffer)
+      continue;
+
+    threads.push_back (static_cast <THREADID> (i));
+
+    if (0 != trailer && PER_THREAD_FILES == this->mode_)
+    {
+      buffer->end_record ();
+      buffer->write (trailer);
+    }
+
+    // Destroying the buffer flushes it, and closes its file.
+    buffer->end_record ();
+    retval = buffer->flush () && retval;
+
+    this->buffers_[i] = 0;
+    delete buffer;
+  }
+
+  if (MERGED_FILE == this->mode_ && (!threads.empty () || 0 != trailer))
+    retval = this->merge (threads, trailer) && retval;
+
+  return retval;
+}
+
+bool Text_Sink::merge (const std::vector <THREADID> & threads, const char * trailer)
+{
+  FILE * output = ::fopen (this->filename_.c_str (), "wb");
+
+  if (0 == output)
+    return false;
+
+  bool retval = true;
+  std::vector <Merge_Input> inputs;
+
+  // Only the files of the threads that wrote to this sink are merged. A
+  // file left by another sink, or by an earlier run, is not touched.
+  for (size_t i = 0; i < threads.size () && retval; ++ i)
+  {
+    Merge_Input input;
+    input.file_ = ::fopen (this->thread_filename (threads[i]).c_str (), "rb");
+    input.thr_id_ = threads[i];
+    input.failed_ = false;
+
+    if (0 == input.file_)
+      retval = false;
+    else
+      inputs.push_back (input);
+  }
+
+  std::vector <Merge_Input> heap;
+
+  for (size_t i = 0; i < inputs.size () && retval; ++ i)
+  {
+    if (inputs[i].next ())
+      heap.push_back (inputs[i]);
+    else
+      retval = !inputs[i].failed_;
+  }
+
+  std::make_heap (heap.begin (), heap.end ());
+  std::vector <char> record;
+
+  // Copy the record with the lowest timestamp, and read the next frame of
+  // its file, until all the files are exhausted. The merge stops at the
+  // first error.
+  while (retval && !heap.empty ())
+  {
+    std::pop_heap (heap.begin (), heap.end ());
+    Merge_Input & input = heap.back ();
+
+    record.resize (input.length_);
+
+    if (0 != input.length_ &&
+        (input.length_ != ::fread (&record[0], 1, input.length_, input.file_) ||
+         input.length_ != ::fwrite (&record[0], 1, input.length_, output)))
+    {
+      retval = false;
+    }
+    else if (input.next ())
+    {
+      std::push_heap (heap.begin (), heap.end ());
+    }
+    else
+    {
+      retval = !input.failed_;
+      heap.pop_back ();
+    }
+  }
+
+  if (retval && 0 != trailer)
+    retval = EOF != ::fputs (trailer, output);
+
+  retval = 0 == ::fclose (output) && retval;
+
+  // The temporary files are only removed if the whole merge succeeded, so
+  // the records are not lost if the output is incomplete.
+  for (size_t i = 0; i < inputs.size (); ++ i)
+  {
+    ::fclose (inputs[i].file_);
+
+    if (retval)
+      ::remove (this->thread_filename (inputs[i].thr_id_).c_str ());
+  }
+
+  return retval;
+}
+
+} // namespace OASIS
+} // namespace Pin
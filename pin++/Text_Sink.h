@@ -0,0 +1,179 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Text_Sink.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TEXT_SINK_H_
+#define _OASIS_PIN_TEXT_SINK_H_
+
+#include "Padded.h"
+#include "Pin_export.h"
+#include "Text_Buffer.h"
+
+#include <string>
+#include <vector>
+
+#if defined (_MSC_VER)
+  #include <intrin.h>
+#else
+  #include <x86intrin.h>
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Text_Sink
+ *
+ * Text output of a tool, where each thread writes to its own Text_Buffer
+ * instead of sharing one stream. The sink has two modes:
+ *
+ * - PER_THREAD_FILES writes the text of each thread to its own file,
+ *   named <filename>.<thread id>.
+ * - MERGED_FILE writes the records of each thread, with a timestamp, to
+ *   a temporary file. When the sink is closed, the records of the threads
+ *   that wrote to the sink are merged in time order into <filename>, and
+ *   the temporary files are removed. If the merge fails, the temporary
+ *   files are kept, and close () returns false.
+ *
+ * The buffer of a thread is created the first time the thread writes to
+ * the sink. The analysis routines write whole events as Text_Record
+ * objects:
+ *
+ * @code
+ * void handle_analyze (ADDRINT ip, THREADID thr_id)
+ * {
+ *   OASIS::Pin::Text_Record record (this->sink_, thr_id);
+ *   record.buffer () << OASIS::Pin::Hex (ip) << '\n';
+ * }
+ * @endcode
+ *
+ * The tool must call close () when the application exits, e.g., in its
+ * handle_fini () method, after all the threads have stopped writing.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Text_Sink
+{
+public:
+  /// The modes of the sink.
+  enum Mode
+  {
+    PER_THREAD_FILES,
+    MERGED_FILE
+  };
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       filename        Name of the output file(s)
+   * @param[in]       mode            How the threads share the output
+   * @param[in]       capacity        Capacity of each thread's buffer
+   */
+  Text_Sink (const std::string & filename,
+             Mode mode = PER_THREAD_FILES,
+             size_t capacity = Text_Buffer::DEFAULT_CAPACITY);
+
+  /// Destructor.
+  ~Text_Sink (void);
+
+  /// Get the mode of the sink.
+  Mode mode (void) const;
+
+  /// Get the buffer of a thread. It is created if it does not exist.
+  Text_Buffer & buffer (THREADID thr_id);
+
+  /// Write the complete records of a thread's buffer to its file.
+  bool flush (THREADID thr_id);
+
+  /**
+   * Flush and close the buffers of all threads. In MERGED_FILE mode, the
+   * records of the threads are merged into the output file.
+   *
+   * @param[in]       trailer         Optional text for the end of each file
+   * @retval          true            The output was written
+   * @retval          false           Failed to write some of the output
+   */
+  bool close (const char * trailer = 0);
+
+  /// Timestamp for a record, in the time stamp counter of the processor.
+  static UINT64 timestamp (void);
+
+private:
+  /// Create the buffer of a thread.
+  Text_Buffer & open (THREADID thr_id);
+
+  /// Name of the file for a thread.
+  std::string thread_filename (THREADID thr_id) const;
+
+  /// Merge the temporary files of \a threads into the output file.
+  bool merge (const std::vector <THREADID> & threads, const char * trailer);
+
+  /// Name of the output file.
+  std::string filename_;
+
+  /// Mode of the sink.
+  Mode mode_;
+
+  /// Capacity of each buffer.
+  size_t capacity_;
+
+  /// Buffer of each thread.
+  Padded_Array <Text_Buffer *> buffers_;
+
+  // prevent the following operations
+  Text_Sink (const Text_Sink &);
+  const Text_Sink & operator = (const Text_Sink &);
+};
+
+/**
+ * @class Text_Record
+ *
+ * Guard that writes one record to the buffer of a thread. The record
+ * begins, with the current timestamp, when the object is created, and
+ * ends when it is destroyed.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class Text_Record
+{
+public:
+  /// Begin a record in the buffer of a thread.
+  Text_Record (Text_Sink & sink, THREADID thr_id);
+
+  /**
+   * Begin a record with a known timestamp, e.g., from ARG_TSC. The
+   * records are merged on the assumption that the timestamps of each
+   * THREADID never decrease.
+   */
+  Text_Record (Text_Sink & sink, THREADID thr_id, UINT64 timestamp);
+
+  /// Destructor. The record is ended.
+  ~Text_Record (void);
+
+  /// Get the buffer for the text of the record.
+  Text_Buffer & buffer (void);
+
+private:
+  Text_Buffer & buffer_;
+
+  // prevent the following operations
+  Text_Record (const Text_Record &);
+  const Text_Record & operator = (const Text_Record &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Text_Sink.inl"
+
+#endif  // _OASIS_PIN_TEXT_SINK_H_
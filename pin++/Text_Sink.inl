@@ -0,0 +1,68 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Text_Sink::~Text_Sink (void)
+{
+  this->close ();
+}
+
+inline
+Text_Sink::Mode Text_Sink::mode (void) const
+{
+  return this->mode_;
+}
+
+inline
+Text_Buffer & Text_Sink::buffer (THREADID thr_id)
+{
+  Text_Buffer * buffer = this->buffers_[thr_id];
+  return 0 != buffer ? *buffer : this->open (thr_id);
+}
+
+inline
+bool Text_Sink::flush (THREADID thr_id)
+{
+  Text_Buffer * buffer = this->buffers_[thr_id];
+  return 0 == buffer || buffer->flush ();
+}
+
+inline
+UINT64 Text_Sink::timestamp (void)
+{
+  return __rdtsc ();
+}
+
+inline
+Text_Record::Text_Record (Text_Sink & sink, THREADID thr_id)
+: buffer_ (sink.buffer (thr_id))
+{
+  this->buffer_.begin_record (this->buffer_.framed () ? Text_Sink::timestamp () : 0);
+}
+
+inline
+Text_Record::Text_Record (Text_Sink & sink, THREADID thr_id, UINT64 timestamp)
+: buffer_ (sink.buffer (thr_id))
+{
+  this->buffer_.begin_record (timestamp);
+}
+
+inline
+Text_Record::~Text_Record (void)
+{
+  this->buffer_.end_record ();
+}
+
+inline
+Text_Buffer & Text_Record::buffer (void)
+{
+  return this->buffer_;
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -83,16 +83,23 @@ Thread::State Thread::start (size_t stack_size)
 
 bool Thread::wait (UINT32 millis, INT32 * exit_code)
 {
-  // Ideally, we would like to put a read guard here while we are "reading"
-  // the thread uid. Unfortunately, using a read guard here results in the
-  // program hanging if the wait() method is called in fini unlocked by a
-  // tool (the most logical place to call this method).
-  Read_Guard <RW_Mutex> guard (this->rw_mutex_);
+  // Only hold the read guard while we are reading the thread uid. If we
+  // hold it while waiting, then the thread cannot acquire the write guard
+  // to update its state when run () returns, and the program hangs if the
+  // wait () method is called in fini unlocked by a tool (the most logical
+  // place to call this method).
+  PIN_THREAD_UID thr_uid = INVALID_PIN_THREAD_UID;
+
+  do
+  {
+    Read_Guard <RW_Mutex> guard (this->rw_mutex_);
+    thr_uid = this->thr_uid_;
+  } while (0);
 
-  if (this->thr_uid_ == INVALID_PIN_THREAD_UID)
+  if (thr_uid == INVALID_PIN_THREAD_UID)
     return true;
 
-  return PIN_WaitForThreadTermination (this->thr_uid_, millis, exit_code);
+  return PIN_WaitForThreadTermination (thr_uid, millis, exit_code);
 }
 
 VOID Thread::__thr_run (VOID * arg)
@@ -101,8 +108,9 @@ VOID Thread::__thr_run (VOID * arg)
   Thread * thr = reinterpret_cast <Thread *> (arg);
   
   // Set the current thread to the Thread object. This allows the
-  // client to access the Thread object via the current () method.
-  Thread::current_.set (thr->thr_id_, thr);
+  // client to access the Thread object via the current () method. Use
+  // the id from Pin since start () may not have stored it yet.
+  Thread::current_.set (PIN_ThreadId (), thr);
   
   do
   {
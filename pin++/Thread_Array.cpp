@@ -0,0 +1,46 @@
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+Thread_Array <T>::Thread_Array (DESTRUCTFUN destructor)
+: destructor_ (destructor),
+  items_ (PIN_MAX_THREADS, 0)
+{
+  if (0 != this->destructor_)
+    PIN_AddThreadFiniFunction (&Thread_Array::__thread_fini, this);
+}
+
+template <typename T>
+Thread_Array <T>::~Thread_Array (void)
+{
+  if (0 == this->destructor_)
+    return;
+
+  for (size_t i = 0; i < this->items_.size (); ++ i)
+    this->destroy (static_cast <THREADID> (i));
+}
+
+template <typename T>
+void Thread_Array <T>::destroy (THREADID thr_id)
+{
+  T * & data = this->items_[thr_id];
+
+  if (0 == data)
+    return;
+
+  this->destructor_ (data);
+  data = 0;
+}
+
+template <typename T>
+VOID Thread_Array <T>::__thread_fini (THREADID thr_id, const CONTEXT *, INT32, VOID * v)
+{
+  reinterpret_cast <Thread_Array *> (v)->destroy (thr_id);
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,125 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Thread_Array.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_THREAD_ARRAY_H_
+#define _OASIS_PIN_THREAD_ARRAY_H_
+
+#include "pin.H"
+#include "Padded.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Thread_Array
+ *
+ * Alternative to TLS that stores the object for each thread in a dense,
+ * cache line padded array indexed by THREADID. Getting the object of a
+ * thread is a single indexed load instead of a call to PIN_GetThreadData.
+ * The class has the same interface as TLS, so the two can be swapped.
+ *
+ * The client has the option of registering a destruction function. If a
+ * function is registered, then the object of a thread is destroyed when
+ * the thread terminates. All remaining objects are destroyed when the
+ * Thread_Array is destroyed.
+ *
+ * The array is bounded by PIN_MAX_THREADS. Each thread should only set its
+ * own slot, but any thread can read the slot of another thread.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+template <typename T>
+class Thread_Array
+{
+public:
+  /// Default constructor.
+  Thread_Array (DESTRUCTFUN destructor = 0);
+
+  /// Destructor.
+  ~Thread_Array (void);
+
+  /// Get the object for the current thread.
+  T * operator -> (void) const;
+
+  /// Get the object for the current thread.
+  T * get (void) const;
+
+  /**
+   * Get the object for a thread.
+   *
+   * @param[in]     thr_id        Target thread
+   */
+  T * get (THREADID thr_id) const;
+
+  /**
+   * Get the object for the thread. If the object does not exists, then
+   * the factory object will be used to create a new one. The FACTORY
+   * should have void -> T * function type signature.
+   */
+  template <typename FACTORY>
+  T * get_with_create (FACTORY factory);
+
+  /**
+   * @overload
+   *
+   * @param[in]     thr_id        Target thread
+   */
+  template <typename FACTORY>
+  T * get_with_create (THREADID thr_id, FACTORY factory);
+
+  /// Set the data for the current thread.
+  void set (T * data);
+
+  /**
+   * Set the data for a thread.
+   *
+   * @param[in]     thr_id        Target thread
+   */
+  void set (THREADID thr_id, T * data);
+
+  /// Test if the value for the current thread is set.
+  bool is_set (void) const;
+
+  /**
+   * Test if the value of a thread is set.
+   *
+   * @param[in]     thr_id        Target thread
+   */
+  bool is_set (THREADID thr_id) const;
+
+private:
+  /// Destroy the object of a thread, and reset its slot.
+  void destroy (THREADID thr_id);
+
+  /// Thread fini callback that destroys the object of the thread.
+  static VOID __thread_fini (THREADID thr_id, const CONTEXT * ctx, INT32 flags, VOID * v);
+
+  /// The destruction function for the objects.
+  DESTRUCTFUN destructor_;
+
+  /// The object for each thread.
+  Padded_Array <T *> items_;
+
+  // prevent the following operations
+  const Thread_Array & operator = (const Thread_Array &);
+  Thread_Array (const Thread_Array & rhs);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Thread_Array.inl"
+#include "Thread_Array.cpp"
+
+#endif  // _OASIS_PIN_THREAD_ARRAY_H_
@@ -0,0 +1,80 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+inline
+T * Thread_Array <T>::operator -> (void) const
+{
+  return this->get ();
+}
+
+template <typename T>
+inline
+T * Thread_Array <T>::get (void) const
+{
+  return this->get (PIN_ThreadId ());
+}
+
+template <typename T>
+inline
+T * Thread_Array <T>::get (THREADID thr_id) const
+{
+  return this->items_[thr_id];
+}
+
+template <typename T>
+template <typename FACTORY>
+inline
+T * Thread_Array <T>::get_with_create (FACTORY factory)
+{
+  return this->get_with_create (PIN_ThreadId (), factory);
+}
+
+template <typename T>
+template <typename FACTORY>
+inline
+T * Thread_Array <T>::get_with_create (THREADID thr_id, FACTORY factory)
+{
+  T * & data = this->items_[thr_id];
+
+  if (0 == data)
+    data = factory ();
+
+  return data;
+}
+
+template <typename T>
+inline
+void Thread_Array <T>::set (T * data)
+{
+  this->set (PIN_ThreadId (), data);
+}
+
+template <typename T>
+inline
+void Thread_Array <T>::set (THREADID thr_id, T * data)
+{
+  this->items_[thr_id] = data;
+}
+
+template <typename T>
+inline
+bool Thread_Array <T>::is_set (void) const
+{
+  return this->is_set (PIN_ThreadId ());
+}
+
+template <typename T>
+inline
+bool Thread_Array <T>::is_set (THREADID thr_id) const
+{
+  return 0 != this->items_[thr_id];
+}
+
+} // namespace OASIS
+} // namespace Pin
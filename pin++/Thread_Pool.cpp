@@ -0,0 +1,229 @@
+// $Id$
+
+#include "Thread_Pool.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Time a thread waiting on a latch sleeps before it looks for tasks again.
+static const UINT32 LATCH_WAIT_TIMEOUT = 50;
+
+Thread_Pool::Thread_Pool (size_t threads)
+: queued_ (0),
+  next_ (0),
+  stopped_ (0),
+  running_ (0)
+{
+  // The workers read the vector, so fill it before starting any of them. A
+  // worker that does not start keeps its (empty) deque, and the tasks
+  // queued on it are stolen by the other workers.
+  for (size_t i = 0; i < threads; ++ i)
+    this->workers_.push_back (new Worker (*this, i));
+
+  for (size_t i = 0; i < threads; ++ i)
+  {
+    if (this->workers_[i]->start () != Thread::ERROR)
+      ++ this->running_;
+  }
+}
+
+Thread_Pool::~Thread_Pool (void)
+{
+  this->shutdown ();
+}
+
+bool Thread_Pool::submit (Runnable * task, Latch * latch)
+{
+  // The read lock keeps shutdown () from setting the flag, or freeing the
+  // workers, until the task is queued. A worker keeps its own subtasks,
+  // even while the pool is shutting down, since it runs them before it
+  // exits. Other threads spread their tasks across the workers.
+  Read_Guard <RW_Mutex> guard (this->lock_);
+
+  size_t index = this->current_index ();
+
+  if (index == this->workers_.size ())
+  {
+    if (this->is_stopped () || 0 == this->running_)
+      return false;
+
+    index = ATOMIC::OPS::Increment (&this->next_, static_cast <UINT32> (1)) % this->workers_.size ();
+  }
+
+  if (0 != latch)
+    latch->add ();
+
+  Task t;
+  t.runnable_ = task;
+  t.latch_ = latch;
+
+  // Count the task before it is visible so a worker never sees an empty
+  // pool while the task is in a deque.
+  ATOMIC::OPS::Increment (&this->queued_, static_cast <UINT32> (1));
+
+  Worker * worker = this->workers_[index];
+
+  do
+  {
+    Guard <Lock> guard (worker->lock_);
+    worker->tasks_.push_back (t);
+  } while (false);
+
+  this->work_ready_.set ();
+
+  return true;
+}
+
+void Thread_Pool::wait (Latch & latch)
+{
+  const size_t index = this->current_index ();
+
+  while (!latch.is_done ())
+  {
+    Task task;
+
+    if (this->next_task (index, task))
+      this->execute (task);
+    else
+      latch.wait (LATCH_WAIT_TIMEOUT);
+  }
+}
+
+bool Thread_Pool::shutdown (void)
+{
+  do
+  {
+    // A submit () that got the lock first has queued its task, so the
+    // workers still run it.
+    Write_Guard <RW_Mutex> guard (this->lock_);
+
+    if (this->is_stopped ())
+      return true;
+
+    // A worker cannot wait for itself to exit.
+    if (this->current_index () != this->workers_.size ())
+      return false;
+
+    ATOMIC::OPS::Store (&this->stopped_, static_cast <UINT32> (1), ATOMIC::BARRIER_ST_PREV);
+  } while (false);
+
+  this->work_ready_.set ();
+
+  // The workers steal from each other, so wait for all of them before
+  // deleting any of them. The workers can still submit subtasks, so the
+  // lock is not held while waiting.
+  for (size_t i = 0; i < this->workers_.size (); ++ i)
+    this->workers_[i]->wait ();
+
+  Write_Guard <RW_Mutex> guard (this->lock_);
+
+  for (size_t i = 0; i < this->workers_.size (); ++ i)
+    delete this->workers_[i];
+
+  this->workers_.clear ();
+  this->running_ = 0;
+
+  return true;
+}
+
+void Thread_Pool::run_worker (size_t index)
+{
+  for (;;)
+  {
+    Task task;
+
+    if (this->next_task (index, task))
+    {
+      this->execute (task);
+      continue;
+    }
+
+    if (this->is_stopped () && 0 == ATOMIC::OPS::Load (&this->queued_))
+      break;
+
+    // Clear the semaphore before checking for work again so a task that
+    // is queued in between is not missed: submit () counts the task before
+    // it sets the semaphore. If there is work, set it again in case another
+    // worker is waiting. Otherwise, block until there is work.
+    this->work_ready_.release ();
+
+    if (0 != ATOMIC::OPS::Load (&this->queued_, ATOMIC::BARRIER_LD_NEXT) || this->is_stopped ())
+      this->work_ready_.set ();
+    else
+      this->work_ready_.acquire ();
+  }
+}
+
+bool Thread_Pool::next_task (size_t index, Task & task)
+{
+  const size_t count = this->workers_.size ();
+
+  if (0 == ATOMIC::OPS::Load (&this->queued_, ATOMIC::BARRIER_LD_NEXT))
+    return false;
+
+  // Run the newest task of our own deque first since its data is most
+  // likely still in the cache.
+  if (index < count)
+  {
+    Worker * worker = this->workers_[index];
+    Guard <Lock> guard (worker->lock_);
+
+    if (!worker->tasks_.empty ())
+    {
+      task = worker->tasks_.back ();
+      worker->tasks_.pop_back ();
+
+      ATOMIC::OPS::Increment (&this->queued_, static_cast <UINT32> (-1));
+      return true;
+    }
+  }
+
+  // Steal the oldest task of another worker, starting with our neighbor.
+  for (size_t i = 1; i <= count; ++ i)
+  {
+    Worker * victim = this->workers_[(index + i) % count];
+    Guard <Lock> guard (victim->lock_);
+
+    if (!victim->tasks_.empty ())
+    {
+      task = victim->tasks_.front ();
+      victim->tasks_.pop_front ();
+
+      ATOMIC::OPS::Increment (&this->queued_, static_cast <UINT32> (-1));
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void Thread_Pool::execute (const Task & task)
+{
+  task.runnable_->run ();
+
+  if (0 != task.latch_)
+    task.latch_->count_down ();
+}
+
+size_t Thread_Pool::current_index (void) const
+{
+  Thread * current = Thread::current ();
+
+  for (size_t i = 0; i < this->workers_.size (); ++ i)
+  {
+    if (this->workers_[i] == current)
+      return i;
+  }
+
+  return this->workers_.size ();
+}
+
+void Thread_Pool::Worker::run (void)
+{
+  this->pool_.run_worker (this->index_);
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,193 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Thread_Pool.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_THREAD_POOL_H_
+#define _OASIS_PIN_THREAD_POOL_H_
+
+#include "pin.H"
+#include "atomic.hpp"
+
+#include "Pin_export.h"
+#include "Guard.h"
+#include "Latch.h"
+#include "RW_Mutex.h"
+#include "Thread.h"
+
+#include <deque>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Thread_Pool
+ *
+ * Pool of Pin internal threads that run Runnable tasks. Each worker has
+ * its own deque of tasks. A worker runs the newest task in its own deque
+ * first, and steals the oldest task from another worker when its deque is
+ * empty. Tasks submitted by a worker (e.g., a task that splits its work)
+ * go to the deque of that worker, and tasks submitted by any other thread
+ * are spread across the workers.
+ *
+ * Completion is tracked with a Latch. The latch passed to submit () is
+ * raised when the task is queued and lowered when it completes. Calling
+ * wait () on the pool instead of the latch runs queued tasks while the
+ * latch is not done, so a task can wait on its own subtasks without
+ * deadlocking the pool.
+ *
+ * @code
+ * Latch done;
+ *
+ * for (size_t i = 0; i < parts; ++ i)
+ *   pool.submit (&tasks[i], &done);
+ *
+ * pool.wait (done);
+ * @endcode
+ *
+ * The pool does not own the tasks. The workers must be stopped with
+ * shutdown () before Pin terminates the internal threads, i.e., in the
+ * handle_fini_unlocked () or handle_detach () method of the tool.
+ * shutdown () runs the queued tasks before it returns. Once shutdown ()
+ * starts, submit () from outside the pool fails, so a late task is never
+ * queued on a worker that is about to be freed. A task must not shut
+ * down, or destroy, its own pool, since the worker would wait for itself.
+ * shutdown () detects this case and returns false without stopping the
+ * workers.
+ *
+ * An idle worker blocks on a semaphore until a task is queued or the pool
+ * shuts down, so an idle pool does not use the CPU.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Thread_Pool
+{
+public:
+  /**
+   * Initializing constructor. The workers are started immediately.
+   *
+   * @param[in]       threads         Number of workers
+   */
+  explicit Thread_Pool (size_t threads);
+
+  /// Destructor.
+  ~Thread_Pool (void);
+
+  /// Number of workers that are running.
+  size_t size (void) const;
+
+  /**
+   * Submit a task to the pool.
+   *
+   * @param[in]       task            The task
+   * @param[in]       latch           Optional latch for the task
+   * @retval          true            The task is queued
+   * @retval          false           The pool is shut down
+   */
+  bool submit (Runnable * task, Latch * latch = 0);
+
+  /// Wait for a latch, and run queued tasks in the meantime.
+  void wait (Latch & latch);
+
+  /**
+   * Run the queued tasks, and stop the workers.
+   *
+   * @retval          true            The workers are stopped
+   * @retval          false           Called from a worker of the pool
+   */
+  bool shutdown (void);
+
+private:
+  /**
+   * @struct Task
+   *
+   * A task and its latch.
+   */
+  struct Task
+  {
+    Runnable * runnable_;
+    Latch * latch_;
+  };
+
+  /**
+   * @class Worker
+   *
+   * Worker thread with its own deque of tasks.
+   */
+  class Worker : public Thread
+  {
+  public:
+    Worker (Thread_Pool & pool, size_t index);
+
+    virtual void run (void);
+
+    /// Lock for the deque.
+    Lock lock_;
+
+    /// Tasks queued on this worker.
+    std::deque <Task> tasks_;
+
+  private:
+    Thread_Pool & pool_;
+
+    size_t index_;
+  };
+
+  /// Main loop of a worker.
+  void run_worker (size_t index);
+
+  /// Get the next task for a worker, stealing one if needed.
+  bool next_task (size_t index, Task & task);
+
+  /// Run a task, and lower its latch.
+  void execute (const Task & task);
+
+  /// Test if the pool is shutting down.
+  bool is_stopped (void) const;
+
+  /// Index of the worker for the calling thread, or size () if it is not a worker.
+  size_t current_index (void) const;
+
+  /// The workers.
+  std::vector <Worker *> workers_;
+
+  /// Number of tasks in the deques.
+  volatile UINT32 queued_;
+
+  /// Worker for the next task submitted from outside the pool.
+  volatile UINT32 next_;
+
+  /// The pool is shutting down.
+  volatile UINT32 stopped_;
+
+  /// Number of workers that started.
+  size_t running_;
+
+  /// Semaphore set when a task is queued.
+  Semaphore work_ready_;
+
+  /// Lock for the workers. submit () holds it for reading, and shutdown ()
+  /// holds it for writing while it stops, and later frees, the workers.
+  RW_Mutex lock_;
+
+  // prevent the following operations
+  Thread_Pool (const Thread_Pool &);
+  const Thread_Pool & operator = (const Thread_Pool &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Thread_Pool.inl"
+
+#endif  // _OASIS_PIN_THREAD_POOL_H_
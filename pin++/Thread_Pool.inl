@@ -0,0 +1,30 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+size_t Thread_Pool::size (void) const
+{
+  return this->running_;
+}
+
+inline
+bool Thread_Pool::is_stopped (void) const
+{
+  return 0 != ATOMIC::OPS::Load (&this->stopped_, ATOMIC::BARRIER_LD_NEXT);
+}
+
+inline
+Thread_Pool::Worker::Worker (Thread_Pool & pool, size_t index)
+: pool_ (pool),
+  index_ (index)
+{
+
+}
+
+} // namespace OASIS
+} // namespace Pin
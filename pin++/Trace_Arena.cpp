@@ -0,0 +1,205 @@
+// $Id$
+
+#include "Trace_Arena.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Round \a addr up to a multiple of \a alignment.
+static inline char * align (char * addr, size_t alignment)
+{
+  const ADDRINT value = reinterpret_cast <ADDRINT> (addr);
+  return addr + ((alignment - value % alignment) % alignment);
+}
+
+Trace_Arena * Trace_Arena::arenas_ = 0;
+bool Trace_Arena::registered_ = false;
+
+Trace_Arena::Trace_Arena (size_t block_size)
+: block_size_ (block_size),
+  pending_addr_ (0),
+  pending_ (0),
+  next_ (arenas_)
+{
+  // These callbacks visit every arena so they are only registered once.
+  if (!registered_)
+  {
+    CODECACHE_AddTraceInvalidatedFunction (&Trace_Arena::__trace_invalidated, 0);
+    CODECACHE_AddCacheFlushedFunction (&Trace_Arena::__cache_flushed, 0);
+    PIN_AddFiniFunction (&Trace_Arena::__fini, 0);
+
+    registered_ = true;
+  }
+
+  arenas_ = this;
+  CODECACHE_AddTraceInsertedFunction (&Trace_Arena::__trace_inserted, this);
+}
+
+Trace_Arena::~Trace_Arena (void)
+{
+  // Remove the arena from the list of arenas.
+  for (Trace_Arena ** iter = &arenas_; 0 != *iter; iter = &(*iter)->next_)
+  {
+    if (*iter == this)
+    {
+      *iter = this->next_;
+      break;
+    }
+  }
+
+  this->release_all ();
+}
+
+Trace_Arena::Allocation *
+Trace_Arena::allocate_i (ADDRINT addr, size_t size, size_t alignment)
+{
+  // The pending blocks belong to a trace that Pin did not insert into
+  // the code cache. Nothing references its objects so we can release them.
+  if (0 != this->pending_ && addr != this->pending_addr_)
+  {
+    release (this->pending_);
+    this->pending_ = 0;
+  }
+
+  this->pending_addr_ = addr;
+
+  const size_t header_alignment = Alignment_Of <Allocation>::value;
+
+  if (alignment < header_alignment)
+    alignment = header_alignment;
+
+  Block * block = this->pending_;
+  char * header = 0;
+  char * items = 0;
+
+  if (0 != block)
+  {
+    header = align (block->curr, header_alignment);
+    items = align (header + sizeof (Allocation), alignment);
+  }
+
+  if (0 == block || items > block->end || static_cast <size_t> (block->end - items) < size)
+  {
+    // Allocate a new block that is large enough for the request, after
+    // the block header and the padding needed to align the array.
+    size_t block_size =
+      sizeof (Block) + header_alignment + sizeof (Allocation) + alignment + size;
+
+    if (block_size < this->block_size_)
+      block_size = this->block_size_;
+
+    char * memory = new char [block_size];
+
+    block = reinterpret_cast <Block *> (memory);
+    block->next = this->pending_;
+    block->curr = memory + sizeof (Block);
+    block->end = memory + block_size;
+    block->allocations = 0;
+
+    this->pending_ = block;
+
+    header = align (block->curr, header_alignment);
+    items = align (header + sizeof (Allocation), alignment);
+  }
+
+  Allocation * allocation = reinterpret_cast <Allocation *> (header);
+  allocation->destroy = 0;
+  allocation->items = items;
+  allocation->count = 0;
+  allocation->next = block->allocations;
+
+  block->allocations = allocation;
+  block->curr = items + size;
+
+  return allocation;
+}
+
+void Trace_Arena::release (Block * blocks)
+{
+  while (0 != blocks)
+  {
+    Block * block = blocks;
+    blocks = blocks->next;
+
+    for (Allocation * iter = block->allocations; 0 != iter; iter = iter->next)
+    {
+      if (0 != iter->destroy)
+        iter->destroy (iter->items, iter->count);
+    }
+
+    delete [] reinterpret_cast <char *> (block);
+  }
+}
+
+void Trace_Arena::release_traces (void)
+{
+  for (map_type::iterator iter = this->traces_.begin (); iter != this->traces_.end (); ++ iter)
+    release (iter->second);
+
+  this->traces_.clear ();
+}
+
+void Trace_Arena::release_all (void)
+{
+  release (this->pending_);
+  this->pending_ = 0;
+
+  this->release_traces ();
+}
+
+VOID Trace_Arena::__trace_inserted (TRACE trace, VOID * v)
+{
+  Trace_Arena * arena = reinterpret_cast <Trace_Arena *> (v);
+
+  if (0 == arena->pending_)
+    return;
+
+  // The pending blocks now belong to the trace in the code cache.
+  Block * & blocks = arena->traces_[TRACE_CodeCacheAddress (trace)];
+
+  Block * tail = arena->pending_;
+
+  while (0 != tail->next)
+    tail = tail->next;
+
+  tail->next = blocks;
+  blocks = arena->pending_;
+
+  arena->pending_ = 0;
+}
+
+VOID Trace_Arena::__trace_invalidated (ADDRINT, ADDRINT cache_pc, BOOL success)
+{
+  if (!success)
+    return;
+
+  for (Trace_Arena * arena = arenas_; 0 != arena; arena = arena->next_)
+  {
+    map_type::iterator iter = arena->traces_.find (cache_pc);
+
+    if (iter == arena->traces_.end ())
+      continue;
+
+    release (iter->second);
+    arena->traces_.erase (iter);
+  }
+}
+
+VOID Trace_Arena::__cache_flushed (void)
+{
+  // None of the traces are in the code cache anymore. The pending blocks
+  // belong to a trace that is not inserted yet, so they are kept.
+  for (Trace_Arena * arena = arenas_; 0 != arena; arena = arena->next_)
+    arena->release_traces ();
+}
+
+VOID Trace_Arena::__fini (INT32, VOID *)
+{
+  for (Trace_Arena * arena = arenas_; 0 != arena; arena = arena->next_)
+    arena->release_all ();
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,218 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Trace_Arena.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TRACE_ARENA_H_
+#define _OASIS_PIN_TRACE_ARENA_H_
+
+#include "Trace.h"
+#include "Pin_export.h"
+
+#include <map>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Trace_Arena
+ *
+ * Arena for callback objects that are created while instrumenting a trace.
+ * The objects allocated for a trace are placed contiguously in one block
+ * of memory, and they are destroyed when Pin removes the trace from the
+ * code cache. This bounds the memory used by tools that allocate callback
+ * objects in handle_instrument (), which would otherwise grow for as long
+ * as Pin keeps generating traces.
+ *
+ * Pin compiles and inserts one trace at a time. The objects allocated
+ * since the last trace was inserted into the code cache therefore belong
+ * to the next trace that is inserted. When that trace is invalidated, its
+ * objects are destroyed and the block is released. Objects allocated for
+ * a trace that Pin discards without inserting are released when the next
+ * trace is instrumented. A full flush of the code cache does not always
+ * invalidate each trace, so the objects of the traces in the code cache
+ * are released when the code cache is flushed. The objects of the trace
+ * that is being instrumented are kept, since the trace can still be
+ * inserted after the flush. All the objects are released when the
+ * application exits.
+ *
+ * Each array is aligned for its type, so the arena can hold objects that
+ * are aligned to a cache line, such as Padded <T>.
+ *
+ * The arena must be used only from Trace instrumentation callbacks, which
+ * Pin serializes. The arena must also outlive every trace that references
+ * its objects, i.e., it should have the same lifetime as the tool.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Trace_Arena
+{
+public:
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       block_size      Minimum size of a trace block
+   */
+  Trace_Arena (size_t block_size = 4096);
+
+  /// Destructor.
+  ~Trace_Arena (void);
+
+  /**
+   * Allocate \a count default constructed objects for a trace. The
+   * objects are destroyed when the trace is removed from the code cache.
+   *
+   * @param[in]       trace           Trace being instrumented
+   * @param[in]       count           Number of objects
+   * @return          Pointer to the first object
+   */
+  template <typename T>
+  T * allocate (const Trace & trace, size_t count);
+
+  /**
+   * Allocate \a count copies of \a value for a trace. This allows the
+   * arena to hold callback objects without a default constructor.
+   *
+   * @param[in]       trace           Trace being instrumented
+   * @param[in]       count           Number of objects
+   * @param[in]       value           Initial value of each object
+   * @return          Pointer to the first object
+   */
+  template <typename T>
+  T * allocate (const Trace & trace, size_t count, const T & value);
+
+  /// Number of traces in the code cache with objects in the arena.
+  size_t trace_count (void) const;
+
+private:
+  /**
+   * @struct Allocation
+   *
+   * Header placed in front of each array in a block. The header records
+   * how to destroy the array.
+   */
+  struct Allocation
+  {
+    /// Destroy the array that follows the header.
+    void (* destroy) (void * items, size_t count);
+
+    /// The array, aligned for its type.
+    void * items;
+
+    /// Number of items in the array.
+    size_t count;
+
+    /// Next allocation in the block.
+    Allocation * next;
+  };
+
+  /**
+   * @struct Block
+   *
+   * Contiguous memory that holds the objects of a trace.
+   */
+  struct Block
+  {
+    /// Next block of the same trace.
+    Block * next;
+
+    /// Next free byte in the block.
+    char * curr;
+
+    /// End of the block.
+    char * end;
+
+    /// Allocations in the block.
+    Allocation * allocations;
+  };
+
+  /**
+   * @struct Alignment_Of
+   *
+   * Alignment of T. The compiler places T after the char at the
+   * alignment of T, which includes an alignment requested with
+   * OASIS_PIN_CACHE_ALIGNED.
+   */
+  template <typename T>
+  struct Alignment_Of
+  {
+    struct Probe
+    {
+      char c;
+      T t;
+    };
+
+    static const size_t value = sizeof (Probe) - sizeof (T);
+  };
+
+  /// Allocate \a size bytes, aligned to \a alignment, for the trace
+  /// starting at \a addr.
+  Allocation * allocate_i (ADDRINT addr, size_t size, size_t alignment);
+
+  /// Destroy the objects in a chain of blocks, and free the blocks.
+  static void release (Block * blocks);
+
+  /// Release the blocks of the traces in the code cache.
+  void release_traces (void);
+
+  /// Release the blocks of every trace, and the pending blocks.
+  void release_all (void);
+
+  /// Destroy an array of T.
+  template <typename T>
+  static void destroy (void * items, size_t count);
+
+  /// @{ Code Cache Callbacks
+  static VOID __trace_inserted (TRACE trace, VOID * v);
+  static VOID __trace_invalidated (ADDRINT orig_pc, ADDRINT cache_pc, BOOL success);
+  static VOID __cache_flushed (void);
+  /// @}
+
+  /// Fini callback.
+  static VOID __fini (INT32 code, VOID * v);
+
+  /// Minimum size of a block.
+  size_t block_size_;
+
+  /// Original address of the trace that owns the pending blocks.
+  ADDRINT pending_addr_;
+
+  /// Blocks allocated for the trace that is being instrumented.
+  Block * pending_;
+
+  /// Type definition of the blocks of the traces in the code cache.
+  typedef std::map <ADDRINT, Block *> map_type;
+
+  /// Blocks of the traces in the code cache, keyed by code cache address.
+  map_type traces_;
+
+  /// Next arena in the list of arenas.
+  Trace_Arena * next_;
+
+  /// The list of arenas. Pin does not pass a client argument to the trace
+  /// invalidated and cache flushed callbacks, so they visit every arena.
+  static Trace_Arena * arenas_;
+
+  /// The callbacks that visit every arena are registered.
+  static bool registered_;
+
+  // prevent the following operations
+  Trace_Arena (const Trace_Arena &);
+  const Trace_Arena & operator = (const Trace_Arena &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Trace_Arena.inl"
+
+#endif  // _OASIS_PIN_TRACE_ARENA_H_
@@ -0,0 +1,60 @@
+// -*- C++ -*-
+// $Id$
+
+#include <new>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename T>
+inline
+T * Trace_Arena::allocate (const Trace & trace, size_t count)
+{
+  Allocation * allocation =
+    this->allocate_i (trace.address (), sizeof (T) * count, Alignment_Of <T>::value);
+  allocation->destroy = &Trace_Arena::destroy <T>;
+
+  T * items = reinterpret_cast <T *> (allocation->items);
+
+  for (; allocation->count < count; ++ allocation->count)
+    new (&items[allocation->count]) T ();
+
+  return items;
+}
+
+template <typename T>
+inline
+T * Trace_Arena::allocate (const Trace & trace, size_t count, const T & value)
+{
+  Allocation * allocation =
+    this->allocate_i (trace.address (), sizeof (T) * count, Alignment_Of <T>::value);
+  allocation->destroy = &Trace_Arena::destroy <T>;
+
+  T * items = reinterpret_cast <T *> (allocation->items);
+
+  for (; allocation->count < count; ++ allocation->count)
+    new (&items[allocation->count]) T (value);
+
+  return items;
+}
+
+template <typename T>
+inline
+void Trace_Arena::destroy (void * items, size_t count)
+{
+  T * iter = reinterpret_cast <T *> (items);
+
+  for (T * end = iter + count; iter != end; ++ iter)
+    iter->~T ();
+}
+
+inline
+size_t Trace_Arena::trace_count (void) const
+{
+  return this->traces_.size ();
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -9,6 +9,11 @@ inline
 VOID * Trace_Buffer <T, ELEMENT_TYPE>::
 __handle_trace_buffer (BUFFER_ID id,  THREADID tid, const CONTEXT * ctx, VOID * buf, UINT64 elements, VOID * v)
 {
+  Trace_Buffer * tb = reinterpret_cast <Trace_Buffer *> (v);
+
+  if (tb->double_buffering_)
+    return tb->hand_off (tid, reinterpret_cast <element_type *> (buf), elements);
+
   // Strip the const from CONTEXT, and let the const Context handle the 
   const Context context (const_cast <CONTEXT *> (ctx));
   return reinterpret_cast <T *> (v)->handle_trace_buffer (id,
@@ -18,5 +23,144 @@ __handle_trace_buffer (BUFFER_ID id,  THREADID tid, const CONTEXT * ctx, VOID *
                                                           elements);
 }
 
+template <typename T, typename ELEMENT_TYPE>
+typename Trace_Buffer <T, ELEMENT_TYPE>::element_type *
+Trace_Buffer <T, ELEMENT_TYPE>::hand_off (THREADID thr_id, element_type * buf, UINT64 elements)
+{
+  bool queued = false;
+
+  do
+  {
+    Guard <Lock> guard (this->lock_);
+
+    if (!this->stopped_)
+    {
+      this->full_.push_back (Full_Buffer (thr_id, buf, elements));
+      queued = true;
+    }
+  } while (0);
+
+  if (!queued)
+  {
+    // There is no drain thread, so we must drain the buffer ourselves.
+    static_cast <T *> (this)->handle_drain (thr_id, buf, elements);
+    return buf;
+  }
+
+  this->full_ready_.set ();
+  return this->take_spare ();
+}
+
+template <typename T, typename ELEMENT_TYPE>
+typename Trace_Buffer <T, ELEMENT_TYPE>::element_type *
+Trace_Buffer <T, ELEMENT_TYPE>::take_spare (void)
+{
+  for (bool stalled = false; ; stalled = true)
+  {
+    // Clear the semaphore before checking for a spare buffer. Otherwise,
+    // we can miss the drain thread returning a buffer between the check
+    // and the wait.
+    this->spare_ready_.release ();
+
+    do
+    {
+      Guard <Lock> guard (this->lock_);
+
+      if (!this->spares_.empty ())
+      {
+        element_type * spare = this->spares_.back ();
+        this->spares_.pop_back ();
+
+        if (stalled)
+          ++ this->stalls_;
+
+        // Another application thread may have cleared the semaphore
+        // after the drain thread set it. Pass the signal along if there
+        // are buffers left.
+        if (!this->spares_.empty ())
+          this->spare_ready_.set ();
+
+        return spare;
+      }
+    } while (0);
+
+    this->spare_ready_.acquire ();
+  }
+}
+
+template <typename T, typename ELEMENT_TYPE>
+void Trace_Buffer <T, ELEMENT_TYPE>::drain_i (void)
+{
+  for (;;)
+  {
+    this->full_ready_.release ();
+
+    element_type * buf = 0;
+    THREADID thr_id = INVALID_THREADID;
+    UINT64 elements = 0;
+
+    do
+    {
+      Guard <Lock> guard (this->lock_);
+
+      if (this->full_.empty ())
+      {
+        // Only stop once there are no full buffers left to drain.
+        if (this->stopped_)
+          return;
+      }
+      else
+      {
+        const Full_Buffer & full = this->full_.front ();
+
+        thr_id = full.thr_id_;
+        buf = full.buf_;
+        elements = full.elements_;
+
+        this->full_.pop_front ();
+      }
+    } while (0);
+
+    if (0 == buf)
+    {
+      this->full_ready_.acquire ();
+      continue;
+    }
+
+    static_cast <T *> (this)->handle_drain (thr_id, buf, elements);
+
+    do
+    {
+      Guard <Lock> guard (this->lock_);
+      this->spares_.push_back (buf);
+    } while (0);
+
+    this->spare_ready_.set ();
+  }
+}
+
+template <typename T, typename ELEMENT_TYPE>
+void Trace_Buffer <T, ELEMENT_TYPE>::stop_draining (void)
+{
+  do
+  {
+    Guard <Lock> guard (this->lock_);
+
+    if (this->stopped_)
+      return;
+
+    this->stopped_ = true;
+  } while (0);
+
+  this->full_ready_.set ();
+  this->drain_->wait ();
+}
+
+template <typename T, typename ELEMENT_TYPE>
+void Trace_Buffer <T, ELEMENT_TYPE>::Drain::run (void)
+{
+  this->buffer_.drain_i ();
+}
+
 }
 }
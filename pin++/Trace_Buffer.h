@@ -12,6 +12,14 @@
 #define _OASIS_PINPP_TRACE_BUFFER_H_
 
 #include "Context.h"
+#include "Bbl.h"
+#include "Buffer_Record.h"
+#include "Guard.h"
+#include "Instrument_Profiler.h"
+#include "Thread.h"
+
+#include <deque>
+#include <vector>
 
 namespace OASIS
 {
@@ -23,6 +31,24 @@ namespace Pin
  *
  * Wrapper class for managing the state of trace buffers in Pin. The trace
  * buffer can be configured to support double buffering.
+ *
+ * Without double buffering, the subclass handles a full buffer in
+ * handle_trace_buffer () on the application thread, and the application
+ * thread does not continue until the handler returns. With double
+ * buffering, the full buffer is handed to a background drain thread and
+ * the application thread continues right away with a spare buffer. The
+ * subclass then handles the full buffer in handle_drain () on the drain
+ * thread. If the drain thread falls behind and there are no spare buffers
+ * left, the application thread waits for the drain thread to return one.
+ * Because there is one drain thread, handle_drain () is not called
+ * concurrently while the drain thread is running. The subclass must call
+ * stop_draining () before the tool exits, e.g., in handle_fini_unlocked ().
+ * Any buffer that fills after that point is drained on the application
+ * thread that filled it.
+ *
+ * If the ELEMENT_TYPE is a Buffer_Record, then the insert_fill () methods
+ * insert a fill of the buffer without writing the INS_InsertFillBuffer
+ * argument list by hand.
  */
 template <typename T, typename ELEMENT_TYPE>
 class Trace_Buffer
@@ -38,9 +64,11 @@ public:
    * Initializing constructor. Flag that enables/disables double
    * buffering. By default, double buffering is not enabled.
    *
+   * @param[in]       pages                 Number of pages in a buffer
    * @param[in]       double_buffering      Enable double buffering
+   * @param[in]       spares                Number of spare buffers
    */
-  Trace_Buffer (UINT32 pages, bool double_buffering = false);
+  Trace_Buffer (UINT32 pages, bool double_buffering = false, UINT32 spares = 2);
 
   /// Destructor.
   ~Trace_Buffer (void);
@@ -57,7 +85,170 @@ public:
   /// Number of pages in the trace buffer.
   UINT32 pages (void) const;
 
+  /// Test if double buffering is enabled.
+  bool double_buffering (void) const;
+
+  /**
+   * Stop the drain thread. The drain thread handles the buffers that are
+   * waiting to be drained before it exits. Afterwards, full buffers are
+   * drained on the application thread.
+   */
+  void stop_draining (void);
+
+  /// Number of times an application thread waited for a spare buffer.
+  UINT64 stalls (void) const;
+
+  /// @{ Fill Methods
+
+  /**
+   * Insert a fill of the buffer at \a location. If \a obj is a Bbl, then
+   * the fill is inserted at the first instruction of the Bbl. The record's
+   * extra values come after the object, as in Callback::insert ().
+   *
+   * @param[in]       location      Location to insert the fill
+   * @param[in]       obj           Object to instrument
+   */
+  template <typename S>
+  void insert_fill (IPOINT location, const S & obj) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1>
+  void insert_fill (IPOINT location, const S & obj, XARG1 xarg1) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2>
+  void insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3>
+  void insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
+  void insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
+  void insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
+  void insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5, XARG6 xarg6) const;
+  /// @}
+
+  /// @{ Predicated Fill Methods
+
+  /**
+   * Insert a predicated fill of the buffer at \a location. The fill
+   * only executes if the instruction's predicate is true.
+   */
+  template <typename S>
+  void insert_fill_predicated (IPOINT location, const S & obj) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1>
+  void insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2>
+  void insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3>
+  void insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
+  void insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
+  void insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5) const;
+
+  /**
+   * @overload
+   */
+  template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
+  void insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5, XARG6 xarg6) const;
+  /// @}
+
+protected:
+  /// @{ Callback Handler Methods
+  element_type * handle_trace_buffer (BUFFER_ID id, THREADID thr_id, const Context & ctx, element_type * buf, UINT64 elements);
+  void handle_drain (THREADID thr_id, element_type * buf, UINT64 elements);
+  /// @}
+
 private:
+  /**
+   * @struct Full_Buffer
+   *
+   * A full buffer waiting to be drained.
+   */
+  struct Full_Buffer
+  {
+    Full_Buffer (THREADID thr_id, element_type * buf, UINT64 elements);
+
+    THREADID thr_id_;
+    element_type * buf_;
+    UINT64 elements_;
+  };
+
+  /**
+   * @class Drain
+   *
+   * Background thread that drains the full buffers.
+   */
+  class Drain : public Thread
+  {
+  public:
+    Drain (Trace_Buffer & buffer);
+
+    virtual void run (void);
+
+  private:
+    Trace_Buffer & buffer_;
+  };
+
+  /// Hand off a full buffer, and get the buffer to use next.
+  element_type * hand_off (THREADID thr_id, element_type * buf, UINT64 elements);
+
+  /// Take a spare buffer, and wait for one if there are none.
+  element_type * take_spare (void);
+
+  /// Service loop for the drain thread.
+  void drain_i (void);
+
+  /// Insert the fill of the buffer at an instruction.
+  template <typename PACK>
+  void fill_i (VOID (* insert) (INS, IPOINT, BUFFER_ID, ...), INS ins, IPOINT location, const PACK & pack) const;
+
+  /// @{ Fill Targets
+  static INS fill_target (const Ins & ins);
+  static INS fill_target (const Bbl & bbl);
+  /// @}
+
   /// Callback for handling trace buffer notification
   static VOID * __handle_trace_buffer (BUFFER_ID id, THREADID tid, const CONTEXT *ctx, VOID *buf, UINT64 elements  , VOID *v);
 
@@ -73,8 +264,29 @@ private:
   /// Double buffering state.
   bool double_buffering_;
 
-  /// Pointer to the double buffer.
-  element_type * xbuf_;
+  /// Lock for the full and spare buffers.
+  Lock lock_;
+
+  /// Full buffers waiting to be drained.
+  std::deque <Full_Buffer> full_;
+
+  /// Spare buffers for the application threads.
+  std::vector <element_type *> spares_;
+
+  /// Signaled when there is a full buffer.
+  Semaphore full_ready_;
+
+  /// Signaled when there is a spare buffer.
+  Semaphore spare_ready_;
+
+  /// The drain thread is stopped.
+  bool stopped_;
+
+  /// Number of times an application thread waited for a spare.
+  UINT64 stalls_;
+
+  /// The drain thread.
+  Drain * drain_;
 };
 
 }
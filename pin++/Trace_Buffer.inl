@@ -7,25 +7,56 @@ namespace Pin
 
 template <typename T, typename ELEMENT_TYPE>
 inline
-Trace_Buffer <T, ELEMENT_TYPE>::Trace_Buffer (UINT32 pages, bool double_buffering)
+Trace_Buffer <T, ELEMENT_TYPE>::
+Trace_Buffer (UINT32 pages, bool double_buffering, UINT32 spares)
 : record_size_ (sizeof (ELEMENT_TYPE)),
   pages_ (pages),
   buf_id_ (BUFFER_ID_INVALID),
   double_buffering_ (double_buffering),
-  xbuf_ (0)
+  stopped_ (true),
+  stalls_ (0),
+  drain_ (0)
 {
   this->buf_id_ = PIN_DefineTraceBuffer (this->record_size_, this->pages_, &Trace_Buffer::__handle_trace_buffer, this);
 
-  if (double_buffering && this->buf_id_ != BUFFER_ID_INVALID)
-    this->xbuf_ = reinterpret_cast <element_type *> (PIN_AllocateBuffer (this->buf_id_));
+  if (!double_buffering || this->buf_id_ == BUFFER_ID_INVALID)
+    return;
+
+  for (UINT32 i = 0; i < spares; ++ i)
+  {
+    VOID * spare = PIN_AllocateBuffer (this->buf_id_);
+
+    if (0 != spare)
+      this->spares_.push_back (reinterpret_cast <element_type *> (spare));
+  }
+
+  // Start the drain thread. If we cannot start the thread, or there are no
+  // spare buffers, then the full buffers are drained on the application
+  // thread instead.
+  if (this->spares_.empty ())
+    return;
+
+  this->stopped_ = false;
+  this->drain_ = new Drain (*this);
+
+  if (this->drain_->start () == Thread::ERROR)
+    this->stopped_ = true;
 }
 
 template <typename T, typename ELEMENT_TYPE>
 inline
 Trace_Buffer <T, ELEMENT_TYPE>::~Trace_Buffer (void)
 {
-  if (0 != this->xbuf_)
-    PIN_DeallocateBuffer (this->buf_id_, this->xbuf_);
+  this->stop_draining ();
+
+  if (0 != this->drain_)
+    delete this->drain_;
+
+  typename std::vector <element_type *>::iterator
+    iter = this->spares_.begin (), iter_end = this->spares_.end ();
+
+  for (; iter != iter_end; ++ iter)
+    PIN_DeallocateBuffer (this->buf_id_, *iter);
 }
 
 template <typename T, typename ELEMENT_TYPE>
@@ -56,5 +87,190 @@ UINT32 Trace_Buffer <T, ELEMENT_TYPE>::pages (void) const
   return this->pages_;
 }
 
+template <typename T, typename ELEMENT_TYPE>
+template <typename S>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill (IPOINT location, const S & obj) const
+{
+  this->fill_i (&INS_InsertFillBuffer, fill_target (obj), location, Xarg_Pack <> ());
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill (IPOINT location, const S & obj, XARG1 xarg1) const
+{
+  this->fill_i (&INS_InsertFillBuffer, fill_target (obj), location, Xarg_Pack <XARG1> (xarg1));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2) const
+{
+  this->fill_i (&INS_InsertFillBuffer, fill_target (obj), location, Xarg_Pack <XARG1, XARG2> (xarg1, xarg2));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3) const
+{
+  this->fill_i (&INS_InsertFillBuffer, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3> (xarg1, xarg2, xarg3));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4) const
+{
+  this->fill_i (&INS_InsertFillBuffer, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3, XARG4> (xarg1, xarg2, xarg3, xarg4));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5) const
+{
+  this->fill_i (&INS_InsertFillBuffer, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3, XARG4, XARG5> (xarg1, xarg2, xarg3, xarg4, xarg5));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5, XARG6 xarg6) const
+{
+  this->fill_i (&INS_InsertFillBuffer, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3, XARG4, XARG5, XARG6> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill_predicated (IPOINT location, const S & obj) const
+{
+  this->fill_i (&INS_InsertFillBufferPredicated, fill_target (obj), location, Xarg_Pack <> ());
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1) const
+{
+  this->fill_i (&INS_InsertFillBufferPredicated, fill_target (obj), location, Xarg_Pack <XARG1> (xarg1));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2) const
+{
+  this->fill_i (&INS_InsertFillBufferPredicated, fill_target (obj), location, Xarg_Pack <XARG1, XARG2> (xarg1, xarg2));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3) const
+{
+  this->fill_i (&INS_InsertFillBufferPredicated, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3> (xarg1, xarg2, xarg3));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4) const
+{
+  this->fill_i (&INS_InsertFillBufferPredicated, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3, XARG4> (xarg1, xarg2, xarg3, xarg4));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5) const
+{
+  this->fill_i (&INS_InsertFillBufferPredicated, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3, XARG4, XARG5> (xarg1, xarg2, xarg3, xarg4, xarg5));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename S, typename XARG1, typename XARG2, typename XARG3, typename XARG4, typename XARG5, typename XARG6>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::insert_fill_predicated (IPOINT location, const S & obj, XARG1 xarg1, XARG2 xarg2, XARG3 xarg3, XARG4 xarg4, XARG5 xarg5, XARG6 xarg6) const
+{
+  this->fill_i (&INS_InsertFillBufferPredicated, fill_target (obj), location, Xarg_Pack <XARG1, XARG2, XARG3, XARG4, XARG5, XARG6> (xarg1, xarg2, xarg3, xarg4, xarg5, xarg6));
+}
+
+template <typename T, typename ELEMENT_TYPE>
+template <typename PACK>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::
+fill_i (VOID (* insert) (INS, IPOINT, BUFFER_ID, ...), INS ins, IPOINT location, const PACK & pack) const
+{
+  OASIS_PIN_PROFILE_INSERT ();
+  Fill_Buffer_T <ELEMENT_TYPE>::execute (insert, ins, location, this->buf_id_, pack);
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+bool Trace_Buffer <T, ELEMENT_TYPE>::double_buffering (void) const
+{
+  return this->double_buffering_;
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+UINT64 Trace_Buffer <T, ELEMENT_TYPE>::stalls (void) const
+{
+  return this->stalls_;
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+typename Trace_Buffer <T, ELEMENT_TYPE>::element_type *
+Trace_Buffer <T, ELEMENT_TYPE>::
+handle_trace_buffer (BUFFER_ID, THREADID, const Context &, element_type * buf, UINT64)
+{
+  return buf;
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+void Trace_Buffer <T, ELEMENT_TYPE>::handle_drain (THREADID, element_type *, UINT64)
+{
+
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+Trace_Buffer <T, ELEMENT_TYPE>::Full_Buffer::
+Full_Buffer (THREADID thr_id, element_type * buf, UINT64 elements)
+: thr_id_ (thr_id),
+  buf_ (buf),
+  elements_ (elements)
+{
+
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+Trace_Buffer <T, ELEMENT_TYPE>::Drain::Drain (Trace_Buffer & buffer)
+: buffer_ (buffer)
+{
+
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+INS Trace_Buffer <T, ELEMENT_TYPE>::fill_target (const Ins & ins)
+{
+  return ins;
+}
+
+template <typename T, typename ELEMENT_TYPE>
+inline
+INS Trace_Buffer <T, ELEMENT_TYPE>::fill_target (const Bbl & bbl)
+{
+  return BBL_InsHead (bbl);
+}
+
 }
 }
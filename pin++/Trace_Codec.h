@@ -0,0 +1,213 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Trace_Codec.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TRACE_CODEC_H_
+#define _OASIS_PIN_TRACE_CODEC_H_
+
+#include "Trace_File_Format.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Trace_Codec_Field
+ *
+ * Field of a record as seen by the encoder and decoder.
+ */
+struct Trace_Codec_Field
+{
+  /// Offset of the field in the record.
+  uint32_t offset_;
+
+  /// Size of the field in bytes.
+  uint32_t size_;
+};
+
+/**
+ * @class Trace_Codec
+ *
+ * Base class for the encoder and decoder of trace file blocks. A block
+ * holds the records of one write to the trace file. Each field of each
+ * record is stored as the zigzag varint of its difference from the same
+ * field of the previous record in the block. Program counters repeat and
+ * effective addresses stride, so most fields take one or two bytes.
+ * Fields that are not 1, 2, 4, or 8 bytes are copied as is. The delta
+ * state is reset at the start of each block so blocks can be decoded
+ * independently. If the header has no field layout, the record is coded
+ * as a sequence of 8-byte words.
+ *
+ * If OASIS_PIN_HAS_ZLIB is defined and the header has TRACE_FILE_ZLIB set,
+ * then the encoded block is also deflated. A block that does not shrink is
+ * stored without compression.
+ *
+ * The codec does not depend on Pin, and the records are coded in host byte
+ * order.
+ */
+class Trace_Codec
+{
+public:
+  /// Initializing constructor.
+  explicit Trace_Codec (const Trace_File_Header & header);
+
+  /// Size of a record.
+  uint32_t record_size (void) const;
+
+  /// Upper bound on the encoded size of \a count records.
+  size_t max_encoded_size (uint64_t count) const;
+
+protected:
+  /// Test if the field is coded as a varint.
+  static bool is_coded (const Trace_Codec_Field & field);
+
+  /// Load a field of \a size bytes.
+  static uint64_t load (const unsigned char * data, uint32_t size);
+
+  /// Store a field of \a size bytes.
+  static void store (unsigned char * data, uint32_t size, uint64_t value);
+
+  /// Sign extend a value of \a size bytes to 64 bits.
+  static uint64_t sign_extend (uint64_t value, uint32_t size);
+
+  /// Write a varint, and return the end of the varint.
+  static unsigned char * put_varint (unsigned char * out, uint64_t value);
+
+  /// Read a varint, and return the end of the varint or 0 if corrupt.
+  static const unsigned char * get_varint (const unsigned char * in,
+                                           const unsigned char * end,
+                                           uint64_t & value);
+
+  /// Layout of the record.
+  std::vector <Trace_Codec_Field> fields_;
+
+  /// Size of a record.
+  uint32_t record_size_;
+
+  /// Flags from the file header.
+  uint32_t flags_;
+};
+
+/**
+ * @class Trace_Encoder
+ *
+ * Encodes records into a block for a trace file.
+ */
+class Trace_Encoder : public Trace_Codec
+{
+public:
+  /// Initializing constructor.
+  explicit Trace_Encoder (const Trace_File_Header & header);
+
+  /**
+   * Encode records into a block. The block starts with a Trace_Block_Header
+   * and is followed by the payload.
+   *
+   * @param[in]       records       Pointer to the records
+   * @param[in]       count         Number of records
+   * @param[out]      block         The encoded block
+   */
+  void encode (const void * records, uint32_t count, std::vector <unsigned char> & block);
+
+private:
+  /// Encoded records before compression.
+  std::vector <unsigned char> encoded_;
+};
+
+/**
+ * @class Trace_Decoder
+ *
+ * Decodes the blocks of a trace file.
+ */
+class Trace_Decoder : public Trace_Codec
+{
+public:
+  /// Initializing constructor.
+  explicit Trace_Decoder (const Trace_File_Header & header);
+
+  /**
+   * Decode the payload of a block. \a records must have room for the
+   * record count of the block.
+   *
+   * @param[in]       block         Header of the block
+   * @param[in]       payload       Payload of the block
+   * @param[out]      records       The decoded records
+   * @retval          true          The block was decoded
+   * @retval          false         The block is corrupt
+   */
+  bool decode (const Trace_Block_Header & block, const unsigned char * payload, void * records);
+
+private:
+  /// Inflated payload of a compressed block.
+  std::vector <unsigned char> inflated_;
+};
+
+/**
+ * @class Trace_Stream_Decoder
+ *
+ * Streaming decoder that reads an encoded trace file one block at a time.
+ * Only one block of records is in memory at a time.
+ *
+ * @code
+ * Trace_Stream_Decoder decoder (file, header);
+ * uint32_t count;
+ *
+ * while (const unsigned char * records = decoder.next (count))
+ *   ...
+ * @endcode
+ */
+class Trace_Stream_Decoder
+{
+public:
+  /**
+   * Initializing constructor. The file must be positioned at the first
+   * block, i.e., just after the file header.
+   */
+  Trace_Stream_Decoder (FILE * file, const Trace_File_Header & header);
+
+  /**
+   * Decode the next block.
+   *
+   * @param[out]      count         Number of records in the block
+   * @return          The records, or 0 at the end of the file
+   */
+  const unsigned char * next (uint32_t & count);
+
+  /// Test if the stream ended because of a corrupt or truncated block.
+  bool failed (void) const;
+
+private:
+  /// The source file.
+  FILE * file_;
+
+  /// The block decoder.
+  Trace_Decoder decoder_;
+
+  /// Payload of the current block.
+  std::vector <unsigned char> payload_;
+
+  /// Records of the current block.
+  std::vector <unsigned char> records_;
+
+  /// The stream failed.
+  bool failed_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Trace_Codec.inl"
+
+#endif  // _OASIS_PIN_TRACE_CODEC_H_
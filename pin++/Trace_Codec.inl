@@ -0,0 +1,343 @@
+// -*- C++ -*-
+// $Id$
+
+#include <cstring>
+
+#if defined (OASIS_PIN_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Codec
+
+inline
+Trace_Codec::Trace_Codec (const Trace_File_Header & header)
+: record_size_ (header.record_size_),
+  flags_ (header.flags_)
+{
+#if !defined (OASIS_PIN_HAS_ZLIB)
+  this->flags_ &= ~TRACE_FILE_ZLIB;
+#endif
+
+  Trace_Codec_Field field;
+
+  if (0 != header.field_count_)
+  {
+    for (uint32_t i = 0; i < header.field_count_; ++ i)
+    {
+      field.offset_ = header.fields_[i].offset_;
+      field.size_ = header.fields_[i].size_;
+
+      this->fields_.push_back (field);
+    }
+  }
+  else
+  {
+    // Code an opaque record as 8-byte words, and copy the tail as is.
+    for (field.offset_ = 0; field.offset_ < this->record_size_; field.offset_ += 8)
+    {
+      field.size_ = this->record_size_ - field.offset_ < 8 ? this->record_size_ - field.offset_ : 8;
+      this->fields_.push_back (field);
+    }
+  }
+}
+
+inline
+uint32_t Trace_Codec::record_size (void) const
+{
+  return this->record_size_;
+}
+
+inline
+size_t Trace_Codec::max_encoded_size (uint64_t count) const
+{
+  // A varint of a 64-bit value takes at most 10 bytes.
+  size_t size = 0;
+
+  for (size_t i = 0; i < this->fields_.size (); ++ i)
+    size += Trace_Codec::is_coded (this->fields_[i]) ? 10 : this->fields_[i].size_;
+
+  return static_cast <size_t> (count) * size;
+}
+
+inline
+bool Trace_Codec::is_coded (const Trace_Codec_Field & field)
+{
+  return 1 == field.size_ || 2 == field.size_ || 4 == field.size_ || 8 == field.size_;
+}
+
+inline
+uint64_t Trace_Codec::load (const unsigned char * data, uint32_t size)
+{
+  uint64_t value = 0;
+  ::memcpy (&value, data, size);
+
+  return value;
+}
+
+inline
+void Trace_Codec::store (unsigned char * data, uint32_t size, uint64_t value)
+{
+  ::memcpy (data, &value, size);
+}
+
+inline
+uint64_t Trace_Codec::sign_extend (uint64_t value, uint32_t size)
+{
+  if (8 == size)
+    return value;
+
+  const uint32_t bits = size * 8;
+  const uint64_t mask = (static_cast <uint64_t> (1) << bits) - 1;
+
+  value &= mask;
+
+  if (0 != (value >> (bits - 1)))
+    value |= ~mask;
+
+  return value;
+}
+
+inline
+unsigned char * Trace_Codec::put_varint (unsigned char * out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    *out ++ = static_cast <unsigned char> (value | 0x80);
+    value >>= 7;
+  }
+
+  *out ++ = static_cast <unsigned char> (value);
+  return out;
+}
+
+inline
+const unsigned char *
+Trace_Codec::get_varint (const unsigned char * in, const unsigned char * end, uint64_t & value)
+{
+  value = 0;
+
+  for (uint32_t shift = 0; in != end && shift < 64; shift += 7)
+  {
+    unsigned char byte = *in ++;
+    value |= static_cast <uint64_t> (byte & 0x7F) << shift;
+
+    if (0 == (byte & 0x80))
+      return in;
+  }
+
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Encoder
+
+inline
+Trace_Encoder::Trace_Encoder (const Trace_File_Header & header)
+: Trace_Codec (header)
+{
+
+}
+
+inline
+void Trace_Encoder::
+encode (const void * records, uint32_t count, std::vector <unsigned char> & block)
+{
+  const size_t field_count = this->fields_.size ();
+  std::vector <uint64_t> prev (field_count, 0);
+
+  this->encoded_.resize (this->max_encoded_size (count));
+
+  const unsigned char * record = reinterpret_cast <const unsigned char *> (records);
+  unsigned char * out = this->encoded_.empty () ? 0 : &this->encoded_[0];
+  unsigned char * const begin = out;
+
+  for (uint32_t i = 0; i < count; ++ i, record += this->record_size_)
+  {
+    for (size_t j = 0; j < field_count; ++ j)
+    {
+      const Trace_Codec_Field & field = this->fields_[j];
+
+      if (!Trace_Codec::is_coded (field))
+      {
+        ::memcpy (out, record + field.offset_, field.size_);
+        out += field.size_;
+        continue;
+      }
+
+      // Zigzag the delta so small negative strides stay small.
+      uint64_t value = Trace_Codec::load (record + field.offset_, field.size_);
+      uint64_t delta = Trace_Codec::sign_extend (value - prev[j], field.size_);
+
+      out = Trace_Codec::put_varint (out, (delta << 1) ^ static_cast <uint64_t> (static_cast <int64_t> (delta) >> 63));
+      prev[j] = value;
+    }
+  }
+
+  Trace_Block_Header header;
+  header.encoded_size_ = static_cast <uint32_t> (out - begin);
+  header.size_ = header.encoded_size_;
+  header.record_count_ = count;
+  header.flags_ = 0;
+
+  const unsigned char * payload = begin;
+
+#if defined (OASIS_PIN_HAS_ZLIB)
+  std::vector <unsigned char> deflated;
+
+  if (0 != (this->flags_ & TRACE_FILE_ZLIB) && 0 != header.encoded_size_)
+  {
+    uLongf size = ::compressBound (header.encoded_size_);
+    deflated.resize (size);
+
+    if (Z_OK == ::compress2 (&deflated[0], &size, begin, header.encoded_size_, Z_BEST_SPEED) &&
+        size < header.encoded_size_)
+    {
+      header.size_ = static_cast <uint32_t> (size);
+      header.flags_ = TRACE_FILE_ZLIB;
+      payload = &deflated[0];
+    }
+  }
+#endif
+
+  block.resize (sizeof (Trace_Block_Header) + header.size_);
+  ::memcpy (&block[0], &header, sizeof (Trace_Block_Header));
+
+  if (0 != header.size_)
+    ::memcpy (&block[sizeof (Trace_Block_Header)], payload, header.size_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Decoder
+
+inline
+Trace_Decoder::Trace_Decoder (const Trace_File_Header & header)
+: Trace_Codec (header)
+{
+
+}
+
+inline
+bool Trace_Decoder::
+decode (const Trace_Block_Header & block, const unsigned char * payload, void * records)
+{
+  const unsigned char * in = payload;
+  const unsigned char * end = payload + block.size_;
+
+  if (0 != (block.flags_ & TRACE_FILE_ZLIB))
+  {
+#if defined (OASIS_PIN_HAS_ZLIB)
+    this->inflated_.resize (block.encoded_size_);
+    uLongf size = block.encoded_size_;
+
+    if (0 != size &&
+        (Z_OK != ::uncompress (&this->inflated_[0], &size, payload, block.size_) ||
+         size != block.encoded_size_))
+      return false;
+
+    in = this->inflated_.empty () ? 0 : &this->inflated_[0];
+    end = in + block.encoded_size_;
+#else
+    return false;
+#endif
+  }
+
+  const size_t field_count = this->fields_.size ();
+  std::vector <uint64_t> prev (field_count, 0);
+
+  unsigned char * record = reinterpret_cast <unsigned char *> (records);
+  ::memset (record, 0, static_cast <size_t> (block.record_count_) * this->record_size_);
+
+  for (uint32_t i = 0; i < block.record_count_; ++ i, record += this->record_size_)
+  {
+    for (size_t j = 0; j < field_count; ++ j)
+    {
+      const Trace_Codec_Field & field = this->fields_[j];
+
+      if (!Trace_Codec::is_coded (field))
+      {
+        if (static_cast <size_t> (end - in) < field.size_)
+          return false;
+
+        ::memcpy (record + field.offset_, in, field.size_);
+        in += field.size_;
+        continue;
+      }
+
+      uint64_t zigzag;
+      in = Trace_Codec::get_varint (in, end, zigzag);
+
+      if (0 == in)
+        return false;
+
+      uint64_t delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+      prev[j] += delta;
+
+      Trace_Codec::store (record + field.offset_, field.size_, prev[j]);
+    }
+  }
+
+  return in == end;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Stream_Decoder
+
+inline
+Trace_Stream_Decoder::Trace_Stream_Decoder (FILE * file, const Trace_File_Header & header)
+: file_ (file),
+  decoder_ (header),
+  failed_ (false)
+{
+
+}
+
+inline
+const unsigned char * Trace_Stream_Decoder::next (uint32_t & count)
+{
+  count = 0;
+
+  if (this->failed_)
+    return 0;
+
+  Trace_Block_Header block;
+  size_t n = ::fread (&block, 1, sizeof (Trace_Block_Header), this->file_);
+
+  if (0 == n)
+    return 0;
+
+  // A partial block header means the file is truncated. The header is not
+  // complete, so its sizes cannot be trusted.
+  if (n != sizeof (Trace_Block_Header))
+  {
+    this->failed_ = true;
+    return 0;
+  }
+
+  this->payload_.resize (block.size_);
+  this->records_.resize (static_cast <size_t> (block.record_count_) * this->decoder_.record_size ());
+
+  if ((0 != block.size_ && 1 != ::fread (&this->payload_[0], block.size_, 1, this->file_)) ||
+      (0 != block.record_count_ && !this->decoder_.decode (block, this->payload_.empty () ? 0 : &this->payload_[0], &this->records_[0])))
+  {
+    this->failed_ = true;
+    return 0;
+  }
+
+  count = block.record_count_;
+  return this->records_.empty () ? reinterpret_cast <const unsigned char *> ("") : &this->records_[0];
+}
+
+inline
+bool Trace_Stream_Decoder::failed (void) const
+{
+  return this->failed_;
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,89 @@
+// $Id$
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include <sys/stat.h>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename ANALYSIS>
+bool Trace_Driver <ANALYSIS>::
+run (const std::vector <std::string> & files, analysis_type & analysis)
+{
+  this->failed_.clear ();
+  this->next_ = 0;
+
+  // Hand out the largest files first so the last files to finish are
+  // small ones.
+  std::vector <std::pair <uint64_t, std::string> > sized;
+
+  for (size_t i = 0; i < files.size (); ++ i)
+  {
+    struct stat st;
+    uint64_t size = 0 == ::stat (files[i].c_str (), &st) ? st.st_size : 0;
+
+    sized.push_back (std::make_pair (size, files[i]));
+  }
+
+  std::stable_sort (sized.begin (), sized.end (), Trace_Driver::larger);
+
+  std::vector <std::string> ordered;
+
+  for (size_t i = 0; i < sized.size (); ++ i)
+    ordered.push_back (sized[i].second);
+
+  // Each worker runs its own copy of the analysis.
+  size_t count = std::min (this->workers_, ordered.size ());
+  std::vector <analysis_type> partial (count, analysis);
+  std::vector <std::thread> threads;
+
+  for (size_t i = 0; i < count; ++ i)
+    threads.push_back (std::thread (&Trace_Driver::work, this, std::cref (ordered), std::ref (partial[i])));
+
+  for (size_t i = 0; i < count; ++ i)
+    threads[i].join ();
+
+  for (size_t i = 0; i < count; ++ i)
+    analysis.merge (partial[i]);
+
+  std::sort (this->failed_.begin (), this->failed_.end ());
+  return this->failed_.empty ();
+}
+
+template <typename ANALYSIS>
+bool Trace_Driver <ANALYSIS>::
+larger (const std::pair <uint64_t, std::string> & lhs,
+        const std::pair <uint64_t, std::string> & rhs)
+{
+  return lhs.first > rhs.first;
+}
+
+template <typename ANALYSIS>
+void Trace_Driver <ANALYSIS>::
+work (const std::vector <std::string> & files, analysis_type & analysis)
+{
+  for (size_t i = this->next_ ++; i < files.size (); i = this->next_ ++)
+  {
+    Trace_Reader reader;
+    bool opened = reader.open (files[i].c_str ());
+
+    // The records before a corrupt block are still analyzed, but the file
+    // is reported so the results are not mistaken for the whole trace.
+    if (opened)
+      analysis.handle_file (reader);
+
+    if (!opened || reader.failed ())
+    {
+      std::lock_guard <std::mutex> guard (this->lock_);
+      this->failed_.push_back (files[i]);
+    }
+  }
+}
+
+} // namespace OASIS
+} // namespace Pin
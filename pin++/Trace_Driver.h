@@ -0,0 +1,148 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Trace_Driver.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TRACE_DRIVER_H_
+#define _OASIS_PIN_TRACE_DRIVER_H_
+
+#include "Trace_Reader.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Trace_Analysis
+ *
+ * Base class for an offline analysis pass run by a Trace_Driver. The
+ * subclass hides the methods it needs:
+ *
+ *   - handle_file (reader)   visits one trace file; by default, it calls
+ *                            handle_record () for each record.
+ *   - handle_record (rec)    visits one record.
+ *   - merge (other)          folds the results of another worker into
+ *                            this analysis.
+ *
+ * @code
+ * class PC_Count : public Trace_Analysis <PC_Count>
+ * {
+ * public:
+ *   void handle_record (const Trace_Record & record)
+ *   {
+ *     ++ this->counts_[record.field (0)];
+ *   }
+ *
+ *   void merge (const PC_Count & other) { ... }
+ * };
+ * @endcode
+ */
+template <typename T>
+class Trace_Analysis
+{
+public:
+  /// Visit a trace file.
+  void handle_file (const Trace_Reader & reader);
+
+  /// Visit a record.
+  void handle_record (const Trace_Record & record);
+
+  /// Merge the results of another worker.
+  void merge (const T & other);
+};
+
+/**
+ * @class Trace_Driver
+ *
+ * Runs a Trace_Analysis over many trace files in parallel. The files are
+ * handed out to a pool of worker threads one at a time, largest first, so
+ * a few large per-thread files do not leave the other workers idle. Each
+ * worker runs its own copy of the analysis without locking. When all the
+ * files are done, the copies are merged into the analysis passed to run ()
+ * in the order of the workers.
+ *
+ * The analysis must be copy constructible, and each copy starts from the
+ * analysis passed to run (). It should therefore hold the options of the
+ * pass, but no results yet. Merging must not depend on which worker read
+ * which file, e.g., counts and histograms.
+ *
+ * The driver does not depend on Pin, and requires C++11 threads.
+ */
+template <typename ANALYSIS>
+class Trace_Driver
+{
+public:
+  /// Type definition of the analysis.
+  typedef ANALYSIS analysis_type;
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       workers         Number of workers, or 0 for one per core
+   */
+  explicit Trace_Driver (size_t workers = 0);
+
+  /// Number of workers.
+  size_t workers (void) const;
+
+  /**
+   * Run the analysis over the files.
+   *
+   * @param[in]       files           Names of the trace files
+   * @param[inout]    analysis        The analysis, and its merged results
+   * @retval          true            Every file was read
+   * @retval          false           At least one file could not be opened,
+   *                                  or has a corrupt block
+   */
+  bool run (const std::vector <std::string> & files, analysis_type & analysis);
+
+  /// Files that could not be opened, or were corrupt, in the last run.
+  const std::vector <std::string> & failed (void) const;
+
+private:
+  /// Order files from largest to smallest.
+  static bool larger (const std::pair <uint64_t, std::string> & lhs,
+                      const std::pair <uint64_t, std::string> & rhs);
+
+  /// Main loop of a worker.
+  void work (const std::vector <std::string> & files, analysis_type & analysis);
+
+  /// Number of workers.
+  size_t workers_;
+
+  /// Index of the next file to hand out.
+  std::atomic <size_t> next_;
+
+  /// Lock for failed_.
+  std::mutex lock_;
+
+  /// Files that could not be opened, or were corrupt.
+  std::vector <std::string> failed_;
+
+  // prevent the following operations
+  Trace_Driver (const Trace_Driver &);
+  const Trace_Driver & operator = (const Trace_Driver &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Trace_Driver.inl"
+#include "Trace_Driver.cpp"
+
+#endif  // _OASIS_PIN_TRACE_DRIVER_H_
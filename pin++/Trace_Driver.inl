@@ -0,0 +1,67 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Analysis
+
+template <typename T>
+inline
+void Trace_Analysis <T>::handle_file (const Trace_Reader & reader)
+{
+  T * self = static_cast <T *> (this);
+
+  for (Trace_Reader::iterator iter = reader.begin (), end = reader.end (); iter != end; ++ iter)
+    self->handle_record (*iter);
+}
+
+template <typename T>
+inline
+void Trace_Analysis <T>::handle_record (const Trace_Record &)
+{
+
+}
+
+template <typename T>
+inline
+void Trace_Analysis <T>::merge (const T &)
+{
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Driver
+
+template <typename ANALYSIS>
+inline
+Trace_Driver <ANALYSIS>::Trace_Driver (size_t workers)
+: workers_ (workers),
+  next_ (0)
+{
+  if (0 == this->workers_)
+    this->workers_ = std::thread::hardware_concurrency ();
+
+  if (0 == this->workers_)
+    this->workers_ = 1;
+}
+
+template <typename ANALYSIS>
+inline
+size_t Trace_Driver <ANALYSIS>::workers (void) const
+{
+  return this->workers_;
+}
+
+template <typename ANALYSIS>
+inline
+const std::vector <std::string> & Trace_Driver <ANALYSIS>::failed (void) const
+{
+  return this->failed_;
+}
+
+} // namespace OASIS
+} // namespace Pin
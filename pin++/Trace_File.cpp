@@ -0,0 +1,158 @@
+// $Id$
+
+#include "Trace_File.h"
+
+#if !defined (TARGET_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+bool Trace_File::open (const char * filename,
+                       const Trace_File_Header & header,
+                       size_t chunk_size)
+{
+  if (this->is_open () || 0 == chunk_size)
+    return false;
+
+#if defined (TARGET_WINDOWS)
+  return false;
+#else
+  this->fd_ = ::open (filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+  if (-1 == this->fd_)
+    return false;
+
+  this->chunk_size_ = chunk_size;
+  this->header_ = header;
+  this->header_.header_size_ = sizeof (Trace_File_Header);
+  this->header_.record_count_ = 0;
+
+#if !defined (OASIS_PIN_HAS_ZLIB)
+  this->header_.flags_ &= ~TRACE_FILE_ZLIB;
+#endif
+
+  if (!this->grow (sizeof (Trace_File_Header)))
+  {
+    ::close (this->fd_);
+    this->fd_ = -1;
+
+    return false;
+  }
+
+  ::memcpy (this->map_, &this->header_, sizeof (Trace_File_Header));
+  this->used_ = sizeof (Trace_File_Header);
+
+  if (this->header_.is_encoded ())
+    this->encoder_ = new Trace_Encoder (this->header_);
+
+  return true;
+#endif
+}
+
+bool Trace_File::write (const void * records, UINT64 count)
+{
+  if (!this->is_open ())
+    return false;
+
+  if (0 == count)
+    return true;
+
+  if (0 != this->encoder_)
+  {
+    // Store the records as one encoded block.
+    this->encoder_->encode (records, static_cast <uint32_t> (count), this->block_);
+
+    if (!this->append (&this->block_[0], this->block_.size ()))
+      return false;
+  }
+  else if (!this->append (records, static_cast <size_t> (count) * this->header_.record_size_))
+  {
+    return false;
+  }
+
+  // Publish the new count so readers know the records are valid even if
+  // the file is never closed.
+  this->header_.record_count_ += count;
+  reinterpret_cast <Trace_File_Header *> (this->map_)->record_count_ = this->header_.record_count_;
+
+  return true;
+}
+
+void Trace_File::close (void)
+{
+  if (-1 == this->fd_)
+    return;
+
+#if !defined (TARGET_WINDOWS)
+  if (0 != this->map_)
+    ::munmap (this->map_, this->capacity_);
+
+  // Remove the unused part of the last chunk. If this fails, the file
+  // keeps its padding, but the record count in the header is still valid.
+  int retval = ::ftruncate (this->fd_, this->used_);
+  (void) retval;
+
+  ::close (this->fd_);
+#endif
+
+  delete this->encoder_;
+  this->encoder_ = 0;
+
+  std::vector <unsigned char> ().swap (this->block_);
+
+  this->map_ = 0;
+  this->fd_ = -1;
+  this->capacity_ = 0;
+  this->used_ = 0;
+}
+
+bool Trace_File::append (const void * data, size_t size)
+{
+  if (this->used_ + size > this->capacity_ && !this->grow (this->used_ + size))
+    return false;
+
+  ::memcpy (this->map_ + this->used_, data, size);
+  this->used_ += size;
+
+  return true;
+}
+
+bool Trace_File::grow (size_t size)
+{
+#if defined (TARGET_WINDOWS)
+  return false;
+#else
+  // Round the new capacity up to the next chunk.
+  size_t capacity = ((size + this->chunk_size_ - 1) / this->chunk_size_) * this->chunk_size_;
+
+  if (0 != ::ftruncate (this->fd_, capacity))
+    return false;
+
+  if (0 != this->map_)
+    ::munmap (this->map_, this->capacity_);
+
+  void * map = ::mmap (0, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd_, 0);
+
+  if (MAP_FAILED == map)
+  {
+    this->map_ = 0;
+    this->capacity_ = 0;
+
+    return false;
+  }
+
+  this->map_ = reinterpret_cast <char *> (map);
+  this->capacity_ = capacity;
+
+  return true;
+#endif
+}
+
+} // namespace OASIS
+} // namespace Pin
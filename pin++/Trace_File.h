@@ -0,0 +1,139 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Trace_File.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TRACE_FILE_H_
+#define _OASIS_PIN_TRACE_FILE_H_
+
+#include "pin.H"
+#include "Pin_export.h"
+#include "Trace_Codec.h"
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Trace_File
+ *
+ * Binary trace file that is written through a memory mapping. The file
+ * starts with a Trace_File_Header, and is followed by the raw records. The
+ * mapping grows in large chunks so that writing a buffer of records costs
+ * a single memcpy, and the records are never formatted in the instrumented
+ * process. When the file is closed, it is truncated to the records that
+ * were written.
+ *
+ * The record count in the header is updated on every write. If the tool
+ * does not close the file, e.g., the process is killed, the header still
+ * tells readers how many records in the file are valid.
+ *
+ * If the header has TRACE_FILE_ENCODED set, then each write is stored as
+ * one block of delta/varint encoded records (see Trace_Codec) instead of
+ * the raw records. The flag TRACE_FILE_ZLIB is cleared if the library was
+ * built without zlib.
+ *
+ * A Trace_File is not thread-safe. It is meant to be written by one thread,
+ * e.g., the thread that owns the trace buffer or the drain thread of a
+ * double buffered Trace_Buffer. Memory mapped files are only supported on
+ * POSIX systems. On other systems, open () always fails.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class OASIS_PIN_Export Trace_File
+{
+public:
+  /// Default size of a chunk when growing the file (64 MB).
+  static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024 * 1024;
+
+  /// Default constructor.
+  Trace_File (void);
+
+  /// Destructor.
+  ~Trace_File (void);
+
+  /**
+   * Open the trace file. If the file exists, it is truncated.
+   *
+   * @param[in]       filename        Name of the file
+   * @param[in]       header          Header for the file
+   * @param[in]       chunk_size      Size to grow the file by
+   * @retval          true            The file is open
+   * @retval          false           The file could not be opened
+   */
+  bool open (const char * filename,
+             const Trace_File_Header & header,
+             size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  /// Test if the file is open.
+  bool is_open (void) const;
+
+  /**
+   * Write records to the end of the file.
+   *
+   * @param[in]       records         Pointer to the records
+   * @param[in]       count           Number of records
+   * @retval          true            The records were written
+   * @retval          false           The file could not grow
+   */
+  bool write (const void * records, UINT64 count);
+
+  /// Close the file, and truncate it to the records written.
+  void close (void);
+
+  /// Number of records written to the file.
+  UINT64 record_count (void) const;
+
+  /// The header of the file.
+  const Trace_File_Header & header (void) const;
+
+private:
+  /// Grow the mapping so it can hold at least \a size bytes.
+  bool grow (size_t size);
+
+  /// Append bytes to the end of the file.
+  bool append (const void * data, size_t size);
+
+  /// The file descriptor.
+  int fd_;
+
+  /// Start of the mapping.
+  char * map_;
+
+  /// Size of the mapping.
+  size_t capacity_;
+
+  /// Number of bytes written, including the header.
+  size_t used_;
+
+  /// Size to grow the file by.
+  size_t chunk_size_;
+
+  /// Copy of the header. The header in the mapping is updated from it.
+  Trace_File_Header header_;
+
+  /// Encoder for the records, or 0 if the records are stored raw.
+  Trace_Encoder * encoder_;
+
+  /// Scratch space for an encoded block.
+  std::vector <unsigned char> block_;
+
+  // prevent the following operations
+  Trace_File (const Trace_File &);
+  const Trace_File & operator = (const Trace_File &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Trace_File.inl"
+
+#endif  // _OASIS_PIN_TRACE_FILE_H_
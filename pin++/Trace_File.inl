@@ -0,0 +1,46 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+inline
+Trace_File::Trace_File (void)
+: fd_ (-1),
+  map_ (0),
+  capacity_ (0),
+  used_ (0),
+  chunk_size_ (DEFAULT_CHUNK_SIZE),
+  encoder_ (0)
+{
+  this->header_.init (1, 0);
+}
+
+inline
+Trace_File::~Trace_File (void)
+{
+  this->close ();
+}
+
+inline
+bool Trace_File::is_open (void) const
+{
+  return 0 != this->map_;
+}
+
+inline
+UINT64 Trace_File::record_count (void) const
+{
+  return this->header_.record_count_;
+}
+
+inline
+const Trace_File_Header & Trace_File::header (void) const
+{
+  return this->header_;
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,181 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Trace_File_Format.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TRACE_FILE_FORMAT_H_
+#define _OASIS_PIN_TRACE_FILE_FORMAT_H_
+
+#include <stdint.h>
+#include <string.h>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/// Magic string at the start of every trace file.
+#define OASIS_PIN_TRACE_FILE_MAGIC "PINPPTRC"
+
+/// Current version of the trace file format.
+static const uint32_t TRACE_FILE_VERSION = 1;
+
+/// Maximum number of fields described in the header.
+static const uint32_t TRACE_FILE_MAX_FIELDS = 8;
+
+/**
+ * @enum Trace_File_Flags
+ *
+ * Flags that describe the encoding of the records in a trace file.
+ */
+enum Trace_File_Flags
+{
+  /// The records are stored in blocks of delta/varint encoded records.
+  TRACE_FILE_ENCODED = 0x01,
+
+  /// The encoded blocks are compressed with zlib.
+  TRACE_FILE_ZLIB    = 0x02
+};
+
+/**
+ * @struct Trace_File_Field
+ *
+ * Description of one field in a trace file record.
+ */
+struct Trace_File_Field
+{
+  /// Offset of the field in the record.
+  uint32_t offset_;
+
+  /// Size of the field in bytes.
+  uint32_t size_;
+
+  /// The IARG_TYPE that filled the field, or 0 if not known.
+  uint32_t arg_type_;
+
+  /// Reserved for future use.
+  uint32_t reserved_;
+};
+
+/**
+ * @struct Trace_File_Header
+ *
+ * Header at the start of a trace file. The header is followed by the raw
+ * records, exactly as they appeared in the trace buffer. The header does
+ * not depend on Pin so offline tools can read the trace files without the
+ * Pin kit.
+ *
+ * The fields describe the layout of a record if it is known (e.g., the
+ * record is a Buffer_Record). Otherwise, field_count_ is 0 and the record
+ * is an opaque block of record_size_ bytes.
+ */
+struct Trace_File_Header
+{
+  /// Initialize the header for records of the specified size.
+  void init (uint32_t record_size, uint32_t thread_id)
+  {
+    ::memset (this, 0, sizeof (Trace_File_Header));
+    ::memcpy (this->magic_, OASIS_PIN_TRACE_FILE_MAGIC, sizeof (this->magic_));
+
+    this->version_ = TRACE_FILE_VERSION;
+    this->header_size_ = sizeof (Trace_File_Header);
+    this->record_size_ = record_size;
+    this->thread_id_ = thread_id;
+  }
+
+  /// Test if the header is a valid trace file header. The fields must
+  /// lie within the record, so readers can trust their offsets.
+  bool is_valid (void) const
+  {
+    return 0 == ::memcmp (this->magic_, OASIS_PIN_TRACE_FILE_MAGIC, sizeof (this->magic_)) &&
+           this->version_ == TRACE_FILE_VERSION &&
+           this->header_size_ >= sizeof (Trace_File_Header) &&
+           this->record_size_ != 0 &&
+           this->field_count_ <= TRACE_FILE_MAX_FIELDS &&
+           this->has_valid_fields ();
+  }
+
+  /// Test if each field lies within the record.
+  bool has_valid_fields (void) const
+  {
+    for (uint32_t i = 0; i < this->field_count_ && i < TRACE_FILE_MAX_FIELDS; ++ i)
+    {
+      const Trace_File_Field & field = this->fields_[i];
+
+      if (0 == field.size_ ||
+          field.offset_ > this->record_size_ ||
+          field.size_ > this->record_size_ - field.offset_)
+        return false;
+    }
+
+    return true;
+  }
+
+  /// Test if the records are stored in encoded blocks.
+  bool is_encoded (void) const
+  {
+    return 0 != (this->flags_ & TRACE_FILE_ENCODED);
+  }
+
+  /// Magic string.
+  char magic_[8];
+
+  /// Version of the format.
+  uint32_t version_;
+
+  /// Size of the header. The records start at this offset.
+  uint32_t header_size_;
+
+  /// Size of one record.
+  uint32_t record_size_;
+
+  /// Number of fields described in the header.
+  uint32_t field_count_;
+
+  /// Pin thread id that wrote the records.
+  uint32_t thread_id_;
+
+  /// Flags that describe the encoding of the records.
+  uint32_t flags_;
+
+  /// Number of records in the file.
+  uint64_t record_count_;
+
+  /// Layout of the record.
+  Trace_File_Field fields_[TRACE_FILE_MAX_FIELDS];
+};
+
+/**
+ * @struct Trace_Block_Header
+ *
+ * Header of an encoded block of records. The header is followed by size_
+ * bytes of payload. If the block is compressed, the payload inflates to
+ * encoded_size_ bytes of delta/varint encoded records. Otherwise, size_
+ * and encoded_size_ are the same.
+ */
+struct Trace_Block_Header
+{
+  /// Size of the payload in the file.
+  uint32_t size_;
+
+  /// Size of the encoded records.
+  uint32_t encoded_size_;
+
+  /// Number of records in the block.
+  uint32_t record_count_;
+
+  /// Flags for the block (TRACE_FILE_ZLIB if compressed).
+  uint32_t flags_;
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#endif  // !defined _OASIS_PIN_TRACE_FILE_FORMAT_H_
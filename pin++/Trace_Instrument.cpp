@@ -11,6 +11,7 @@ namespace Pin
 template <typename T>
 void Trace_Instrument <T>::__instrument (TRACE trace, void * v)
 {
+  OASIS_PIN_PROFILE_HOOK (HOOK_TRACE, TRACE_NumIns (trace));
   reinterpret_cast <T *> (v)->handle_instrument (Trace (trace));
 }
 
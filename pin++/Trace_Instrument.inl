@@ -14,6 +14,7 @@ inline
 Trace_Instrument <T>::Trace_Instrument (void)
 {
   TRACE_AddInstrumentFunction (&Trace_Instrument::__instrument, this);
+  OASIS_PIN_PROFILE_INIT ();
 }
 
 //
@@ -0,0 +1,251 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Trace_Reader.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TRACE_READER_H_
+#define _OASIS_PIN_TRACE_READER_H_
+
+#include "Trace_Codec.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @class Trace_Record
+ *
+ * View of one record in a trace file. The view is only valid until the
+ * iterator that produced it moves.
+ */
+class Trace_Record
+{
+public:
+  /// Default constructor.
+  Trace_Record (void);
+
+  /// Initializing constructor.
+  Trace_Record (const unsigned char * data, const Trace_File_Header * header);
+
+  /// Raw bytes of the record.
+  const unsigned char * data (void) const;
+
+  /**
+   * Get the value of a field described in the header. Fields of 1, 2, 4,
+   * or 8 bytes are zero extended. Other fields return their first 8 bytes.
+   * If \a i is not a field in the header, then 0 is returned.
+   */
+  uint64_t field (uint32_t i) const;
+
+  /// Get the record as a structure that matches its layout.
+  template <typename T>
+  const T & as (void) const;
+
+private:
+  /// Start of the record.
+  const unsigned char * data_;
+
+  /// Header of the file that contains the record.
+  const Trace_File_Header * header_;
+};
+
+class Trace_Reader;
+
+/**
+ * @class Trace_Record_Iterator
+ *
+ * Forward iterator over the records of a Trace_Reader. If the file is
+ * raw, the iterator walks the mapping directly. If the file is encoded,
+ * the iterator decodes one block at a time into its own buffer. If a block
+ * cannot be decoded, the iterator moves to the end, and the reader is
+ * marked as failed.
+ */
+class Trace_Record_Iterator
+{
+public:
+  /// Initializing constructor.
+  Trace_Record_Iterator (const Trace_Reader & reader, uint64_t index);
+
+  /// Copy constructor.
+  Trace_Record_Iterator (const Trace_Record_Iterator & iter);
+
+  /// Assignment operator
+  const Trace_Record_Iterator & operator = (const Trace_Record_Iterator & rhs);
+
+  /// {@ Reference/Dereference Operators
+  const Trace_Record & operator * (void) const;
+  const Trace_Record * operator -> (void) const;
+  /// @}
+
+  /// Index of the current record in the file.
+  uint64_t index (void) const;
+
+  /// @{ Prefix Operators
+  Trace_Record_Iterator & operator ++ (void);
+  /// @}
+
+  /// @{ Postfix Operators
+  Trace_Record_Iterator operator ++ (int);
+  /// @}
+
+  /// {@ Comparision Operators
+  bool operator == (const Trace_Record_Iterator & rhs) const;
+  bool operator != (const Trace_Record_Iterator & rhs) const;
+  /// @}
+
+private:
+  /// Point the iterator at the current record.
+  void locate (void);
+
+  /// Decode a block, and point the iterator at its first record.
+  void load_block (size_t block);
+
+  /// The source reader.
+  const Trace_Reader * reader_;
+
+  /// Index of the current record.
+  uint64_t index_;
+
+  /// The current record.
+  Trace_Record record_;
+
+  /// Decoder for encoded files.
+  Trace_Decoder decoder_;
+
+  /// Index of the decoded block.
+  size_t block_;
+
+  /// Index of the first record in the decoded block.
+  uint64_t block_first_;
+
+  /// Index of the record after the decoded block.
+  uint64_t block_end_;
+
+  /// Records of the decoded block.
+  std::vector <unsigned char> records_;
+};
+
+/**
+ * @class Trace_Reader
+ *
+ * Read-only view of a trace file written by Trace_File or Trace_Sink.
+ * The file is memory mapped, and the records are visited with an STL-like
+ * iterator:
+ *
+ * @code
+ * Trace_Reader reader;
+ *
+ * if (reader.open ("buffer.1234.0.trace"))
+ *   for (Trace_Record_Iterator iter = reader.begin (), end = reader.end (); iter != end; ++ iter)
+ *     ++ counts[iter->field (0)];
+ * @endcode
+ *
+ * The blocks of an encoded file are indexed when the file is opened. The
+ * record count is trimmed to the records that are actually in the file,
+ * so a file from a tool that was killed before it closed the file is read
+ * up to its last complete write.
+ *
+ * The reader does not depend on Pin, and can be used by offline tools.
+ * Many iterators can walk the same reader at the same time. Memory mapped
+ * files are only supported on POSIX systems. On other systems, open ()
+ * always fails.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+class Trace_Reader
+{
+public:
+  /// Type definition of the iterator.
+  typedef Trace_Record_Iterator iterator;
+
+  /// Default constructor.
+  Trace_Reader (void);
+
+  /// Destructor.
+  ~Trace_Reader (void);
+
+  /**
+   * Open a trace file.
+   *
+   * @param[in]       filename        Name of the file
+   * @retval          true            The file is open
+   * @retval          false           The file is missing or not a trace file
+   */
+  bool open (const char * filename);
+
+  /// Test if the file is open.
+  bool is_open (void) const;
+
+  /// Close the file.
+  void close (void);
+
+  /// The header of the file.
+  const Trace_File_Header & header (void) const;
+
+  /// Number of records that can be read from the file.
+  uint64_t record_count (void) const;
+
+  /// Test if an iterator stopped early because a block is corrupt.
+  bool failed (void) const;
+
+  /// @{ Iterators over the records.
+  iterator begin (void) const;
+  iterator end (void) const;
+  /// @}
+
+private:
+  friend class Trace_Record_Iterator;
+
+  /// Index the blocks of an encoded file.
+  void index_blocks (void);
+
+  /// Start of the mapping.
+  const unsigned char * map_;
+
+  /// Size of the mapping.
+  size_t size_;
+
+  /// Copy of the header.
+  Trace_File_Header header_;
+
+  /// Number of records that can be read.
+  uint64_t record_count_;
+
+  /// A block could not be decoded.
+  mutable volatile bool failed_;
+
+  /// Location of a block in an encoded file.
+  struct Block
+  {
+    /// Offset of the block in the file.
+    size_t offset_;
+
+    /// Index of the first record in the block.
+    uint64_t first_;
+  };
+
+  /// Blocks of an encoded file.
+  std::vector <Block> blocks_;
+
+  // prevent the following operations
+  Trace_Reader (const Trace_Reader &);
+  const Trace_Reader & operator = (const Trace_Reader &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Trace_Reader.inl"
+
+#endif  // _OASIS_PIN_TRACE_READER_H_
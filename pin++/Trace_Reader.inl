@@ -0,0 +1,403 @@
+// -*- C++ -*-
+// $Id$
+
+#include <cstring>
+
+#if !defined (TARGET_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace OASIS
+{
+namespace Pin
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Record
+
+inline
+Trace_Record::Trace_Record (void)
+: data_ (0),
+  header_ (0)
+{
+
+}
+
+inline
+Trace_Record::Trace_Record (const unsigned char * data, const Trace_File_Header * header)
+: data_ (data),
+  header_ (header)
+{
+
+}
+
+inline
+const unsigned char * Trace_Record::data (void) const
+{
+  return this->data_;
+}
+
+inline
+uint64_t Trace_Record::field (uint32_t i) const
+{
+  if (i >= this->header_->field_count_)
+    return 0;
+
+  const Trace_File_Field & field = this->header_->fields_[i];
+  uint64_t value = 0;
+
+  ::memcpy (&value, this->data_ + field.offset_, field.size_ < 8 ? field.size_ : 8);
+  return value;
+}
+
+template <typename T>
+inline
+const T & Trace_Record::as (void) const
+{
+  return *reinterpret_cast <const T *> (this->data_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Record_Iterator
+
+inline
+Trace_Record_Iterator::Trace_Record_Iterator (const Trace_Reader & reader, uint64_t index)
+: reader_ (&reader),
+  index_ (index),
+  decoder_ (reader.header_),
+  block_ (0),
+  block_first_ (0),
+  block_end_ (0)
+{
+  if (this->index_ >= this->reader_->record_count_)
+  {
+    this->index_ = this->reader_->record_count_;
+  }
+  else if (this->reader_->header_.is_encoded ())
+  {
+    // Find the last block that starts at or before the record.
+    const std::vector <Trace_Reader::Block> & blocks = this->reader_->blocks_;
+    size_t lo = 0, hi = blocks.size ();
+
+    while (hi - lo > 1)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if (blocks[mid].first_ <= index)
+        lo = mid;
+      else
+        hi = mid;
+    }
+
+    this->load_block (lo);
+
+    if (this->index_ < this->reader_->record_count_)
+      this->index_ = index;
+  }
+
+  this->locate ();
+}
+
+inline
+Trace_Record_Iterator::Trace_Record_Iterator (const Trace_Record_Iterator & iter)
+: reader_ (iter.reader_),
+  index_ (iter.index_),
+  decoder_ (iter.decoder_),
+  block_ (iter.block_),
+  block_first_ (iter.block_first_),
+  block_end_ (iter.block_end_),
+  records_ (iter.records_)
+{
+  this->locate ();
+}
+
+inline
+const Trace_Record_Iterator &
+Trace_Record_Iterator::operator = (const Trace_Record_Iterator & rhs)
+{
+  if (this == &rhs)
+    return *this;
+
+  this->reader_ = rhs.reader_;
+  this->index_ = rhs.index_;
+  this->decoder_ = rhs.decoder_;
+  this->block_ = rhs.block_;
+  this->block_first_ = rhs.block_first_;
+  this->block_end_ = rhs.block_end_;
+  this->records_ = rhs.records_;
+
+  this->locate ();
+  return *this;
+}
+
+inline
+const Trace_Record & Trace_Record_Iterator::operator * (void) const
+{
+  return this->record_;
+}
+
+inline
+const Trace_Record * Trace_Record_Iterator::operator -> (void) const
+{
+  return &this->record_;
+}
+
+inline
+uint64_t Trace_Record_Iterator::index (void) const
+{
+  return this->index_;
+}
+
+inline
+Trace_Record_Iterator & Trace_Record_Iterator::operator ++ (void)
+{
+  if (this->index_ >= this->reader_->record_count_)
+    return *this;
+
+  ++ this->index_;
+
+  if (this->reader_->header_.is_encoded () &&
+      this->index_ == this->block_end_ &&
+      this->index_ < this->reader_->record_count_)
+  {
+    this->load_block (this->block_ + 1);
+  }
+
+  this->locate ();
+  return *this;
+}
+
+inline
+Trace_Record_Iterator Trace_Record_Iterator::operator ++ (int)
+{
+  Trace_Record_Iterator tmp (*this);
+  ++ (*this);
+  return tmp;
+}
+
+inline
+bool Trace_Record_Iterator::operator == (const Trace_Record_Iterator & rhs) const
+{
+  return this->reader_ == rhs.reader_ && this->index_ == rhs.index_;
+}
+
+inline
+bool Trace_Record_Iterator::operator != (const Trace_Record_Iterator & rhs) const
+{
+  return !(*this == rhs);
+}
+
+inline
+void Trace_Record_Iterator::locate (void)
+{
+  const Trace_File_Header & header = this->reader_->header_;
+
+  if (this->index_ >= this->reader_->record_count_)
+  {
+    this->record_ = Trace_Record (0, &header);
+  }
+  else if (header.is_encoded ())
+  {
+    size_t offset = static_cast <size_t> (this->index_ - this->block_first_) * header.record_size_;
+    this->record_ = Trace_Record (&this->records_[offset], &header);
+  }
+  else
+  {
+    size_t offset = header.header_size_ + static_cast <size_t> (this->index_) * header.record_size_;
+    this->record_ = Trace_Record (this->reader_->map_ + offset, &header);
+  }
+}
+
+inline
+void Trace_Record_Iterator::load_block (size_t block)
+{
+  const std::vector <Trace_Reader::Block> & blocks = this->reader_->blocks_;
+
+  if (block >= blocks.size ())
+  {
+    this->index_ = this->reader_->record_count_;
+    return;
+  }
+
+  // The blocks were checked against the size of the mapping when the
+  // file was opened, so only the payload can be corrupt.
+  const unsigned char * data = this->reader_->map_ + blocks[block].offset_;
+  Trace_Block_Header header;
+  ::memcpy (&header, data, sizeof (Trace_Block_Header));
+
+  this->records_.resize (static_cast <size_t> (header.record_count_) * this->reader_->header_.record_size_);
+
+  if (!this->decoder_.decode (header, data + sizeof (Trace_Block_Header), &this->records_[0]))
+  {
+    this->reader_->failed_ = true;
+    this->index_ = this->reader_->record_count_;
+    return;
+  }
+
+  this->block_first_ = blocks[block].first_;
+  this->block_end_ = this->block_first_ + header.record_count_;
+  this->block_ = block;
+  this->index_ = this->block_first_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace_Reader
+
+inline
+Trace_Reader::Trace_Reader (void)
+: map_ (0),
+  size_ (0),
+  record_count_ (0),
+  failed_ (false)
+{
+  this->header_.init (1, 0);
+}
+
+inline
+Trace_Reader::~Trace_Reader (void)
+{
+  this->close ();
+}
+
+inline
+bool Trace_Reader::open (const char * filename)
+{
+  if (this->is_open ())
+    return false;
+
+#if defined (TARGET_WINDOWS)
+  return false;
+#else
+  int fd = ::open (filename, O_RDONLY);
+
+  if (-1 == fd)
+    return false;
+
+  struct stat st;
+
+  if (0 != ::fstat (fd, &st) || static_cast <size_t> (st.st_size) < sizeof (Trace_File_Header))
+  {
+    ::close (fd);
+    return false;
+  }
+
+  void * map = ::mmap (0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close (fd);
+
+  if (MAP_FAILED == map)
+    return false;
+
+  this->map_ = reinterpret_cast <const unsigned char *> (map);
+  this->size_ = st.st_size;
+  ::memcpy (&this->header_, this->map_, sizeof (Trace_File_Header));
+
+  if (!this->header_.is_valid () || this->header_.header_size_ > this->size_)
+  {
+    this->close ();
+    return false;
+  }
+
+  if (this->header_.is_encoded ())
+  {
+    this->index_blocks ();
+  }
+  else
+  {
+    uint64_t available = (this->size_ - this->header_.header_size_) / this->header_.record_size_;
+    this->record_count_ = available < this->header_.record_count_ ? available : this->header_.record_count_;
+  }
+
+  return true;
+#endif
+}
+
+inline
+bool Trace_Reader::is_open (void) const
+{
+  return 0 != this->map_;
+}
+
+inline
+void Trace_Reader::close (void)
+{
+  if (0 == this->map_)
+    return;
+
+#if !defined (TARGET_WINDOWS)
+  ::munmap (const_cast <unsigned char *> (this->map_), this->size_);
+#endif
+
+  this->map_ = 0;
+  this->size_ = 0;
+  this->record_count_ = 0;
+  this->failed_ = false;
+  this->blocks_.clear ();
+}
+
+inline
+const Trace_File_Header & Trace_Reader::header (void) const
+{
+  return this->header_;
+}
+
+inline
+uint64_t Trace_Reader::record_count (void) const
+{
+  return this->record_count_;
+}
+
+inline
+bool Trace_Reader::failed (void) const
+{
+  return this->failed_;
+}
+
+inline
+Trace_Reader::iterator Trace_Reader::begin (void) const
+{
+  return iterator (*this, 0);
+}
+
+inline
+Trace_Reader::iterator Trace_Reader::end (void) const
+{
+  return iterator (*this, this->record_count_);
+}
+
+inline
+void Trace_Reader::index_blocks (void)
+{
+  size_t offset = this->header_.header_size_;
+  uint64_t remaining = this->header_.record_count_;
+
+  // Stop at the first block that is not complete, or once the header's
+  // record count is reached since an unclosed file has padding at the end.
+  while (0 != remaining && this->size_ - offset >= sizeof (Trace_Block_Header))
+  {
+    Trace_Block_Header block;
+    ::memcpy (&block, this->map_ + offset, sizeof (Trace_Block_Header));
+
+    if (block.size_ > this->size_ - offset - sizeof (Trace_Block_Header) ||
+        block.record_count_ > remaining)
+      break;
+
+    if (0 != block.record_count_)
+    {
+      Block location;
+      location.offset_ = offset;
+      location.first_ = this->record_count_;
+
+      this->blocks_.push_back (location);
+    }
+
+    offset += sizeof (Trace_Block_Header) + block.size_;
+    remaining -= block.record_count_;
+    this->record_count_ += block.record_count_;
+  }
+}
+
+} // namespace OASIS
+} // namespace Pin
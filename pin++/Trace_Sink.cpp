@@ -0,0 +1,52 @@
+// $Id$
+
+#include <sstream>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename ELEMENT_TYPE>
+Trace_File * Trace_Sink <ELEMENT_TYPE>::open (THREADID thr_id)
+{
+  std::ostringstream filename;
+  filename << this->prefix_ << "." << thr_id << ".trace";
+
+  Trace_File_Header header;
+  header.init (sizeof (element_type), thr_id);
+  Record_Traits <element_type>::describe (header);
+  header.flags_ = this->flags_;
+
+  Trace_File * file = new Trace_File ();
+
+  if (!file->open (filename.str ().c_str (), header, this->chunk_size_))
+  {
+    delete file;
+    return 0;
+  }
+
+  this->files_[thr_id] = file;
+  return file;
+}
+
+template <typename ELEMENT_TYPE>
+void Trace_Sink <ELEMENT_TYPE>::close (THREADID thr_id)
+{
+  Trace_File * file = this->files_[thr_id];
+
+  if (0 != file)
+    file->close ();
+}
+
+template <typename ELEMENT_TYPE>
+void Trace_Sink <ELEMENT_TYPE>::close (void)
+{
+  this->closed_ = true;
+
+  for (size_t i = 0; i < this->files_.size (); ++ i)
+    this->close (static_cast <THREADID> (i));
+}
+
+} // namespace OASIS
+} // namespace Pin
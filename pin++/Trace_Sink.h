@@ -0,0 +1,172 @@
+// -*- C++ -*-
+
+//==============================================================================
+/**
+ *  @file        Trace_Sink.h
+ *
+ *  $Id$
+ *
+ *  @author      James H. Hill
+ */
+//==============================================================================
+
+#ifndef _OASIS_PIN_TRACE_SINK_H_
+#define _OASIS_PIN_TRACE_SINK_H_
+
+#include "Buffer_Record.h"
+#include "Padded.h"
+#include "Trace_File.h"
+
+#include <string>
+
+namespace OASIS
+{
+namespace Pin
+{
+
+/**
+ * @struct Record_Traits
+ *
+ * Describes the layout of a trace buffer record in a trace file header.
+ * By default, the record is an opaque block of bytes.
+ */
+template <typename T>
+struct Record_Traits
+{
+  static void describe (Trace_File_Header & header)
+  {
+    header.field_count_ = 0;
+  }
+};
+
+/**
+ * @struct Record_Traits <Buffer_Record <...> >
+ *
+ * The layout of a Buffer_Record is known, so each field is described in
+ * the header.
+ */
+template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct Record_Traits <Buffer_Record <A1, A2, A3, A4, A5, A6> >
+{
+  typedef Buffer_Record <A1, A2, A3, A4, A5, A6> record_type;
+
+  static void describe (Trace_File_Header & header)
+  {
+    header.field_count_ = record_type::field_count;
+
+    for (int i = 0; i < record_type::field_count; ++ i)
+    {
+      header.fields_[i].offset_ = record_type::offset (i);
+      header.fields_[i].size_ = record_type::size (i);
+      header.fields_[i].arg_type_ = record_type::arg_type (i);
+    }
+  }
+};
+
+/**
+ * @class Trace_Sink
+ *
+ * Writes the records of a trace buffer into one Trace_File per thread.
+ * The files are named <prefix>.<thread id>.trace, and are opened the first
+ * time a thread writes to the sink. The sink is meant to be used in the
+ * handle_trace_buffer () or handle_drain () method of a Trace_Buffer:
+ *
+ * @code
+ * void handle_drain (THREADID thr_id, element_type * buf, UINT64 elements)
+ * {
+ *   this->sink_.write (thr_id, buf, elements);
+ * }
+ * @endcode
+ *
+ * Each thread writes to its own file, so the sink does not need a lock if
+ * the application threads write their own buffers. If the buffers are
+ * drained on a single drain thread, then the drain thread writes all the
+ * files. The files can be converted to text offline with trace2text.
+ *
+ * Once the sink, or the file of a thread, is closed, the writes are
+ * rejected. A late write therefore cannot reopen, and truncate, a file
+ * that holds the records of the thread.
+ *
+ * The flags are copied into the header of each file. For example, passing
+ * TRACE_FILE_ENCODED stores each write as a delta/varint encoded block,
+ * which shrinks memory address traces several times over.
+ *
+ * The copy constructor and assignment operator for this class are disabled.
+ */
+template <typename ELEMENT_TYPE>
+class Trace_Sink
+{
+public:
+  /// Type definition of the record type.
+  typedef ELEMENT_TYPE element_type;
+
+  /**
+   * Initializing constructor.
+   *
+   * @param[in]       prefix          Prefix of the file names
+   * @param[in]       flags           Trace_File_Flags for the files
+   * @param[in]       chunk_size      Size to grow each file by
+   */
+  Trace_Sink (const std::string & prefix,
+              UINT32 flags = 0,
+              size_t chunk_size = Trace_File::DEFAULT_CHUNK_SIZE);
+
+  /// Destructor.
+  ~Trace_Sink (void);
+
+  /**
+   * Write the records of a thread to its trace file.
+   *
+   * @param[in]       thr_id          Thread that filled the records
+   * @param[in]       records         Pointer to the records
+   * @param[in]       count           Number of records
+   * @retval          true            The records were written
+   * @retval          false           The records were not written, or
+   *                                  the file or the sink is closed
+   */
+  bool write (THREADID thr_id, const element_type * records, UINT64 count);
+
+  /// Close the trace file of a thread. The thread's writes are rejected.
+  void close (THREADID thr_id);
+
+  /// Close the trace files of all threads. All writes are rejected.
+  void close (void);
+
+  /// Test if the sink is closed.
+  bool is_closed (void) const;
+
+  /// Get the trace file of a thread, or 0 if it does not have one.
+  const Trace_File * file (THREADID thr_id) const;
+
+private:
+  /// Open the trace file for a thread.
+  Trace_File * open (THREADID thr_id);
+
+  /// Prefix for the file names.
+  std::string prefix_;
+
+  /// Flags for the file headers.
+  UINT32 flags_;
+
+  /// Size to grow the files by.
+  size_t chunk_size_;
+
+  /// The sink is closed.
+  volatile bool closed_;
+
+  /// Trace file of each thread. A closed file stays in the array so the
+  /// thread cannot open it again.
+  Padded_Array <Trace_File *> files_;
+
+  // prevent the following operations
+  Trace_Sink (const Trace_Sink &);
+  const Trace_Sink & operator = (const Trace_Sink &);
+};
+
+} // namespace OASIS
+} // namespace Pin
+
+#include "Trace_Sink.inl"
+#include "Trace_Sink.cpp"
+
+#endif  // _OASIS_PIN_TRACE_SINK_H_
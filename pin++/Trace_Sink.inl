@@ -0,0 +1,61 @@
+// -*- C++ -*-
+// $Id$
+
+namespace OASIS
+{
+namespace Pin
+{
+
+template <typename ELEMENT_TYPE>
+inline
+Trace_Sink <ELEMENT_TYPE>::Trace_Sink (const std::string & prefix, UINT32 flags, size_t chunk_size)
+: prefix_ (prefix),
+  flags_ (flags),
+  chunk_size_ (chunk_size),
+  closed_ (false),
+  files_ (PIN_MAX_THREADS, 0)
+{
+
+}
+
+template <typename ELEMENT_TYPE>
+inline
+Trace_Sink <ELEMENT_TYPE>::~Trace_Sink (void)
+{
+  for (size_t i = 0; i < this->files_.size (); ++ i)
+    delete this->files_[i];
+}
+
+template <typename ELEMENT_TYPE>
+inline
+bool Trace_Sink <ELEMENT_TYPE>::
+write (THREADID thr_id, const element_type * records, UINT64 count)
+{
+  if (this->closed_)
+    return false;
+
+  Trace_File * file = this->files_[thr_id];
+
+  if (0 == file)
+    file = this->open (thr_id);
+
+  // A closed file rejects the write.
+  return 0 != file && file->write (records, count);
+}
+
+template <typename ELEMENT_TYPE>
+inline
+bool Trace_Sink <ELEMENT_TYPE>::is_closed (void) const
+{
+  return this->closed_;
+}
+
+template <typename ELEMENT_TYPE>
+inline
+const Trace_File * Trace_Sink <ELEMENT_TYPE>::file (THREADID thr_id) const
+{
+  return this->files_[thr_id];
+}
+
+} // namespace OASIS
+} // namespace Pin
@@ -0,0 +1,155 @@
+// $Id$
+
+//
+// Test for the asynchronous log. The formats are tested in the tool's
+// constructor, where the records are written without the writer thread.
+// The writer thread is tested once the application starts, and closed
+// in handle_fini_unlocked (). The log still writes the messages of
+// handle_fini ().
+//
+
+#include "pin++/Pintool.h"
+#include "pin++/Async_Log.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/// Read a whole file into a string.
+static std::string read_file (const char * filename)
+{
+  std::ifstream file (filename, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf ();
+
+  return contents.str ();
+}
+
+class Async_Log_Test : public OASIS::Pin::Tool <Async_Log_Test>
+{
+public:
+  Async_Log_Test (void)
+    : log_ (::fopen ("Async_Log_Test.writer", "wb"), 16),
+      flush_passed_ (false),
+      close_passed_ (false)
+  {
+    this->enable_application_start_callback ();
+    this->enable_fini_unlocked_callback ();
+    this->enable_fini_callback ();
+
+    this->format_passed_ = this->test_format ();
+
+    this->line_ = this->log_.register_format ("line %u of %s\n");
+    this->text_ = this->log_.register_format ("text: %s\n");
+    this->log_.open ();
+  }
+
+  void handle_application_start (void)
+  {
+    // The queue is smaller than the number of messages, so the messages
+    // are written while they are logged.
+    for (UINT64 i = 0; i < 1000; ++ i)
+    {
+      this->log_.log (this->line_, i, reinterpret_cast <ADDRINT> ("start"));
+      this->expected_ << "line " << i << " of start\n";
+    }
+
+    this->flush_passed_ = this->log_.flush () &&
+                          this->expected_.str () == read_file ("Async_Log_Test.writer");
+  }
+
+  void handle_fini_unlocked (INT32)
+  {
+    // A text longer than the record is copied to the heap.
+    const std::string text (200, 'x');
+    this->log_.log_text (this->text_, text.c_str ());
+
+    this->expected_ << "text: " << text << "\n";
+
+    this->close_passed_ = this->log_.close () &&
+                          this->expected_.str () == read_file ("Async_Log_Test.writer");
+  }
+
+  void handle_fini (INT32)
+  {
+    // The log is closed, so the message is written by this thread.
+    this->log_.log (this->line_, 0, reinterpret_cast <ADDRINT> ("fini"));
+    this->expected_ << "line 0 of fini\n";
+
+    this->close_passed_ = this->log_.flush () && this->close_passed_ &&
+                          this->expected_.str () == read_file ("Async_Log_Test.writer");
+
+    std::cerr << ">> Format passed: " << this->format_passed_ << std::endl;
+    std::cerr << ">> Flush passed: " << this->flush_passed_ << std::endl;
+    std::cerr << ">> Close passed: " << this->close_passed_ << std::endl;
+  }
+
+private:
+  bool test_format (void)
+  {
+    OASIS::Pin::Async_Log log (::fopen ("Async_Log_Test.format", "wb"), 4);
+
+    if (OASIS::Pin::Async_Log::INVALID_FORMAT != log.register_format ("%q") ||
+        OASIS::Pin::Async_Log::INVALID_FORMAT != log.register_format ("%u %u %u %u %u %u %u") ||
+        OASIS::Pin::Async_Log::INVALID_FORMAT != log.register_format ("%") ||
+        OASIS::Pin::Async_Log::INVALID_FORMAT != log.register_format ("%4d") ||
+        OASIS::Pin::Async_Log::INVALID_FORMAT != log.register_format ("%.2"))
+    {
+      return false;
+    }
+
+    const UINT32 numbers = log.register_format ("%d %i %u %x %p %c%%\n");
+    const UINT32 real = log.register_format ("%g\n");
+    const UINT32 fixed = log.register_format ("[%4.2f] [%.1f] [%f] [%8.3g]\n");
+    const UINT32 text = log.register_format ("[%s]\n");
+
+    // The writer is not running, so the queue is written each time it fills.
+    for (int i = 0; i < 3; ++ i)
+      log.log (numbers, -42, 7, 18446744073709551615ULL, 0xab, 0x10, 'z');
+
+    log.log (real, OASIS::Pin::Async_Log::real (0.5));
+    log.log (fixed,
+             OASIS::Pin::Async_Log::real (3.14159),
+             OASIS::Pin::Async_Log::real (-2.71),
+             OASIS::Pin::Async_Log::real (1.5),
+             OASIS::Pin::Async_Log::real (12.345));
+
+    // The text of the application can change once it is logged.
+    char str[] = "abc";
+    log.log_text (text, str);
+    str[0] = 'X';
+
+    log.log_text (text, "");
+
+    if (!log.close ())
+      return false;
+
+    std::ostringstream expected;
+
+    for (int i = 0; i < 3; ++ i)
+      expected << "-42 7 18446744073709551615 ab 0x10 z%\n";
+
+    expected << "0.5\n"
+             << "[3.14] [-2.7] [1.500000] [    12.3]\n"
+             << "[abc]\n" << "[]\n";
+
+    return expected.str () == read_file ("Async_Log_Test.format");
+  }
+
+  OASIS::Pin::Async_Log log_;
+
+  UINT32 line_;
+
+  UINT32 text_;
+
+  bool format_passed_;
+
+  bool flush_passed_;
+
+  bool close_passed_;
+
+  std::ostringstream expected_;
+};
+
+DECLARE_PINTOOL (Async_Log_Test);
@@ -1,6 +1,7 @@
 // $Id: inscount1.cpp 2286 2013-09-19 18:40:30Z hillj $
 
 #include "pin++/Callback.h"
+#include "pin++/Static_Callback.h"
 #include "pin++/Trace.h"
 #include "pin++/Routine.h"
 
@@ -86,6 +87,31 @@ public:
   }
 };
 
+class static_callback0 :
+  public OASIS::Pin::Static_Callback <static_callback0 (void)>
+{
+public:
+  static void handle_analyze (void) { }
+};
+
+class static_callback2 :
+  public OASIS::Pin::Static_Callback <static_callback2 (OASIS::Pin::ARG_INST_PTR,
+                                                        OASIS::Pin::ARG_SYSARG_VALUE)>
+{
+public:
+  static void handle_analyze (param_type1 p1, param_type2 p2) { }
+};
+
+class Static_Conditional_Test :
+  public OASIS::Pin::Static_Conditional_Callback <Static_Conditional_Test (void)>
+{
+public:
+  static bool do_next (void)
+  {
+    return true;
+  }
+};
+
 template <typename T>
 void test_callback (void)
 {
@@ -144,6 +170,23 @@ void test_conditional_callback (void)
   c6[condition].insert (IPOINT_BEFORE, obj, 0, 0, 0, 0, 0 ,0);
 }
 
+template <typename T>
+void test_static_callback (void)
+{
+  typename T::pin_type pin_obj;
+  T obj (pin_obj);
+
+  static_callback0 s0;
+  s0.insert (IPOINT_BEFORE, obj);
+
+  static_callback2 s2;
+  s2.insert (IPOINT_BEFORE, obj, 0);
+
+  Static_Conditional_Test condition;
+  s0[condition].insert (IPOINT_BEFORE, obj);
+  s2[condition].insert (IPOINT_BEFORE, obj, 0);
+}
+
 int main (int argc, char * argv [])
 {
   test_callback <OASIS::Pin::Ins> ();
@@ -155,5 +198,9 @@ int main (int argc, char * argv [])
   test_conditional_callback <OASIS::Pin::Bbl> ();
   test_conditional_callback <OASIS::Pin::Trace> ();
 
+  test_static_callback <OASIS::Pin::Ins> ();
+  test_static_callback <OASIS::Pin::Bbl> ();
+  test_static_callback <OASIS::Pin::Trace> ();
+
   return 0;
 }
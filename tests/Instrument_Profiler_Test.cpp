@@ -0,0 +1,133 @@
+// $Id$
+
+//
+// Test for the instrumentation profiler. The test is always built with
+// OASIS_PIN_PROFILE_INSTRUMENT (see tests.mpc), so the profiler is
+// compiled in even though the profile_instrument feature is off by
+// default. The tool counts its own insert calls, and checks that the
+// profile of the trace hook counted the same number.
+//
+
+#include "pin++/Buffer_Record.h"
+#include "pin++/Callback.h"
+#include "pin++/Instrument_Profiler.h"
+#include "pin++/Pintool.h"
+#include "pin++/Static_Callback.h"
+#include "pin++/Trace_Buffer.h"
+#include "pin++/Trace_Instrument.h"
+
+#include <iostream>
+
+#if !defined (OASIS_PIN_PROFILE_INSTRUMENT)
+  #error This test must be built with OASIS_PIN_PROFILE_INSTRUMENT
+#endif
+
+class docount : public OASIS::Pin::Callback <docount (void)>
+{
+public:
+  docount (void)
+    : count_ (0)
+  {
+
+  }
+
+  void handle_analyze (void)
+  {
+    ++ this->count_;
+  }
+
+private:
+  UINT64 count_;
+};
+
+class docount_static : public OASIS::Pin::Static_Callback <docount_static (void)>
+{
+public:
+  static void handle_analyze (void)
+  {
+    ++ count_;
+  }
+
+private:
+  static UINT64 count_;
+};
+
+UINT64 docount_static::count_ = 0;
+
+typedef OASIS::Pin::Buffer_Record <OASIS::Pin::ARG_INST_PTR> IPREF;
+
+class Ip_Buffer : public OASIS::Pin::Trace_Buffer <Ip_Buffer, IPREF>
+{
+public:
+  Ip_Buffer (void)
+    : OASIS::Pin::Trace_Buffer <Ip_Buffer, IPREF> (1)
+  {
+
+  }
+};
+
+class Trace : public OASIS::Pin::Trace_Instrument <Trace>
+{
+public:
+  Trace (void)
+    : inserts_ (0)
+  {
+
+  }
+
+  void handle_instrument (const OASIS::Pin::Trace & trace)
+  {
+    // One object callback, one static callback, and one buffer fill per
+    // basic block.
+    for (OASIS::Pin::Bbl & bbl : trace)
+    {
+      this->docount_.insert (IPOINT_BEFORE, bbl);
+      this->docount_static_.insert (IPOINT_BEFORE, bbl);
+      this->buffer_.insert_fill (IPOINT_BEFORE, *bbl.begin ());
+
+      this->inserts_ += 3;
+    }
+  }
+
+  UINT64 inserts (void) const
+  {
+    return this->inserts_;
+  }
+
+private:
+  docount docount_;
+  docount_static docount_static_;
+  Ip_Buffer buffer_;
+  UINT64 inserts_;
+};
+
+class Instrument_Profiler_Test : public OASIS::Pin::Tool <Instrument_Profiler_Test>
+{
+public:
+  Instrument_Profiler_Test (void)
+  {
+    this->enable_fini_callback ();
+  }
+
+  void handle_fini (INT32)
+  {
+    using OASIS::Pin::Instrument_Profiler;
+
+    const Instrument_Profiler::Stats & stats =
+      Instrument_Profiler::instance ().stats (Instrument_Profiler::HOOK_TRACE);
+
+    bool passed = 0 != stats.calls_ &&
+                  0 != this->trace_.inserts () &&
+                  stats.inserts_ == this->trace_.inserts ();
+
+    std::cerr << ">> Trace hook calls: " << stats.calls_ << std::endl
+              << ">> Inserts counted by the tool: " << this->trace_.inserts () << std::endl
+              << ">> Inserts counted by the profiler: " << stats.inserts_ << std::endl
+              << ">> Insert count passed: " << passed << std::endl;
+  }
+
+private:
+  Trace trace_;
+};
+
+DECLARE_PINTOOL (Instrument_Profiler_Test);
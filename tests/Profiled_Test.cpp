@@ -0,0 +1,302 @@
+// $Id$
+
+//
+// Test for the analysis profiler. The test is always built with
+// OASIS_PIN_PROFILE_ANALYSIS (see tests.mpc), so every Profiled_Analyze
+// routine, from 0 to 8 parameters, is compiled and inserted. Each callback
+// checks the extra arguments it is passed, since the decorator adds the
+// thread id to the argument list, and counts its calls. At fini, the count
+// of each callback must match the calls in its profile. The counts are not
+// atomic, so the test is run on a single-threaded application.
+//
+
+#include "pin++/Callback.h"
+#include "pin++/Pintool.h"
+#include "pin++/Profiled.h"
+#include "pin++/Trace_Instrument.h"
+
+#include <iostream>
+
+#if !defined (OASIS_PIN_PROFILE_ANALYSIS)
+  #error This test must be built with OASIS_PIN_PROFILE_ANALYSIS
+#endif
+
+using OASIS::Pin::ARG_ADDRINT;
+using OASIS::Pin::ARG_BOOL;
+using OASIS::Pin::ARG_INST_PTR;
+using OASIS::Pin::ARG_THREAD_ID;
+using OASIS::Pin::ARG_UINT32;
+using OASIS::Pin::ARG_UINT64;
+
+/**
+ * @class Counted
+ *
+ * The count, and the result of the argument checks, of a callback.
+ */
+class Counted
+{
+public:
+  Counted (void)
+    : count_ (0),
+      passed_ (true)
+  {
+
+  }
+
+  UINT64 count (void) const
+  {
+    return this->count_;
+  }
+
+  bool passed (void) const
+  {
+    return this->passed_;
+  }
+
+protected:
+  void check (bool result)
+  {
+    ++ this->count_;
+
+    if (!result)
+      this->passed_ = false;
+  }
+
+private:
+  UINT64 count_;
+  bool passed_;
+};
+
+class callback0 :
+  public OASIS::Pin::Callback <callback0 (void)>,
+  public Counted
+{
+public:
+  void handle_analyze (void)
+  {
+    this->check (true);
+  }
+};
+
+class callback1 :
+  public OASIS::Pin::Callback <callback1 (ARG_INST_PTR)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 ip)
+  {
+    this->check (0 != ip);
+  }
+};
+
+class callback2 :
+  public OASIS::Pin::Callback <callback2 (ARG_INST_PTR, ARG_UINT32)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 ip, param_type2 a)
+  {
+    this->check (0 != ip && 2 == a);
+  }
+};
+
+class callback3 :
+  public OASIS::Pin::Callback <callback3 (ARG_THREAD_ID, ARG_UINT32, ARG_INST_PTR)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 thr_id, param_type2 a, param_type3 ip)
+  {
+    this->check (thr_id < PIN_MAX_THREADS && 3 == a && 0 != ip);
+  }
+};
+
+class callback4 :
+  public OASIS::Pin::Callback <callback4 (ARG_UINT32, ARG_UINT64, ARG_INST_PTR, ARG_BOOL)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 a, param_type2 b, param_type3 ip, param_type4 c)
+  {
+    this->check (4 == a && 40 == b && 0 != ip && TRUE == c);
+  }
+};
+
+class callback5 :
+  public OASIS::Pin::Callback <callback5 (ARG_INST_PTR,
+                                          ARG_UINT32,
+                                          ARG_THREAD_ID,
+                                          ARG_UINT64,
+                                          ARG_ADDRINT)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 ip, param_type2 a, param_type3 thr_id, param_type4 b, param_type5 c)
+  {
+    this->check (0 != ip && 5 == a && thr_id < PIN_MAX_THREADS && 50 == b && 500 == c);
+  }
+};
+
+class callback6 :
+  public OASIS::Pin::Callback <callback6 (ARG_UINT32,
+                                          ARG_UINT32,
+                                          ARG_UINT32,
+                                          ARG_UINT32,
+                                          ARG_UINT32,
+                                          ARG_UINT32)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 a, param_type2 b, param_type3 c, param_type4 d, param_type5 e, param_type6 f)
+  {
+    this->check (1 == a && 2 == b && 3 == c && 4 == d && 5 == e && 6 == f);
+  }
+};
+
+class callback7 :
+  public OASIS::Pin::Callback <callback7 (ARG_INST_PTR,
+                                          ARG_UINT32,
+                                          ARG_UINT32,
+                                          ARG_THREAD_ID,
+                                          ARG_UINT32,
+                                          ARG_UINT32,
+                                          ARG_INST_PTR)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 ip, param_type2 a, param_type3 b, param_type4 thr_id, param_type5 c, param_type6 d, param_type7 ip2)
+  {
+    this->check (0 != ip && 7 == a && 70 == b && thr_id < PIN_MAX_THREADS && 700 == c && 7000 == d && ip == ip2);
+  }
+};
+
+class callback8 :
+  public OASIS::Pin::Callback <callback8 (ARG_INST_PTR,
+                                          ARG_THREAD_ID,
+                                          ARG_UINT32,
+                                          ARG_UINT64,
+                                          ARG_BOOL,
+                                          ARG_ADDRINT,
+                                          ARG_INST_PTR,
+                                          ARG_THREAD_ID)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 ip, param_type2 thr_id, param_type3 a, param_type4 b, param_type5 c, param_type6 d, param_type7 ip2, param_type8 thr_id2)
+  {
+    this->check (0 != ip && thr_id < PIN_MAX_THREADS && 8 == a && 80 == b && FALSE == c && 800 == d && ip == ip2 && thr_id == thr_id2);
+  }
+};
+
+/**
+ * @class Every_Other
+ *
+ * Guard that passes every other call.
+ */
+class Every_Other :
+  public OASIS::Pin::Conditional_Callback <Every_Other (ARG_INST_PTR, ARG_THREAD_ID)>,
+  public Counted
+{
+public:
+  bool do_next (param_type1 ip, param_type2 thr_id)
+  {
+    this->check (0 != ip && thr_id < PIN_MAX_THREADS);
+    return 0 == (this->count () & 1);
+  }
+};
+
+class guarded :
+  public OASIS::Pin::Callback <guarded (ARG_UINT32, ARG_INST_PTR)>,
+  public Counted
+{
+public:
+  void handle_analyze (param_type1 a, param_type2 ip)
+  {
+    this->check (9 == a && 0 != ip);
+  }
+};
+
+class Trace : public OASIS::Pin::Trace_Instrument <Trace>
+{
+public:
+  void handle_instrument (const OASIS::Pin::Trace & trace)
+  {
+    for (OASIS::Pin::Bbl & bbl : trace)
+    {
+      this->c0_.insert (IPOINT_BEFORE, bbl);
+      this->c1_.insert (IPOINT_BEFORE, bbl);
+      this->c2_.insert (IPOINT_BEFORE, bbl, 2);
+      this->c3_.insert (IPOINT_BEFORE, bbl, 3);
+      this->c4_.insert (IPOINT_BEFORE, bbl, 4, 40, TRUE);
+      this->c5_.insert (IPOINT_BEFORE, bbl, 5, 50, 500);
+      this->c6_.insert (IPOINT_BEFORE, bbl, 1, 2, 3, 4, 5, 6);
+      this->c7_.insert (IPOINT_BEFORE, bbl, 7, 70, 700, 7000);
+      this->c8_.insert (IPOINT_BEFORE, bbl, 8, 80, FALSE, 800);
+
+      // A profiled guard, and a profiled callback behind a guard.
+      this->guarded_[this->guard_].insert (IPOINT_BEFORE, bbl, 9);
+    }
+  }
+
+  bool passed (void)
+  {
+    return
+      this->check ("callback0", this->c0_) &&
+      this->check ("callback1", this->c1_) &&
+      this->check ("callback2", this->c2_) &&
+      this->check ("callback3", this->c3_) &&
+      this->check ("callback4", this->c4_) &&
+      this->check ("callback5", this->c5_) &&
+      this->check ("callback6", this->c6_) &&
+      this->check ("callback7", this->c7_) &&
+      this->check ("callback8", this->c8_) &&
+      this->check ("Every_Other", this->guard_) &&
+      this->check ("guarded", this->guarded_) &&
+      this->guarded_.count () == this->guard_.count () / 2;
+  }
+
+private:
+  template <typename T>
+  static bool check (const char * name, T & callback)
+  {
+    const UINT64 calls = callback.profile ().total ().calls_;
+    const bool passed = callback.passed () && 0 != calls && callback.count () == calls;
+
+    std::cerr << ">> " << name << ": " << callback.count () << " calls, "
+              << calls << " profiled" << std::endl;
+
+    return passed;
+  }
+
+  OASIS::Pin::Profiled <callback0> c0_;
+  OASIS::Pin::Profiled <callback1> c1_;
+  OASIS::Pin::Profiled <callback2> c2_;
+  OASIS::Pin::Profiled <callback3> c3_;
+  OASIS::Pin::Profiled <callback4> c4_;
+  OASIS::Pin::Profiled <callback5> c5_;
+  OASIS::Pin::Profiled <callback6> c6_;
+  OASIS::Pin::Profiled <callback7> c7_;
+  OASIS::Pin::Profiled <callback8> c8_;
+
+  OASIS::Pin::Profiled <Every_Other> guard_;
+  OASIS::Pin::Profiled <guarded> guarded_;
+};
+
+class Profiled_Test : public OASIS::Pin::Tool <Profiled_Test>
+{
+public:
+  Profiled_Test (void)
+  {
+    this->enable_fini_callback ();
+  }
+
+  void handle_fini (INT32)
+  {
+    std::cerr << ">> Profiled callbacks passed: " << this->trace_.passed () << std::endl;
+  }
+
+private:
+  Trace trace_;
+};
+
+DECLARE_PINTOOL (Profiled_Test);
@@ -0,0 +1,284 @@
+// $Id$
+
+//
+// Test for the signature parser and matcher, and a benchmark against the
+// string-based parsing in SDMM and DynamicEventMonitor. The parser does not
+// depend on Pin, so this test is a plain executable.
+//
+// The benchmark uses the signatures in the file named on the command line,
+// one per line (e.g., the output of nm -C on a large library), or a set of
+// generated signatures.
+//
+
+#include "pin++/Signature.h"
+#include "pin++/Signature_Matcher.h"
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using OASIS::Pin::Signature;
+using OASIS::Pin::Signature_Matcher;
+using OASIS::Pin::String_Slice;
+
+//
+// Copy of parse_signature from examples/SDMM/middleware.h before it used
+// the Signature parser.
+//
+static std::list <std::string> legacy_parse_signature (const std::string & sign)
+{
+  std::list<std::string> parsed_list;
+  std::string object("");
+  std::string method("");
+  std::string in_types("");
+  size_t i = 0;
+
+  for (; sign[i] != '('; ++i)
+    object += sign[i];
+
+  ++i;
+
+  for (; sign[i] != ')'; ++i)
+    in_types += sign[i];
+
+  std::string temp("");
+  for (i=object.length(); object[i] != ':'; --i) {
+    temp += object[i];
+    object[i] = ' ';
+  }
+
+  object[i] = ' ';
+  object[i-1] = ' ';
+
+  for (i=temp.length(); i > 0; --i)
+    method += temp[i];
+
+  parsed_list.push_back(object);
+  parsed_list.push_back(method);
+  parsed_list.push_back(in_types);
+
+  return parsed_list;
+}
+
+static bool check (const char * text,
+                   const char * prefix,
+                   const char * scope,
+                   const char * method,
+                   const char * params,
+                   const char * qualifiers)
+{
+  Signature sign (text);
+
+  bool passed =
+    sign.is_valid () &&
+    sign.prefix () == prefix &&
+    sign.scope () == scope &&
+    sign.method () == method &&
+    sign.params () == params &&
+    sign.qualifiers () == qualifiers;
+
+  if (!passed)
+    std::cerr << "!! " << text << std::endl
+              << "   prefix: '" << sign.prefix () << "' scope: '" << sign.scope ()
+              << "' method: '" << sign.method () << "' params: '" << sign.params ()
+              << "' qualifiers: '" << sign.qualifiers () << "'" << std::endl;
+
+  return passed;
+}
+
+static bool test_signature (void)
+{
+  bool passed =
+    check ("public: virtual void __thiscall Foo::Bar::push_event(class Foo::Event *)",
+           "public: virtual void __thiscall", "Foo::Bar", "push_event", "class Foo::Event *", "") &&
+    check ("DDS::DataWriter::write(Foo const&, long)", "", "DDS::DataWriter", "write", "Foo const&, long", "") &&
+    check ("std::vector<int, std::allocator<int> >::size() const",
+           "", "std::vector<int, std::allocator<int> >", "size", "", "const") &&
+    check ("unsigned int ns::get<a::b>(int)", "unsigned int", "ns", "get<a::b>", "int", "") &&
+    check ("Foo::operator<(Foo const&) const", "", "Foo", "operator<", "Foo const&", "const") &&
+    check ("Foo::operator()(int)", "", "Foo", "operator()", "int", "") &&
+    check ("outer(int)::Local::run()", "", "outer(int)::Local", "run", "", "") &&
+    check ("main", "", "", "main", "", "") &&
+    check ("Client::Stub::Call", "", "Client::Stub", "Call", "", "");
+
+  Signature sign ("void __cdecl f(std::map<int, long>, char const*, void (*)(int, int))");
+  passed = passed &&
+    3 == sign.param_count () &&
+    sign.param (0) == "std::map<int, long>" &&
+    sign.param (1) == "char const*" &&
+    sign.param (2) == "void (*)(int, int)" &&
+    sign.param (3).empty () &&
+    sign.object () == "void __cdecl" &&
+    sign.qualified_name () == "f";
+
+  Signature nothing ("Foo::bar(void)");
+  passed = passed && 0 == nothing.param_count () && nothing.object () == "Foo";
+
+  Signature broken ("Foo::bar(int))");
+  passed = passed && !broken.is_valid ();
+
+  return passed;
+}
+
+/**
+ * @struct Collect
+ *
+ * Visitor that records the id of each match.
+ */
+struct Collect
+{
+  bool operator () (size_t id, size_t)
+  {
+    this->ids_.push_back (id);
+    return true;
+  }
+
+  std::vector <size_t> ids_;
+};
+
+static bool test_matcher (void)
+{
+  Signature_Matcher matcher;
+  size_t he = matcher.add ("he");
+  size_t she = matcher.add ("she");
+  size_t his = matcher.add ("his");
+  size_t hers = matcher.add ("hers");
+
+  if (he != matcher.add ("he") || Signature_Matcher::npos != matcher.add (""))
+    return false;
+
+  matcher.compile ();
+
+  size_t id = 0, pos = 0;
+  bool passed = matcher.find ("ushers", id, pos) && id == she && pos == 1;
+
+  Collect collect;
+  passed = passed && 3 == matcher.for_each ("ushers", collect) &&
+           collect.ids_[0] == she && collect.ids_[1] == he && collect.ids_[2] == hers;
+
+  passed = passed && matcher.contains ("this") && !matcher.contains ("hxs") && !matcher.contains ("");
+  passed = passed && matcher.find ("ahisb", id, pos) && id == his && pos == 1;
+
+  // Patterns added after compile () are not matched until compiled again.
+  matcher.add ("xyz");
+  passed = passed && !matcher.contains ("xyz");
+  matcher.compile ();
+  passed = passed && matcher.contains ("axyz");
+
+  return passed;
+}
+
+static void generate (std::vector <std::string> & signatures)
+{
+  static const char * methods [] = { "push_", "write", "take_next_sample", "get_value", "set_value",
+                                     "create_topic", "dispatch", "handle_input", "open", "close" };
+
+  for (size_t i = 0; i < 200000; ++ i)
+  {
+    std::ostringstream sign;
+    sign << "public: virtual int __thiscall Module" << i % 97 << "::Component" << i % 13
+         << "::" << methods[i % 10] << (i % 7 == 0 ? "Event" : "") << "(class Event" << i % 5
+         << " *, unsigned long, char const *)";
+
+    signatures.push_back (sign.str ());
+  }
+}
+
+static double elapsed (std::clock_t start)
+{
+  return 1000.0 * (std::clock () - start) / CLOCKS_PER_SEC;
+}
+
+static void benchmark (const std::vector <std::string> & signatures)
+{
+  static const char * patterns [] = { "::push_", "::write(", "::take_next_sample(", "::create_topic(" };
+  const size_t pattern_count = sizeof (patterns) / sizeof (patterns[0]);
+
+  // Both versions match each signature against the patterns, and parse
+  // the matches into the object, method, and parameters.
+  size_t legacy_matches = 0, legacy_bytes = 0;
+  std::clock_t start = std::clock ();
+
+  for (size_t i = 0; i < signatures.size (); ++ i)
+  {
+    const std::string & signature = signatures[i];
+
+    for (size_t p = 0; p < pattern_count; ++ p)
+    {
+      if (signature.find (patterns[p]) == std::string::npos || signature.find ('(') == std::string::npos)
+        continue;
+
+      std::list <std::string> info (legacy_parse_signature (signature));
+      ++ legacy_matches;
+      legacy_bytes += info.front ().size ();
+    }
+  }
+
+  double legacy_time = elapsed (start);
+
+  Signature_Matcher matcher;
+
+  for (size_t p = 0; p < pattern_count; ++ p)
+    matcher.add (patterns[p]);
+
+  matcher.compile ();
+
+  size_t matches = 0, bytes = 0;
+  start = std::clock ();
+
+  for (size_t i = 0; i < signatures.size (); ++ i)
+  {
+    const String_Slice signature (signatures[i]);
+    size_t id, pos;
+
+    if (!matcher.find (signature, id, pos))
+      continue;
+
+    Signature sign (signature);
+
+    if (!sign.has_params ())
+      continue;
+
+    ++ matches;
+    bytes += sign.object ().size ();
+  }
+
+  double time = elapsed (start);
+
+  std::cerr << ">> Benchmark over " << signatures.size () << " signatures" << std::endl
+            << ">>   legacy: " << legacy_time << " ms, " << legacy_matches << " matches" << std::endl
+            << ">>   slices: " << time << " ms, " << matches << " matches" << std::endl;
+
+  (void) legacy_bytes;
+  (void) bytes;
+}
+
+int main (int argc, char * argv [])
+{
+  bool signature_passed = test_signature ();
+  bool matcher_passed = test_matcher ();
+
+  std::cerr << ">> Signature parsing passed: " << signature_passed << std::endl
+            << ">> Signature matching passed: " << matcher_passed << std::endl;
+
+  std::vector <std::string> signatures;
+
+  if (argc > 1)
+  {
+    std::ifstream file (argv[1]);
+    std::string line;
+
+    while (std::getline (file, line))
+      signatures.push_back (line);
+  }
+  else
+    generate (signatures);
+
+  benchmark (signatures);
+
+  return signature_passed && matcher_passed ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+// $Id$
+
+#include "pin++/Pintool.h"
+#include "pin++/Task.h"
+
+#include "atomic.hpp"
+
+#include <iostream>
+
+/**
+ * @class Syscall_Counter
+ *
+ * Task that counts the system call numbers put on its queue.
+ */
+class Syscall_Counter : public OASIS::Pin::Task <ADDRINT>
+{
+public:
+  Syscall_Counter (void)
+    : OASIS::Pin::Task <ADDRINT> (16, 4),
+      count_ (0),
+      max_batch_ (0)
+  {
+
+  }
+
+  virtual ~Syscall_Counter (void)
+  {
+    this->close ();
+  }
+
+  UINT64 count (void) const
+  {
+    return this->count_;
+  }
+
+  size_t max_batch (void) const
+  {
+    return this->max_batch_;
+  }
+
+protected:
+  virtual void handle_messages (ADDRINT *, size_t count)
+  {
+    // There is only one worker, so the counters are not shared.
+    this->count_ += count;
+
+    if (count > this->max_batch_)
+      this->max_batch_ = count;
+  }
+
+private:
+  UINT64 count_;
+
+  size_t max_batch_;
+};
+
+class Task_Test : public OASIS::Pin::Tool <Task_Test>
+{
+public:
+  Task_Test (void)
+    : syscalls_ (0),
+      open_passed_ (false),
+      close_passed_ (false)
+  {
+    this->open_passed_ = 1 == this->counter_.open (1);
+
+    this->enable_fini_callback ();
+    this->enable_fini_unlocked_callback ();
+    this->enable_syscall_entry_callback ();
+  }
+
+  void handle_syscall_entry (THREADID, OASIS::Pin::Context & ctx, SYSCALL_STANDARD std)
+  {
+    if (this->counter_.putq (ctx.get_syscall_number (std)))
+      ATOMIC::OPS::Increment (&this->syscalls_, static_cast <UINT64> (1));
+  }
+
+  void handle_fini_unlocked (INT32)
+  {
+    this->counter_.close ();
+    this->close_passed_ = !this->counter_.is_active () && 0 == this->counter_.message_count ();
+  }
+
+  void handle_fini (INT32)
+  {
+    std::cerr << ">> Task open passed: " << this->open_passed_ << std::endl;
+    std::cerr << ">> Task close passed: " << this->close_passed_ << std::endl;
+    std::cerr << ">> Task count passed: " << (this->counter_.count () == this->syscalls_) << std::endl;
+    std::cerr << ">> Task batch passed: " << (this->counter_.max_batch () <= this->counter_.batch_size ()) << std::endl;
+    std::cerr << ">> Task putq after close passed: " << !this->counter_.putq (0) << std::endl;
+  }
+
+private:
+  Syscall_Counter counter_;
+
+  volatile UINT64 syscalls_;
+
+  bool open_passed_;
+  bool close_passed_;
+};
+
+DECLARE_PINTOOL (Task_Test);
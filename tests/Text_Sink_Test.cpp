@@ -0,0 +1,199 @@
+// $Id$
+
+//
+// Test for the buffered text output. The records are written from the
+// tool's constructor on behalf of several THREADIDs, so the test does not
+// depend on the application.
+//
+
+#include "pin++/Pintool.h"
+#include "pin++/Text_Sink.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/// Read a whole file into a string.
+static std::string read_file (const char * filename)
+{
+  std::ifstream file (filename, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf ();
+
+  return contents.str ();
+}
+
+class Text_Sink_Test : public OASIS::Pin::Tool <Text_Sink_Test>
+{
+public:
+  Text_Sink_Test (void)
+  {
+    this->enable_fini_callback ();
+
+    this->format_passed_ = this->test_format ();
+    this->per_thread_passed_ = this->test_per_thread ();
+    this->merged_passed_ = this->test_merged ();
+    this->merged_threads_passed_ = this->test_merged_threads ();
+  }
+
+  void handle_fini (INT32)
+  {
+    std::cerr << ">> Format passed: " << this->format_passed_ << std::endl;
+    std::cerr << ">> Per-thread files passed: " << this->per_thread_passed_ << std::endl;
+    std::cerr << ">> Merged file passed: " << this->merged_passed_ << std::endl;
+    std::cerr << ">> Merged threads passed: " << this->merged_threads_passed_ << std::endl;
+  }
+
+private:
+  bool test_format (void)
+  {
+    using OASIS::Pin::Hex;
+
+    do
+    {
+      // The capacity is smaller than the record, so the buffer must grow.
+      OASIS::Pin::Text_Buffer out (::fopen ("Text_Sink_Test.format", "wb"), false, 8);
+
+      out.begin_record ();
+      out << Hex (0x7fff1234) << ' ' << Hex (0xab, false) << ' '
+          << 0 << ' ' << -42 << ' ' << 18446744073709551615ULL << ' '
+          << (-9223372036854775807LL - 1) << ' '
+          << std::string ("str") << ' ' << reinterpret_cast <const void *> (0x10) << '\n';
+      out.end_record ();
+    } while (0);
+
+    const std::string expected =
+      "0x7fff1234 ab 0 -42 18446744073709551615 -9223372036854775808 str 0x10\n";
+
+    return expected == read_file ("Text_Sink_Test.format");
+  }
+
+  bool test_per_thread (void)
+  {
+    do
+    {
+      OASIS::Pin::Text_Sink sink ("Text_Sink_Test.per_thread", OASIS::Pin::Text_Sink::PER_THREAD_FILES, 16);
+
+      for (int i = 0; i < 100; ++ i)
+      {
+        for (THREADID thr_id = 0; thr_id < 2; ++ thr_id)
+        {
+          OASIS::Pin::Text_Record record (sink, thr_id);
+          record.buffer () << thr_id << ':' << i << '\n';
+        }
+      }
+
+      if (!sink.close ("#eof\n"))
+        return false;
+    } while (0);
+
+    for (THREADID thr_id = 0; thr_id < 2; ++ thr_id)
+    {
+      std::ostringstream expected;
+
+      for (int i = 0; i < 100; ++ i)
+        expected << thr_id << ':' << i << '\n';
+
+      expected << "#eof\n";
+
+      std::ostringstream filename;
+      filename << "Text_Sink_Test.per_thread." << thr_id;
+
+      if (expected.str () != read_file (filename.str ().c_str ()))
+        return false;
+    }
+
+    return true;
+  }
+
+  bool test_merged (void)
+  {
+    do
+    {
+      OASIS::Pin::Text_Sink sink ("Text_Sink_Test.merged", OASIS::Pin::Text_Sink::MERGED_FILE, 16);
+
+      // Thread 2 writes the earlier event of each pair, so the merge must
+      // interleave the files. The second line of each record must stay
+      // with the first.
+      for (UINT64 i = 0; i < 100; ++ i)
+      {
+        for (THREADID thr_id = 1; thr_id <= 2; ++ thr_id)
+        {
+          OASIS::Pin::Text_Record record (sink, thr_id, i * 10 + (2 - thr_id));
+          record.buffer () << "event " << i << " from " << thr_id << '\n'
+                           << "  end\n";
+        }
+      }
+
+      if (!sink.close ("#eof\n"))
+        return false;
+    } while (0);
+
+    std::ostringstream expected;
+
+    for (UINT64 i = 0; i < 100; ++ i)
+    {
+      expected << "event " << i << " from 2\n  end\n";
+      expected << "event " << i << " from 1\n  end\n";
+    }
+
+    expected << "#eof\n";
+
+    // The temporary files are removed after the merge.
+    std::ifstream temporary ("Text_Sink_Test.merged.1.tmp");
+
+    return !temporary && expected.str () == read_file ("Text_Sink_Test.merged");
+  }
+
+  bool test_merged_threads (void)
+  {
+    // A temporary file of a thread that does not write to the sink, e.g.,
+    // from an earlier run. It holds one valid record.
+    FILE * stale = ::fopen ("Text_Sink_Test.threads.5.tmp", "wb");
+
+    if (0 == stale)
+      return false;
+
+    const UINT64 timestamp = 0;
+    const UINT32 length = 6;
+
+    bool written = 1 == ::fwrite (&timestamp, sizeof (timestamp), 1, stale) &&
+                   1 == ::fwrite (&length, sizeof (length), 1, stale) &&
+                   1 == ::fwrite ("stale\n", length, 1, stale);
+
+    if (0 != ::fclose (stale) || !written)
+      return false;
+
+    do
+    {
+      OASIS::Pin::Text_Sink sink ("Text_Sink_Test.threads", OASIS::Pin::Text_Sink::MERGED_FILE, 16);
+
+      for (UINT64 i = 0; i < 10; ++ i)
+      {
+        OASIS::Pin::Text_Record record (sink, 1, i + 1);
+        record.buffer () << "event " << i << '\n';
+      }
+
+      if (!sink.close ())
+        return false;
+    } while (0);
+
+    std::ostringstream expected;
+
+    for (UINT64 i = 0; i < 10; ++ i)
+      expected << "event " << i << '\n';
+
+    // Only the file of thread 1 is merged, and removed.
+    std::ifstream temporary ("Text_Sink_Test.threads.5.tmp");
+
+    return temporary && expected.str () == read_file ("Text_Sink_Test.threads");
+  }
+
+  bool format_passed_;
+  bool per_thread_passed_;
+  bool merged_passed_;
+  bool merged_threads_passed_;
+};
+
+DECLARE_PINTOOL (Text_Sink_Test);
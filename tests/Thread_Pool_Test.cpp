@@ -0,0 +1,229 @@
+// $Id$
+
+//
+// Test for the work-stealing thread pool. The pool is started with the
+// tool, and it is tested once the application exits, while the internal
+// threads are still running. The stealing test submits subtasks from a
+// task, which queues them on the worker of that task. The task then
+// waits on the latch without running them, so only another worker can
+// run the subtasks.
+//
+
+#include "pin++/Pintool.h"
+#include "pin++/Thread_Pool.h"
+
+#include "atomic.hpp"
+
+#include <iostream>
+
+/// Number of workers in the pool.
+static const size_t WORKERS = 4;
+
+/// Number of tasks submitted by each test.
+static const size_t TASKS = 64;
+
+/**
+ * @class Count_Task
+ *
+ * Task that counts how many times it runs.
+ */
+class Count_Task : public OASIS::Pin::Runnable
+{
+public:
+  Count_Task (void)
+    : count_ (0),
+      thread_ (0)
+  {
+
+  }
+
+  virtual void run (void)
+  {
+    this->thread_ = OASIS::Pin::Thread::current ();
+    ATOMIC::OPS::Increment (&this->count_, static_cast <UINT32> (1));
+  }
+
+  UINT32 count (void) const
+  {
+    return this->count_;
+  }
+
+  /// The thread that last ran the task.
+  OASIS::Pin::Thread * thread (void) const
+  {
+    return this->thread_;
+  }
+
+private:
+  volatile UINT32 count_;
+
+  OASIS::Pin::Thread * volatile thread_;
+};
+
+/**
+ * @class Steal_Task
+ *
+ * Task that submits subtasks to its own worker, and waits for the other
+ * workers to steal them.
+ */
+class Steal_Task : public OASIS::Pin::Runnable
+{
+public:
+  Steal_Task (OASIS::Pin::Thread_Pool & pool)
+    : pool_ (pool),
+      passed_ (false)
+  {
+
+  }
+
+  virtual void run (void)
+  {
+    OASIS::Pin::Thread * self = OASIS::Pin::Thread::current ();
+    OASIS::Pin::Latch done;
+
+    for (size_t i = 0; i < TASKS; ++ i)
+      this->pool_.submit (&this->subtasks_[i], &done);
+
+    done.wait ();
+
+    for (size_t i = 0; i < TASKS; ++ i)
+    {
+      if (1 != this->subtasks_[i].count () || self == this->subtasks_[i].thread ())
+        return;
+    }
+
+    this->passed_ = true;
+  }
+
+  bool passed (void) const
+  {
+    return this->passed_;
+  }
+
+private:
+  OASIS::Pin::Thread_Pool & pool_;
+
+  Count_Task subtasks_[TASKS];
+
+  bool passed_;
+};
+
+/**
+ * @class Shutdown_Task
+ *
+ * Task that tries to shut down its own pool.
+ */
+class Shutdown_Task : public OASIS::Pin::Runnable
+{
+public:
+  Shutdown_Task (OASIS::Pin::Thread_Pool & pool)
+    : pool_ (pool),
+      passed_ (false)
+  {
+
+  }
+
+  virtual void run (void)
+  {
+    this->passed_ = !this->pool_.shutdown ();
+  }
+
+  bool passed (void) const
+  {
+    return this->passed_;
+  }
+
+private:
+  OASIS::Pin::Thread_Pool & pool_;
+
+  bool passed_;
+};
+
+class Thread_Pool_Test : public OASIS::Pin::Tool <Thread_Pool_Test>
+{
+public:
+  Thread_Pool_Test (void)
+    : pool_ (WORKERS),
+      steal_ (pool_),
+      worker_shutdown_ (pool_),
+      start_passed_ (false),
+      wait_passed_ (false),
+      drain_passed_ (false),
+      submit_after_shutdown_passed_ (false)
+  {
+    this->start_passed_ = WORKERS == this->pool_.size ();
+
+    this->enable_fini_callback ();
+    this->enable_fini_unlocked_callback ();
+  }
+
+  void handle_fini_unlocked (INT32)
+  {
+    using OASIS::Pin::Latch;
+
+    // Submit the tasks, and wait for them.
+    Latch done;
+
+    for (size_t i = 0; i < TASKS; ++ i)
+      this->pool_.submit (&this->wait_tasks_[i], &done);
+
+    this->pool_.submit (&this->steal_, &done);
+    this->pool_.wait (done);
+
+    this->wait_passed_ = done.is_done () && ran_once (this->wait_tasks_);
+
+    // Wait on the latch only, so the task runs on a worker and not on
+    // this thread.
+    Latch shutdown_done;
+
+    this->pool_.submit (&this->worker_shutdown_, &shutdown_done);
+    shutdown_done.wait (5000);
+
+    // Queue the tasks without waiting. shutdown () must run all of them
+    // before it stops the workers.
+    for (size_t i = 0; i < TASKS; ++ i)
+      this->pool_.submit (&this->drain_tasks_[i]);
+
+    this->drain_passed_ = this->pool_.shutdown () && ran_once (this->drain_tasks_);
+
+    Count_Task late;
+    this->submit_after_shutdown_passed_ = !this->pool_.submit (&late) && 0 == this->pool_.size ();
+  }
+
+  void handle_fini (INT32)
+  {
+    std::cerr << ">> Thread_Pool start passed: " << this->start_passed_ << std::endl;
+    std::cerr << ">> Thread_Pool wait passed: " << this->wait_passed_ << std::endl;
+    std::cerr << ">> Thread_Pool steal passed: " << this->steal_.passed () << std::endl;
+    std::cerr << ">> Thread_Pool worker shutdown passed: " << this->worker_shutdown_.passed () << std::endl;
+    std::cerr << ">> Thread_Pool shutdown drain passed: " << this->drain_passed_ << std::endl;
+    std::cerr << ">> Thread_Pool submit after shutdown passed: " << this->submit_after_shutdown_passed_ << std::endl;
+  }
+
+private:
+  static bool ran_once (const Count_Task (& tasks)[TASKS])
+  {
+    for (size_t i = 0; i < TASKS; ++ i)
+    {
+      if (1 != tasks[i].count ())
+        return false;
+    }
+
+    return true;
+  }
+
+  OASIS::Pin::Thread_Pool pool_;
+
+  Count_Task wait_tasks_[TASKS];
+  Count_Task drain_tasks_[TASKS];
+
+  Steal_Task steal_;
+  Shutdown_Task worker_shutdown_;
+
+  bool start_passed_;
+  bool wait_passed_;
+  bool drain_passed_;
+  bool submit_after_shutdown_passed_;
+};
+
+DECLARE_PINTOOL (Thread_Pool_Test);
@@ -0,0 +1,145 @@
+// $Id$
+
+//
+// Round trip test for the delta/varint encoding of trace files. The codec
+// does not depend on Pin, so this test is a plain executable.
+//
+
+#include "pin++/Trace_Codec.h"
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+using OASIS::Pin::Trace_File_Header;
+using OASIS::Pin::Trace_Block_Header;
+using OASIS::Pin::Trace_Encoder;
+using OASIS::Pin::Trace_Decoder;
+
+struct Record
+{
+  uint64_t pc_;
+  uint64_t ea_;
+  uint32_t size_;
+  uint16_t tag_;
+  uint8_t read_;
+  uint8_t raw_[3];
+};
+
+static void describe (Trace_File_Header & header)
+{
+  header.field_count_ = 6;
+
+  header.fields_[0].offset_ = offsetof (Record, pc_);
+  header.fields_[0].size_ = sizeof (uint64_t);
+  header.fields_[1].offset_ = offsetof (Record, ea_);
+  header.fields_[1].size_ = sizeof (uint64_t);
+  header.fields_[2].offset_ = offsetof (Record, size_);
+  header.fields_[2].size_ = sizeof (uint32_t);
+  header.fields_[3].offset_ = offsetof (Record, tag_);
+  header.fields_[3].size_ = sizeof (uint16_t);
+  header.fields_[4].offset_ = offsetof (Record, read_);
+  header.fields_[4].size_ = sizeof (uint8_t);
+  header.fields_[5].offset_ = offsetof (Record, raw_);
+  header.fields_[5].size_ = 3;
+}
+
+static void fill (Record * records, uint32_t count)
+{
+  ::memset (records, 0, count * sizeof (Record));
+
+  uint64_t ea = 0x7fff00001000ULL;
+
+  for (uint32_t i = 0; i < count; ++ i)
+  {
+    records[i].pc_ = 0x400000 + (i % 7) * 4;
+
+    // Stride forward, and sometimes jump far backward.
+    ea = (i % 100 == 99) ? ea - 0x100000 : ea + 8;
+    records[i].ea_ = ea;
+
+    records[i].size_ = (i % 3 == 0) ? 0xFFFFFFFF : 8;
+    records[i].tag_ = static_cast <uint16_t> (0xFFF0 + (i % 32));
+    records[i].read_ = static_cast <uint8_t> (i & 1 ? 0 : 255);
+    records[i].raw_[0] = static_cast <uint8_t> (i);
+    records[i].raw_[1] = static_cast <uint8_t> (i >> 8);
+    records[i].raw_[2] = 0xAB;
+  }
+}
+
+static bool round_trip (const Trace_File_Header & header, const Record * records, uint32_t count)
+{
+  Trace_Encoder encoder (header);
+  Trace_Decoder decoder (header);
+
+  std::vector <unsigned char> block;
+  std::vector <Record> decoded (count);
+
+  // Encode the records as a few blocks to test the reset of the delta state.
+  for (uint32_t first = 0; first < count; first += 1000)
+  {
+    uint32_t n = count - first < 1000 ? count - first : 1000;
+    encoder.encode (records + first, n, block);
+
+    Trace_Block_Header block_header;
+    ::memcpy (&block_header, &block[0], sizeof (Trace_Block_Header));
+
+    if (block_header.record_count_ != n ||
+        block_header.size_ + sizeof (Trace_Block_Header) != block.size ())
+      return false;
+
+    // A truncated block must be rejected.
+    if (0 == block_header.flags_ && 0 != block_header.size_)
+    {
+      Trace_Block_Header truncated = block_header;
+      truncated.size_ -= 1;
+
+      if (decoder.decode (truncated, &block[sizeof (Trace_Block_Header)], &decoded[first]))
+        return false;
+    }
+
+    if (!decoder.decode (block_header, &block[sizeof (Trace_Block_Header)], &decoded[first]))
+      return false;
+  }
+
+  return 0 == ::memcmp (records, &decoded[0], count * sizeof (Record));
+}
+
+int main (int, char * [])
+{
+  const uint32_t count = 4500;
+  std::vector <Record> records (count);
+  fill (&records[0], count);
+
+  Trace_File_Header header;
+  header.init (sizeof (Record), 0);
+  header.flags_ = OASIS::Pin::TRACE_FILE_ENCODED;
+  describe (header);
+
+  bool fields_passed = round_trip (header, &records[0], count);
+
+  // Without a layout, the record is coded as 8-byte words.
+  Trace_File_Header opaque;
+  opaque.init (sizeof (Record), 0);
+  opaque.flags_ = OASIS::Pin::TRACE_FILE_ENCODED;
+
+  bool opaque_passed = round_trip (opaque, &records[0], count);
+
+  header.flags_ |= OASIS::Pin::TRACE_FILE_ZLIB;
+  bool zlib_passed = round_trip (header, &records[0], count);
+
+  // The encoded size of the strided addresses should be small.
+  Trace_Encoder encoder (header);
+  std::vector <unsigned char> block;
+  encoder.encode (&records[0], count, block);
+
+  bool smaller_passed = block.size () < count * sizeof (Record) / 2;
+
+  std::cerr << ">> Field round trip passed: " << fields_passed << std::endl
+            << ">> Opaque round trip passed: " << opaque_passed << std::endl
+            << ">> Compressed round trip passed: " << zlib_passed << std::endl
+            << ">> Encoded size passed: " << smaller_passed
+            << " (" << block.size () << " of " << count * sizeof (Record) << " bytes)" << std::endl;
+
+  return fields_passed && opaque_passed && zlib_passed && smaller_passed ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+// $Id$
+
+//
+// Test for reading trace files offline. The files are written by hand
+// with the encoder, then read back with Trace_Reader, Trace_Driver, and
+// Trace_Stream_Decoder. None of them depend on Pin, so this test is a
+// plain executable.
+//
+
+#include "pin++/Trace_Driver.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using OASIS::Pin::Trace_Analysis;
+using OASIS::Pin::Trace_Block_Header;
+using OASIS::Pin::Trace_Driver;
+using OASIS::Pin::Trace_Encoder;
+using OASIS::Pin::Trace_File_Header;
+using OASIS::Pin::Trace_Reader;
+using OASIS::Pin::Trace_Record;
+using OASIS::Pin::Trace_Stream_Decoder;
+
+// Number of records in each test file.
+static const uint32_t RECORD_COUNT = 3000;
+
+// Number of records in each encoded block.
+static const uint32_t BLOCK_SIZE = 1000;
+
+struct Record
+{
+  uint64_t pc_;
+  uint64_t ea_;
+};
+
+/**
+ * @class Record_Count
+ *
+ * Counts the records, and sums the pc field to check the values.
+ */
+class Record_Count : public Trace_Analysis <Record_Count>
+{
+public:
+  Record_Count (void)
+    : records_ (0),
+      sum_ (0)
+  {
+
+  }
+
+  void handle_record (const Trace_Record & record)
+  {
+    ++ this->records_;
+    this->sum_ += record.field (0);
+  }
+
+  void merge (const Record_Count & other)
+  {
+    this->records_ += other.records_;
+    this->sum_ += other.sum_;
+  }
+
+  uint64_t records_;
+  uint64_t sum_;
+};
+
+static void make_header (Trace_File_Header & header, uint32_t flags)
+{
+  header.init (sizeof (Record), 0);
+  header.flags_ = flags;
+  header.record_count_ = RECORD_COUNT;
+  header.field_count_ = 2;
+
+  header.fields_[0].offset_ = offsetof (Record, pc_);
+  header.fields_[0].size_ = sizeof (uint64_t);
+  header.fields_[1].offset_ = offsetof (Record, ea_);
+  header.fields_[1].size_ = sizeof (uint64_t);
+}
+
+static void fill (std::vector <Record> & records)
+{
+  records.resize (RECORD_COUNT);
+
+  for (uint32_t i = 0; i < RECORD_COUNT; ++ i)
+  {
+    records[i].pc_ = i;
+    records[i].ea_ = 0x7fff00001000ULL + i * 8;
+  }
+}
+
+/// Sum of the pc fields of the first \a count records.
+static uint64_t pc_sum (uint64_t count)
+{
+  return count * (count - 1) / 2;
+}
+
+/// Write a trace file, and return the contents that follow the header.
+static bool write_file (const char * filename,
+                        const Trace_File_Header & header,
+                        const std::vector <Record> & records,
+                        std::vector <unsigned char> & contents)
+{
+  contents.clear ();
+
+  if (header.is_encoded ())
+  {
+    Trace_Encoder encoder (header);
+    std::vector <unsigned char> block;
+
+    for (uint32_t first = 0; first < RECORD_COUNT; first += BLOCK_SIZE)
+    {
+      encoder.encode (&records[first], BLOCK_SIZE, block);
+      contents.insert (contents.end (), block.begin (), block.end ());
+    }
+  }
+  else
+  {
+    const unsigned char * data = reinterpret_cast <const unsigned char *> (&records[0]);
+    contents.assign (data, data + RECORD_COUNT * sizeof (Record));
+  }
+
+  FILE * file = ::fopen (filename, "wb");
+
+  if (0 == file)
+    return false;
+
+  bool written = 1 == ::fwrite (&header, sizeof (header), 1, file) &&
+                 1 == ::fwrite (&contents[0], contents.size (), 1, file);
+
+  return 0 == ::fclose (file) && written;
+}
+
+/// Write \a size bytes of \a contents after the header.
+static bool write_partial (const char * filename,
+                           const Trace_File_Header & header,
+                           const std::vector <unsigned char> & contents,
+                           size_t size)
+{
+  FILE * file = ::fopen (filename, "wb");
+
+  if (0 == file)
+    return false;
+
+  bool written = 1 == ::fwrite (&header, sizeof (header), 1, file) &&
+                 (0 == size || 1 == ::fwrite (&contents[0], size, 1, file));
+
+  return 0 == ::fclose (file) && written;
+}
+
+static bool read_file (const char * filename, const std::vector <Record> & records)
+{
+  Trace_Reader reader;
+
+  if (!reader.open (filename) || RECORD_COUNT != reader.record_count ())
+    return false;
+
+  uint64_t index = 0;
+
+  for (Trace_Reader::iterator iter = reader.begin (), end = reader.end (); iter != end; ++ iter, ++ index)
+  {
+    if (iter->field (0) != records[index].pc_ || iter->field (1) != records[index].ea_)
+      return false;
+  }
+
+  return RECORD_COUNT == index && !reader.failed ();
+}
+
+int main (int, char * [])
+{
+  std::vector <Record> records;
+  fill (records);
+
+  Trace_File_Header raw;
+  make_header (raw, 0);
+
+  Trace_File_Header encoded;
+  make_header (encoded, OASIS::Pin::TRACE_FILE_ENCODED);
+
+  std::vector <unsigned char> raw_contents;
+  std::vector <unsigned char> encoded_contents;
+
+  bool reader_passed =
+    write_file ("Trace_Reader_Test.raw.trace", raw, records, raw_contents) &&
+    write_file ("Trace_Reader_Test.encoded.trace", encoded, records, encoded_contents) &&
+    read_file ("Trace_Reader_Test.raw.trace", records) &&
+    read_file ("Trace_Reader_Test.encoded.trace", records);
+
+  // Fill the payload of the second block with continuation bytes, so the
+  // varints never end and the block cannot be decoded.
+  Trace_Block_Header block;
+  ::memcpy (&block, &encoded_contents[0], sizeof (Trace_Block_Header));
+
+  size_t second = sizeof (Trace_Block_Header) + block.size_;
+  ::memcpy (&block, &encoded_contents[second], sizeof (Trace_Block_Header));
+
+  std::vector <unsigned char> corrupt (encoded_contents);
+  ::memset (&corrupt[second + sizeof (Trace_Block_Header)], 0x80, block.size_);
+
+  bool corrupt_passed = write_partial ("Trace_Reader_Test.corrupt.trace", encoded, corrupt, corrupt.size ());
+
+  // The driver analyzes the records before the corrupt block, and reports
+  // the file.
+  std::vector <std::string> files;
+  files.push_back ("Trace_Reader_Test.raw.trace");
+  files.push_back ("Trace_Reader_Test.encoded.trace");
+  files.push_back ("Trace_Reader_Test.corrupt.trace");
+
+  Record_Count analysis;
+  Trace_Driver <Record_Count> driver (2);
+
+  bool driver_passed =
+    !driver.run (files, analysis) &&
+    1 == driver.failed ().size () &&
+    "Trace_Reader_Test.corrupt.trace" == driver.failed ()[0] &&
+    2 * RECORD_COUNT + BLOCK_SIZE == analysis.records_ &&
+    2 * pc_sum (RECORD_COUNT) + pc_sum (BLOCK_SIZE) == analysis.sum_;
+
+  // Without the corrupt file, the run succeeds.
+  files.pop_back ();
+  Record_Count good;
+
+  driver_passed = driver_passed &&
+    driver.run (files, good) &&
+    driver.failed ().empty () &&
+    2 * RECORD_COUNT == good.records_;
+
+  // A file that ends in the middle of a block header is truncated, so the
+  // stream decoder must fail instead of returning the end of the file.
+  bool truncated_passed =
+    write_partial ("Trace_Reader_Test.truncated.trace", encoded, encoded_contents, second + 5);
+
+  FILE * file = ::fopen ("Trace_Reader_Test.truncated.trace", "rb");
+
+  if (0 != file)
+  {
+    Trace_File_Header header;
+    truncated_passed = truncated_passed && 1 == ::fread (&header, sizeof (header), 1, file);
+
+    Trace_Stream_Decoder decoder (file, header);
+    uint32_t count = 0;
+
+    truncated_passed = truncated_passed &&
+      0 != decoder.next (count) && BLOCK_SIZE == count && !decoder.failed () &&
+      0 == decoder.next (count) && 0 == count && decoder.failed ();
+
+    ::fclose (file);
+  }
+  else
+  {
+    truncated_passed = false;
+  }
+
+  // A field that lies outside the record is rejected when the file is
+  // opened.
+  Trace_File_Header outside = raw;
+  outside.fields_[1].offset_ = sizeof (Record) - 4;
+
+  Trace_Reader reader;
+
+  bool header_passed =
+    !outside.is_valid () &&
+    write_partial ("Trace_Reader_Test.outside.trace", outside, raw_contents, raw_contents.size ()) &&
+    !reader.open ("Trace_Reader_Test.outside.trace");
+
+  std::cerr << ">> Reader passed: " << reader_passed << std::endl
+            << ">> Corrupt block passed: " << (corrupt_passed && driver_passed) << std::endl
+            << ">> Truncated block header passed: " << truncated_passed << std::endl
+            << ">> Field layout passed: " << header_passed << std::endl;
+
+  return reader_passed && corrupt_passed && driver_passed && truncated_passed && header_passed ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// $Id$
+
+//
+// Test for the per-thread trace files. The records are written from the
+// tool's constructor on behalf of several THREADIDs, so the test does not
+// depend on the application. The files are read back with Trace_Reader.
+//
+
+#include "pin++/Pintool.h"
+#include "pin++/Trace_Reader.h"
+#include "pin++/Trace_Sink.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+struct Record
+{
+  UINT64 index_;
+  UINT64 thr_id_;
+};
+
+class Trace_Sink_Test : public OASIS::Pin::Tool <Trace_Sink_Test>
+{
+public:
+  Trace_Sink_Test (void)
+  {
+    this->enable_fini_callback ();
+
+    this->write_passed_ = this->test_write ();
+    this->write_after_close_passed_ = this->test_write_after_close ();
+  }
+
+  void handle_fini (INT32)
+  {
+    std::cerr << ">> Write passed: " << this->write_passed_ << std::endl;
+    std::cerr << ">> Write after close passed: " << this->write_after_close_passed_ << std::endl;
+  }
+
+private:
+  /// Write \a count records for a thread, starting at \a first.
+  static bool write (OASIS::Pin::Trace_Sink <Record> & sink, THREADID thr_id, UINT64 first, UINT64 count)
+  {
+    Record records[100];
+
+    for (UINT64 i = 0; i < count; i += 100)
+    {
+      const UINT64 n = count - i < 100 ? count - i : 100;
+
+      for (UINT64 j = 0; j < n; ++ j)
+      {
+        records[j].index_ = first + i + j;
+        records[j].thr_id_ = thr_id;
+      }
+
+      if (!sink.write (thr_id, records, n))
+        return false;
+    }
+
+    return true;
+  }
+
+  /// Check that the file of a thread holds records 0 to \a count - 1.
+  static bool verify (const char * prefix, THREADID thr_id, UINT64 count)
+  {
+    std::ostringstream filename;
+    filename << prefix << "." << thr_id << ".trace";
+
+    OASIS::Pin::Trace_Reader reader;
+
+    if (!reader.open (filename.str ().c_str ()) || count != reader.record_count ())
+      return false;
+
+    UINT64 index = 0;
+
+    for (OASIS::Pin::Trace_Reader::iterator iter = reader.begin (), end = reader.end (); iter != end; ++ iter, ++ index)
+    {
+      const Record & record = iter->as <Record> ();
+
+      if (index != record.index_ || thr_id != record.thr_id_)
+        return false;
+    }
+
+    return index == count;
+  }
+
+  bool test_write (void)
+  {
+    do
+    {
+      // The chunk is smaller than the records, so the files must grow.
+      OASIS::Pin::Trace_Sink <Record> sink ("Trace_Sink_Test.write", 0, 4096);
+
+      for (THREADID thr_id = 0; thr_id < 2; ++ thr_id)
+        if (!write (sink, thr_id, 0, 1000 * (thr_id + 1)))
+          return false;
+
+      sink.close ();
+    } while (0);
+
+    return verify ("Trace_Sink_Test.write", 0, 1000) &&
+           verify ("Trace_Sink_Test.write", 1, 2000);
+  }
+
+  bool test_write_after_close (void)
+  {
+    do
+    {
+      OASIS::Pin::Trace_Sink <Record> sink ("Trace_Sink_Test.close");
+
+      if (!write (sink, 0, 0, 5000) || !write (sink, 1, 0, 10) || !write (sink, 2, 0, 10))
+        return false;
+
+      // The file of the thread is closed, so its late records are rejected
+      // instead of reopening, and truncating, the file. The other threads
+      // still write their files.
+      sink.close (1);
+
+      if (write (sink, 1, 10, 3) || !write (sink, 2, 10, 3))
+        return false;
+
+      sink.close ();
+
+      if (!sink.is_closed () || write (sink, 0, 5000, 3) || write (sink, 3, 0, 3))
+        return false;
+    } while (0);
+
+    return verify ("Trace_Sink_Test.close", 0, 5000) &&
+           verify ("Trace_Sink_Test.close", 1, 10) &&
+           verify ("Trace_Sink_Test.close", 2, 13);
+  }
+
+  bool write_passed_;
+  bool write_after_close_passed_;
+};
+
+DECLARE_PINTOOL (Trace_Sink_Test);
@@ -0,0 +1,189 @@
+// $Id$
+
+//
+// Offline converter from the binary trace files written by Trace_Sink to
+// text. Each record is printed on its own line. If the header describes
+// the record layout, then each field is printed in hex. Otherwise, the
+// record is printed as raw bytes. Encoded files are decoded one block at a
+// time. The converter does not depend on Pin.
+//
+// usage: trace2text <file> [<file> ...]
+//
+
+#include "pin++/Trace_Codec.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using OASIS::Pin::Trace_File_Header;
+using OASIS::Pin::Trace_File_Field;
+using OASIS::Pin::Trace_Stream_Decoder;
+
+// Number of records to read from the file at a time.
+static const size_t RECORDS_PER_READ = 4096;
+
+static void print_field (const unsigned char * data, const Trace_File_Field & field)
+{
+  const unsigned char * value = data + field.offset_;
+
+  switch (field.size_)
+  {
+  case 1:
+    printf ("%x", *value);
+    break;
+
+  case 2:
+  {
+    uint16_t v;
+    ::memcpy (&v, value, sizeof (v));
+    printf ("%x", v);
+    break;
+  }
+
+  case 4:
+  {
+    uint32_t v;
+    ::memcpy (&v, value, sizeof (v));
+    printf ("%x", v);
+    break;
+  }
+
+  case 8:
+  {
+    uint64_t v;
+    ::memcpy (&v, value, sizeof (v));
+    printf ("%llx", static_cast <unsigned long long> (v));
+    break;
+  }
+
+  default:
+    for (uint32_t i = 0; i < field.size_; ++ i)
+      printf ("%02x", value[i]);
+  }
+}
+
+static void print_record (const unsigned char * data, const Trace_File_Header & header)
+{
+  if (0 == header.field_count_)
+  {
+    for (uint32_t i = 0; i < header.record_size_; ++ i)
+      printf ("%02x", data[i]);
+  }
+  else
+  {
+    for (uint32_t i = 0; i < header.field_count_; ++ i)
+    {
+      if (0 != i)
+        printf (" ");
+
+      print_field (data, header.fields_[i]);
+    }
+  }
+
+  printf ("\n");
+}
+
+static uint64_t convert_raw (FILE * file, const Trace_File_Header & header)
+{
+  std::vector <unsigned char> buffer (header.record_size_ * RECORDS_PER_READ);
+  uint64_t remaining = header.record_count_;
+
+  while (remaining != 0)
+  {
+    size_t count = remaining < RECORDS_PER_READ ? static_cast <size_t> (remaining) : RECORDS_PER_READ;
+    size_t n = ::fread (&buffer[0], header.record_size_, count, file);
+
+    for (size_t i = 0; i < n; ++ i)
+      print_record (&buffer[i * header.record_size_], header);
+
+    remaining -= n;
+
+    if (n != count)
+      break;
+  }
+
+  return remaining;
+}
+
+static uint64_t convert_encoded (FILE * file, const Trace_File_Header & header)
+{
+  Trace_Stream_Decoder decoder (file, header);
+  uint64_t remaining = header.record_count_;
+  uint32_t count;
+
+  // The file may have padding after the last block if it was not closed,
+  // so stop once the header's record count is reached.
+  while (remaining != 0)
+  {
+    const unsigned char * records = decoder.next (count);
+
+    if (0 == records || count > remaining)
+      break;
+
+    for (uint32_t i = 0; i < count; ++ i)
+      print_record (records + i * header.record_size_, header);
+
+    remaining -= count;
+  }
+
+  return remaining;
+}
+
+static bool convert (const char * filename)
+{
+  FILE * file = ::fopen (filename, "rb");
+
+  if (0 == file)
+  {
+    fprintf (stderr, "*** error: cannot open %s\n", filename);
+    return false;
+  }
+
+  Trace_File_Header header;
+
+  if (1 != ::fread (&header, sizeof (header), 1, file) || !header.is_valid ())
+  {
+    fprintf (stderr, "*** error: %s is not a trace file\n", filename);
+    ::fclose (file);
+
+    return false;
+  }
+
+  // Skip the remainder of the header, if any.
+  ::fseek (file, header.header_size_, SEEK_SET);
+
+  printf ("# thread %u, %llu records of %u bytes\n",
+          header.thread_id_,
+          static_cast <unsigned long long> (header.record_count_),
+          header.record_size_);
+
+  uint64_t remaining = header.is_encoded () ?
+                       convert_encoded (file, header) :
+                       convert_raw (file, header);
+
+  if (0 != remaining)
+    fprintf (stderr, "*** error: %s is truncated or corrupt\n", filename);
+
+  ::fclose (file);
+  return 0 == remaining;
+}
+
+int main (int argc, char * argv [])
+{
+  if (argc < 2)
+  {
+    fprintf (stderr, "usage: %s <file> [<file> ...]\n", argv[0]);
+    return 1;
+  }
+
+  int retval = 0;
+
+  for (int i = 1; i < argc; ++ i)
+  {
+    if (!convert (argv[i]))
+      retval = 1;
+  }
+
+  return retval;
+}
@@ -0,0 +1,136 @@
+// $Id$
+
+//
+// Offline aggregation over the binary trace files written by Trace_Sink.
+// The files are read in parallel by a Trace_Driver, and the tool prints
+// the most frequent values of one field of the records, e.g., the per-PC
+// counts of a memory trace (field 0) or the hottest addresses (field 1).
+//
+// usage: tracestat [-j workers] [-f field] [-n top] <file> [<file> ...]
+//
+
+#include "pin++/Trace_Driver.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+using OASIS::Pin::Trace_Analysis;
+using OASIS::Pin::Trace_Driver;
+using OASIS::Pin::Trace_Record;
+
+/**
+ * @class Field_Count
+ *
+ * Counts the number of times each value of a field appears.
+ */
+class Field_Count : public Trace_Analysis <Field_Count>
+{
+public:
+  typedef std::unordered_map <uint64_t, uint64_t> map_type;
+
+  explicit Field_Count (uint32_t field)
+    : field_ (field),
+      records_ (0)
+  {
+
+  }
+
+  void handle_record (const Trace_Record & record)
+  {
+    ++ this->counts_[record.field (this->field_)];
+    ++ this->records_;
+  }
+
+  void merge (const Field_Count & other)
+  {
+    for (map_type::const_iterator iter = other.counts_.begin (); iter != other.counts_.end (); ++ iter)
+      this->counts_[iter->first] += iter->second;
+
+    this->records_ += other.records_;
+  }
+
+  const map_type & counts (void) const
+  {
+    return this->counts_;
+  }
+
+  uint64_t records (void) const
+  {
+    return this->records_;
+  }
+
+private:
+  uint32_t field_;
+
+  uint64_t records_;
+
+  map_type counts_;
+};
+
+static bool more_frequent (const std::pair <uint64_t, uint64_t> & lhs,
+                           const std::pair <uint64_t, uint64_t> & rhs)
+{
+  return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+}
+
+static void usage (const char * program)
+{
+  fprintf (stderr, "usage: %s [-j workers] [-f field] [-n top] <file> [<file> ...]\n", program);
+}
+
+int main (int argc, char * argv [])
+{
+  size_t workers = 0;
+  uint32_t field = 0;
+  size_t top = 20;
+  int i = 1;
+
+  for (; i + 1 < argc && '-' == argv[i][0]; i += 2)
+  {
+    if (0 == ::strcmp (argv[i], "-j"))
+      workers = ::strtoul (argv[i + 1], 0, 10);
+    else if (0 == ::strcmp (argv[i], "-f"))
+      field = ::strtoul (argv[i + 1], 0, 10);
+    else if (0 == ::strcmp (argv[i], "-n"))
+      top = ::strtoul (argv[i + 1], 0, 10);
+    else
+      break;
+  }
+
+  if (i >= argc)
+  {
+    usage (argv[0]);
+    return 1;
+  }
+
+  std::vector <std::string> files (argv + i, argv + argc);
+
+  Field_Count analysis (field);
+  Trace_Driver <Field_Count> driver (workers);
+
+  bool passed = driver.run (files, analysis);
+
+  for (size_t k = 0; k < driver.failed ().size (); ++ k)
+    fprintf (stderr, "*** error: %s is not a trace file, or is corrupt\n", driver.failed ()[k].c_str ());
+
+  std::vector <std::pair <uint64_t, uint64_t> > sorted (analysis.counts ().begin (), analysis.counts ().end ());
+  size_t count = std::min (top, sorted.size ());
+
+  std::partial_sort (sorted.begin (), sorted.begin () + count, sorted.end (), more_frequent);
+
+  printf ("# %llu records, %llu distinct values of field %u, %llu workers\n",
+          static_cast <unsigned long long> (analysis.records ()),
+          static_cast <unsigned long long> (sorted.size ()),
+          field,
+          static_cast <unsigned long long> (driver.workers ()));
+
+  for (size_t k = 0; k < count; ++ k)
+    printf ("%llx %llu\n",
+            static_cast <unsigned long long> (sorted[k].first),
+            static_cast <unsigned long long> (sorted[k].second));
+
+  return passed ? 0 : 1;
+}